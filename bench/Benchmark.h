@@ -0,0 +1,57 @@
+#ifndef FDCORE_BENCHMARK_H
+#define FDCORE_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs f(iterations) once to warm up, then reports the best of runs timed executions
+ * as operations per second
+ */
+template<typename F>
+double runBenchmark(const std::string &name, size_t iterations, F &&f, size_t runs = 5)
+{
+    f(iterations);
+
+    double best = 0.0;
+    for(size_t i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f(iterations);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double opsPerSecond = static_cast<double>(iterations) / elapsed.count();
+        if(opsPerSecond > best)
+            best = opsPerSecond;
+    }
+
+    std::printf("%-40s %12.2f Mops/s\n", name.c_str(), best / 1e6);
+    return best;
+}
+
+/**
+ * @brief Reports the median and the 99th percentile of latencies, in seconds
+ */
+inline void reportLatencies(const std::string &name, std::vector<double> latencies)
+{
+    if(latencies.empty())
+        return;
+
+    std::sort(latencies.begin(), latencies.end());
+    const double median = latencies[latencies.size() / 2];
+    const double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    std::printf("%-40s %9.1f us p50 %9.1f us p99\n", name.c_str(), median * 1e6, p99 * 1e6);
+}
+
+/**
+ * @brief Keeps the compiler from optimizing away the computation of value
+ */
+template<typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // FDCORE_BENCHMARK_H
@@ -0,0 +1,93 @@
+#ifndef FDCORE_BUFFERPOOL_BENCH_H
+#define FDCORE_BUFFERPOOL_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/Request.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Acquiring and releasing buffers on one thread, and handing them over from the thread
+ * that acquires them to the thread that releases them, as the server does with the requests
+ */
+inline void benchBufferPool()
+{
+    FDCore::BufferPool pool;
+
+    runBenchmark("Buffer pool acquire 64 KiB", 2000000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(pool.acquire()->data.get());
+    });
+
+    runBenchmark("Buffer pool acquire x8 of 200 B", 500000, [&](size_t iterations) {
+        std::vector<FDCore::BufferPool::BufferPtr> buffers(8);
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(FDCore::BufferPool::BufferPtr &buffer: buffers)
+                buffer = pool.acquire(200);
+            for(FDCore::BufferPool::BufferPtr &buffer: buffers)
+                buffer.reset();
+        }
+    });
+
+    const uint8_t payload[100] = {};
+    FDCore::MessageHeader header;
+    header.setFiled("path", { 6, reinterpret_cast<const uint8_t *>("/items") });
+    runBenchmark("Buffer pool small request encode", 2000000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(FDCore::Request::create(pool, FDCore::RequestType::Read, header,
+                                                  { sizeof(payload), payload })
+                            .getFrame()
+                            .size);
+    });
+
+    // batches of 64 buffers acquired by this thread and released by another one
+    runBenchmark("Buffer pool cross-thread release", 1000000, [&](size_t iterations) {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<std::vector<FDCore::BufferPool::BufferPtr>> batches;
+        bool isDone = false;
+        std::thread releaser([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(!isDone || !batches.empty())
+            {
+                ready.wait(lock, [&]() { return isDone || !batches.empty(); });
+                while(!batches.empty())
+                {
+                    std::vector<FDCore::BufferPool::BufferPtr> batch = std::move(batches.front());
+                    batches.pop_front();
+                    lock.unlock();
+                    batch.clear();
+                    lock.lock();
+                }
+            }
+        });
+
+        for(size_t i = 0; i < iterations; i += 64)
+        {
+            std::vector<FDCore::BufferPool::BufferPtr> batch;
+            batch.reserve(64);
+            for(size_t j = 0; j < 64; ++j)
+                batch.push_back(pool.acquire(512));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(std::move(batch));
+            ready.notify_one();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isDone = true;
+            ready.notify_one();
+        }
+        releaser.join();
+    });
+}
+
+#endif // FDCORE_BUFFERPOOL_BENCH_H
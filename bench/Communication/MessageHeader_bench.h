@@ -0,0 +1,105 @@
+#ifndef FDCORE_MESSAGEHEADER_BENCH_H
+#define FDCORE_MESSAGEHEADER_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Encoding and parsing a header with the usual fields of a request, then parsing a header
+ * full of large fields and rejecting hostile ones, to keep the cost of the checks visible
+ */
+inline void benchMessageHeader()
+{
+    auto bytes = [](std::string_view text) {
+        return FDCore::Span<const uint8_t> { static_cast<uint32_t>(text.size()),
+                                             reinterpret_cast<const uint8_t *>(text.data()) };
+    };
+
+    FDCore::MessageHeader header(64);
+    header.setType(1);
+    header.setRequestId(42);
+    header.setFiled("path", bytes("/items/1234"));
+    header.setFiled("id", bytes("8f14e45f"));
+    header.setFiled("content-type", bytes("application/json"));
+    header.setFiled("token", bytes("abcdef"));
+    header.setFiled("trace-id", bytes("0af7651916cd43dd"));
+    header.setFiled("x-shard", bytes("7"));
+    std::printf("%-40s %12zu bytes\n", "Message header size", header.size());
+
+    std::vector<uint8_t> buffer(header.size());
+    const FDCore::Span<uint8_t> output { static_cast<uint32_t>(buffer.size()), buffer.data() };
+    runBenchmark("Message header write", 2000000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(header.write(output));
+    });
+
+    FDCore::MessageHeaderView view;
+    runBenchmark("Message header view parse", 2000000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            doNotOptimize(view.parse(output));
+            doNotOptimize(view.getField("content-type").size);
+        }
+    });
+
+    FDCore::MessageHeader owning;
+    runBenchmark("Message header read", 500000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(owning.read(output));
+    });
+
+    FDCore::MessageHeader large;
+    const std::string value(1000, 'v');
+    for(size_t i = 0; i < FDCore::MessageHeaderView::MaxFields; ++i)
+        large.setFiled("x-field-" + std::to_string(i), bytes(value));
+    std::vector<uint8_t> largeBuffer(large.size());
+    const FDCore::Span<uint8_t> largeOutput { static_cast<uint32_t>(largeBuffer.size()),
+                                              largeBuffer.data() };
+    large.write(largeOutput);
+    const double largeRate = runBenchmark("Message header view parse, 32 KiB", 500000,
+                                          [&](size_t iterations) {
+                                              for(size_t i = 0; i < iterations; ++i)
+                                                  doNotOptimize(view.parse(largeOutput));
+                                          });
+    std::printf("%-40s %12.0f MB/s\n", "Message header view parse, 32 KiB",
+                largeRate * static_cast<double>(largeBuffer.size()) / 1e6);
+
+    // a header claiming 4 GiB, and one whose first value is longer than the limit
+    std::vector<uint8_t> hostile(largeBuffer.begin(),
+                                 largeBuffer.begin() + FDCore::WireFormat::PreambleSize);
+    FDCore::WireFormat::storeUint32(hostile.data() + FDCore::WireFormat::HeaderLengthOffset,
+                                    UINT32_MAX);
+    FDCore::MessageHeaderLimits limits;
+    limits.maxValueLength = 512;
+    runBenchmark("Message header rejection", 1000000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            try
+            {
+                view.parse({ static_cast<uint32_t>(hostile.size()), hostile.data() });
+            }
+            catch(const std::length_error &)
+            {
+            }
+
+            try
+            {
+                view.parse(largeOutput, limits);
+            }
+            catch(const std::length_error &)
+            {
+            }
+        }
+    });
+}
+
+#endif // FDCORE_MESSAGEHEADER_BENCH_H
@@ -0,0 +1,92 @@
+#ifndef FDCORE_MESSAGESERVER_BENCH_H
+#define FDCORE_MESSAGESERVER_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/Communication/MessageClient.h>
+#include <FDCore/Communication/MessageServer.h>
+
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Round trips of small requests to a server on the loopback interface, one at a time
+ * and pipelined
+ */
+inline void benchMessageServer()
+{
+    FDCore::ThreadPool threads(2);
+    FDCore::MessageServer server(
+      threads, [](const FDCore::Request &request, FDCore::BufferPool &pool) {
+          return FDCore::Response::create(pool, FDCore::ResponseStatus::Ok,
+                                          FDCore::MessageHeader(), request.getPayload());
+      });
+
+    const std::string path = "/tmp/fdcore_bench_" + std::to_string(getpid()) + ".sock";
+    unlink(path.c_str());
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.listenUnix(path);
+    server.start();
+
+    const std::string payload(64, 'p');
+    const FDCore::Span<const uint8_t> payloadBytes {
+        static_cast<uint32_t>(payload.size()), reinterpret_cast<const uint8_t *>(payload.data())
+    };
+    FDCore::MessageHeader header;
+    header.setFiled("path", { 6, reinterpret_cast<const uint8_t *>("/items") });
+
+    auto benchClient = [&](const std::string &name, FDCore::Socket socket) {
+        FDCore::MessageClient client(std::move(socket));
+        FDCore::Request request = FDCore::Request::create(
+          client.getPool(), FDCore::RequestType::Read, header, payloadBytes);
+
+        std::vector<double> latencies;
+        runBenchmark(name + " round trip", 20000, [&](size_t iterations) {
+            latencies.clear();
+            for(size_t i = 0; i < iterations; ++i)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                doNotOptimize(client.call(request).getPayload().size);
+                latencies.push_back(
+                  std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+        });
+        reportLatencies(name + " round trip latency", latencies);
+
+        const size_t window = 64;
+        std::vector<FDCore::Request> batch;
+        for(size_t i = 0; i < window; ++i)
+            batch.push_back(FDCore::Request::create(client.getPool(), FDCore::RequestType::Read,
+                                                    header, payloadBytes));
+
+        runBenchmark(name + " pipelined x64", 200000, [&](size_t iterations) {
+            for(size_t i = 0; i < iterations; i += window)
+            {
+                client.send({ batch.size(), batch.data() });
+                for(size_t j = 0; j < window; ++j)
+                    doNotOptimize(client.receive().getPayload().size);
+            }
+        });
+
+        // a new request is sent as soon as a response arrives, keeping the window full
+        client.setWindow(window);
+        runBenchmark(name + " sliding window x64", 200000, [&](size_t iterations) {
+            for(size_t i = 0; i < iterations; ++i)
+            {
+                FDCore::Request &next = batch[i % window];
+                client.send(next);
+                if(client.getArrivedCount() > 0)
+                    doNotOptimize(client.receive().getPayload().size);
+            }
+            while(client.getInFlightCount() + client.getArrivedCount() > 0)
+                doNotOptimize(client.receive().getPayload().size);
+        });
+    };
+
+    benchClient("TCP loopback", FDCore::Socket::connectTcp("127.0.0.1", port));
+    benchClient("Unix socket", FDCore::Socket::connectUnix(path));
+}
+
+#endif // FDCORE_MESSAGESERVER_BENCH_H
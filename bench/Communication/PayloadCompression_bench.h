@@ -0,0 +1,72 @@
+#ifndef FDCORE_PAYLOADCOMPRESSION_BENCH_H
+#define FDCORE_PAYLOADCOMPRESSION_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Communication/DeflateCodec.h>
+#include <FDCore/Communication/PayloadCompression.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compressing and decompressing JSON-like payloads, large ones alone and small ones
+ * with a dictionary
+ */
+inline void benchPayloadCompression()
+{
+    auto makePayload = [](size_t first, size_t count) {
+        std::string payload = "[";
+        for(size_t i = first; i < first + count; ++i)
+            payload += "{\"id\":" + std::to_string(i) + ",\"status\":\"active\",\"price\":" +
+                       std::to_string(i % 97) + ".5,\"tags\":[\"new\",\"sale\"]},";
+        payload.back() = ']';
+        return payload;
+    };
+    auto bytes = [](const std::string &text) {
+        return FDCore::Span<const uint8_t> { static_cast<uint32_t>(text.size()),
+                                             reinterpret_cast<const uint8_t *>(text.data()) };
+    };
+
+    FDCore::BufferPool pool;
+    const FDCore::MessageHeader header;
+    auto codec = std::make_shared<FDCore::DeflateCodec>();
+    FDCore::PayloadCompression compression(codec);
+
+    const std::string large = makePayload(0, 64);
+    FDCore::Message message = compression.encode(pool, 0, header, bytes(large));
+    std::printf("%-40s %12zu -> %zu bytes\n", "Deflate 4 KiB payload", large.size(),
+                static_cast<size_t>(message.getPayload().size));
+    runBenchmark("Deflate 4 KiB payload encode", 20000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(compression.encode(pool, 0, header, bytes(large)).getFrame().size);
+    });
+    runBenchmark("Deflate 4 KiB payload decode", 50000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(compression.decode(message, pool).size());
+    });
+
+    const std::string sample = makePayload(1000, 16);
+    FDCore::PayloadCompression primed(codec, 0);
+    primed.addDictionary(1, std::vector<uint8_t>(sample.begin(), sample.end()));
+    primed.useDictionary(1);
+    const std::string small = makePayload(5, 2);
+    FDCore::Message plainSmall = FDCore::PayloadCompression(codec, 0).encode(pool, 0, header,
+                                                                             bytes(small));
+    FDCore::Message primedSmall = primed.encode(pool, 0, header, bytes(small));
+    std::printf("%-40s %12zu -> %zu bytes, %zu with dictionary\n", "Deflate small frame",
+                static_cast<size_t>(header.size() + small.size()),
+                static_cast<size_t>(plainSmall.getFrame().size),
+                static_cast<size_t>(primedSmall.getFrame().size));
+    runBenchmark("Deflate small payload with dictionary", 50000, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            FDCore::Message encoded = primed.encode(pool, 0, header, bytes(small));
+            doNotOptimize(primed.decode(encoded, pool).size());
+        }
+    });
+}
+
+#endif // FDCORE_PAYLOADCOMPRESSION_BENCH_H
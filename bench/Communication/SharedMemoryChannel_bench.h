@@ -0,0 +1,79 @@
+#ifndef FDCORE_SHAREDMEMORYCHANNEL_BENCH_H
+#define FDCORE_SHAREDMEMORYCHANNEL_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Communication/SharedMemoryChannel.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief One-way throughput and round trips through a pair of channels served by an echo
+ * thread
+ */
+inline void benchSharedMemoryChannel()
+{
+    const std::string prefix = "/fdcore_bench_" + std::to_string(getpid());
+    FDCore::SharedMemoryChannel requests =
+      FDCore::SharedMemoryChannel::create(prefix + "_requests", 1 << 20);
+    FDCore::SharedMemoryChannel responses =
+      FDCore::SharedMemoryChannel::create(prefix + "_responses", 1 << 20);
+    FDCore::SharedMemoryChannel::remove(prefix + "_requests");
+    FDCore::SharedMemoryChannel::remove(prefix + "_responses");
+
+    const std::string payload(64, 'p');
+    const FDCore::Span<const uint8_t> payloadBytes {
+        static_cast<uint32_t>(payload.size()), reinterpret_cast<const uint8_t *>(payload.data())
+    };
+    FDCore::MessageHeader header;
+    header.setFiled("path", { 6, reinterpret_cast<const uint8_t *>("/items") });
+
+    // the echo thread sends back every frame, a frame of type 1 stops it
+    std::thread echo([&requests, &responses]() {
+        bool isRunning = true;
+        while(isRunning)
+        {
+            requests.read([&](FDCore::Span<const uint8_t> frame) {
+                isRunning = frame.data[0] != 1;
+                const FDCore::Span<const uint8_t> copy = frame;
+                responses.send(FDCore::MessageHeader(), copy);
+            });
+        }
+    });
+
+    std::vector<double> latencies;
+    runBenchmark("Shared memory round trip", 200000, [&](size_t iterations) {
+        latencies.clear();
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            requests.send(header, payloadBytes);
+            responses.read([](FDCore::Span<const uint8_t> frame) { doNotOptimize(frame.size); });
+            latencies.push_back(
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    });
+    reportLatencies("Shared memory round trip latency", latencies);
+
+    runBenchmark("Shared memory streamed", 1000000, [&](size_t iterations) {
+        std::thread drain([&responses, iterations]() {
+            auto consume = [](FDCore::Span<const uint8_t> frame) { doNotOptimize(frame.size); };
+            for(size_t i = 0; i < iterations; ++i)
+                responses.read(consume);
+        });
+        for(size_t i = 0; i < iterations; ++i)
+            requests.send(header, payloadBytes);
+        drain.join();
+    });
+
+    FDCore::MessageHeader stop;
+    stop.setType(1);
+    requests.send(stop, { 0, nullptr });
+    echo.join();
+}
+
+#endif // FDCORE_SHAREDMEMORYCHANNEL_BENCH_H
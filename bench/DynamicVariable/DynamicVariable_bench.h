@@ -0,0 +1,55 @@
+#ifndef FDCORE_DYNAMICVARIABLE_BENCH_H
+#define FDCORE_DYNAMICVARIABLE_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+
+#include <vector>
+
+inline void benchDynamicVariableOperators()
+{
+    using FDCore::DynamicVariable;
+
+    // alternate integers and floats so that every type pair is dispatched
+    std::vector<DynamicVariable> values;
+    for(int i = 0; i < 1024; ++i)
+    {
+        if(i % 2 == 0)
+            values.emplace_back(DynamicVariable::IntType(i + 1));
+        else
+            values.emplace_back(DynamicVariable::FloatType(i + 0.5));
+    }
+
+    const size_t mask = values.size() - 1;
+    runBenchmark("DynamicVariable mixed operator+", 1 << 22, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(values[i & mask] + values[(i * 7 + 3) & mask]);
+    });
+
+    runBenchmark("DynamicVariable mixed operator*", 1 << 22, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(values[i & mask] * values[(i * 7 + 3) & mask]);
+    });
+
+    runBenchmark("DynamicVariable mixed operator+=", 1 << 22, [&](size_t iterations) {
+        DynamicVariable acc(DynamicVariable::IntType(0));
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            if((i & 1023) == 0)
+                acc = DynamicVariable(DynamicVariable::IntType(0));
+
+            acc += values[i & mask];
+        }
+        doNotOptimize(acc);
+    });
+
+    runBenchmark("DynamicVariable mixed operator==", 1 << 22, [&](size_t iterations) {
+        size_t count = 0;
+        for(size_t i = 0; i < iterations; ++i)
+            count += values[i & mask] == values[(i * 7 + 3) & mask];
+        doNotOptimize(count);
+    });
+}
+
+#endif // FDCORE_DYNAMICVARIABLE_BENCH_H
@@ -0,0 +1,66 @@
+#ifndef FDCORE_EXPRESSION_BENCH_H
+#define FDCORE_EXPRESSION_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/DynamicVariable/Expression.h>
+
+#include <string>
+
+inline void benchExpression()
+{
+    using FDCore::DynamicVariable;
+
+    const size_t recordCount = 1024;
+    DynamicVariable::ArrayType cells;
+    for(size_t i = 0; i < recordCount; ++i)
+    {
+        DynamicVariable record(FDCore::ValueType::Object);
+        record.set("quantity", DynamicVariable(DynamicVariable::IntType(i % 17)));
+        record.set("price", DynamicVariable(0.25 * static_cast<double>(i % 13)));
+        record.set("status", DynamicVariable(i % 3 ? "active" : "closed"));
+        cells.push_back(record.internalValue());
+    }
+
+    const DynamicVariable records(std::move(cells));
+    const std::string source = "status == 'active' && quantity * price > 2.0";
+
+    FDCore::ExpressionEnvironment environment;
+    environment.fieldTypes["/quantity"] = FDCore::ValueType::Integer;
+    environment.fieldTypes["/price"] = FDCore::ValueType::Float;
+    const FDCore::Expression generic(source);
+    const FDCore::Expression typed(source, environment);
+
+    // each iteration evaluates the filter on one record
+    runBenchmark("DynamicVariable operators", recordCount << 8, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; i += recordCount)
+        {
+            for(size_t j = 0; j < recordCount; ++j)
+            {
+                const DynamicVariable record = records[j];
+                doNotOptimize(record["status"] == DynamicVariable::StringViewType("active") &&
+                              static_cast<bool>(record["quantity"] * record["price"] > 2.0));
+            }
+        }
+    });
+
+    runBenchmark("Expression evaluate", recordCount << 8, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; i += recordCount)
+        {
+            for(size_t j = 0; j < recordCount; ++j)
+                doNotOptimize(generic.evaluate(records[j]));
+        }
+    });
+
+    runBenchmark("Expression filter", recordCount << 8, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; i += recordCount)
+            doNotOptimize(generic.filter(records));
+    });
+
+    runBenchmark("Expression filter, typed fields", recordCount << 8, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; i += recordCount)
+            doNotOptimize(typed.filter(records));
+    });
+}
+
+#endif // FDCORE_EXPRESSION_BENCH_H
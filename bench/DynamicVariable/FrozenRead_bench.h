@@ -0,0 +1,93 @@
+#ifndef FDCORE_FROZENREAD_BENCH_H
+#define FDCORE_FROZENREAD_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/DynamicVariable/DynamicVariableRef.h>
+
+#include <algorithm>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Splits iterations between threadCount tasks of pool, each running read(count)
+ */
+template<typename F>
+void runOnPool(FDCore::ThreadPool &pool, size_t threadCount, size_t iterations, const F &read)
+{
+    std::vector<std::future<void>> tasks;
+    for(size_t i = 0; i < threadCount; ++i)
+        tasks.push_back(pool.enqueue(read, iterations / threadCount));
+
+    for(auto &task: tasks)
+        task.get();
+}
+
+inline void benchFrozenRead()
+{
+    using FDCore::DynamicVariable;
+    using FDCore::DynamicVariableRef;
+    using FDCore::InternedString;
+
+    DynamicVariable document(FDCore::ValueType::Object);
+    for(int i = 0; i < 8; ++i)
+    {
+        DynamicVariable record(FDCore::ValueType::Object);
+        for(int j = 0; j < 8; ++j)
+            record.set("field" + std::to_string(j), DynamicVariable(DynamicVariable::IntType(j)));
+
+        document.set("record" + std::to_string(i), record);
+    }
+
+    document.freeze();
+
+    std::vector<std::pair<InternedString, InternedString>> names;
+    for(size_t i = 0; i < 16; ++i)
+    {
+        names.emplace_back(
+          FDCore::StringInterner::global().intern("record" + std::to_string(i % 8)),
+          FDCore::StringInterner::global().intern("field" + std::to_string((i * 3) % 8)));
+    }
+
+    // each iteration reads the 16 fields of the document
+    auto readVariable = [&document, &names](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const auto &name: names)
+                doNotOptimize(document[name.first.view()][name.second.view()]);
+        }
+    };
+
+    const DynamicVariableRef root(document);
+    auto readRef = [root, &names](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const auto &name: names)
+                doNotOptimize(root[name.first][name.second].getNode());
+        }
+    };
+
+    const size_t maxThreads = std::max<size_t>(1, std::min<size_t>(
+                                                    8, std::thread::hardware_concurrency()));
+    std::vector<size_t> threadCounts { 1 };
+    if(maxThreads > 1)
+        threadCounts.push_back(maxThreads);
+
+    FDCore::ThreadPool pool(maxThreads);
+    for(size_t threadCount: threadCounts)
+    {
+        const std::string suffix = " x" + std::to_string(threadCount);
+        runBenchmark("Frozen DynamicVariable operator[]" + suffix, 1 << 18,
+                     [&](size_t iterations) {
+                         runOnPool(pool, threadCount, iterations, readVariable);
+                     });
+
+        runBenchmark("Frozen DynamicVariableRef operator[]" + suffix, 1 << 18,
+                     [&](size_t iterations) { runOnPool(pool, threadCount, iterations, readRef); });
+    }
+}
+
+#endif // FDCORE_FROZENREAD_BENCH_H
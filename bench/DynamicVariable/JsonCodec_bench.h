@@ -0,0 +1,66 @@
+#ifndef FDCORE_JSONCODEC_BENCH_H
+#define FDCORE_JSONCODEC_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/DynamicVariable/JsonCodec.h>
+
+#include <string>
+#include <vector>
+
+struct JsonCodecBenchRecord
+{
+    std::string name;
+    int64_t id = 0;
+    double score = 0.0;
+    bool active = false;
+    std::vector<int64_t> values;
+};
+
+FDCORE_STRUCT_SCHEMA(JsonCodecBenchRecord,
+                     FDCORE_STRUCT_FIELD(JsonCodecBenchRecord, name),
+                     FDCORE_STRUCT_FIELD(JsonCodecBenchRecord, id),
+                     FDCORE_STRUCT_FIELD(JsonCodecBenchRecord, score),
+                     FDCORE_STRUCT_FIELD(JsonCodecBenchRecord, active),
+                     FDCORE_STRUCT_FIELD(JsonCodecBenchRecord, values));
+
+inline void benchJsonCodec()
+{
+    JsonCodecBenchRecord record { "benchmark record", 42, 0.75, true, { 1, 2, 3, 4, 5, 6, 7, 8 } };
+    const std::string json = FDCore::toJson(record);
+
+    runBenchmark("struct to JSON through DynamicVariable", 1 << 18, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+            doNotOptimize(FDCore::toJson(FDCore::DynamicVariable(record)));
+    });
+
+    runBenchmark("struct to JSON direct", 1 << 18, [&](size_t iterations) {
+        std::string output;
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            output.clear();
+            FDCore::writeJson(record, output);
+            doNotOptimize(output.data());
+        }
+    });
+
+    runBenchmark("JSON to struct through DynamicVariable", 1 << 16, [&](size_t iterations) {
+        JsonCodecBenchRecord result;
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            FDCore::fromVariable(FDCore::DynamicVariableView(json).toVariable(), result);
+            doNotOptimize(result);
+        }
+    });
+
+    runBenchmark("JSON to struct direct", 1 << 16, [&](size_t iterations) {
+        JsonCodecBenchRecord result;
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            FDCore::readJson(FDCore::DynamicVariableView(json), result);
+            doNotOptimize(result);
+        }
+    });
+}
+
+#endif // FDCORE_JSONCODEC_BENCH_H
@@ -0,0 +1,64 @@
+#ifndef FDCORE_PATHQUERY_BENCH_H
+#define FDCORE_PATHQUERY_BENCH_H
+
+#include "../Benchmark.h"
+
+#include <FDCore/DynamicVariable/PathQuery.h>
+
+#include <string>
+#include <vector>
+
+inline void benchPathQuery()
+{
+    using FDCore::DynamicVariable;
+
+    DynamicVariable document(FDCore::ValueType::Object);
+    for(int i = 0; i < 8; ++i)
+    {
+        DynamicVariable record(FDCore::ValueType::Object);
+        for(int j = 0; j < 8; ++j)
+            record.set("field" + std::to_string(j), DynamicVariable(DynamicVariable::IntType(j)));
+
+        document.set("record" + std::to_string(i), record);
+    }
+
+    const size_t pathCount = 16;
+    std::vector<std::pair<std::string, std::string>> names;
+    std::vector<FDCore::PathQuery> queries;
+    FDCore::PathQueryBatch batch;
+    for(size_t i = 0; i < pathCount; ++i)
+    {
+        names.emplace_back("record" + std::to_string(i % 8),
+                           "field" + std::to_string((i * 3) % 8));
+        queries.emplace_back("/" + names.back().first + "/" + names.back().second);
+        batch.add(queries.back());
+    }
+
+    // each iteration extracts the 16 paths from the document
+    runBenchmark("DynamicVariable chained operator[]", 1 << 18, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const auto &name: names)
+                doNotOptimize(document[name.first][name.second]);
+        }
+    });
+
+    runBenchmark("PathQuery get", 1 << 18, [&](size_t iterations) {
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const FDCore::PathQuery &query: queries)
+                doNotOptimize(query.get(document));
+        }
+    });
+
+    runBenchmark("PathQueryBatch extract", 1 << 18, [&](size_t iterations) {
+        std::vector<DynamicVariable> results;
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            batch.extract(document, results);
+            doNotOptimize(results.data());
+        }
+    });
+}
+
+#endif // FDCORE_PATHQUERY_BENCH_H
@@ -0,0 +1,25 @@
+#include "Communication/BufferPool_bench.h"
+#include "Communication/MessageHeader_bench.h"
+#include "Communication/MessageServer_bench.h"
+#include "Communication/PayloadCompression_bench.h"
+#include "Communication/SharedMemoryChannel_bench.h"
+#include "DynamicVariable/DynamicVariable_bench.h"
+#include "DynamicVariable/Expression_bench.h"
+#include "DynamicVariable/FrozenRead_bench.h"
+#include "DynamicVariable/JsonCodec_bench.h"
+#include "DynamicVariable/PathQuery_bench.h"
+
+int main()
+{
+    benchDynamicVariableOperators();
+    benchPathQuery();
+    benchJsonCodec();
+    benchFrozenRead();
+    benchExpression();
+    benchBufferPool();
+    benchMessageHeader();
+    benchMessageServer();
+    benchPayloadCompression();
+    benchSharedMemoryChannel();
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/MessageDecoder.h>
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+#include <FDCore/Communication/Request.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Small limits so that the fuzzer reaches them with short inputs
+     */
+    FDCore::MessageHeaderLimits makeFuzzLimits()
+    {
+        FDCore::MessageHeaderLimits limits;
+        limits.maxHeaderLength = 4096;
+        limits.maxNameLength = 64;
+        limits.maxValueLength = 1024;
+        return limits;
+    }
+
+    void check(bool condition)
+    {
+        if(!condition)
+            abort();
+    }
+
+    /**
+     * @brief A header that parses is converted, written again and parsed back to the same
+     * fields
+     */
+    void fuzzHeader(FDCore::Span<const uint8_t> input, const FDCore::MessageHeaderLimits &limits)
+    {
+        FDCore::MessageHeaderView view;
+        try
+        {
+            if(!view.parse(input, limits))
+                return;
+        }
+        catch(const std::invalid_argument &)
+        {
+            return;
+        }
+        catch(const std::length_error &)
+        {
+            return;
+        }
+
+        check(view.getHeaderLength() <= input.size);
+        check(view.getHeaderLength() <= limits.maxHeaderLength);
+        for(size_t i = 0; i < view.getFieldCount(); ++i)
+        {
+            const FDCore::MessageHeaderView::FieldValue value = view.getValue(i);
+            check(value.data >= input.data &&
+                  value.data + value.size <= input.data + view.getHeaderLength());
+            check(view.find(view.getName(i)) <= i);
+        }
+
+        FDCore::MessageHeader header;
+        check(header.read(input, limits) == view.getHeaderLength());
+
+        std::vector<uint8_t> buffer(header.size());
+        header.write({ static_cast<uint32_t>(buffer.size()), buffer.data() });
+
+        // the written header holds each name once, well-known names as keys, so it may be
+        // shorter than the input but never longer than the limits require
+        FDCore::MessageHeaderView written;
+        check(written.parse({ static_cast<uint32_t>(buffer.size()), buffer.data() }));
+        check(written.getType() == view.getType());
+        check(written.getRequestId() == view.getRequestId());
+        check(written.getPayloadLength() == view.getPayloadLength());
+        for(size_t i = 0; i < view.getFieldCount(); ++i)
+        {
+            const FDCore::MessageHeaderView::FieldValue expected =
+              view.getValue(view.find(view.getName(i)));
+            const FDCore::MessageHeaderView::FieldValue value = written.getField(view.getName(i));
+            check(value.size == expected.size &&
+                  (value.size == 0 || memcmp(value.data, expected.data, value.size) == 0));
+        }
+    }
+
+    /**
+     * @brief The input is received as a stream, in reads whose sizes come from its first byte
+     */
+    void fuzzStream(FDCore::Span<const uint8_t> input, const FDCore::MessageHeaderLimits &limits)
+    {
+        if(input.size == 0)
+            return;
+
+        const size_t readSize = input.data[0] % 64 + 1;
+        FDCore::BufferPool pool(1024, 4);
+        FDCore::MessageDecoder decoder(pool, 8192, limits);
+        try
+        {
+            for(uint32_t offset = 1; offset < input.size;)
+            {
+                const FDCore::Span<uint8_t> space = decoder.prepare();
+                const size_t count =
+                  std::min<size_t>({ readSize, space.size, input.size - offset });
+                memcpy(space.data, input.data + offset, count);
+                decoder.commit(count);
+                offset += static_cast<uint32_t>(count);
+
+                FDCore::Request request;
+                while(decoder.next(request))
+                {
+                    const FDCore::Span<const uint8_t> frame = request.getFrame();
+                    check(frame.size == request.getHeader().getHeaderLength() +
+                                          request.getPayload().size);
+                }
+            }
+        }
+        catch(const std::invalid_argument &)
+        {
+        }
+        catch(const std::length_error &)
+        {
+        }
+    }
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if(size > UINT32_MAX)
+        return 0;
+
+    const FDCore::Span<const uint8_t> input { static_cast<uint32_t>(size), data };
+    const FDCore::MessageHeaderLimits limits = makeFuzzLimits();
+    fuzzHeader(input, limits);
+    fuzzStream(input, limits);
+    return 0;
+}
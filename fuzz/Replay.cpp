@@ -0,0 +1,32 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/**
+ * @brief Runs the fuzz target on the files given as arguments, for compilers without libFuzzer,
+ * so that a corpus or a crash found elsewhere can be replayed under any sanitizer
+ */
+int main(int argc, char **argv)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::ifstream file(argv[i], std::ios::binary);
+        if(!file)
+        {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+
+        const std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)),
+                                         std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    std::printf("%d inputs replayed\n", argc - 1);
+    return 0;
+}
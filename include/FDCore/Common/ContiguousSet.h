@@ -658,6 +658,7 @@ namespace FDCore
             {
                 it = first;
                 step = count / 2;
+                std::advance(it, step);
                 size_t h = hasher(*it);
                 if(h < hash)
                 {
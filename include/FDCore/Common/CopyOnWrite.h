@@ -5,6 +5,27 @@
 
 namespace FDCore
 {
+    /**
+     * @brief Makes the private copy of a shared object before it is modified
+     *
+     * Specialize it for polymorphic types, which cannot be copied through their base class.
+     */
+    template<typename T>
+    struct CopyOnWriteTraits
+    {
+        static std::shared_ptr<T> copy(const T &value) { return std::shared_ptr<T>(new T(value)); }
+
+        /**
+         * @brief Called on the private object before each access that may modify it
+         */
+        static void prepareWrite(T & /*value*/) {}
+
+        /**
+         * @brief A frozen object is copied before being modified even if it is not shared
+         */
+        static bool isFrozen(const T & /*value*/) { return false; }
+    };
+
     template<typename T>
     class CopyOnWrite
     {
@@ -17,8 +38,13 @@ namespace FDCore
         void detach()
         {
             T *tmp = m_ptr.get();
-            if(tmp != nullptr && !m_ptr.unique())
-                m_ptr = PointerType(new T(*tmp));
+            if(tmp == nullptr)
+                return;
+
+            if(!isWritable())
+                m_ptr = CopyOnWriteTraits<T>::copy(*tmp);
+
+            CopyOnWriteTraits<T>::prepareWrite(*m_ptr);
         }
 
       public:
@@ -76,14 +102,8 @@ namespace FDCore
         {
         }
 
-        template<typename Y>
-        CopyOnWrite(std::auto_ptr<Y> &&r) : m_ptr(r)
-        {
-        }
-
-
         template<typename Y, class Deleter>
-        CopyOnWrite(std::unique_ptr<Y, Deleter> &&r) : m_ptr(r)
+        CopyOnWrite(std::unique_ptr<Y, Deleter> &&r) : m_ptr(std::move(r))
         {
         }
 
@@ -114,6 +134,12 @@ namespace FDCore
 
         T *get() const noexcept { return m_ptr.get(); }
 
+        /**
+         * @brief Gets the shared pointer without detaching, the object must not be modified
+         * through it while it is shared
+         */
+        const PointerType &getSharedPointer() const noexcept { return m_ptr; }
+
         const T &operator*() const { return *m_ptr; }
 
         T &operator*()
@@ -133,6 +159,14 @@ namespace FDCore
         explicit operator bool() const noexcept { return static_cast<bool>(m_ptr); }
 
         long use_count() const noexcept { return m_ptr.use_count(); }
+
+        /**
+         * @brief Checks if the object can be modified in place, without being copied first
+         */
+        bool isWritable() const
+        {
+            return m_ptr.unique() && !CopyOnWriteTraits<T>::isFrozen(*m_ptr);
+        }
     };
 } // namespace FDCore
 
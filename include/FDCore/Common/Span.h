@@ -2,6 +2,7 @@
 #define FDCORE_COMMON_SPAN_H
 
 #include <cstdint>
+#include <type_traits>
 
 namespace FDCore
 {
@@ -13,6 +14,17 @@ namespace FDCore
 
         size_type size;
         value_type *data;
+
+        value_type &operator[](size_type pos) const { return data[pos]; }
+
+        value_type *begin() const { return data; }
+        value_type *end() const { return data + size; }
+
+        template<typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+        operator Span<const U, SizeType>() const
+        {
+            return { size, data };
+        }
     };
 } // namespace FDCore
 
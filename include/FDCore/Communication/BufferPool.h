@@ -0,0 +1,181 @@
+#ifndef FDCORE_COMMUNICATION_BUFFERPOOL_H
+#define FDCORE_COMMUNICATION_BUFFERPOOL_H
+
+#include <FDCore/Common/NonCopyableTrait.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace FDCore
+{
+    /**
+     * @brief Recycles the byte buffers messages are read into and written from.
+     *
+     * Buffers come in size classes, powers of two from MinClassSize up to the pooled buffer
+     * size, so that a small message does not hold a large buffer. Buffers larger than the
+     * pooled size are allocated on demand and freed when released.
+     *
+     * Buffers are reference counted so that the messages decoded from a buffer can keep it
+     * alive after the reader has moved to another one. When the last reference goes away the
+     * buffer goes back to the cache of the releasing thread, without locking. A thread whose
+     * cache of a class is full moves half of it to the pool, and a thread whose cache is empty
+     * takes a batch from the pool, so buffers flow between the threads that acquire them and
+     * the threads that release them a batch at a time. The pool may be destroyed before its
+     * buffers.
+     */
+    class BufferPool : public NonCopyable
+    {
+      private:
+        struct State;
+        struct ThreadCache;
+
+      public:
+        struct Buffer
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t capacity;
+
+          private:
+            friend class BufferPool;
+
+            std::atomic<uint32_t> m_references;
+            std::shared_ptr<State> m_state;
+            uint8_t m_sizeClass;
+
+            Buffer(size_t size, uint8_t sizeClass);
+        };
+
+        /**
+         * @brief Shared reference to a Buffer, with an intrusive reference count
+         */
+        class BufferPtr
+        {
+          private:
+            Buffer *m_buffer;
+
+          public:
+            BufferPtr() noexcept : m_buffer(nullptr) {}
+            BufferPtr(std::nullptr_t) noexcept : m_buffer(nullptr) {}
+
+            BufferPtr(const BufferPtr &other) noexcept : m_buffer(other.m_buffer)
+            {
+                if(m_buffer)
+                    m_buffer->m_references.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            BufferPtr(BufferPtr &&other) noexcept : m_buffer(other.m_buffer)
+            {
+                other.m_buffer = nullptr;
+            }
+
+            ~BufferPtr() { reset(); }
+
+            BufferPtr &operator=(const BufferPtr &other) noexcept
+            {
+                BufferPtr(other).swap(*this);
+                return *this;
+            }
+
+            BufferPtr &operator=(BufferPtr &&other) noexcept
+            {
+                BufferPtr(std::move(other)).swap(*this);
+                return *this;
+            }
+
+            void reset() noexcept
+            {
+                if(m_buffer && m_buffer->m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    release(m_buffer);
+                m_buffer = nullptr;
+            }
+
+            void swap(BufferPtr &other) noexcept { std::swap(m_buffer, other.m_buffer); }
+
+            Buffer *get() const { return m_buffer; }
+            Buffer *operator->() const { return m_buffer; }
+            Buffer &operator*() const { return *m_buffer; }
+            explicit operator bool() const { return m_buffer != nullptr; }
+
+            /**
+             * @brief Number of references to the buffer, 1 when this is the only one
+             */
+            long use_count() const
+            {
+                return m_buffer ? m_buffer->m_references.load(std::memory_order_acquire) : 0;
+            }
+
+            bool operator==(const BufferPtr &other) const { return m_buffer == other.m_buffer; }
+            bool operator!=(const BufferPtr &other) const { return m_buffer != other.m_buffer; }
+
+          private:
+            friend class BufferPool;
+
+            explicit BufferPtr(Buffer *buffer) noexcept : m_buffer(buffer) {}
+        };
+
+        constexpr static size_t DefaultBufferSize = 64 * 1024;
+        constexpr static size_t DefaultMaxCached = 64;
+        constexpr static size_t MinClassSize = 256;
+
+        /**
+         * @brief Buffers of each class a thread keeps for itself
+         */
+        constexpr static size_t ThreadCacheSize = 16;
+
+        /**
+         * @brief Pools a thread keeps a cache for, the least recently added one is flushed
+         * when a thread uses more
+         */
+        constexpr static size_t MaxThreadCachedPools = 4;
+
+      private:
+        std::shared_ptr<State> m_state;
+        size_t m_bufferSize;
+
+      public:
+        /**
+         * @param bufferSize size of the buffers acquired without a minimum size, the largest
+         * class is this size rounded up to a power of two
+         * @param maxCached buffers of each class kept by the pool itself, in addition to the
+         * caches of the threads. 0 disables the pooling.
+         */
+        explicit BufferPool(size_t bufferSize = DefaultBufferSize,
+                            size_t maxCached = DefaultMaxCached);
+        ~BufferPool() override;
+
+        /**
+         * @brief Buffer of at least minimumSize bytes, of getBufferSize() bytes if
+         * minimumSize is 0, whose content is unspecified
+         */
+        BufferPtr acquire(size_t minimumSize = 0);
+
+        size_t getBufferSize() const { return m_bufferSize; }
+
+        size_t getClassCount() const;
+
+        /**
+         * @brief Number of released buffers waiting to be reused, by the pool itself and by the
+         * calling thread
+         */
+        size_t getCachedCount() const;
+
+      private:
+        static void release(Buffer *buffer);
+        static ThreadCache *getThreadCache();
+    };
+
+    inline bool operator==(const BufferPool::BufferPtr &buffer, std::nullptr_t)
+    {
+        return !buffer;
+    }
+
+    inline bool operator!=(const BufferPool::BufferPtr &buffer, std::nullptr_t)
+    {
+        return static_cast<bool>(buffer);
+    }
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_BUFFERPOOL_H
@@ -0,0 +1,63 @@
+#ifndef FDCORE_COMMUNICATION_BUFFERSLICE_H
+#define FDCORE_COMMUNICATION_BUFFERSLICE_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace FDCore
+{
+    /**
+     * @brief Bytes of a pooled buffer together with a reference keeping the buffer alive.
+     *
+     * Slices are how the bytes of a message are handed over without copying them: the payload
+     * of a received message, or the payload it was decompressed to, may outlive the message
+     * and be passed to another thread, the buffer goes back to its pool with the last slice.
+     * A slice without buffer refers to bytes owned by someone else.
+     */
+    class BufferSlice
+    {
+      private:
+        BufferPool::BufferPtr m_buffer;
+        Span<const uint8_t> m_data;
+
+      public:
+        BufferSlice() : m_data { 0, nullptr } {}
+
+        BufferSlice(BufferPool::BufferPtr buffer, Span<const uint8_t> data) :
+            m_buffer(std::move(buffer)),
+            m_data(data)
+        {
+        }
+
+        const BufferPool::BufferPtr &getBuffer() const { return m_buffer; }
+        Span<const uint8_t> getData() const { return m_data; }
+
+        const uint8_t *data() const { return m_data.data; }
+        uint32_t size() const { return m_data.size; }
+        bool empty() const { return m_data.size == 0; }
+
+        /**
+         * @brief true if the slice keeps its bytes alive
+         */
+        bool isOwning() const { return static_cast<bool>(m_buffer); }
+
+        /**
+         * @brief Slice of length bytes from offset, sharing the buffer of this slice
+         *
+         * @throw std::out_of_range if the bytes are not all in this slice
+         */
+        BufferSlice slice(uint32_t offset, uint32_t length) const
+        {
+            if(offset > m_data.size || length > m_data.size - offset)
+                throw std::out_of_range("BufferSlice::slice: bytes out of the slice");
+
+            return BufferSlice(m_buffer, { length, m_data.data + offset });
+        }
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_BUFFERSLICE_H
@@ -0,0 +1,47 @@
+#ifndef FDCORE_COMMUNICATION_DEFLATECODEC_H
+#define FDCORE_COMMUNICATION_DEFLATECODEC_H
+
+#include <FDCore/Communication/PayloadCodec.h>
+
+#include <memory>
+
+namespace FDCore
+{
+    /**
+     * @brief Raw deflate (RFC 1951) by zlib, named "deflate" on the wire.
+     *
+     * The zlib streams are kept and reset between payloads instead of being allocated for each
+     * of them, a dictionary primes the window of the stream before each payload.
+     */
+    class DeflateCodec : public PayloadCodec
+    {
+      public:
+        constexpr static int DefaultLevel = 1;
+        constexpr static size_t MaxCachedStreams = 16;
+
+      private:
+        struct State;
+        class Decompressor;
+
+        std::shared_ptr<State> m_state;
+
+      public:
+        /**
+         * @param level zlib compression level, from 1 (fastest) to 9 (smallest)
+         * @throw std::invalid_argument if level is out of range
+         */
+        explicit DeflateCodec(int level = DefaultLevel);
+        ~DeflateCodec() override = default;
+
+        std::string_view getName() const override { return "deflate"; }
+
+        size_t compress(Span<const uint8_t> input,
+                        Span<uint8_t> output,
+                        Span<const uint8_t> dictionary) const override;
+
+        std::unique_ptr<PayloadDecompressor> createDecompressor(
+          Span<const uint8_t> dictionary) const override;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_DEFLATECODEC_H
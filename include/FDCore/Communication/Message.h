@@ -0,0 +1,89 @@
+#ifndef FDCORE_COMMUNICATION_MESSAGE_H
+#define FDCORE_COMMUNICATION_MESSAGE_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/BufferSlice.h>
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+
+namespace FDCore
+{
+    /**
+     * @brief Framed message, its header followed by its payload, stored in a pooled buffer.
+     *
+     * A message is a view of its frame in a buffer it shares with the other messages decoded
+     * from the same read, so decoding does not copy the fields nor the payload and the frame
+     * is sent as is. Messages are move-only, the buffer is released once every message
+     * referencing it is destroyed.
+     */
+    class Message
+    {
+      private:
+        BufferPool::BufferPtr m_buffer;
+        Span<const uint8_t> m_frame;
+        MessageHeaderView m_header;
+
+      public:
+        Message() : m_frame { 0, nullptr } {}
+
+        /**
+         * @brief Message whose frame is in buffer
+         *
+         * @throw std::invalid_argument if frame is not exactly one well-formed message
+         * @throw std::length_error if the header exceeds limits
+         */
+        Message(BufferPool::BufferPtr buffer,
+                Span<const uint8_t> frame,
+                const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+        Message(const Message &) = delete;
+        Message(Message &&) noexcept = default;
+        ~Message() = default;
+
+        Message &operator=(const Message &) = delete;
+        Message &operator=(Message &&) noexcept = default;
+
+        /**
+         * @brief Frames header and payload in a buffer of pool, with type as message type
+         */
+        static Message encode(BufferPool &pool,
+                              uint8_t type,
+                              const MessageHeader &header,
+                              Span<const uint8_t> payload);
+
+        bool isValid() const { return m_buffer != nullptr; }
+
+        uint8_t getType() const { return m_header.getType(); }
+        uint32_t getRequestId() const { return m_header.getRequestId(); }
+
+        /**
+         * @brief Changes the request identifier in the frame itself, which must not be shared
+         * with a message being sent
+         */
+        void setRequestId(uint32_t requestId);
+
+        const MessageHeaderView &getHeader() const { return m_header; }
+
+        Span<const uint8_t> getPayload() const
+        {
+            const uint32_t headerLength = m_header.getHeaderLength();
+            return { m_frame.size - headerLength, m_frame.data + headerLength };
+        }
+
+        /**
+         * @brief Bytes of the whole message, as sent on the wire
+         */
+        Span<const uint8_t> getFrame() const { return m_frame; }
+
+        /**
+         * @brief Payload sharing the buffer of the message, valid after the message is
+         * destroyed
+         */
+        BufferSlice getPayloadSlice() const { return BufferSlice(m_buffer, getPayload()); }
+
+        BufferSlice getFrameSlice() const { return BufferSlice(m_buffer, m_frame); }
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_MESSAGE_H
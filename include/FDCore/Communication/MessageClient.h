@@ -0,0 +1,107 @@
+#ifndef FDCORE_COMMUNICATION_MESSAGECLIENT_H
+#define FDCORE_COMMUNICATION_MESSAGECLIENT_H
+
+#include <FDCore/Common/NonCopyableTrait.h>
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/MessageDecoder.h>
+#include <FDCore/Communication/Request.h>
+#include <FDCore/Communication/Response.h>
+#include <FDCore/Communication/Socket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace FDCore
+{
+    /**
+     * @brief Blocking client of a MessageServer, pipelining its requests.
+     *
+     * Each request sent is given a new identifier, which its response carries back, so many
+     * requests can be in flight at once and their responses can arrive in any order. At most
+     * getWindow() requests are in flight: sending another one first reads the responses that
+     * arrived, which are kept until they are received.
+     */
+    class MessageClient : public NonCopyable
+    {
+      public:
+        constexpr static size_t DefaultWindow = 128;
+
+      private:
+        Socket m_socket;
+        BufferPool m_pool;
+        MessageDecoder m_decoder;
+        std::unordered_map<uint32_t, Response> m_arrived;
+        size_t m_window;
+        size_t m_inFlight;
+        uint32_t m_nextRequestId;
+
+      public:
+        /**
+         * @param socket connected socket, in blocking mode
+         */
+        explicit MessageClient(Socket socket, size_t window = DefaultWindow);
+
+        /**
+         * @brief Gives request a new identifier and sends it, after waiting for room in the
+         * window
+         *
+         * @return the identifier of the request
+         * @throw std::system_error if the connection failed
+         */
+        uint32_t send(Request &request);
+
+        /**
+         * @brief Sends all of requests with as few system calls as possible, giving them
+         * consecutive identifiers
+         */
+        void send(Span<Request, size_t> requests);
+
+        /**
+         * @brief Response of the request requestId, waiting for it if needed
+         *
+         * @throw std::runtime_error if the server closed the connection
+         * @throw std::invalid_argument if requestId is not in flight
+         */
+        Response receive(uint32_t requestId);
+
+        /**
+         * @brief First response available, whatever its request
+         *
+         * @throw std::runtime_error if the server closed the connection or no request is in
+         * flight
+         */
+        Response receive();
+
+        Response call(Request &request) { return receive(send(request)); }
+
+        size_t getWindow() const { return m_window; }
+        void setWindow(size_t window) { m_window = window > 0 ? window : 1; }
+
+        /**
+         * @brief Number of requests sent whose response did not arrive yet
+         */
+        size_t getInFlightCount() const { return m_inFlight; }
+
+        /**
+         * @brief Number of responses arrived and not received yet
+         */
+        size_t getArrivedCount() const { return m_arrived.size(); }
+
+        /**
+         * @brief Pool to create the requests from
+         */
+        BufferPool &getPool() { return m_pool; }
+
+      private:
+        void write(Span<Request, size_t> requests);
+
+        /**
+         * @brief Reads the next response from the socket
+         */
+        Response read();
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_MESSAGECLIENT_H
@@ -0,0 +1,107 @@
+#ifndef FDCORE_COMMUNICATION_MESSAGEDECODER_H
+#define FDCORE_COMMUNICATION_MESSAGEDECODER_H
+
+#include <FDCore/Common/NonCopyableTrait.h>
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FDCore
+{
+    /**
+     * @brief Splits a byte stream into messages as it is received.
+     *
+     * The bytes are read into the space returned by prepare(), then commit() makes them
+     * available to next(), which returns the messages whose frame is complete, as many as a
+     * single read brought. The messages refer to the buffer they were received in; when it is
+     * full the bytes of the incomplete message, if any, are moved to a fresh buffer of the pool
+     * and the old one is released with the last message referencing it.
+     *
+     * A malformed stream cannot be resynchronized, once next() throws the decoder must be
+     * discarded along with the connection.
+     */
+    class MessageDecoder : public NonCopyable
+    {
+      public:
+        constexpr static uint32_t DefaultMaxMessageSize = 16 * 1024 * 1024;
+
+        /**
+         * @brief Smallest space prepare() returns, unless the current message needs less
+         */
+        constexpr static size_t MinimumReadSize = 4096;
+
+      private:
+        BufferPool &m_pool;
+        BufferPool::BufferPtr m_buffer;
+        size_t m_begin;
+        size_t m_end;
+        uint32_t m_maxMessageSize;
+        MessageHeaderLimits m_limits;
+
+      public:
+        /**
+         * @param limits limits of the headers, the length of a header is checked as soon as its
+         * preamble is received
+         */
+        explicit MessageDecoder(BufferPool &pool,
+                                uint32_t maxMessageSize = DefaultMaxMessageSize,
+                                const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+        /**
+         * @brief Space to read the next bytes of the stream into
+         *
+         * @throw std::length_error if the pending message is longer than the maximum size or
+         * its header longer than the limit
+         */
+        Span<uint8_t> prepare();
+
+        /**
+         * @brief Appends the first count bytes of the space returned by prepare() to the stream
+         */
+        void commit(size_t count) { m_end += count; }
+
+        /**
+         * @brief Decodes the next complete message into message, of type Message, Request or
+         * Response
+         *
+         * @return false if the stream does not hold a whole message yet
+         * @throw std::invalid_argument if the message is malformed
+         * @throw std::length_error if the message is longer than the maximum size or its
+         * header exceeds the limits
+         */
+        template<typename T>
+        bool next(T &message)
+        {
+            const size_t length = completeMessageLength();
+            if(length == 0)
+                return false;
+
+            message = T(m_buffer,
+                        { static_cast<uint32_t>(length), m_buffer->data.get() + m_begin },
+                        m_limits);
+            m_begin += length;
+            return true;
+        }
+
+        /**
+         * @brief Number of received bytes not decoded yet
+         */
+        size_t getPendingSize() const { return m_end - m_begin; }
+
+      private:
+        /**
+         * @brief Length of the message starting at m_begin, 0 if its preamble is incomplete
+         */
+        size_t messageLength() const;
+
+        /**
+         * @brief Length of the message starting at m_begin, 0 if it is incomplete
+         */
+        size_t completeMessageLength() const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_MESSAGEDECODER_H
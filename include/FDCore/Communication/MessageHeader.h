@@ -2,34 +2,121 @@
 #define FDCORE_COMMUNICATION_MESSAGEHEADER_H
 
 #include <FDCore/Common/Span.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+
+#include <array>
+#include <string>
 #include <string_view>
+#include <sys/uio.h>
 #include <unordered_map>
 #include <vector>
 
 namespace FDCore
 {
+    /**
+     * @brief Owning message header, laid out on the wire as described by WireFormat
+     */
     class MessageHeader
     {
+      public:
+        /**
+         * @brief Vectors describing a whole message for writev() or sendmsg()
+         */
+        typedef std::array<iovec, 2> IoVectors;
+
       private:
-        std::unordered_map<std::string, std::vector<uint8_t>> m_fields;
+        struct Field
+        {
+            std::vector<uint8_t> value;
+
+            /**
+             * @brief Key of the name in WireFormat::FieldNames, looked up once when the field
+             * is set
+             */
+            uint32_t key;
+        };
+
+        std::unordered_map<std::string, Field> m_fields;
         uint32_t m_payloadLength;
+        uint32_t m_requestId;
+        uint8_t m_type;
 
       public:
         MessageHeader() : MessageHeader(0) {}
-        MessageHeader(uint32_t payloadLength) : m_payloadLength(payloadLength) {}
+        MessageHeader(uint32_t payloadLength) :
+            m_payloadLength(payloadLength),
+            m_requestId(0),
+            m_type(0)
+        {
+        }
 
         bool hasField(std::string_view name) const;
         const std::vector<uint8_t> &getFiled(std::string_view name) const;
-        void setFiled(std::string_view name, const Span<uint8_t> &value);
+
+        /**
+         * @throw std::invalid_argument if name contains a NUL byte
+         */
+        void setFiled(std::string_view name, const Span<const uint8_t> &value);
 
         uint32_t getPayloadLength() const { return m_payloadLength; }
         void setPayloadLength(uint32_t length) { m_payloadLength = length; }
 
+        uint8_t getType() const { return m_type; }
+        void setType(uint8_t type) { m_type = type; }
+
+        uint32_t getRequestId() const { return m_requestId; }
+        void setRequestId(uint32_t requestId) { m_requestId = requestId; }
+
+        /**
+         * @brief Exact number of bytes written by write()
+         */
         size_t size() const;
 
-        uint32_t write(Span<uint8_t> &output, uint32_t payloadLength);
-        uint32_t read(const Span<uint8_t> &input);
+        /**
+         * @brief Writes the header at the start of output in a single pass, the payload is
+         * expected right after it
+         *
+         * @return the length of the header
+         * @throw std::length_error if output is smaller than size() or the header does not fit
+         * the 32 bits length of the wire format
+         */
+        uint32_t write(const Span<uint8_t> &output) const;
+
+        /**
+         * @brief Writes the header followed by a copy of payload, whose size replaces the
+         * payload length
+         *
+         * @return the length of the message
+         * @throw std::length_error if output is smaller than size() + payload.size
+         */
+        uint32_t write(const Span<uint8_t> &output, const Span<const uint8_t> &payload) const;
+
+        /**
+         * @brief Writes the header in headerBuffer and describes the message in vectors, the
+         * header then payload, so that the payload is sent by writev() or sendmsg() without
+         * being copied. The size of payload replaces the payload length.
+         *
+         * @return the number of vectors used, 1 if payload is empty and 2 otherwise
+         * @throw std::length_error if headerBuffer is smaller than size()
+         */
+        int gather(const Span<uint8_t> &headerBuffer,
+                   const Span<const uint8_t> &payload,
+                   IoVectors &vectors) const;
+
+        /**
+         * @brief Replaces the type, the request identifier, the fields and the payload length by
+         * the ones of the header at the start of input, see MessageHeaderView
+         *
+         * @return the length of the header, 0 if input does not hold the whole header yet
+         * @throw std::invalid_argument if the header is malformed
+         * @throw std::length_error if the header exceeds limits
+         */
+        uint32_t read(const Span<const uint8_t> &input,
+                      const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+      private:
+        uint32_t writeHeader(const Span<uint8_t> &output, uint32_t payloadLength) const;
     };
 } // namespace FDCore
 
-#endif // FDCORE_COMMUNICATION_MESSAGEHEADER_H
\ No newline at end of file
+#endif // FDCORE_COMMUNICATION_MESSAGEHEADER_H
@@ -0,0 +1,150 @@
+#ifndef FDCORE_COMMUNICATION_MESSAGEHEADERVIEW_H
+#define FDCORE_COMMUNICATION_MESSAGEHEADERVIEW_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/WireFormat.h>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace FDCore
+{
+    class MessageHeader;
+
+    /**
+     * @brief Largest header accepted from a peer, checked before any of it is buffered or
+     * copied so that a malformed or hostile frame is rejected at the cost of its preamble
+     */
+    struct MessageHeaderLimits
+    {
+        constexpr static uint32_t DefaultMaxHeaderLength = 64 * 1024;
+        constexpr static uint32_t DefaultMaxNameLength = 256;
+        constexpr static uint32_t DefaultMaxValueLength = 16 * 1024;
+
+        /**
+         * @brief Length of the whole header, preamble included
+         */
+        uint32_t maxHeaderLength = DefaultMaxHeaderLength;
+
+        /**
+         * @brief Length of a name sent in full
+         */
+        uint32_t maxNameLength = DefaultMaxNameLength;
+
+        uint32_t maxValueLength = DefaultMaxValueLength;
+    };
+
+    /**
+     * @brief Read-only view of a message header in the buffer it was received in.
+     *
+     * Parsing checks the whole header once and records the position of each field in a fixed
+     * array, the names and values are then returned as views into the buffer, or into
+     * WireFormat::FieldNames for the well-known names, without allocating or copying. Fields
+     * past the first InlineFields are indexed in a growable array. The buffer must outlive the
+     * view and stay unchanged.
+     */
+    class MessageHeaderView
+    {
+      public:
+        typedef Span<const uint8_t> FieldValue;
+
+        /**
+         * @brief Fields indexed without allocating
+         */
+        constexpr static size_t InlineFields = 32;
+        constexpr static size_t npos = static_cast<size_t>(-1);
+
+      private:
+        struct FieldEntry
+        {
+            const char *name;
+            uint32_t nameLength;
+            uint32_t key;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+        };
+
+        const uint8_t *m_data;
+        uint32_t m_headerLength;
+        uint32_t m_fieldCount;
+        std::array<FieldEntry, InlineFields> m_fields;
+        std::vector<FieldEntry> m_extraFields;
+
+      public:
+        MessageHeaderView() : m_data(nullptr), m_headerLength(0), m_fieldCount(0) {}
+
+        /**
+         * @brief Parses the header at the start of input. Every length read from the wire is
+         * checked against the bytes left in the header before it is used.
+         *
+         * @return false if input does not hold the whole header yet
+         * @throw std::invalid_argument if the header is malformed or has a name with a NUL
+         * byte
+         * @throw std::length_error if the header, a name or a value is longer than limits
+         * allow, as soon as the preamble is received for the length of the header
+         */
+        bool parse(Span<const uint8_t> input,
+                   const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+        bool isValid() const { return m_data != nullptr; }
+
+        uint8_t getType() const { return m_data[WireFormat::TypeOffset]; }
+        uint32_t getHeaderLength() const { return m_headerLength; }
+
+        uint32_t getPayloadLength() const
+        {
+            return WireFormat::loadUint32(m_data + WireFormat::PayloadLengthOffset);
+        }
+
+        uint32_t getRequestId() const
+        {
+            return WireFormat::loadUint32(m_data + WireFormat::RequestIdOffset);
+        }
+
+        size_t getFieldCount() const { return m_fieldCount; }
+
+        std::string_view getName(size_t index) const
+        {
+            const FieldEntry &entry = getEntry(index);
+            return { entry.name, entry.nameLength };
+        }
+
+        /**
+         * @brief Key of the name of the field in WireFormat::FieldNames, 0 if it was sent in
+         * full
+         */
+        uint32_t getKey(size_t index) const { return getEntry(index).key; }
+
+        FieldValue getValue(size_t index) const
+        {
+            const FieldEntry &entry = getEntry(index);
+            return { entry.valueLength, m_data + entry.valueOffset };
+        }
+
+        /**
+         * @brief Index of the first field called name, npos if there is none
+         */
+        size_t find(std::string_view name) const;
+
+        bool hasField(std::string_view name) const { return find(name) != npos; }
+
+        /**
+         * @throw std::out_of_range if there is no field called name
+         */
+        FieldValue getField(std::string_view name) const;
+
+        /**
+         * @brief Copies the fields and the payload length into an owning MessageHeader
+         */
+        MessageHeader toHeader() const;
+
+      private:
+        const FieldEntry &getEntry(size_t index) const
+        {
+            return index < InlineFields ? m_fields[index] : m_extraFields[index - InlineFields];
+        }
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_MESSAGEHEADERVIEW_H
@@ -0,0 +1,146 @@
+#ifndef FDCORE_COMMUNICATION_MESSAGESERVER_H
+#define FDCORE_COMMUNICATION_MESSAGESERVER_H
+
+#include <FDCore/Common/NonCopyableTrait.h>
+#include <FDCore/Common/Span.h>
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/Request.h>
+#include <FDCore/Communication/Response.h>
+#include <FDCore/Communication/Socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Server answering the Requests received on TCP and Unix-domain sockets.
+     *
+     * A single thread runs an epoll loop over the listening sockets and the connections: it
+     * accepts the clients, decodes the requests from the bytes received and writes the
+     * responses back. The requests of a connection may be pipelined: those of the same type
+     * received together are handled as a batch, by a single task of the ThreadPool, and the
+     * batches are handled concurrently. Each response carries the identifier of its request
+     * and is sent as soon as it is ready, so the responses may come out of order. They are
+     * gathered in as few writes as possible.
+     *
+     * A handler that throws answers ResponseStatus::InternalError with the message of the
+     * exception as payload. A connection sending a malformed stream is closed.
+     *
+     * A connection stops being read while too many of its requests are handled or wait to be
+     * sent, so a client that does not read its responses cannot pile them up in the server.
+     * The listeners stop accepting while the process is out of descriptors, and retry when a
+     * connection is closed or after a short delay.
+     */
+    class MessageServer : public NonCopyable
+    {
+      public:
+        typedef std::function<Response(const Request &request, BufferPool &pool)> Handler;
+
+        /**
+         * @brief Handler of a batch of requests of the same type, returning their responses in
+         * the same order
+         */
+        typedef std::function<std::vector<Response>(Span<const Request, size_t> requests,
+                                                    BufferPool &pool)>
+          BatchHandler;
+
+        constexpr static size_t MaxBatchSize = 64;
+        constexpr static size_t DefaultMaxInFlightRequests = 1024;
+
+      private:
+        struct Connection;
+
+        ThreadPool &m_threadPool;
+        BatchHandler m_handler;
+        BufferPool m_pool;
+        int m_epoll;
+        int m_wakeup;
+
+        std::vector<Socket> m_listeners;
+        std::vector<std::string> m_socketPaths;
+        std::unordered_map<int, std::shared_ptr<Connection>> m_connections;
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+        size_t m_maxInFlightRequests;
+        bool m_isAcceptPaused;
+        std::chrono::steady_clock::time_point m_acceptResumeTime;
+
+        std::mutex m_mutex;
+        std::condition_variable m_tasksDone;
+        std::vector<std::shared_ptr<Connection>> m_completedConnections;
+        size_t m_pendingTasks;
+
+      public:
+        /**
+         * @throw std::system_error if the epoll instance cannot be created
+         */
+        MessageServer(ThreadPool &threadPool, Handler handler);
+        MessageServer(ThreadPool &threadPool, BatchHandler handler);
+
+        /**
+         * @brief Stops the server and waits for the requests being handled
+         */
+        ~MessageServer() override;
+
+        /**
+         * @brief Listens on the numeric address host, port 0 picks a free port. The server must
+         * not be running.
+         *
+         * @return the port listened on
+         */
+        uint16_t listenTcp(const std::string &host, uint16_t port);
+
+        /**
+         * @brief Listens on the Unix-domain socket path, removed when the server is destroyed.
+         * The server must not be running.
+         */
+        void listenUnix(const std::string &path);
+
+        /**
+         * @brief Sets how many requests of a connection may be handled or wait to be sent before
+         * the server stops reading it. The server must not be running.
+         *
+         * @throw std::invalid_argument if count is 0
+         */
+        void setMaxInFlightRequests(size_t count);
+        size_t getMaxInFlightRequests() const { return m_maxInFlightRequests; }
+
+        void start();
+
+        /**
+         * @brief Stops the event loop and closes the connections, the requests being handled
+         * are dropped
+         */
+        void stop();
+
+        bool isRunning() const { return m_running; }
+
+      private:
+        void addListener(Socket socket);
+        void run();
+        void accept(const Socket &listener);
+        void setAccepting(bool accepting);
+        void receive(const std::shared_ptr<Connection> &connection);
+        void dispatch(const std::shared_ptr<Connection> &connection,
+                      std::vector<Request> &&requests);
+        void complete(const std::shared_ptr<Connection> &connection,
+                      std::vector<Response> &&responses);
+        void flush(const std::shared_ptr<Connection> &connection);
+        void watch(Connection &connection);
+        void close(Connection &connection);
+        void finishTask();
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_MESSAGESERVER_H
@@ -0,0 +1,68 @@
+#ifndef FDCORE_COMMUNICATION_PAYLOADCODEC_H
+#define FDCORE_COMMUNICATION_PAYLOADCODEC_H
+
+#include <FDCore/Common/NonCopyableTrait.h>
+#include <FDCore/Common/Span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace FDCore
+{
+    /**
+     * @brief Incremental decompression of one payload, which may be fed in any number of
+     * chunks and written to any number of output buffers
+     */
+    class PayloadDecompressor : public NonCopyable
+    {
+      public:
+        struct Progress
+        {
+            size_t consumed;
+            size_t produced;
+        };
+
+        /**
+         * @brief Decompresses the start of input into output, until either is exhausted or the
+         * end of the payload is reached
+         *
+         * @throw std::invalid_argument if input is not valid compressed data
+         */
+        virtual Progress decompress(Span<const uint8_t> input, Span<uint8_t> output) = 0;
+
+        /**
+         * @brief true once the end of the compressed payload has been decoded
+         */
+        virtual bool isFinished() const = 0;
+    };
+
+    /**
+     * @brief Compression algorithm of the payloads, named on the wire by the content-encoding
+     * header field.
+     *
+     * A dictionary holds bytes frequent in the payloads, the payloads compressed with a
+     * dictionary can only be decompressed with the same one. Implementations are used from
+     * several threads at once.
+     */
+    class PayloadCodec : public NonCopyable
+    {
+      public:
+        virtual std::string_view getName() const = 0;
+
+        /**
+         * @brief Compresses input into output with dictionary, which may be empty
+         *
+         * @return the number of bytes written, 0 if the compressed payload does not fit output
+         */
+        virtual size_t compress(Span<const uint8_t> input,
+                                Span<uint8_t> output,
+                                Span<const uint8_t> dictionary) const = 0;
+
+        virtual std::unique_ptr<PayloadDecompressor> createDecompressor(
+          Span<const uint8_t> dictionary) const = 0;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_PAYLOADCODEC_H
@@ -0,0 +1,128 @@
+#ifndef FDCORE_COMMUNICATION_PAYLOADCOMPRESSION_H
+#define FDCORE_COMMUNICATION_PAYLOADCOMPRESSION_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/BufferSlice.h>
+#include <FDCore/Communication/Message.h>
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+#include <FDCore/Communication/PayloadCodec.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Per-message compression of the payloads.
+     *
+     * A payload of at least getThreshold() bytes is compressed by the first codec, with the
+     * dictionary in use if any, and sent compressed when that makes it smaller. The header of
+     * a compressed message tells the codec in content-encoding, the size of the payload once
+     * decompressed in decoded-length and the dictionary in dictionary-id, so each message may
+     * or may not be compressed and the receiver needs no other agreement than the codecs and
+     * the dictionaries it knows.
+     *
+     * Payloads are decompressed into pooled buffers. The configuration must not change while
+     * messages are encoded or decoded, which may then happen from several threads at once.
+     */
+    class PayloadCompression
+    {
+      public:
+        constexpr static size_t DefaultThreshold = 512;
+        constexpr static size_t DefaultMaxDecodedSize = 16 * 1024 * 1024;
+
+      private:
+        std::vector<std::shared_ptr<const PayloadCodec>> m_codecs;
+        std::unordered_map<uint32_t, std::vector<uint8_t>> m_dictionaries;
+        uint32_t m_dictionaryId;
+        size_t m_threshold;
+        size_t m_maxDecodedSize;
+
+      public:
+        /**
+         * @param codec codec compressing the payloads, also accepted when decoding
+         */
+        explicit PayloadCompression(std::shared_ptr<const PayloadCodec> codec,
+                                    size_t threshold = DefaultThreshold);
+
+        /**
+         * @brief Accepts the payloads compressed by codec when decoding
+         */
+        void addCodec(std::shared_ptr<const PayloadCodec> codec);
+
+        /**
+         * @brief Registers a dictionary shared with the peers under identifier
+         *
+         * @throw std::invalid_argument if identifier is 0
+         */
+        void addDictionary(uint32_t identifier, std::vector<uint8_t> dictionary);
+
+        /**
+         * @brief Compresses the payloads with the dictionary identifier, 0 for none
+         *
+         * @throw std::invalid_argument if no dictionary was added under identifier
+         */
+        void useDictionary(uint32_t identifier);
+
+        size_t getThreshold() const { return m_threshold; }
+        void setThreshold(size_t threshold) { m_threshold = threshold; }
+
+        size_t getMaxDecodedSize() const { return m_maxDecodedSize; }
+        void setMaxDecodedSize(size_t size) { m_maxDecodedSize = size; }
+
+        /**
+         * @brief Frames header and payload as Message::encode(), the payload compressed if it
+         * is large enough and compresses well
+         */
+        Message encode(BufferPool &pool,
+                       uint8_t type,
+                       const MessageHeader &header,
+                       Span<const uint8_t> payload) const;
+
+        /**
+         * @brief Payload of the message, decompressed into a buffer of pool if needed. The
+         * slice of an uncompressed payload does not own its bytes.
+         *
+         * @throw std::invalid_argument if the codec or the dictionary is unknown or the
+         * payload is corrupted
+         * @throw std::length_error if the decoded payload is larger than getMaxDecodedSize()
+         */
+        BufferSlice decode(const MessageHeaderView &header,
+                           Span<const uint8_t> payload,
+                           BufferPool &pool) const;
+
+        /**
+         * @brief Payload of the message, sharing the buffer of the message when it is not
+         * compressed
+         */
+        BufferSlice decode(const Message &message, BufferPool &pool) const
+        {
+            if(!isCompressed(message.getHeader()))
+                return message.getPayloadSlice();
+            return decode(message.getHeader(), message.getPayload(), pool);
+        }
+
+        /**
+         * @brief true if the payload of the message with header is compressed
+         */
+        static bool isCompressed(const MessageHeaderView &header)
+        {
+            return header.hasField(ContentEncodingField);
+        }
+
+      private:
+        constexpr static std::string_view ContentEncodingField = "content-encoding";
+        constexpr static std::string_view DecodedLengthField = "decoded-length";
+        constexpr static std::string_view DictionaryIdField = "dictionary-id";
+
+        const PayloadCodec *findCodec(std::string_view name) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_PAYLOADCOMPRESSION_H
@@ -1,21 +1,50 @@
 #ifndef FDCORE_COMMUNICATION_REQUEST_H
 #define FDCORE_COMMUNICATION_REQUEST_H
 
-#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/Message.h>
 #include <FDCore/Communication/RequestType.h>
 #include <cstdint>
-#include <cstring>
-#include <vector>
 
 namespace FDCore
 {
-    class Request
+    class PayloadCompression;
+
+    /**
+     * @brief Message whose type is a RequestType
+     */
+    class Request : public Message
     {
+      public:
+        Request() = default;
+
+        /**
+         * @throw std::invalid_argument if frame is not exactly one well-formed message or its
+         * type is not a RequestType
+         * @throw std::length_error if the header exceeds limits
+         */
+        Request(BufferPool::BufferPtr buffer,
+                Span<const uint8_t> frame,
+                const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+        static Request create(BufferPool &pool,
+                              RequestType type,
+                              const MessageHeader &header,
+                              Span<const uint8_t> payload);
+
+        /**
+         * @brief Request whose payload is compressed by compression when worth it
+         */
+        static Request create(BufferPool &pool,
+                              RequestType type,
+                              const MessageHeader &header,
+                              Span<const uint8_t> payload,
+                              const PayloadCompression &compression);
+
+        RequestType getRequestType() const { return static_cast<RequestType>(getType()); }
+
       private:
-        RequestType m_type;
-        MessageHeader m_header;
-        std::vector<uint8_t> m_payload;
+        explicit Request(Message &&message) : Message(std::move(message)) {}
     };
 } // namespace FDCore
 
-#endif // FDCORE_COMMUNICATION_REQUEST_H
\ No newline at end of file
+#endif // FDCORE_COMMUNICATION_REQUEST_H
@@ -1,11 +1,50 @@
 #ifndef FDCORE_COMMUNICATION_RESPONSE_H
 #define FDCORE_COMMUNICATION_RESPONSE_H
 
+#include <FDCore/Communication/Message.h>
+#include <FDCore/Communication/ResponseStatus.h>
+#include <cstdint>
+
 namespace FDCore
 {
-    class Response
+    class PayloadCompression;
+
+    /**
+     * @brief Message whose type is a ResponseStatus
+     */
+    class Response : public Message
     {
+      public:
+        Response() = default;
+
+        /**
+         * @throw std::invalid_argument if frame is not exactly one well-formed message or its
+         * type is not a ResponseStatus
+         * @throw std::length_error if the header exceeds limits
+         */
+        Response(BufferPool::BufferPtr buffer,
+                 Span<const uint8_t> frame,
+                 const MessageHeaderLimits &limits = MessageHeaderLimits());
+
+        static Response create(BufferPool &pool,
+                               ResponseStatus status,
+                               const MessageHeader &header,
+                               Span<const uint8_t> payload);
+
+        /**
+         * @brief Response whose payload is compressed by compression when worth it
+         */
+        static Response create(BufferPool &pool,
+                               ResponseStatus status,
+                               const MessageHeader &header,
+                               Span<const uint8_t> payload,
+                               const PayloadCompression &compression);
+
+        ResponseStatus getStatus() const { return static_cast<ResponseStatus>(getType()); }
+
+      private:
+        explicit Response(Message &&message) : Message(std::move(message)) {}
     };
 } // namespace FDCore
 
-#endif // FDCORE_COMMUNICATION_RESPONSE_H
\ No newline at end of file
+#endif // FDCORE_COMMUNICATION_RESPONSE_H
@@ -0,0 +1,19 @@
+#ifndef FDCORE_COMMUNICATION_RESPONSESTATUS_H
+#define FDCORE_COMMUNICATION_RESPONSESTATUS_H
+
+#include <cstdint>
+
+namespace FDCore
+{
+    enum class ResponseStatus : uint8_t
+    {
+        Ok,
+        Created,
+        BadRequest,
+        NotFound,
+        Conflict,
+        InternalError
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_RESPONSESTATUS_H
@@ -0,0 +1,151 @@
+#ifndef FDCORE_COMMUNICATION_SHAREDMEMORYCHANNEL_H
+#define FDCORE_COMMUNICATION_SHAREDMEMORYCHANNEL_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/Message.h>
+#include <FDCore/Communication/MessageHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace FDCore
+{
+    /**
+     * @brief One-way channel carrying message frames between the processes of a host through a
+     * ring buffer in POSIX shared memory.
+     *
+     * Any number of producers, in any number of processes, send to a single consumer. A
+     * producer claims the space of its record with an atomic operation on the write position,
+     * writes the frame in place and publishes it by storing its length, so producers do not
+     * block each other. The consumer reads the frames in order, in place, and gives their
+     * space back by advancing the read position. A side that has to wait spins for a short
+     * while then sleeps on a futex in the shared memory, and is only woken by the other side
+     * when it announced it was sleeping, so a busy channel makes no system call.
+     *
+     * The timeouts are in milliseconds, 0 to not wait and a negative value to wait forever.
+     */
+    class SharedMemoryChannel
+    {
+      private:
+        struct Control;
+
+        struct Record
+        {
+            uint8_t *data;
+            uint32_t size;
+        };
+
+        std::string m_name;
+        void *m_mapping;
+        size_t m_mappingSize;
+        Control *m_control;
+        uint8_t *m_ring;
+
+        SharedMemoryChannel(std::string name, void *mapping, size_t mappingSize);
+
+      public:
+        constexpr static size_t RecordHeaderSize = 8;
+
+        SharedMemoryChannel(const SharedMemoryChannel &) = delete;
+        SharedMemoryChannel(SharedMemoryChannel &&other) noexcept;
+        ~SharedMemoryChannel();
+
+        SharedMemoryChannel &operator=(const SharedMemoryChannel &) = delete;
+        SharedMemoryChannel &operator=(SharedMemoryChannel &&) = delete;
+
+        /**
+         * @brief Creates the shared memory object name, of the form "/name", with a ring of at
+         * least capacity bytes
+         *
+         * @throw std::system_error if the object exists or cannot be created
+         */
+        static SharedMemoryChannel create(const std::string &name, size_t capacity);
+
+        /**
+         * @brief Maps the channel created as name by another process or thread
+         *
+         * @throw std::system_error if the object cannot be opened
+         * @throw std::invalid_argument if it is not a channel
+         */
+        static SharedMemoryChannel open(const std::string &name);
+
+        /**
+         * @brief Removes the name of the channel, the processes that mapped it keep using it
+         */
+        static void remove(const std::string &name);
+
+        const std::string &getName() const { return m_name; }
+        size_t getCapacity() const;
+
+        /**
+         * @brief Size of the largest frame the channel carries, half of its capacity
+         */
+        size_t getMaxFrameSize() const;
+
+        /**
+         * @brief Writes header and payload in the channel
+         *
+         * @return false if there was no room before the timeout
+         * @throw std::length_error if the frame is larger than getMaxFrameSize()
+         */
+        bool send(const MessageHeader &header, Span<const uint8_t> payload, int timeout = -1);
+
+        bool send(const Message &message, int timeout = -1);
+
+        /**
+         * @brief Calls visitor with the frame of the next message, which is only valid during the
+         * call, then removes the message from the channel
+         *
+         * @return false if there was no message before the timeout
+         */
+        template<typename F>
+        bool read(F &&visitor, int timeout = -1)
+        {
+            Record record;
+            if(!peek(record, timeout))
+                return false;
+
+            struct Releaser
+            {
+                SharedMemoryChannel &channel;
+                const Record &record;
+                ~Releaser() { channel.release(record); }
+            } releaser { *this, record };
+
+            visitor(Span<const uint8_t> { record.size, record.data });
+            return true;
+        }
+
+        /**
+         * @brief Copies the next message into a buffer of pool and decodes it in message, of type
+         * Message, Request or Response
+         *
+         * @return false if there was no message before the timeout
+         * @throw std::invalid_argument if the frame is not a message of type T
+         */
+        template<typename T>
+        bool receive(T &message, BufferPool &pool, int timeout = -1)
+        {
+            return read(
+              [&message, &pool](Span<const uint8_t> frame) {
+                  BufferPool::BufferPtr buffer = pool.acquire(frame.size);
+                  memcpy(buffer->data.get(), frame.data, frame.size);
+                  const Span<const uint8_t> copy { frame.size, buffer->data.get() };
+                  message = T(std::move(buffer), copy);
+              },
+              timeout);
+        }
+
+      private:
+        bool claim(uint32_t frameSize, int timeout, Record &record);
+        void commit(const Record &record);
+        bool peek(Record &record, int timeout);
+        void release(const Record &record);
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_SHAREDMEMORYCHANNEL_H
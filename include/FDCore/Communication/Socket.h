@@ -0,0 +1,62 @@
+#ifndef FDCORE_COMMUNICATION_SOCKET_H
+#define FDCORE_COMMUNICATION_SOCKET_H
+
+#include <cstdint>
+#include <string>
+
+namespace FDCore
+{
+    /**
+     * @brief Owner of a TCP or Unix-domain socket descriptor, closed on destruction.
+     *
+     * The factories throw std::system_error carrying errno when a system call fails.
+     */
+    class Socket
+    {
+      private:
+        int m_descriptor;
+
+      public:
+        Socket() : m_descriptor(-1) {}
+        explicit Socket(int descriptor) : m_descriptor(descriptor) {}
+        Socket(const Socket &) = delete;
+        Socket(Socket &&other) noexcept : m_descriptor(other.release()) {}
+        ~Socket() { close(); }
+
+        Socket &operator=(const Socket &) = delete;
+        Socket &operator=(Socket &&other) noexcept;
+
+        /**
+         * @brief Listening socket bound to the numeric address host, port 0 picks a free port
+         */
+        static Socket listenTcp(const std::string &host, uint16_t port, int backlog = 128);
+        static Socket listenUnix(const std::string &path, int backlog = 128);
+
+        static Socket connectTcp(const std::string &host, uint16_t port);
+        static Socket connectUnix(const std::string &path);
+
+        int getDescriptor() const { return m_descriptor; }
+        bool isOpen() const { return m_descriptor >= 0; }
+
+        /**
+         * @brief Port the socket is bound to, 0 for a Unix-domain socket
+         */
+        uint16_t getLocalPort() const;
+
+        void setNonBlocking(bool nonBlocking);
+
+        /**
+         * @brief Disables Nagle's algorithm, does nothing on a Unix-domain socket
+         */
+        void setNoDelay(bool noDelay);
+
+        /**
+         * @brief Gives up the ownership of the descriptor
+         */
+        int release();
+
+        void close();
+    };
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_SOCKET_H
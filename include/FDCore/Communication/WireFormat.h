@@ -0,0 +1,146 @@
+#ifndef FDCORE_COMMUNICATION_WIREFORMAT_H
+#define FDCORE_COMMUNICATION_WIREFORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace FDCore
+{
+    /**
+     * @brief Layout of a message on the wire.
+     *
+     * A message starts with a header made of a preamble followed by its fields, then comes the
+     * payload. The preamble holds the type of the message on one byte, the length of the
+     * header, preamble included, the length of the payload and the identifier of the request,
+     * which a response repeats so that it can be matched with its request. The preamble has a
+     * fixed size so that the length of a message is known from its first bytes.
+     *
+     * Each field starts with a varint key: the index + 1 of its name in FieldNames, or 0
+     * followed by the varint length and the bytes of a name missing from the dictionary. Then
+     * come the varint length and the bytes of the value. A field with a well-known name and a
+     * short value thus takes 2 bytes more than its value.
+     *
+     * Varints are LEB128: 7 bits per byte, least significant first, the high bit set on all
+     * bytes but the last. Other integers are little endian whatever the host.
+     */
+    namespace WireFormat
+    {
+        constexpr size_t TypeOffset = 0;
+        constexpr size_t HeaderLengthOffset = 1;
+        constexpr size_t PayloadLengthOffset = 5;
+        constexpr size_t RequestIdOffset = 9;
+        constexpr size_t PreambleSize = 13;
+        constexpr size_t LengthSize = 4;
+        constexpr size_t MaxVarintSize = 5;
+
+        /**
+         * @brief Dictionary of the well-known field names, shared by all peers. Entries may be
+         * appended but never removed or reordered, their index is part of the wire format.
+         */
+        inline constexpr std::array<std::string_view, 18> FieldNames {
+            "path",
+            "id",
+            "content-type",
+            "content-encoding",
+            "content-length",
+            "accept",
+            "authorization",
+            "token",
+            "user",
+            "session",
+            "timestamp",
+            "deadline",
+            "trace-id",
+            "span-id",
+            "version",
+            "error",
+            "decoded-length",
+            "dictionary-id"
+        };
+
+        /**
+         * @brief Key of the field called name, 0 if name is not in FieldNames
+         */
+        inline uint32_t findFieldKey(std::string_view name)
+        {
+            for(size_t i = 0; i < FieldNames.size(); ++i)
+            {
+                if(FieldNames[i] == name)
+                    return static_cast<uint32_t>(i + 1);
+            }
+
+            return 0;
+        }
+
+        inline uint32_t loadUint32(const uint8_t *data)
+        {
+            return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                   static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+        }
+
+        inline void storeUint32(uint8_t *data, uint32_t value)
+        {
+            data[0] = static_cast<uint8_t>(value);
+            data[1] = static_cast<uint8_t>(value >> 8);
+            data[2] = static_cast<uint8_t>(value >> 16);
+            data[3] = static_cast<uint8_t>(value >> 24);
+        }
+
+        constexpr size_t varintSize(uint32_t value)
+        {
+            size_t size = 1;
+            for(; value >= 0x80; value >>= 7)
+                ++size;
+
+            return size;
+        }
+
+        /**
+         * @return the number of bytes written, at most MaxVarintSize
+         */
+        inline size_t storeVarint(uint8_t *data, uint32_t value)
+        {
+            size_t size = 0;
+            for(; value >= 0x80; value >>= 7)
+                data[size++] = static_cast<uint8_t>(value | 0x80);
+            data[size++] = static_cast<uint8_t>(value);
+            return size;
+        }
+
+        /**
+         * @brief Reads the varint at the start of the size bytes of data
+         *
+         * @return the number of bytes read, 0 if the varint is truncated, longer than
+         * MaxVarintSize bytes or does not fit 32 bits
+         */
+        inline size_t loadVarint(const uint8_t *data, size_t size, uint32_t &value)
+        {
+            if(size > 0 && data[0] < 0x80)
+            {
+                value = data[0];
+                return 1;
+            }
+
+            uint32_t result = 0;
+            for(size_t i = 0; i < size && i < MaxVarintSize; ++i)
+            {
+                const uint32_t bits = data[i] & 0x7F;
+                if(i == MaxVarintSize - 1 && bits > 0x0F)
+                    return 0;
+
+                result |= bits << (7 * i);
+                if(data[i] < 0x80)
+                {
+                    value = result;
+                    return i + 1;
+                }
+            }
+
+            return 0;
+        }
+    } // namespace WireFormat
+} // namespace FDCore
+
+#endif // FDCORE_COMMUNICATION_WIREFORMAT_H
@@ -11,7 +11,7 @@ namespace FDCore
         typedef size_t SizeType;
 
 
-        AbstractArrayValue() = default;
+        AbstractArrayValue() : AbstractValue(ValueType::Array) {}
         AbstractArrayValue(AbstractArrayValue &&) = default;
         AbstractArrayValue(const AbstractArrayValue &) = default;
 
@@ -20,7 +20,7 @@ namespace FDCore
         virtual SizeType size() const = 0;
         virtual bool isEmpty() const = 0;
         virtual AbstractValue::Ptr operator[](SizeType pos) = 0;
-        virtual const AbstractValue::Ptr &operator[](SizeType pos) const = 0;
+        virtual AbstractValue::Ptr operator[](SizeType pos) const = 0;
 
         virtual void push(AbstractValue::Ptr value) = 0;
         virtual AbstractValue::Ptr pop() = 0;
@@ -29,7 +29,23 @@ namespace FDCore
         virtual AbstractValue::Ptr removeAt(SizeType pos) = 0;
         virtual void clear() = 0;
 
-        ValueType getValueType() const override { return ValueType::Array; }
+
+        /**
+         * @brief Type shared by every cell of a dense array, None if cells may have any type
+         */
+        virtual ValueType getElementType() const { return ValueType::None; }
+
+        /**
+         * @brief Checks if value can be stored in this array
+         */
+        virtual bool accepts(const AbstractValue::Ptr & /*value*/) const { return true; }
+
+        /**
+         * @brief Gets the slot storing the cell at pos without sharing it, nullptr if pos is out
+         * of range or if the cells are not stored as nodes. The slot is invalidated by any change
+         * to this array.
+         */
+        virtual const AbstractValue::Ptr *findSlot(SizeType /*pos*/) const { return nullptr; }
     };
 } // namespace FDCore
 
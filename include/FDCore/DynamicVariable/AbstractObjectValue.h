@@ -14,6 +14,9 @@
 #endif     // FDCORE_STRING_TYPE
 
 #include <FDCore/DynamicVariable/AbstractValue.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
+
+#include <functional>
 
 namespace FDCore
 {
@@ -22,8 +25,11 @@ namespace FDCore
       public:
         typedef FDCORE_STRING_TYPE StringType;
         typedef FDCORE_STRING_VIEW_TYPE StringViewType;
+        typedef size_t SizeType;
+        typedef std::function<void(const InternedString &, const AbstractValue::Ptr &)>
+          MemberFunction;
 
-        AbstractObjectValue() = default;
+        AbstractObjectValue() : AbstractValue(ValueType::Object) {}
         AbstractObjectValue(AbstractObjectValue &&) = default;
         AbstractObjectValue(const AbstractObjectValue &) = default;
 
@@ -41,7 +47,24 @@ namespace FDCore
         virtual void set(StringViewType key, AbstractValue::Ptr value) = 0;
         virtual void unset(StringViewType key) = 0;
 
-        ValueType getValueType() const override { return ValueType::Object; }
+        virtual SizeType size() const = 0;
+        virtual bool isEmpty() const = 0;
+
+        /**
+         * @brief Calls function with the name and the value of each member
+         */
+        virtual void forEachMember(const MemberFunction &function) const = 0;
+
+        /**
+         * @brief Gets the slot storing member without sharing its value, nullptr if there is no
+         * such member. The slot is invalidated by any change to this object.
+         */
+        virtual const AbstractValue::Ptr *findSlot(const InternedString &member) const = 0;
+
+        /**
+         * @brief Same as findSlot(const InternedString &), looking member up by its name
+         */
+        virtual const AbstractValue::Ptr *findSlot(StringViewType member) const = 0;
     };
 } // namespace FDCore
 
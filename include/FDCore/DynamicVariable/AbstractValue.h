@@ -1,9 +1,16 @@
 #ifndef FDCORE_ABSTRACTVALUE_H
 #define FDCORE_ABSTRACTVALUE_H
 
+#include <FDCore/Common/CopyOnWrite.h>
 #include <FDCore/DynamicVariable/ValueType.h>
+
+#include <atomic>
 #include <memory>
 
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+    #include <FDCore/Common/Macros.h>
+#endif
+
 namespace FDCore
 {
     template<typename T, typename U = void>
@@ -16,23 +23,144 @@ namespace FDCore
     inline constexpr bool is_AbstractValue_constructible_v =
       is_AbstractValue_constructible<T>::value;
 
+    /**
+     * @brief Memory used by a node: its own object, then the used and the unused capacity of the
+     * storage it owns
+     */
+    struct ValueFootprint
+    {
+        size_t headerBytes = 0;
+        size_t payloadBytes = 0;
+        size_t slackBytes = 0;
+    };
+
+    /**
+     * @brief Adds the storage of a contiguous container to footprint
+     */
+    template<typename Container>
+    void addContainerFootprint(const Container &container, ValueFootprint &footprint)
+    {
+        typedef typename Container::value_type ElementType;
+        footprint.payloadBytes += container.size() * sizeof(ElementType);
+        footprint.slackBytes += (container.capacity() - container.size()) * sizeof(ElementType);
+    }
+
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+    /**
+     * @brief Counts the nodes created and destroyed, see getLiveValueCounts()
+     */
+    FD_EXPORT void trackValueAllocation(ValueType type, bool allocated);
+#endif
+
+    /**
+     * @brief Node of a DynamicVariable tree.
+     *
+     * The type of a node is given to the constructor and stored in the node, so reading it does
+     * not need a virtual call.
+     *
+     * A node also caches the hash of its content computed by DynamicVariable::hash(). The cache
+     * is reset when the node is written through a DynamicVariable, code modifying a node
+     * directly must call resetCachedHash().
+     *
+     * A frozen node is never modified again, writing it through a DynamicVariable modifies a
+     * copy even if the node is not shared. Copies of a frozen node are not frozen.
+     */
     class AbstractValue
     {
       public:
         typedef std::shared_ptr<AbstractValue> Ptr;
 
+      private:
+        ValueType m_valueType;
+        bool m_frozen;
+        mutable std::atomic<size_t> m_cachedHash;
+
+      public:
+        explicit AbstractValue(ValueType type) :
+            m_valueType(type),
+            m_frozen(false),
+            m_cachedHash(0)
+        {
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+            trackValueAllocation(type, true);
+#endif
+        }
+
+        AbstractValue(AbstractValue &&other) : AbstractValue(other.m_valueType) {}
+        AbstractValue(const AbstractValue &other) : AbstractValue(other.m_valueType) {}
+
+        virtual ~AbstractValue() noexcept
+        {
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+            trackValueAllocation(m_valueType, false);
+#endif
+        }
 
-        AbstractValue() = default;
-        AbstractValue(AbstractValue &&) = default;
-        AbstractValue(const AbstractValue &) = default;
+        AbstractValue &operator=(AbstractValue &&other)
+        {
+            m_valueType = other.m_valueType;
+            resetCachedHash();
+            return *this;
+        }
 
-        virtual ~AbstractValue() noexcept = default;
+        AbstractValue &operator=(const AbstractValue &other)
+        {
+            m_valueType = other.m_valueType;
+            resetCachedHash();
+            return *this;
+        }
+
+        ValueType getValueType() const { return m_valueType; }
+        bool isType(ValueType type) const { return type == m_valueType; }
+
+        /**
+         * @brief Cached hash of the content of this node, 0 if it is not known
+         */
+        size_t getCachedHash() const { return m_cachedHash.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Caches hash, which must be the hash of the current content of this node
+         */
+        void setCachedHash(size_t hash) const
+        {
+            m_cachedHash.store(hash, std::memory_order_relaxed);
+        }
+
+        void resetCachedHash() { m_cachedHash.store(0, std::memory_order_relaxed); }
+
+        bool isFrozen() const { return m_frozen; }
+
+        /**
+         * @brief Marks this node as immutable, use DynamicVariable::freeze() to freeze a whole
+         * tree. A node must be frozen before it is shared with other threads.
+         */
+        void freeze() { m_frozen = true; }
+
+        /**
+         * @brief Copies this node, the children of containers are shared with the copy
+         */
+        virtual Ptr copy() const = 0;
+
+        /**
+         * @brief Copies this node and all its children
+         */
+        virtual Ptr clone() const { return copy(); }
+
+        /**
+         * @brief Memory used by this node, without its children and the strings owned by an
+         * interner
+         */
+        virtual ValueFootprint getFootprint() const = 0;
+    };
+
+    template<>
+    struct CopyOnWriteTraits<AbstractValue>
+    {
+        static AbstractValue::Ptr copy(const AbstractValue &value) { return value.copy(); }
 
-        AbstractValue &operator=(AbstractValue &&) = default;
-        AbstractValue &operator=(const AbstractValue &) = default;
+        static void prepareWrite(AbstractValue &value) { value.resetCachedHash(); }
 
-        virtual ValueType getValueType() const = 0;
-        virtual bool isType(ValueType type) const { return type == getValueType(); }
+        static bool isFrozen(const AbstractValue &value) { return value.isFrozen(); }
     };
 } // namespace FDCore
 
@@ -0,0 +1,95 @@
+#ifndef FDCORE_ARRAYOPERATIONS_H
+#define FDCORE_ARRAYOPERATIONS_H
+
+#include <FDCore/Common/Macros.h>
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/DynamicVariable/DynamicVariable_fwd.h>
+
+namespace FDCore
+{
+    enum class ComparisonOperator : uint8_t
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual
+    };
+
+    /**
+     * @brief Minimum number of cells for which the element-wise operations split their work on
+     * the thread pool they are given, smaller arrays are processed on the calling thread
+     */
+    constexpr DynamicVariable::SizeType ArrayOperationParallelThreshold = 1 << 16;
+
+    /**
+     * @brief Element-wise operations on numeric arrays.
+     *
+     * Each operand is either a numeric scalar or an array. Arrays whose cells are all integers
+     * or all numbers are processed as contiguous dense storage by loops the compiler can
+     * vectorize, other arrays fall back to the DynamicVariable operators cell by cell. Integer
+     * operands give dense integer results, any float operand gives a dense float result.
+     *
+     * The overloads taking a ThreadPool split arrays of at least ArrayOperationParallelThreshold
+     * cells into one chunk per thread. They wait for the chunks, so they must not be called from
+     * a task of the same pool.
+     *
+     * @throw std::invalid_argument if two arrays have different sizes
+     * @throw std::domain_error if arrayDiv() divides an integer cell by zero
+     * @throw std::overflow_error if arrayDiv() divides the smallest integer by -1
+     */
+    FD_EXPORT DynamicVariable arrayAdd(const DynamicVariable &a, const DynamicVariable &b);
+    FD_EXPORT DynamicVariable arraySub(const DynamicVariable &a, const DynamicVariable &b);
+    FD_EXPORT DynamicVariable arrayMul(const DynamicVariable &a, const DynamicVariable &b);
+    FD_EXPORT DynamicVariable arrayDiv(const DynamicVariable &a, const DynamicVariable &b);
+
+    FD_EXPORT DynamicVariable arrayAdd(const DynamicVariable &a,
+                                       const DynamicVariable &b,
+                                       ThreadPool &pool);
+    FD_EXPORT DynamicVariable arraySub(const DynamicVariable &a,
+                                       const DynamicVariable &b,
+                                       ThreadPool &pool);
+    FD_EXPORT DynamicVariable arrayMul(const DynamicVariable &a,
+                                       const DynamicVariable &b,
+                                       ThreadPool &pool);
+    FD_EXPORT DynamicVariable arrayDiv(const DynamicVariable &a,
+                                       const DynamicVariable &b,
+                                       ThreadPool &pool);
+
+    /**
+     * @brief Compares the cells of a with the cells of b (or with b if it is a scalar)
+     *
+     * @return a dense boolean array holding the result of each comparison
+     * @throw std::runtime_error if an operand is not numeric
+     */
+    FD_EXPORT DynamicVariable arrayCompare(const DynamicVariable &a,
+                                           const DynamicVariable &b,
+                                           ComparisonOperator op);
+    FD_EXPORT DynamicVariable arrayCompare(const DynamicVariable &a,
+                                           const DynamicVariable &b,
+                                           ComparisonOperator op,
+                                           ThreadPool &pool);
+
+    /**
+     * @brief Reductions of a numeric array
+     *
+     * arraySum returns 0 for an empty array, arrayMin, arrayMax and arrayMean return None.
+     * The sum of integers wraps around on overflow. arrayMean always returns a float and sums
+     * integers as floats. NaN sorts after every number: arrayMin returns NaN only if every cell
+     * is NaN, arrayMax as soon as one cell is NaN.
+     *
+     * @throw std::runtime_error if the array is not numeric
+     */
+    FD_EXPORT DynamicVariable arraySum(const DynamicVariable &array);
+    FD_EXPORT DynamicVariable arrayMin(const DynamicVariable &array);
+    FD_EXPORT DynamicVariable arrayMax(const DynamicVariable &array);
+    FD_EXPORT DynamicVariable arrayMean(const DynamicVariable &array);
+
+    FD_EXPORT DynamicVariable arraySum(const DynamicVariable &array, ThreadPool &pool);
+    FD_EXPORT DynamicVariable arrayMin(const DynamicVariable &array, ThreadPool &pool);
+    FD_EXPORT DynamicVariable arrayMax(const DynamicVariable &array, ThreadPool &pool);
+    FD_EXPORT DynamicVariable arrayMean(const DynamicVariable &array, ThreadPool &pool);
+} // namespace FDCore
+
+#endif // FDCORE_ARRAYOPERATIONS_H
@@ -34,10 +34,37 @@ namespace FDCore
 
         explicit operator const ArrayType &() const { return m_values; }
 
+        AbstractValue::Ptr copy() const override { return std::make_shared<ArrayValue>(*this); }
+        AbstractValue::Ptr clone() const override;
+
+        ValueFootprint getFootprint() const override
+        {
+            ValueFootprint result { sizeof(*this), 0, 0 };
+            addContainerFootprint(m_values, result);
+            return result;
+        }
+
+        /**
+         * @brief Moves the cells out of the array, leaving it empty
+         */
+        ArrayType release()
+        {
+            ArrayType result = std::move(m_values);
+            m_values.clear();
+            return result;
+        }
+
         SizeType size() const override { return m_values.size(); }
         bool isEmpty() const override { return m_values.empty(); }
         AbstractValue::Ptr operator[](SizeType pos) override { return m_values[pos]; }
-        const AbstractValue::Ptr &operator[](SizeType pos) const override { return m_values[pos]; }
+        AbstractValue::Ptr operator[](SizeType pos) const override { return m_values[pos]; }
+
+        const AbstractValue::Ptr &at(SizeType pos) const { return m_values[pos]; }
+
+        const AbstractValue::Ptr *findSlot(SizeType pos) const override
+        {
+            return pos < m_values.size() ? &m_values[pos] : nullptr;
+        }
 
         void push(AbstractValue::Ptr value) override { m_values.push_back(std::move(value)); }
         AbstractValue::Ptr pop() override;
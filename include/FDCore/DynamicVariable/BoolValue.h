@@ -14,13 +14,15 @@ namespace FDCore
 
       public:
         BoolValue() : BoolValue(false) {}
-        explicit BoolValue(bool value) : m_value(value) {}
+        explicit BoolValue(bool value) : AbstractValue(ValueType::Boolean), m_value(value) {}
 
         BoolValue(BoolValue &&) = default;
         BoolValue(const BoolValue &) = default;
         ~BoolValue() override = default;
 
-        ValueType getValueType() const override { return ValueType::Boolean; }
+        AbstractValue::Ptr copy() const override { return std::make_shared<BoolValue>(*this); }
+
+        ValueFootprint getFootprint() const override { return { sizeof(*this), 0, 0 }; }
 
         BoolValue &operator=(bool value)
         {
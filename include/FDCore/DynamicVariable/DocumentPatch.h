@@ -0,0 +1,70 @@
+#ifndef FDCORE_DOCUMENTPATCH_H
+#define FDCORE_DOCUMENTPATCH_H
+
+#include <FDCore/Common/Macros.h>
+#include <FDCore/DynamicVariable/PathQuery.h>
+
+#include <vector>
+
+namespace FDCore
+{
+    enum class PatchOperationType : uint8_t
+    {
+        Add,
+        Remove,
+        Replace
+    };
+
+    /**
+     * @brief Change of a single node, with the semantics of the JSON Patch (RFC 6902) operation
+     * of the same name
+     *
+     * Add inserts value before the cell at the index of the path, or at the end of the array for
+     * the "-" token, and sets the member of an object. Remove and Replace require the node to
+     * exist. value is unused by Remove.
+     */
+    struct PatchOperation
+    {
+        PatchOperationType type;
+        PathQuery path;
+        DynamicVariable value;
+    };
+
+    typedef std::vector<PatchOperation> DocumentPatch;
+
+    /**
+     * @brief Computes the operations turning from into to
+     *
+     * Subtrees shared by both documents are skipped without being visited, so the cost of the
+     * diff of a document and a modified copy of it depends on the changed paths only. Arrays
+     * are compared cell by cell, cells are added or removed at their end. The values of the
+     * operations share their nodes with to.
+     */
+    FD_EXPORT DocumentPatch diff(const DynamicVariable &from, const DynamicVariable &to);
+
+    /**
+     * @brief Applies the operations of patch to document, in order
+     *
+     * The nodes along the path of an operation are modified in place when document is their
+     * only owner and copied first otherwise, the rest of the tree is left shared. If an
+     * operation fails, document is left unchanged.
+     *
+     * @throw std::invalid_argument if the target or the parent of an operation does not exist
+     */
+    FD_EXPORT void applyPatch(DynamicVariable &document, const DocumentPatch &patch);
+
+    /**
+     * @brief Converts patch to a JSON Patch document: an array of objects with the members
+     * "op", "path" and "value"
+     */
+    FD_EXPORT DynamicVariable toJsonPatch(const DocumentPatch &patch);
+
+    /**
+     * @brief Reads a JSON Patch document made of add, remove and replace operations
+     *
+     * @throw std::invalid_argument if patch is not an array of such operations
+     */
+    FD_EXPORT DocumentPatch fromJsonPatch(const DynamicVariable &patch);
+} // namespace FDCore
+
+#endif // FDCORE_DOCUMENTPATCH_H
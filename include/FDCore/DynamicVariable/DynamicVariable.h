@@ -26,34 +26,36 @@ namespace FDCore
     void DynamicVariable::convert(
       std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, T> &result) const
     {
-        if(isType(ValueType::Integer))
-        {
-            result = static_cast<T>(toInteger());
-        }
-        else if(isType(ValueType::Float))
-        {
-            result = static_cast<T>(toFloat());
-        }
-        else
+        switch(getValueType())
         {
-            throw generateCastException(__func__);
+            case ValueType::Integer:
+                result = static_cast<T>(nodeAs<IntValue>());
+                break;
+
+            case ValueType::Float:
+                result = static_cast<T>(nodeAs<FloatValue>());
+                break;
+
+            default:
+                throw generateCastException(__func__);
         }
     }
 
     template<typename T>
     void DynamicVariable::convert(std::enable_if_t<std::is_floating_point_v<T>, T> &result) const
     {
-        if(isType(ValueType::Integer))
-        {
-            result = static_cast<T>(static_cast<IntType>(toInteger()));
-        }
-        else if(isType(ValueType::Float))
-        {
-            result = static_cast<T>(toFloat());
-        }
-        else
+        switch(getValueType())
         {
-            throw generateCastException(__func__);
+            case ValueType::Integer:
+                result = static_cast<T>(static_cast<IntType>(nodeAs<IntValue>()));
+                break;
+
+            case ValueType::Float:
+                result = static_cast<T>(nodeAs<FloatValue>());
+                break;
+
+            default:
+                throw generateCastException(__func__);
         }
     }
 
@@ -61,17 +63,17 @@ namespace FDCore
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator==(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() == value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() == value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() == value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() == value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
@@ -80,7 +82,7 @@ namespace FDCore
     {
         if(isType(ValueType::Float))
         {
-            return toFloat() == value;
+            return nodeAs<FloatValue>() == value;
         }
 
         throw generateCastException(__func__);
@@ -90,17 +92,17 @@ namespace FDCore
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator!=(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() != value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() != value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() != value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() != value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
@@ -109,7 +111,7 @@ namespace FDCore
     {
         if(isType(ValueType::Float))
         {
-            return toFloat() != value;
+            return nodeAs<FloatValue>() != value;
         }
 
         throw generateCastException(__func__);
@@ -119,17 +121,17 @@ namespace FDCore
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator<=(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() <= value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() <= value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() <= value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() <= value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
@@ -138,7 +140,7 @@ namespace FDCore
     {
         if(isType(ValueType::Float))
         {
-            return toFloat() <= value;
+            return nodeAs<FloatValue>() <= value;
         }
 
         throw generateCastException(__func__);
@@ -148,51 +150,51 @@ namespace FDCore
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator<(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() < value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() < value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() < value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() < value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, bool>
       DynamicVariable::operator<(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return static_cast<IntType>(toInteger()) < value;
-        }
+            case ValueType::Integer:
+                return static_cast<IntType>(nodeAs<IntValue>()) < value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() < value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() < value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator>=(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() >= value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() >= value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() >= value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() >= value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
@@ -201,7 +203,7 @@ namespace FDCore
     {
         if(isType(ValueType::Float))
         {
-            return toFloat() >= value;
+            return nodeAs<FloatValue>() >= value;
         }
 
         throw generateCastException(__func__);
@@ -211,17 +213,17 @@ namespace FDCore
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, bool> DynamicVariable::
       operator>(const T &value) const
     {
-        if(isType(ValueType::Integer))
+        switch(getValueType())
         {
-            return toInteger() > value;
-        }
+            case ValueType::Integer:
+                return nodeAs<IntValue>() > value;
 
-        if(isType(ValueType::Float))
-        {
-            return toFloat() > value;
-        }
+            case ValueType::Float:
+                return nodeAs<FloatValue>() > value;
 
-        throw generateCastException(__func__);
+            default:
+                throw generateCastException(__func__);
+        }
     }
 
     template<typename T>
@@ -231,7 +233,7 @@ namespace FDCore
         if(!isType(ValueType::Float))
             throw generateCastException(__func__);
 
-        return toFloat() > value;
+        return nodeAs<FloatValue>() > value;
     }
 
     template<typename T>
@@ -242,13 +244,13 @@ namespace FDCore
         {
             case ValueType::Integer:
             {
-                toInteger() += value;
+                nodeAs<IntValue>() += value;
                 return *this;
             }
 
             case ValueType::Float:
             {
-                toFloat() += static_cast<FloatType>(value);
+                nodeAs<FloatValue>() += static_cast<FloatType>(value);
                 return *this;
             }
 
@@ -264,11 +266,11 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                *this = FloatValue(static_cast<IntType>(toInteger()) + value);
+                *this = FloatValue(static_cast<IntType>(nodeAs<IntValue>()) + value);
                 return *this;
 
             case ValueType::Float:
-                toFloat() += value;
+                nodeAs<FloatValue>() += value;
                 return *this;
 
             default:
@@ -284,13 +286,13 @@ namespace FDCore
         {
             case ValueType::Integer:
             {
-                toInteger() -= value;
+                nodeAs<IntValue>() -= value;
                 return *this;
             }
 
             case ValueType::Float:
             {
-                toFloat() -= static_cast<FloatType>(value);
+                nodeAs<FloatValue>() -= static_cast<FloatType>(value);
                 return *this;
             }
 
@@ -306,11 +308,11 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                *this = FloatValue(static_cast<IntType>(toInteger()) - value);
+                *this = FloatValue(static_cast<IntType>(nodeAs<IntValue>()) - value);
                 return *this;
 
             case ValueType::Float:
-                toFloat() -= value;
+                nodeAs<FloatValue>() -= value;
                 return *this;
 
             default:
@@ -325,9 +327,9 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() + value;
+                return nodeAs<IntValue>() + value;
             case ValueType::Float:
-                return toFloat() + static_cast<FloatType>(value);
+                return nodeAs<FloatValue>() + static_cast<FloatType>(value);
 
             default:
                 throw generateCastException(__func__);
@@ -341,10 +343,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return FloatValue(static_cast<IntType>(toInteger()) + value);
+                return FloatValue(static_cast<IntType>(nodeAs<IntValue>()) + value);
 
             case ValueType::Float:
-                return toFloat() + value;
+                return nodeAs<FloatValue>() + value;
 
             default:
                 throw generateCastException(__func__);
@@ -358,10 +360,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() - value;
+                return nodeAs<IntValue>() - value;
 
             case ValueType::Float:
-                return toFloat() - static_cast<FloatType>(value);
+                return nodeAs<FloatValue>() - static_cast<FloatType>(value);
 
             default:
                 throw generateCastException(__func__);
@@ -375,10 +377,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return FloatValue(static_cast<IntType>(toInteger()) - value);
+                return FloatValue(static_cast<IntType>(nodeAs<IntValue>()) - value);
 
             case ValueType::Float:
-                return toFloat() - value;
+                return nodeAs<FloatValue>() - value;
 
             default:
                 throw generateCastException(__func__);
@@ -392,7 +394,7 @@ namespace FDCore
         if(!isType(ValueType::Integer))
             throw generateCastException(__func__);
 
-        toInteger() %= value;
+        nodeAs<IntValue>() %= value;
         return *this;
     }
 
@@ -403,7 +405,7 @@ namespace FDCore
         if(!isType(ValueType::Integer))
             throw generateCastException(__func__);
 
-        return toInteger() % value;
+        return nodeAs<IntValue>() % value;
     }
 
     template<typename T>
@@ -414,13 +416,13 @@ namespace FDCore
         {
             case ValueType::Integer:
             {
-                toInteger() *= value;
+                nodeAs<IntValue>() *= value;
                 return *this;
             }
 
             case ValueType::Float:
             {
-                toFloat() *= static_cast<FloatType>(value);
+                nodeAs<FloatValue>() *= static_cast<FloatType>(value);
                 return *this;
             }
 
@@ -436,11 +438,11 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                *this = FloatValue(static_cast<IntType>(toInteger()) * value);
+                *this = FloatValue(static_cast<IntType>(nodeAs<IntValue>()) * value);
                 return *this;
 
             case ValueType::Float:
-                toFloat() *= value;
+                nodeAs<FloatValue>() *= value;
                 return *this;
 
             default:
@@ -455,10 +457,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() * value;
+                return nodeAs<IntValue>() * value;
 
             case ValueType::Float:
-                return toFloat() * static_cast<FloatType>(value);
+                return nodeAs<FloatValue>() * static_cast<FloatType>(value);
 
             default:
                 throw generateCastException(__func__);
@@ -472,10 +474,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return FloatValue(static_cast<IntType>(toInteger()) * value);
+                return FloatValue(static_cast<IntType>(nodeAs<IntValue>()) * value);
 
             case ValueType::Float:
-                return toFloat() * value;
+                return nodeAs<FloatValue>() * value;
 
             default:
                 throw generateCastException(__func__);
@@ -490,13 +492,13 @@ namespace FDCore
         {
             case ValueType::Integer:
             {
-                toInteger() /= value;
+                nodeAs<IntValue>() /= value;
                 return *this;
             }
 
             case ValueType::Float:
             {
-                toFloat() /= static_cast<FloatType>(value);
+                nodeAs<FloatValue>() /= static_cast<FloatType>(value);
                 return *this;
             }
 
@@ -512,11 +514,11 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                *this = FloatValue(static_cast<IntType>(toInteger()) / value);
+                *this = FloatValue(static_cast<IntType>(nodeAs<IntValue>()) / value);
                 return *this;
 
             case ValueType::Float:
-                toFloat() /= value;
+                nodeAs<FloatValue>() /= value;
                 return *this;
 
             default:
@@ -531,10 +533,10 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() / value;
+                return nodeAs<IntValue>() / value;
 
             case ValueType::Float:
-                return toFloat() / static_cast<FloatType>(value);
+                return nodeAs<FloatValue>() / static_cast<FloatType>(value);
 
             default:
                 throw generateCastException(__func__);
@@ -548,22 +550,25 @@ namespace FDCore
         switch(getValueType())
         {
             case ValueType::Integer:
-                return FloatValue(static_cast<IntType>(toInteger()) / value);
+                return FloatValue(static_cast<IntType>(nodeAs<IntValue>()) / value);
 
             case ValueType::Float:
-                return toFloat() / value;
+                return nodeAs<FloatValue>() / value;
 
             default:
                 throw generateCastException(__func__);
         }
     }
 
-    DynamicVariable operator""_var(unsigned long long value) { return DynamicVariable(value); }
+    inline DynamicVariable operator""_var(unsigned long long value)
+    {
+        return DynamicVariable(value);
+    }
 
-    DynamicVariable operator""_var(long double value) { return DynamicVariable(value); }
+    inline DynamicVariable operator""_var(long double value) { return DynamicVariable(value); }
 
-    DynamicVariable operator""_var(const DynamicVariable::StringType::value_type *value,
-                                   size_t size)
+    inline DynamicVariable operator""_var(const DynamicVariable::StringType::value_type *value,
+                                          size_t size)
     {
         return DynamicVariable(DynamicVariable::StringType(value, size));
     }
@@ -612,11 +617,11 @@ namespace FDCore
                 break;
 
             case ValueType::Integer:
-                ::operator<<(stream, toInteger());
+                ::operator<<(stream, nodeAs<IntValue>());
                 break;
 
             case ValueType::Float:
-                ::operator<<(stream, toFloat());
+                ::operator<<(stream, nodeAs<FloatValue>());
                 break;
 
             default:
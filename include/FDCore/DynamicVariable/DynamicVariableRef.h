@@ -0,0 +1,152 @@
+#ifndef FDCORE_DYNAMICVARIABLEREF_H
+#define FDCORE_DYNAMICVARIABLEREF_H
+
+#include <FDCore/DynamicVariable/DynamicVariable_fwd.h>
+
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace FDCore
+{
+    /**
+     * @brief Borrowed read-only reference to a node of a DynamicVariable tree.
+     *
+     * A reference only stores a pointer to the node, so navigating and reading it never touches
+     * the reference counts of the tree, which lets many threads read the same tree without
+     * sharing any written cache line. The cells of a dense array are referenced by their array
+     * and their index.
+     *
+     * A reference does not keep the tree alive: the variable owning the tree must outlive it and
+     * the tree must not be modified while it is borrowed, freeze() it before sharing it with
+     * other threads.
+     */
+    class DynamicVariableRef
+    {
+      public:
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+
+        constexpr static SizeType npos = std::numeric_limits<SizeType>::max();
+
+      private:
+        const AbstractValue *m_node;
+        SizeType m_cell;
+
+      public:
+        DynamicVariableRef() : m_node(nullptr), m_cell(npos) {}
+        DynamicVariableRef(const DynamicVariableRef &) = default;
+        DynamicVariableRef(DynamicVariableRef &&) = default;
+
+        explicit DynamicVariableRef(const AbstractValue *node) : m_node(node), m_cell(npos) {}
+
+        /**
+         * @brief Borrows the root of the tree of variable
+         */
+        explicit DynamicVariableRef(const DynamicVariable &variable) :
+            DynamicVariableRef(variable.internalNode())
+        {
+        }
+
+        ~DynamicVariableRef() = default;
+
+        DynamicVariableRef &operator=(const DynamicVariableRef &) = default;
+        DynamicVariableRef &operator=(DynamicVariableRef &&) = default;
+
+        ValueType getValueType() const;
+
+        bool isType(ValueType type) const { return type == getValueType(); }
+
+        /**
+         * @brief Number of cells of an array, members of an object or characters of a string
+         */
+        SizeType size() const;
+        bool isEmpty() const { return size() == 0; }
+
+        /**
+         * @throw std::out_of_range if pos is greater or equal to the size of the array
+         */
+        DynamicVariableRef operator[](SizeType pos) const;
+
+        /**
+         * @brief Gets the reference of the member named member, or a None reference if there
+         * is no such member
+         *
+         * Finding a member of an ObjectValue by its name goes through the interner of the
+         * object, hot paths should use the InternedString overload.
+         */
+        DynamicVariableRef operator[](StringViewType member) const;
+        DynamicVariableRef operator[](const InternedString &member) const;
+
+        DynamicVariableRef get(StringViewType member) const { return operator[](member); }
+        bool hasMember(StringViewType member) const;
+
+        void forEachCell(const std::function<void(const DynamicVariableRef &)> &function) const;
+
+        void forEachMember(
+          const std::function<void(const InternedString &, const DynamicVariableRef &)>
+            &function) const;
+
+        explicit operator bool() const;
+
+        /**
+         * @brief Gets a view on the string, valid as long as the referenced node
+         */
+        explicit operator StringViewType() const;
+
+        template<typename T,
+                 typename U = std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>>>
+        explicit operator T() const
+        {
+            if(isType(ValueType::Integer))
+                return static_cast<T>(toInteger());
+
+            if(isType(ValueType::Float))
+                return static_cast<T>(toFloat());
+
+            throw generateCastException(__func__);
+        }
+
+        bool operator==(std::nullptr_t) const { return isType(ValueType::None); }
+        bool operator!=(std::nullptr_t) const { return !isType(ValueType::None); }
+
+        bool operator==(StringViewType value) const;
+        bool operator!=(StringViewType value) const { return !operator==(value); }
+
+        /**
+         * @brief Referenced node, nullptr for None and for the cells of dense arrays
+         */
+        const AbstractValue *getNode() const { return m_cell == npos ? m_node : nullptr; }
+
+        /**
+         * @brief Makes a variable holding the referenced value, containers share their children
+         * with the referenced node
+         */
+        DynamicVariable toVariable() const;
+
+      private:
+        DynamicVariableRef(const AbstractValue *array, SizeType cell) : m_node(array), m_cell(cell)
+        {
+        }
+
+        static DynamicVariableRef makeChild(const AbstractValue::Ptr *slot)
+        {
+            return slot ? DynamicVariableRef(slot->get()) : DynamicVariableRef();
+        }
+
+        std::runtime_error generateCastException(const std::string &caller) const
+        {
+            return std::runtime_error(caller + ": unsupported action on type " +
+                                      std::to_string(getValueType()));
+        }
+
+        IntType toInteger() const;
+        FloatType toFloat() const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_DYNAMICVARIABLEREF_H
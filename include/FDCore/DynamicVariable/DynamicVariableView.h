@@ -0,0 +1,140 @@
+#ifndef FDCORE_DYNAMICVARIABLEVIEW_H
+#define FDCORE_DYNAMICVARIABLEVIEW_H
+
+#include <FDCore/DynamicVariable/DynamicVariable_fwd.h>
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace FDCore
+{
+    /**
+     * @brief Read-only view over a JSON encoded buffer.
+     *
+     * A view only stores the position of a node inside the buffer. Navigating with operator[]
+     * skips over the siblings without decoding them, and scalars are only decoded when they are
+     * converted. The buffer must outlive every view created on it.
+     */
+    class DynamicVariableView
+    {
+      public:
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+        typedef StringViewType::value_type CharType;
+
+        /**
+         * @brief Deepest nesting of arrays and objects toVariable() decodes
+         */
+        constexpr static SizeType MaxDepth = 512;
+
+      private:
+        StringViewType m_node;
+
+      public:
+        DynamicVariableView() = default;
+        DynamicVariableView(const DynamicVariableView &) = default;
+        DynamicVariableView(DynamicVariableView &&) = default;
+
+        /**
+         * @brief Creates a view on the root value of buffer
+         *
+         * @param buffer the encoded document, leading whitespaces are ignored
+         */
+        explicit DynamicVariableView(StringViewType buffer);
+
+        ~DynamicVariableView() = default;
+
+        DynamicVariableView &operator=(const DynamicVariableView &) = default;
+        DynamicVariableView &operator=(DynamicVariableView &&) = default;
+
+        ValueType getValueType() const;
+
+        bool isType(ValueType type) const { return type == getValueType(); }
+
+        /**
+         * @brief Number of cells of an array, members of an object or characters of a string
+         */
+        SizeType size() const;
+        bool isEmpty() const;
+
+        /**
+         * @brief Gets the view of the cell at pos, the previous cells are skipped but not decoded
+         *
+         * @throw std::out_of_range if pos is greater or equal to the size of the array
+         */
+        DynamicVariableView operator[](SizeType pos) const;
+
+        /**
+         * @brief Gets the view of the member named member, or a None view if there is no such
+         * member
+         */
+        DynamicVariableView operator[](StringViewType member) const;
+
+        DynamicVariableView get(StringViewType member) const { return operator[](member); }
+        bool hasMember(StringViewType member) const;
+
+        /**
+         * @brief Calls function with the view of each cell of an array, in a single pass
+         */
+        void forEachCell(const std::function<void(const DynamicVariableView &)> &function) const;
+
+        /**
+         * @brief Calls function with the views of the name and of the value of each member of an
+         * object, in a single pass
+         */
+        void forEachMember(
+          const std::function<void(const DynamicVariableView &, const DynamicVariableView &)>
+            &function) const;
+
+        explicit operator bool() const;
+        explicit operator StringType() const;
+
+        template<typename T,
+                 typename U = std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>>>
+        explicit operator T() const
+        {
+            if(isType(ValueType::Integer))
+                return static_cast<T>(toInteger());
+
+            if(isType(ValueType::Float))
+                return static_cast<T>(toFloat());
+
+            throw generateCastException(__func__);
+        }
+
+        bool operator==(std::nullptr_t) const { return isType(ValueType::None); }
+        bool operator!=(std::nullptr_t) const { return !isType(ValueType::None); }
+
+        bool operator==(StringViewType value) const;
+        bool operator!=(StringViewType value) const { return !operator==(value); }
+
+        /**
+         * @brief Encoded text of this node, from its first to its last character
+         */
+        StringViewType getEncodedValue() const;
+
+        /**
+         * @brief Decodes this node and all its children into a DynamicVariable
+         *
+         * @throw std::runtime_error if the node is malformed or nested deeper than MaxDepth
+         */
+        DynamicVariable toVariable() const;
+
+      private:
+        std::runtime_error generateCastException(const std::string &caller) const
+        {
+            return std::runtime_error(caller + ": unsupported action on type " +
+                                      std::to_string(getValueType()));
+        }
+
+        IntType toInteger() const;
+        FloatType toFloat() const;
+        DynamicVariable toVariable(SizeType depth) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_DYNAMICVARIABLEVIEW_H
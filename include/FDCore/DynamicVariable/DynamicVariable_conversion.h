@@ -3,10 +3,237 @@
 
 #include <FDCore/DynamicVariable/DynamicVariable_fwd.h>
 
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace FDCore
 {
+    /**
+     * @brief Name and pointer to member of a field of Class
+     */
+    template<typename Class, typename T>
+    struct StructField
+    {
+        typedef T FieldType;
+
+        DynamicVariable::StringViewType name;
+        T Class::*member;
+    };
+
+    template<typename Class, typename T>
+    constexpr StructField<Class, T> makeStructField(DynamicVariable::StringViewType name,
+                                                    T Class::*member)
+    {
+        return { name, member };
+    }
+
+    /**
+     * @brief Describes the fields of T, specialize it with FDCORE_STRUCT_SCHEMA
+     *
+     * A specialization has a static constexpr tuple of StructField named fields. Structs with a
+     * schema are converted to and from DynamicVariable objects and JSON, each field is bound to
+     * the member of the same name.
+     */
+    template<typename T, typename = void>
+    struct StructSchema
+    {
+        constexpr static bool value = false;
+    };
+
+    template<typename T>
+    inline constexpr bool has_StructSchema_v = StructSchema<T>::value;
+
+    template<typename T, typename F, size_t... indices>
+    constexpr void forEachStructField(F &&f, std::index_sequence<indices...>)
+    {
+        (f(std::integral_constant<size_t, indices>(), std::get<indices>(StructSchema<T>::fields)),
+         ...);
+    }
+
+    /**
+     * @brief Calls f(index, field) for each field of the schema of T, index is an
+     * std::integral_constant
+     */
+    template<typename T, typename F>
+    constexpr void forEachStructField(F &&f)
+    {
+        typedef std::remove_const_t<decltype(StructSchema<T>::fields)> FieldsType;
+        forEachStructField<T>(std::forward<F>(f),
+                              std::make_index_sequence<std::tuple_size_v<FieldsType>>());
+    }
+
+    template<typename T>
+    bool readStructField(const AbstractValue::Ptr &value, T &result);
+
+    /**
+     * @brief Conversions between a struct with a schema and its object node.
+     *
+     * Every object built from a T shares the same ObjectShape, so writing it fills the slots by
+     * index and reading an object built this way reads them by index too. Other objects are
+     * read by looking up the interned field names.
+     */
+    template<typename T>
+    struct StructBinding
+    {
+        static const ObjectShape::Ptr &getShape()
+        {
+            static const ObjectShape::Ptr shape = []() {
+                std::vector<ObjectShape::StringType> keys;
+                forEachStructField<T>([&keys](auto, const auto &field) {
+                    keys.emplace_back(field.name);
+                });
+
+                return ObjectShape::fromKeys(keys);
+            }();
+
+            return shape;
+        }
+
+        static AbstractValue::Ptr toValue(const T &value)
+        {
+            auto object = std::make_shared<ShapedObjectValue>(getShape());
+            forEachStructField<T>([&object, &value](auto index, const auto &field) {
+                typedef typename std::decay_t<decltype(field)>::FieldType FieldType;
+                object->at(index) =
+                  is_AbstractValue_constructible<FieldType>::toValue(value.*field.member);
+            });
+
+            return object;
+        }
+
+        /**
+         * @brief Reads the fields of result from value, which must be an object with a member
+         * of the right type for each field
+         *
+         * @return false if value does not match the schema, result may then be partially set
+         */
+        static bool read(const AbstractValue::Ptr &value, T &result)
+        {
+            if(!value || !value->isType(ValueType::Object))
+                return false;
+
+            const ObjectShape::Ptr &shape = getShape();
+            const auto &object = static_cast<const AbstractObjectValue &>(*value);
+            const auto *shaped = dynamic_cast<const ShapedObjectValue *>(&object);
+            if(shaped && shaped->getShape() != shape)
+                shaped = nullptr;
+
+            bool success = true;
+            forEachStructField<T>([&](auto index, const auto &field) {
+                if(!success)
+                    return;
 
+                const AbstractValue::Ptr *slot =
+                  shaped ? &shaped->at(index) : object.findSlot(shape->getKey(index));
+                success = slot && readStructField(*slot, result.*field.member);
+            });
 
+            return success;
+        }
+    };
+
+    template<typename T>
+    bool readStructField(const AbstractValue::Ptr &value, T &result)
+    {
+        if(!value)
+            return false;
+
+        if constexpr(has_StructSchema_v<T>)
+        {
+            return StructBinding<T>::read(value, result);
+        }
+        else
+        {
+            std::optional<T> current = is_AbstractValue_constructible<T>::fromValue(value);
+            if(!current)
+                return false;
+
+            result = std::move(*current);
+            return true;
+        }
+    }
+
+    template<typename T>
+    struct is_AbstractValue_constructible<T, std::enable_if_t<has_StructSchema_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static AbstractValue::Ptr toValue(const T &value)
+        {
+            return StructBinding<T>::toValue(value);
+        }
+
+        static std::optional<T> fromValue(const AbstractValue::Ptr &value)
+        {
+            T result;
+            if(!StructBinding<T>::read(value, result))
+                return std::nullopt;
+
+            return result;
+        }
+    };
+
+    template<typename T>
+    struct is_AbstractValue_constructible<std::vector<T>, std::enable_if_t<has_StructSchema_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static AbstractValue::Ptr toValue(const std::vector<T> &value)
+        {
+            ArrayValue::ArrayType cells;
+            cells.reserve(value.size());
+            for(const T &cell: value)
+                cells.push_back(StructBinding<T>::toValue(cell));
+
+            return std::make_shared<ArrayValue>(std::move(cells));
+        }
+
+        static std::optional<std::vector<T>> fromValue(const AbstractValue::Ptr &value)
+        {
+            if(!value || !value->isType(ValueType::Array))
+                return std::nullopt;
+
+            const auto &array = static_cast<const AbstractArrayValue &>(*value);
+            std::vector<T> result(array.size());
+            for(size_t i = 0, imax = array.size(); i < imax; ++i)
+            {
+                const AbstractValue::Ptr *slot = array.findSlot(i);
+                if(!slot || !StructBinding<T>::read(*slot, result[i]))
+                    return std::nullopt;
+            }
+
+            return result;
+        }
+    };
+
+    /**
+     * @brief Reads result from variable without going through std::optional
+     *
+     * @return false if variable does not hold a value convertible to T
+     */
+    template<typename T>
+    bool fromVariable(const DynamicVariable &variable, T &result)
+    {
+        return readStructField(variable.internalValue(), result);
+    }
 } // namespace FDCore
 
+/**
+ * @brief Expands to the StructField of member in Class
+ */
+#define FDCORE_STRUCT_FIELD(Class, member) ::FDCore::makeStructField(#member, &Class::member)
+
+/**
+ * @brief Declares the schema of Class from the list of its FDCORE_STRUCT_FIELD, must be used
+ * at global namespace scope
+ */
+#define FDCORE_STRUCT_SCHEMA(Class, ...)                                \
+    template<>                                                          \
+    struct FDCore::StructSchema<Class>                                  \
+    {                                                                   \
+        constexpr static bool value = true;                             \
+        static constexpr auto fields = std::make_tuple(__VA_ARGS__);    \
+    }
+
 #endif // FDCORE_DYNAMICVARIABLE_CONVERSION_H
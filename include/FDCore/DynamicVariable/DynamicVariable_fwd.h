@@ -2,24 +2,39 @@
 #define FDCORE_DYNAMICVARIABLE_FWD_H
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <stdexcept>
 
+#include <FDCore/Common/CopyOnWrite.h>
 #include <FDCore/DynamicVariable/AbstractArrayValue.h>
 #include <FDCore/DynamicVariable/AbstractObjectValue.h>
 #include <FDCore/DynamicVariable/AbstractValue.h>
 #include <FDCore/DynamicVariable/ArrayValue.h>
 #include <FDCore/DynamicVariable/BoolValue.h>
 #include <FDCore/DynamicVariable/FloatValue.h>
+#include <FDCore/DynamicVariable/FunctionValue.h>
 #include <FDCore/DynamicVariable/IntValue.h>
+#include <FDCore/DynamicVariable/MemoryUsage.h>
 #include <FDCore/DynamicVariable/ObjectValue.h>
+#include <FDCore/DynamicVariable/ShapedObjectValue.h>
 #include <FDCore/DynamicVariable/StringValue.h>
+#include <FDCore/DynamicVariable/TypedArrayValue.h>
+#include <FDCore/DynamicVariable/ValueVisitor.h>
 
 namespace FDCore
 {
     template<typename T, bool B = is_AbstractValue_constructible_v<T>>
     struct is_DynamicVariable_constructible;
 
+    /**
+     * @brief Value of any ValueType with copy-on-write value semantics.
+     *
+     * Copying a variable only shares its node; the node is copied the first time one of the
+     * variables sharing it is modified, so a modification is never visible through another
+     * variable. Cells and members read from a container are shared the same way: modifying them
+     * does not modify the container, set() or insert() the new value instead.
+     */
     class DynamicVariable
     {
       public:
@@ -31,11 +46,11 @@ namespace FDCore
         typedef ArrayValue::SizeType SizeType;
 
       private:
-        AbstractValue::Ptr m_value;
+        CopyOnWrite<AbstractValue> m_value;
 
       public:
         DynamicVariable();
-        DynamicVariable(const DynamicVariable &);
+        DynamicVariable(const DynamicVariable &) = default;
         DynamicVariable(DynamicVariable &&) = default;
         DynamicVariable(ValueType type);
         DynamicVariable(const AbstractValue::Ptr &value);
@@ -78,7 +93,7 @@ namespace FDCore
         {
             ArrayType arr(l.size());
             std::transform(l.begin(), l.end(), arr.begin(),
-                           [](const DynamicVariable &var) { return var.m_value; });
+                           [](const DynamicVariable &var) { return var.internalValue(); });
             m_value = std::make_shared<ArrayValue>(std::move(arr));
         }
 
@@ -93,23 +108,130 @@ namespace FDCore
 
         SizeType size() const;
         bool isEmpty() const;
-        DynamicVariable operator[](SizeType pos);
-        DynamicVariable operator[](StringViewType member);
+        DynamicVariable operator[](SizeType pos) const;
+        DynamicVariable operator[](StringViewType member) const;
 
-        DynamicVariable get(StringViewType member);
+        DynamicVariable get(StringViewType member) const;
         void set(StringViewType key, DynamicVariable value);
         void unset(StringViewType key);
 
+        /**
+         * @brief Appends value, a dense array that cannot hold it is made generic first
+         */
         void push(const DynamicVariable &value);
         DynamicVariable pop();
 
+        /**
+         * @brief Inserts value at pos, a dense array that cannot hold it is made generic first
+         */
         void insert(const DynamicVariable &value, SizeType pos);
         DynamicVariable removeAt(SizeType pos);
         void clear();
 
+        /**
+         * @brief Type shared by every cell of a dense array, None for generic arrays
+         */
+        ValueType getElementType() const;
+
+        /**
+         * @brief Contiguous storage of a dense array of T
+         *
+         * @throw std::runtime_error if this is not a TypedArrayValue<T>
+         */
+        template<typename T>
+        Span<typename TypedArrayTraits<T>::StorageType, SizeType> getSpan()
+        {
+            return toTypedArray<T>().getSpan();
+        }
+
+        template<typename T>
+        Span<const typename TypedArrayTraits<T>::StorageType, SizeType> getSpan() const
+        {
+            return toTypedArray<T>().getSpan();
+        }
+
+        /**
+         * @brief Replaces a generic array whose cells share the same scalar type by the
+         * equivalent dense array
+         *
+         * Other variables referencing the previous array are not affected.
+         *
+         * @return true if the array is dense after the call
+         */
+        bool makeDense();
+
+        /**
+         * @brief Replaces a dense array by the equivalent generic array, so that it can hold
+         * cells of any type
+         *
+         * Other variables referencing the previous array are not affected.
+         */
+        void makeGeneric();
+
+        /**
+         * @brief Calls the function held by this variable
+         *
+         * @throw std::runtime_error if this is not a Function or if the function is empty
+         */
+        DynamicVariable call(FunctionValue::Arguments arguments) const;
+
+        /**
+         * @brief Calls the function held by this variable with arguments converted to
+         * DynamicVariables
+         */
+        template<typename... Args>
+        DynamicVariable operator()(const Args &...arguments) const
+        {
+            const std::array<DynamicVariable, sizeof...(Args)> values { DynamicVariable(
+              arguments)... };
+            return call({ values.size(), values.data() });
+        }
+
         void append(const DynamicVariable &str) { append(static_cast<StringType>(str)); };
         void append(StringViewType str);
-        DynamicVariable subString(SizeType from, SizeType count);
+        DynamicVariable subString(SizeType from, SizeType count) const;
+
+        /**
+         * @brief Deep copy, the result shares no node with this variable
+         */
+        DynamicVariable clone() const;
+
+        /**
+         * @brief Hash of the content of this variable, equal variables have the same hash
+         *
+         * The hash of a string, an array or an object is cached in its node, so hashing a
+         * variable used as a key again, or hashing a container that shares children with an
+         * already hashed one, does not walk the shared nodes again.
+         */
+        size_t hash() const;
+
+        /**
+         * @brief Total order over every value, negative if this variable is ordered before
+         * value, 0 if they are equivalent and positive otherwise.
+         *
+         * Values are ordered by type (None, Boolean, numbers, String, Array, Object), integers
+         * and floats are compared by value, an integer before the equal float and NaN after
+         * every number. Arrays are compared lexicographically and objects by their number of
+         * members, then by their members sorted by name.
+         */
+        int compare(const DynamicVariable &value) const;
+
+        /**
+         * @brief Marks the node of this variable and all its children as immutable
+         *
+         * Any later modification through a variable, including this one, copies the modified
+         * nodes first, so a frozen tree can be read from any number of threads, for instance
+         * through DynamicVariableRef which does not touch the reference counts. The tree must be
+         * frozen before it is shared with the other threads.
+         */
+        void freeze();
+
+        bool isFrozen() const { return m_value && m_value.get()->isFrozen(); }
+
+        /**
+         * @brief Memory used by the tree of this variable, see MemoryUsage
+         */
+        MemoryUsage memoryUsage() const;
 
         DynamicVariable &operator=(const DynamicVariable &) = default;
         DynamicVariable &operator=(DynamicVariable &&) = default;
@@ -124,10 +246,26 @@ namespace FDCore
           const T &value);
 
         explicit operator bool() const;
-        explicit operator StringType() const;
+        explicit operator StringType() const &;
         explicit operator const StringType &() const;
-        explicit operator ArrayType() const;
-        explicit operator const ArrayType &() const;
+        explicit operator ArrayType() const &;
+
+        /**
+         * @brief References the cells of the array, a dense array is made generic first
+         *
+         * Const variables are converted with the copying operator ArrayType() instead.
+         */
+        explicit operator const ArrayType &();
+
+        /**
+         * @brief Moves the string out of the variable if it does not share it
+         */
+        explicit operator StringType() &&;
+
+        /**
+         * @brief Moves the cells out of the variable if it does not share them
+         */
+        explicit operator ArrayType() &&;
 
         template<typename T>
         explicit operator T() const
@@ -137,10 +275,23 @@ namespace FDCore
             return result;
         }
 
+        /**
+         * @brief Values of different types are never equal, containers are compared
+         * structurally. Every NaN is equal to every other NaN, so that equality agrees with
+         * hash() and compare() and NaN can be a key.
+         */
         bool operator==(const DynamicVariable &value) const;
 
         bool operator!=(const DynamicVariable &value) const;
 
+        bool operator<(const DynamicVariable &value) const { return compare(value) < 0; }
+
+        bool operator<=(const DynamicVariable &value) const { return compare(value) <= 0; }
+
+        bool operator>(const DynamicVariable &value) const { return compare(value) > 0; }
+
+        bool operator>=(const DynamicVariable &value) const { return compare(value) >= 0; }
+
         bool operator==(std::nullptr_t) const;
 
         bool operator!=(std::nullptr_t) const;
@@ -492,9 +643,72 @@ namespace FDCore
 
         void write(StreamType &stream) const;
 
-        AbstractValue::Ptr internalValue() { return m_value; }
+        /**
+         * @brief Gets the node of this variable, which may be shared with other variables and
+         * must not be modified
+         */
+        AbstractValue::Ptr internalValue() const { return m_value.getSharedPointer(); }
+
+        /**
+         * @brief Same as internalValue(), without sharing the node
+         */
+        const AbstractValue *internalNode() const { return m_value.get(); }
+
+        /**
+         * @brief Calls visitor with the node of this variable cast to the class of its type
+         * (BoolValue, IntValue, FloatValue, StringValue, FunctionValue, AbstractArrayValue,
+         * AbstractObjectValue, or std::nullptr_t for None)
+         */
+        template<typename Visitor>
+        decltype(auto) visit(Visitor &&visitor) const
+        {
+            const AbstractValue *node = m_value.get();
+            return visitValue(std::forward<Visitor>(visitor), node);
+        }
+
+        /**
+         * @brief Calls visitor with the nodes of lhs and rhs, the pair of types is resolved by a
+         * single lookup in a precomputed table
+         */
+        template<typename Visitor>
+        static decltype(auto) visit(Visitor &&visitor,
+                                    const DynamicVariable &lhs,
+                                    const DynamicVariable &rhs)
+        {
+            const AbstractValue *lhsNode = lhs.m_value.get();
+            const AbstractValue *rhsNode = rhs.m_value.get();
+            return visitValues(std::forward<Visitor>(visitor), lhsNode, rhsNode);
+        }
 
       private:
+        /**
+         * @brief Same as visit() but gives a modifiable node of lhs, which is detached first
+         */
+        template<typename Visitor>
+        static decltype(auto) visitMutable(Visitor &&visitor,
+                                           DynamicVariable &lhs,
+                                           const DynamicVariable &rhs)
+        {
+            AbstractValue *lhsNode = lhs.m_value ? &*lhs.m_value : nullptr;
+            const AbstractValue *rhsNode = rhs.m_value.get();
+            return visitValues(std::forward<Visitor>(visitor), lhsNode, rhsNode);
+        }
+
+        /**
+         * @brief Unchecked access to the node, for callers that already dispatched on its type
+         */
+        template<typename T>
+        T &nodeAs()
+        {
+            return static_cast<T &>(*m_value);
+        }
+
+        template<typename T>
+        const T &nodeAs() const
+        {
+            return static_cast<const T &>(*m_value);
+        }
+
         std::runtime_error generateCastException(const std::string &caller) const
         {
             return std::runtime_error(caller + ": unsupported action on type " +
@@ -515,7 +729,7 @@ namespace FDCore
             if(!isType(ValueType::Boolean))
                 throw generateCastException(__func__);
 
-            return static_cast<BoolValue &>(*m_value);
+            return static_cast<const BoolValue &>(*m_value);
         }
 
         IntValue &toInteger()
@@ -532,7 +746,7 @@ namespace FDCore
             if(!isType(ValueType::Integer))
                 throw generateCastException(__func__);
 
-            return static_cast<IntValue &>(*m_value);
+            return static_cast<const IntValue &>(*m_value);
         }
 
         FloatValue &toFloat()
@@ -549,7 +763,7 @@ namespace FDCore
             if(!isType(ValueType::Float))
                 throw generateCastException(__func__);
 
-            return static_cast<FloatValue &>(*m_value);
+            return static_cast<const FloatValue &>(*m_value);
         }
 
         StringValue &toString()
@@ -565,7 +779,7 @@ namespace FDCore
             if(!isType(ValueType::String))
                 throw generateCastException(__func__);
 
-            return static_cast<StringValue &>(*m_value);
+            return static_cast<const StringValue &>(*m_value);
         }
 
         AbstractArrayValue &toArray()
@@ -581,7 +795,25 @@ namespace FDCore
             if(!isType(ValueType::Array))
                 throw generateCastException(__func__);
 
-            return static_cast<AbstractArrayValue &>(*m_value);
+            return static_cast<const AbstractArrayValue &>(*m_value);
+        }
+
+        template<typename T>
+        TypedArrayValue<T> &toTypedArray()
+        {
+            if(getElementType() != TypedArrayTraits<T>::elementType)
+                throw generateCastException(__func__);
+
+            return static_cast<TypedArrayValue<T> &>(*m_value);
+        }
+
+        template<typename T>
+        const TypedArrayValue<T> &toTypedArray() const
+        {
+            if(getElementType() != TypedArrayTraits<T>::elementType)
+                throw generateCastException(__func__);
+
+            return static_cast<const TypedArrayValue<T> &>(*m_value);
         }
 
         AbstractObjectValue &toObject()
@@ -597,7 +829,7 @@ namespace FDCore
             if(!isType(ValueType::Object))
                 throw generateCastException(__func__);
 
-            return static_cast<AbstractObjectValue &>(*m_value);
+            return static_cast<const AbstractObjectValue &>(*m_value);
         }
 
         template<typename T>
@@ -635,4 +867,13 @@ namespace FDCore
       is_DynamicVariable_constructible<T>::value;
 } // namespace FDCore
 
+namespace std
+{
+    template<>
+    struct hash<FDCore::DynamicVariable>
+    {
+        size_t operator()(const FDCore::DynamicVariable &value) const { return value.hash(); }
+    };
+} // namespace std
+
 #endif // FDCORE_DYNAMICVARIABLE_FWD_H
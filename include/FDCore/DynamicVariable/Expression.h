@@ -0,0 +1,208 @@
+#ifndef FDCORE_EXPRESSION_H
+#define FDCORE_EXPRESSION_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/PathQuery.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief What is known about the records and the functions when an expression is compiled
+     */
+    struct ExpressionEnvironment
+    {
+        /**
+         * @brief Type of the fields, by JSON Pointer ("/item/price"). The operators on fields
+         * of a known scalar type are specialized for this type, and evaluating the expression
+         * on a record whose field has another type throws.
+         */
+        std::unordered_map<DynamicVariable::StringType, ValueType> fieldTypes;
+
+        /**
+         * @brief Object whose members are the Function values callable from the expression
+         */
+        DynamicVariable functions;
+    };
+
+    /**
+     * @brief Expression compiled once and evaluated on any number of records.
+     *
+     * The language has the literals null, true, false, integers, floats and quoted strings,
+     * the fields of the record ("price", "item.tags[0]", "$" for the record itself), calls of
+     * the functions of the environment, the unary operators - and !, the binary operators
+     * * / % + - < <= > >= == != && || and the conditional operator ?:, with the precedence of
+     * C. The operators behave as the operators of DynamicVariable, ordering uses
+     * DynamicVariable::compare(), && || ?: only accept Booleans, integer division by zero
+     * throws std::domain_error and dividing the smallest integer by -1 throws
+     * std::overflow_error.
+     *
+     * The source is compiled to a bytecode for a stack machine. The operations whose operands
+     * are all constant are folded when compiling, and the operators whose operand types are
+     * known, from literals or from ExpressionEnvironment::fieldTypes, use instructions
+     * specialized for these types. Scalars are kept unboxed on the stack and the nodes of the
+     * record are borrowed, so evaluating an expression that only reads scalars does not
+     * allocate.
+     */
+    class Expression
+    {
+      public:
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+
+        enum class OpCode : uint8_t
+        {
+            Constant,
+            Field,
+            FieldBoolean,
+            FieldInteger,
+            FieldFloat,
+            Negate,
+            NegateInteger,
+            NegateFloat,
+            Not,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo,
+            AddInteger,
+            SubtractInteger,
+            MultiplyInteger,
+            DivideInteger,
+            ModuloInteger,
+            AddFloat,
+            SubtractFloat,
+            MultiplyFloat,
+            DivideFloat,
+            Equal,
+            NotEqual,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+            EqualInteger,
+            NotEqualInteger,
+            LessInteger,
+            LessEqualInteger,
+            GreaterInteger,
+            GreaterEqualInteger,
+            EqualFloat,
+            NotEqualFloat,
+            LessFloat,
+            LessEqualFloat,
+            GreaterFloat,
+            GreaterEqualFloat,
+            Jump,
+            JumpIfFalse,
+            JumpIfTrue,
+            CheckBoolean,
+            Call
+        };
+
+        /**
+         * @brief Instruction of the bytecode. operand is the index of the constant, field or
+         * function, or the target of a jump; count is the number of arguments of a call.
+         */
+        struct Instruction
+        {
+            OpCode code;
+            uint8_t count;
+            uint32_t operand;
+        };
+
+        /**
+         * @brief Value on the stack of the machine
+         */
+        struct Register;
+
+        /**
+         * @brief Deepest nesting of parentheses, operators and calls the compiler accepts,
+         * counting the operands of a chain like a + b + c as nested
+         */
+        constexpr static SizeType MaxDepth = 256;
+
+      private:
+        std::vector<Instruction> m_code;
+        std::vector<AbstractValue::Ptr> m_constants;
+        std::vector<PathQuery> m_fields;
+        std::vector<DynamicVariable> m_functions;
+        SizeType m_stackSize;
+        ValueType m_resultType;
+        bool m_isResultTyped;
+
+      public:
+        /**
+         * @brief Expression evaluating to null
+         */
+        Expression();
+        Expression(const Expression &) = default;
+        Expression(Expression &&) = default;
+
+        /**
+         * @throw std::invalid_argument if source is not a valid expression, is nested deeper
+         * than MaxDepth or calls a function missing from environment
+         */
+        explicit Expression(StringViewType source,
+                            const ExpressionEnvironment &environment = ExpressionEnvironment());
+
+        ~Expression() = default;
+
+        Expression &operator=(const Expression &) = default;
+        Expression &operator=(Expression &&) = default;
+
+        DynamicVariable evaluate(const DynamicVariable &record) const;
+
+        /**
+         * @brief Evaluates the expression on each cell of the array records, reusing the same
+         * stack for all of them
+         *
+         * @throw std::runtime_error if records is not an array
+         */
+        void evaluate(const DynamicVariable &records, std::vector<DynamicVariable> &results) const;
+
+        /**
+         * @brief Evaluates the expression on each cell of the array records, the results are a
+         * dense array when the type of the result is a known scalar type
+         */
+        DynamicVariable evaluateAll(const DynamicVariable &records) const;
+
+        /**
+         * @brief Array of the cells of records for which the expression is true
+         *
+         * @throw std::runtime_error if the expression does not evaluate to a Boolean
+         */
+        DynamicVariable filter(const DynamicVariable &records) const;
+
+        /**
+         * @brief true if the expression was folded to a constant
+         */
+        bool isConstant() const
+        {
+            return m_code.size() == 1 && m_code.front().code == OpCode::Constant;
+        }
+
+        /**
+         * @brief Type of every result, None if it depends on the records
+         */
+        ValueType getResultType() const { return m_isResultTyped ? m_resultType : ValueType::None; }
+
+        const std::vector<Instruction> &getCode() const { return m_code; }
+
+      private:
+        class Compiler;
+
+        void run(const AbstractValue::Ptr &record, std::vector<Register> &stack) const;
+
+        template<typename Function>
+        void forEachRecord(const DynamicVariable &records, Function &&function) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_EXPRESSION_H
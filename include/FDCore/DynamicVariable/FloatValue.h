@@ -20,12 +20,14 @@ namespace FDCore
         FloatType m_value;
 
       public:
-        FloatValue() : m_value(0) {}
+        FloatValue() : AbstractValue(ValueType::Float), m_value(0) {}
 
         template<typename T,
                  typename U =
                    std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, FloatType>>
-        explicit FloatValue(T value) : m_value(static_cast<FloatType>(value))
+        explicit FloatValue(T value) :
+            AbstractValue(ValueType::Float),
+            m_value(static_cast<FloatType>(value))
         {
         }
 
@@ -34,7 +36,9 @@ namespace FDCore
 
         ~FloatValue() noexcept override = default;
 
-        ValueType getValueType() const override { return ValueType::Float; }
+        AbstractValue::Ptr copy() const override { return std::make_shared<FloatValue>(*this); }
+
+        ValueFootprint getFootprint() const override { return { sizeof(*this), 0, 0 }; }
 
         FloatValue &operator=(FloatValue &&) = default;
         FloatValue &operator=(const FloatValue &) = default;
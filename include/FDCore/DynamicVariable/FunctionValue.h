@@ -0,0 +1,175 @@
+#ifndef FDCORE_FUNCTIONVALUE_H
+#define FDCORE_FUNCTIONVALUE_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/DynamicVariable/AbstractValue.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace FDCore
+{
+    class DynamicVariable;
+
+    /**
+     * @brief Node holding a native callable taking its arguments as DynamicVariables and
+     * returning a DynamicVariable.
+     *
+     * Function pointers, captureless lambdas and closures capturing up to BufferSize bytes are
+     * stored inline in the node, larger closures are allocated once when the node is created.
+     * The callable is invoked through a pointer to a table of operations generated for its type,
+     * without going through std::function.
+     *
+     * The callable is invoked as const and may be called from several threads at once when the
+     * node is shared, it must not modify its captures. Copying the node copies the callable.
+     */
+    class FunctionValue : public AbstractValue
+    {
+      public:
+        typedef Span<const DynamicVariable, size_t> Arguments;
+
+        constexpr static size_t BufferSize = 4 * sizeof(void *);
+
+      private:
+        struct Operations
+        {
+            void (*invoke)(const void *storage, Arguments arguments, DynamicVariable &result);
+            void (*copy)(void *target, const void *source);
+            void (*move)(void *target, void *source);
+            void (*destroy)(void *storage);
+            size_t heapBytes;
+        };
+
+        template<typename F>
+        constexpr static bool isStoredInline = sizeof(F) <= BufferSize &&
+                                               alignof(F) <= alignof(std::max_align_t) &&
+                                               std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        struct InlineOperations
+        {
+            static const F &get(const void *storage) { return *static_cast<const F *>(storage); }
+
+            static void invoke(const void *storage, Arguments arguments, DynamicVariable &result)
+            {
+                result = get(storage)(arguments);
+            }
+
+            static void copy(void *target, const void *source) { new(target) F(get(source)); }
+
+            static void move(void *target, void *source)
+            {
+                new(target) F(std::move(*static_cast<F *>(source)));
+            }
+
+            static void destroy(void *storage) { static_cast<F *>(storage)->~F(); }
+        };
+
+        template<typename F>
+        struct HeapOperations
+        {
+            static F *&get(void *storage) { return *static_cast<F **>(storage); }
+
+            static const F &get(const void *storage) { return **static_cast<F *const *>(storage); }
+
+            static void invoke(const void *storage, Arguments arguments, DynamicVariable &result)
+            {
+                result = get(storage)(arguments);
+            }
+
+            static void copy(void *target, const void *source)
+            {
+                new(target) F *(new F(get(source)));
+            }
+
+            static void move(void *target, void *source)
+            {
+                new(target) F *(get(source));
+                get(source) = nullptr;
+            }
+
+            static void destroy(void *storage) { delete get(storage); }
+        };
+
+        template<typename F>
+        constexpr static Operations operationsOf()
+        {
+            typedef std::conditional_t<isStoredInline<F>, InlineOperations<F>, HeapOperations<F>>
+              Implementation;
+            return { &Implementation::invoke, &Implementation::copy, &Implementation::move,
+                     &Implementation::destroy, isStoredInline<F> ? 0 : sizeof(F) };
+        }
+
+        template<typename F>
+        constexpr static Operations s_operations = operationsOf<F>();
+
+        alignas(std::max_align_t) unsigned char m_storage[BufferSize];
+        const Operations *m_operations;
+
+      public:
+        /**
+         * @brief Empty function, calling it throws
+         */
+        FunctionValue() : AbstractValue(ValueType::Function), m_operations(nullptr) {}
+
+        template<typename F,
+                 typename U = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionValue>>>
+        explicit FunctionValue(F &&function) : AbstractValue(ValueType::Function)
+        {
+            typedef std::decay_t<F> FunctionType;
+            m_operations = &s_operations<FunctionType>;
+            if constexpr(isStoredInline<FunctionType>)
+                new(m_storage) FunctionType(std::forward<F>(function));
+            else
+                new(m_storage) FunctionType *(new FunctionType(std::forward<F>(function)));
+        }
+
+        FunctionValue(const FunctionValue &other) :
+            AbstractValue(other),
+            m_operations(other.m_operations)
+        {
+            if(m_operations)
+                m_operations->copy(m_storage, other.m_storage);
+        }
+
+        FunctionValue(FunctionValue &&other) :
+            AbstractValue(std::move(other)),
+            m_operations(other.m_operations)
+        {
+            if(m_operations)
+                m_operations->move(m_storage, other.m_storage);
+        }
+
+        ~FunctionValue() noexcept override
+        {
+            if(m_operations)
+                m_operations->destroy(m_storage);
+        }
+
+        FunctionValue &operator=(const FunctionValue &) = delete;
+        FunctionValue &operator=(FunctionValue &&) = delete;
+
+        AbstractValue::Ptr copy() const override { return std::make_shared<FunctionValue>(*this); }
+
+        ValueFootprint getFootprint() const override
+        {
+            return { sizeof(*this), m_operations ? m_operations->heapBytes : 0, 0 };
+        }
+
+        bool isEmpty() const { return m_operations == nullptr; }
+
+        /**
+         * @brief true if the callable is stored in the node itself
+         */
+        bool isInline() const { return m_operations && m_operations->heapBytes == 0; }
+
+        /**
+         * @throw std::runtime_error if the function is empty
+         */
+        DynamicVariable call(Arguments arguments) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_FUNCTIONVALUE_H
@@ -18,12 +18,14 @@ namespace FDCore
         IntType m_value;
 
       public:
-        IntValue() : m_value(0) {}
+        IntValue() : AbstractValue(ValueType::Integer), m_value(0) {}
 
         template<
           typename T,
           typename U = std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, IntType>>
-        explicit IntValue(T value) : m_value(static_cast<IntType>(value))
+        explicit IntValue(T value) :
+            AbstractValue(ValueType::Integer),
+            m_value(static_cast<IntType>(value))
         {
         }
 
@@ -32,7 +34,9 @@ namespace FDCore
 
         ~IntValue() noexcept override = default;
 
-        ValueType getValueType() const override { return ValueType::Integer; }
+        AbstractValue::Ptr copy() const override { return std::make_shared<IntValue>(*this); }
+
+        ValueFootprint getFootprint() const override { return { sizeof(*this), 0, 0 }; }
 
         IntValue &operator=(IntValue &&) = default;
         IntValue &operator=(const IntValue &) = default;
@@ -0,0 +1,319 @@
+#ifndef FDCORE_JSONCODEC_H
+#define FDCORE_JSONCODEC_H
+
+#include <FDCore/Common/Macros.h>
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/DynamicVariableView.h>
+
+#include <array>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Appends value to output as a quoted and escaped JSON string
+     */
+    FD_EXPORT void writeJsonString(DynamicVariable::StringViewType value,
+                                   DynamicVariable::StringType &output);
+
+    /**
+     * @brief Appends the shortest representation of value that reads back to the same float,
+     * with a fraction or an exponent so that it is not read back as an integer. Infinities and
+     * NaN are written as null.
+     */
+    FD_EXPORT void writeJsonFloat(DynamicVariable::FloatType value,
+                                  DynamicVariable::StringType &output);
+
+    template<typename T>
+    void writeJsonInteger(T value, DynamicVariable::StringType &output)
+    {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        output.append(buffer, result.ptr);
+    }
+
+    /**
+     * @brief Appends the JSON encoding of value to output
+     *
+     * @throw std::runtime_error if value contains a node that has no JSON encoding
+     */
+    FD_EXPORT void writeJson(const DynamicVariable &value, DynamicVariable::StringType &output);
+
+    FD_EXPORT DynamicVariable::StringType toJson(const DynamicVariable &value);
+
+    /**
+     * @brief Encodes T to JSON and decodes it directly from a DynamicVariableView, without
+     * building a DynamicVariable tree.
+     *
+     * Specializations provide write(value, output), which appends the encoding of value, and
+     * read(view, result), which returns false if view does not hold a T.
+     */
+    template<typename T, typename = void>
+    struct JsonCodec
+    {
+        constexpr static bool value = false;
+    };
+
+    template<>
+    struct JsonCodec<bool>
+    {
+        constexpr static bool value = true;
+
+        static void write(bool value, DynamicVariable::StringType &output)
+        {
+            output.append(value ? "true" : "false");
+        }
+
+        static bool read(const DynamicVariableView &view, bool &result)
+        {
+            if(!view.isType(ValueType::Boolean))
+                return false;
+
+            result = static_cast<bool>(view);
+            return true;
+        }
+    };
+
+    template<typename T>
+    struct JsonCodec<T, std::enable_if_t<!std::is_same_v<bool, T> && std::is_integral_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static void write(T value, DynamicVariable::StringType &output)
+        {
+            writeJsonInteger(value, output);
+        }
+
+        /**
+         * @return false if the value is not an integer or does not fit T
+         */
+        static bool read(const DynamicVariableView &view, T &result)
+        {
+            if(!view.isType(ValueType::Integer))
+                return false;
+
+            DynamicVariable::IntType value = 0;
+            try
+            {
+                value = static_cast<DynamicVariable::IntType>(view);
+            }
+            catch(const std::runtime_error &)
+            {
+                // wider than the 64 bits of IntType
+                return false;
+            }
+
+            if constexpr(std::is_signed_v<T>)
+            {
+                if(value < static_cast<DynamicVariable::IntType>(std::numeric_limits<T>::min()) ||
+                   value > static_cast<DynamicVariable::IntType>(std::numeric_limits<T>::max()))
+                    return false;
+            }
+            else
+            {
+                if(value < 0 || static_cast<std::make_unsigned_t<DynamicVariable::IntType>>(
+                                  value) > std::numeric_limits<T>::max())
+                    return false;
+            }
+
+            result = static_cast<T>(value);
+            return true;
+        }
+    };
+
+    template<typename T>
+    struct JsonCodec<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static void write(T value, DynamicVariable::StringType &output)
+        {
+            writeJsonFloat(static_cast<DynamicVariable::FloatType>(value), output);
+        }
+
+        static bool read(const DynamicVariableView &view, T &result)
+        {
+            if(!view.isType(ValueType::Integer) && !view.isType(ValueType::Float))
+                return false;
+
+            result = static_cast<T>(view);
+            return true;
+        }
+    };
+
+    template<>
+    struct JsonCodec<DynamicVariable::StringType>
+    {
+        constexpr static bool value = true;
+
+        static void write(const DynamicVariable::StringType &value,
+                          DynamicVariable::StringType &output)
+        {
+            writeJsonString(value, output);
+        }
+
+        static bool read(const DynamicVariableView &view, DynamicVariable::StringType &result)
+        {
+            if(!view.isType(ValueType::String))
+                return false;
+
+            result = static_cast<DynamicVariable::StringType>(view);
+            return true;
+        }
+    };
+
+    template<>
+    struct JsonCodec<DynamicVariable>
+    {
+        constexpr static bool value = true;
+
+        static void write(const DynamicVariable &value, DynamicVariable::StringType &output)
+        {
+            writeJson(value, output);
+        }
+
+        static bool read(const DynamicVariableView &view, DynamicVariable &result)
+        {
+            result = view.toVariable();
+            return true;
+        }
+    };
+
+    template<typename T>
+    struct JsonCodec<std::vector<T>, std::enable_if_t<JsonCodec<T>::value>>
+    {
+        constexpr static bool value = true;
+
+        static void write(const std::vector<T> &value, DynamicVariable::StringType &output)
+        {
+            output.push_back('[');
+            for(size_t i = 0, imax = value.size(); i < imax; ++i)
+            {
+                if(i != 0)
+                    output.push_back(',');
+
+                JsonCodec<T>::write(value[i], output);
+            }
+
+            output.push_back(']');
+        }
+
+        static bool read(const DynamicVariableView &view, std::vector<T> &result)
+        {
+            if(!view.isType(ValueType::Array))
+                return false;
+
+            bool success = true;
+            result.clear();
+            view.forEachCell([&success, &result](const DynamicVariableView &cell) {
+                if(!success)
+                    return;
+
+                result.emplace_back();
+                success = JsonCodec<T>::read(cell, result.back());
+            });
+
+            return success;
+        }
+    };
+
+    template<typename T>
+    struct JsonCodec<T, std::enable_if_t<has_StructSchema_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static void write(const T &value, DynamicVariable::StringType &output)
+        {
+            output.push_back('{');
+            forEachStructField<T>([&value, &output](auto index, const auto &field) {
+                typedef typename std::decay_t<decltype(field)>::FieldType FieldType;
+                if(index != 0)
+                    output.push_back(',');
+
+                writeJsonString(field.name, output);
+                output.push_back(':');
+                JsonCodec<FieldType>::write(value.*field.member, output);
+            });
+
+            output.push_back('}');
+        }
+
+        /**
+         * @brief Reads every field of result from the member of the same name, in one pass over
+         * the members of view. Members without a field are ignored.
+         */
+        static bool read(const DynamicVariableView &view, T &result)
+        {
+            if(!view.isType(ValueType::Object))
+                return false;
+
+            typedef std::remove_const_t<decltype(StructSchema<T>::fields)> FieldsType;
+            std::array<bool, std::tuple_size_v<FieldsType>> found {};
+            bool success = true;
+            view.forEachMember([&](const DynamicVariableView &name,
+                                   const DynamicVariableView &member) {
+                forEachStructField<T>([&](auto index, const auto &field) {
+                    typedef typename std::decay_t<decltype(field)>::FieldType FieldType;
+                    if(!success || found[index] || name != field.name)
+                        return;
+
+                    found[index] = true;
+                    success = JsonCodec<FieldType>::read(member, result.*field.member);
+                });
+            });
+
+            for(bool current: found)
+                success = success && current;
+
+            return success;
+        }
+    };
+
+    template<typename T>
+    std::enable_if_t<JsonCodec<T>::value> writeJson(const T &value,
+                                                     DynamicVariable::StringType &output)
+    {
+        JsonCodec<T>::write(value, output);
+    }
+
+    template<typename T>
+    std::enable_if_t<JsonCodec<T>::value, DynamicVariable::StringType> toJson(const T &value)
+    {
+        DynamicVariable::StringType result;
+        JsonCodec<T>::write(value, result);
+        return result;
+    }
+
+    /**
+     * @brief Reads result from view
+     *
+     * @return false if view does not match T, result may then be partially set
+     * @throw std::runtime_error if the JSON is malformed
+     */
+    template<typename T>
+    bool readJson(const DynamicVariableView &view, T &result)
+    {
+        return JsonCodec<T>::read(view, result);
+    }
+
+    /**
+     * @brief Decodes a T from the JSON document in buffer
+     *
+     * @throw std::invalid_argument if the document does not match T
+     * @throw std::runtime_error if the JSON is malformed
+     */
+    template<typename T>
+    T fromJson(DynamicVariable::StringViewType buffer)
+    {
+        T result;
+        if(!JsonCodec<T>::read(DynamicVariableView(buffer), result))
+            throw std::invalid_argument("fromJson: the document does not match the type");
+
+        return result;
+    }
+} // namespace FDCore
+
+#endif // FDCORE_JSONCODEC_H
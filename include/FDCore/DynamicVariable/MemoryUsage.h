@@ -0,0 +1,106 @@
+#ifndef FDCORE_MEMORYUSAGE_H
+#define FDCORE_MEMORYUSAGE_H
+
+#include <FDCore/Common/Macros.h>
+#include <FDCore/DynamicVariable/AbstractValue.h>
+#include <FDCore/DynamicVariable/ValueVisitor.h>
+
+#include <array>
+#include <unordered_set>
+
+namespace FDCore
+{
+    /**
+     * @brief Memory used by the nodes of one ValueType
+     */
+    struct ValueMemoryUsage
+    {
+        size_t nodes = 0;
+        size_t headerBytes = 0;
+        size_t payloadBytes = 0;
+        size_t slackBytes = 0;
+
+        size_t totalBytes() const { return headerBytes + payloadBytes + slackBytes; }
+
+        ValueMemoryUsage &operator+=(const ValueMemoryUsage &other)
+        {
+            nodes += other.nodes;
+            headerBytes += other.headerBytes;
+            payloadBytes += other.payloadBytes;
+            slackBytes += other.slackBytes;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Memory used by the nodes of DynamicVariable trees, by ValueType.
+     *
+     * A node shared by several parents is counted once. Allocator overhead, shared_ptr control
+     * blocks, object shapes and the strings owned by interners are not counted.
+     */
+    struct MemoryUsage
+    {
+        std::array<ValueMemoryUsage, ValueTypeCount> byType;
+
+        /**
+         * @brief Number of references to a node that was already counted
+         */
+        size_t sharedReferences = 0;
+
+        const ValueMemoryUsage &operator[](ValueType type) const
+        {
+            return byType[static_cast<size_t>(type)];
+        }
+
+        ValueMemoryUsage &operator[](ValueType type) { return byType[static_cast<size_t>(type)]; }
+
+        ValueMemoryUsage total() const
+        {
+            ValueMemoryUsage result;
+            for(const ValueMemoryUsage &usage: byType)
+                result += usage;
+
+            return result;
+        }
+    };
+
+    /**
+     * @brief Accumulates the memory used by several trees, a node shared between them is
+     * counted once
+     */
+    class FD_EXPORT MemoryUsageCounter
+    {
+      private:
+        MemoryUsage m_usage;
+        std::unordered_set<const AbstractValue *> m_counted;
+
+      public:
+        /**
+         * @brief Counts root and all its children that are not counted yet
+         */
+        void add(const AbstractValue *root);
+
+        const MemoryUsage &getUsage() const { return m_usage; }
+
+        void clear();
+    };
+
+    /**
+     * @brief Number of nodes alive in the process for each ValueType.
+     *
+     * Only tracked when FDCore is built with FDCORE_TRACK_VALUE_ALLOCATIONS, every count is 0
+     * otherwise.
+     */
+    FD_EXPORT std::array<size_t, ValueTypeCount> getLiveValueCounts();
+
+    constexpr bool isValueTrackingEnabled()
+    {
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+} // namespace FDCore
+
+#endif // FDCORE_MEMORYUSAGE_H
@@ -0,0 +1,145 @@
+#ifndef FDCORE_OBJECTSHAPE_H
+#define FDCORE_OBJECTSHAPE_H
+
+#include <FDCore/DynamicVariable/AbstractObjectValue.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
+
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Immutable, shared layout of the members of an object.
+     *
+     * A shape maps each member name to a slot index. Shapes are interned through transitions:
+     * adding the same key to the same shape returns the same shape while it is used, so objects
+     * built with the same members in the same order share a single key table. Member names are
+     * detached InternedString shared by a shape and the shapes derived from it.
+     *
+     * A shape keeps its parent alive but only holds weak transitions to its children, a shape
+     * is released with the last object using it. The shapes are bounded: an object with more
+     * than MaxKeys members, or adding a key to a shape with MaxTransitions children, is meant to
+     * store its members in a dictionary instead, see ShapedObjectValue.
+     */
+    class ObjectShape : public std::enable_shared_from_this<ObjectShape>
+    {
+      public:
+        typedef std::shared_ptr<const ObjectShape> Ptr;
+        typedef AbstractObjectValue::StringType StringType;
+        typedef AbstractObjectValue::StringViewType StringViewType;
+        typedef size_t SizeType;
+
+        static constexpr SizeType npos = static_cast<SizeType>(-1);
+        static constexpr SizeType MaxKeys = 64;
+        static constexpr SizeType MaxTransitions = 64;
+
+      private:
+        Ptr m_parent;
+        std::vector<InternedString> m_keys;
+        std::unordered_map<StringViewType, SizeType> m_indices;
+
+        mutable std::shared_mutex m_transitionMutex;
+        mutable std::unordered_map<InternedString, std::weak_ptr<const ObjectShape>> m_transitions;
+
+      public:
+        ObjectShape() = default;
+
+        /**
+         * @brief Creates the shape with the members of parent followed by key, its index is
+         * extended from the one of parent
+         */
+        ObjectShape(Ptr parent, InternedString key);
+        ObjectShape(const ObjectShape &) = delete;
+        ObjectShape(ObjectShape &&) = delete;
+
+        ~ObjectShape() = default;
+
+        ObjectShape &operator=(const ObjectShape &) = delete;
+        ObjectShape &operator=(ObjectShape &&) = delete;
+
+        /**
+         * @brief The shared shape without any member, every interned shape derives from it
+         */
+        static const Ptr &root();
+
+        /**
+         * @brief Gets the interned shape whose members are keys, in this order. The shape is
+         * not interned when the transitions are full, it is still valid.
+         */
+        static Ptr fromKeys(const std::vector<StringType> &keys);
+
+        SizeType size() const { return m_keys.size(); }
+        bool isEmpty() const { return m_keys.empty(); }
+
+        const std::vector<InternedString> &getKeys() const { return m_keys; }
+        const InternedString &getKey(SizeType index) const { return m_keys[index]; }
+
+        /**
+         * @brief Gets the slot index of key, or npos if the shape has no such member
+         */
+        SizeType indexOf(StringViewType key) const
+        {
+            if(m_keys.size() <= LinearSearchLimit)
+            {
+                for(SizeType i = 0, imax = m_keys.size(); i < imax; ++i)
+                {
+                    if(m_keys[i] == key)
+                        return i;
+                }
+
+                return npos;
+            }
+
+            auto it = m_indices.find(key);
+            return it == m_indices.end() ? npos : it->second;
+        }
+
+        /**
+         * @brief Same as indexOf(StringViewType), a handle on the entry of a key is compared by
+         * address
+         */
+        SizeType indexOf(const InternedString &key) const
+        {
+            if(m_keys.size() <= LinearSearchLimit)
+            {
+                for(SizeType i = 0, imax = m_keys.size(); i < imax; ++i)
+                {
+                    if(m_keys[i] == key)
+                        return i;
+                }
+
+                return npos;
+            }
+
+            auto it = m_indices.find(key.view());
+            return it == m_indices.end() ? npos : it->second;
+        }
+
+        bool hasKey(StringViewType key) const { return indexOf(key) != npos; }
+
+        /**
+         * @brief Gets the shape with the members of this one followed by key
+         *
+         * @return nullptr if the shape would have more than MaxKeys members or this one has
+         * MaxTransitions children already
+         */
+        Ptr withKey(StringViewType key) const;
+
+        /**
+         * @brief Gets the shape with the members of this one except key
+         *
+         * @return nullptr if the shape cannot be rebuilt, see withKey()
+         */
+        Ptr withoutKey(StringViewType key) const;
+
+      private:
+        static constexpr SizeType LinearSearchLimit = 8;
+
+        Ptr derive(StringViewType key, bool isRequired) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_OBJECTSHAPE_H
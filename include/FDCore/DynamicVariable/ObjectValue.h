@@ -7,48 +7,131 @@
 #endif // FDCORE_MAP_TYPE
 
 #include <FDCore/DynamicVariable/AbstractValue.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
 
 namespace FDCore
 {
+    /**
+     * @brief Object storing its members in a map keyed by their names
+     *
+     * Keys are detached strings owned by the object unless an interner is given, which must
+     * outlive the object and then stores each key once. Looking a member up compares the
+     * strings, it never locks the interner.
+     */
     class ObjectValue : public AbstractObjectValue
     {
       public:
-        typedef FDCORE_MAP_TYPE<StringType, AbstractValue::Ptr> ObjectType;
+        typedef FDCORE_MAP_TYPE<InternedString, AbstractValue::Ptr> ObjectType;
 
       private:
         ObjectType m_values;
+        StringInterner *m_interner;
 
       public:
-        ObjectValue() = default;
+        ObjectValue() : m_interner(nullptr) {}
+        explicit ObjectValue(StringInterner &interner) : m_interner(&interner) {}
         ObjectValue(ObjectValue &&) = default;
         ObjectValue(const ObjectValue &) = default;
 
         ~ObjectValue() override = default;
 
-        AbstractValue::Ptr operator[](StringViewType member) override
+        AbstractValue::Ptr copy() const override { return std::make_shared<ObjectValue>(*this); }
+
+        /**
+         * @brief Estimated, each member is counted with the two pointers of overhead of a node
+         * of the map
+         */
+        ValueFootprint getFootprint() const override
+        {
+            typedef ObjectType::value_type MemberType;
+            return { sizeof(*this), m_values.size() * (sizeof(MemberType) + 2 * sizeof(void *)),
+                     0 };
+        }
+
+        AbstractValue::Ptr clone() const override
         {
-            auto it = m_values.find(StringType(member));
-            if(it == m_values.end())
-                return AbstractValue::Ptr();
+            auto result = std::make_shared<ObjectValue>(*this);
+            for(auto &member: result->m_values)
+            {
+                if(member.second)
+                    member.second = member.second->clone();
+            }
 
-            return it->second;
+            return result;
         }
 
+        /**
+         * @brief Gets the interner storing the keys, nullptr if they are detached
+         */
+        StringInterner *getInterner() const { return m_interner; }
+
+        AbstractValue::Ptr operator[](StringViewType member) override { return find(member); }
+
         const AbstractValue::Ptr operator[](StringViewType member) const override
         {
-            auto it = m_values.find(StringType(member));
-            if(it == m_values.end())
-                return AbstractValue::Ptr();
-
-            return it->second;
+            return find(member);
         }
 
         void set(StringViewType key, AbstractValue::Ptr value) override
         {
-            m_values[StringType(key)] = value;
+            const InternedString::Entry probe(key);
+            auto it = m_values.find(InternedString::borrow(probe));
+            if(it != m_values.end())
+                it->second = std::move(value);
+            else if(m_interner)
+                m_values.emplace(m_interner->intern(key), std::move(value));
+            else
+                m_values.emplace(InternedString(key), std::move(value));
+        }
+
+        /**
+         * @brief Same as set(StringViewType, AbstractValue::Ptr), keeping the handle key unless
+         * the keys are interned
+         */
+        void set(const InternedString &key, AbstractValue::Ptr value)
+        {
+            auto it = m_values.find(key);
+            if(it != m_values.end())
+                it->second = std::move(value);
+            else if(m_interner)
+                m_values.emplace(m_interner->intern(key.view()), std::move(value));
+            else
+                m_values.emplace(key, std::move(value));
+        }
+
+        void unset(StringViewType key) override
+        {
+            const InternedString::Entry probe(key);
+            m_values.erase(InternedString::borrow(probe));
         }
 
-        void unset(StringViewType key) override { m_values.erase(StringType(key)); }
+        SizeType size() const override { return m_values.size(); }
+        bool isEmpty() const override { return m_values.empty(); }
+
+        void forEachMember(const MemberFunction &function) const override
+        {
+            for(const auto &member: m_values)
+                function(member.first, member.second);
+        }
+
+        const AbstractValue::Ptr *findSlot(const InternedString &member) const override
+        {
+            auto it = m_values.find(member);
+            return it == m_values.end() ? nullptr : &it->second;
+        }
+
+        const AbstractValue::Ptr *findSlot(StringViewType member) const override
+        {
+            const InternedString::Entry probe(member);
+            return findSlot(InternedString::borrow(probe));
+        }
+
+      private:
+        AbstractValue::Ptr find(StringViewType member) const
+        {
+            const AbstractValue::Ptr *slot = findSlot(member);
+            return slot ? *slot : AbstractValue::Ptr();
+        }
     };
 } // namespace FDCore
 
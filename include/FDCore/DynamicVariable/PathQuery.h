@@ -0,0 +1,191 @@
+#ifndef FDCORE_PATHQUERY_H
+#define FDCORE_PATHQUERY_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
+
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Compiled path to a node of a DynamicVariable tree.
+     *
+     * A path is parsed once and can then be applied to any number of documents. It is written
+     * either as a JSON Pointer ("/items/0/name") or as a JSONPath made of member and index
+     * selectors ("$.items[0].name", "$['first name']"). Member names are interned when the path
+     * is parsed, so each step of the walk is a direct lookup, and the intermediate nodes are
+     * reached without creating any DynamicVariable or copying any shared pointer.
+     */
+    class PathQuery
+    {
+      public:
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+
+        static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+        /**
+         * @brief Step of a path, selecting a member of an object and/or a cell of an array
+         *
+         * A JSON Pointer token such as "0" selects both the member "0" of an object and the
+         * first cell of an array, JSONPath selectors select one or the other.
+         */
+        struct Segment
+        {
+            InternedString member;
+            SizeType index = npos;
+            bool matchesMember = false;
+
+            bool operator==(const Segment &other) const
+            {
+                return matchesMember == other.matchesMember && index == other.index &&
+                       (!matchesMember || member == other.member);
+            }
+
+            bool operator!=(const Segment &other) const { return !(*this == other); }
+        };
+
+      private:
+        std::vector<Segment> m_segments;
+
+      public:
+        PathQuery() = default;
+        PathQuery(const PathQuery &) = default;
+        PathQuery(PathQuery &&) = default;
+
+        /**
+         * @brief Parses expression as a JSONPath if it starts with '$', as a JSON Pointer
+         * otherwise
+         *
+         * @throw std::invalid_argument if expression is not a valid path
+         */
+        explicit PathQuery(StringViewType expression);
+
+        explicit PathQuery(std::vector<Segment> segments) : m_segments(std::move(segments)) {}
+
+        ~PathQuery() = default;
+
+        PathQuery &operator=(const PathQuery &) = default;
+        PathQuery &operator=(PathQuery &&) = default;
+
+        /**
+         * @brief Parses a JSON Pointer (RFC 6901), the empty pointer designates the document
+         *
+         * @throw std::invalid_argument if pointer is not empty and does not start with '/', or
+         * if it contains an invalid escape sequence
+         */
+        static PathQuery fromPointer(StringViewType pointer);
+
+        /**
+         * @brief Parses a JSONPath restricted to the root, member and index selectors:
+         * $, .name, ['name'], ["name"] and [index]
+         *
+         * @throw std::invalid_argument if path does not follow this syntax
+         */
+        static PathQuery fromPath(StringViewType path);
+
+        SizeType size() const { return m_segments.size(); }
+        bool isEmpty() const { return m_segments.empty(); }
+
+        const std::vector<Segment> &getSegments() const { return m_segments; }
+
+        /**
+         * @brief Writes this path as a JSON Pointer
+         */
+        StringType toPointer() const;
+
+        /**
+         * @brief Gets the node designated by this path in document, None if a step of the path
+         * does not exist or goes through a scalar
+         */
+        DynamicVariable get(const DynamicVariable &document) const;
+
+        bool exists(const DynamicVariable &document) const;
+
+        bool operator==(const PathQuery &other) const { return m_segments == other.m_segments; }
+        bool operator!=(const PathQuery &other) const { return m_segments != other.m_segments; }
+
+        /**
+         * @brief Gets the slot of the child of node selected by segment, nullptr if there is no
+         * such child
+         *
+         * @param boxed storage for cells of dense arrays, which are not stored as nodes
+         */
+        static const AbstractValue::Ptr *step(const AbstractValue &node,
+                                              const Segment &segment,
+                                              AbstractValue::Ptr &boxed);
+    };
+
+    /**
+     * @brief Set of paths extracted together from documents in a single walk.
+     *
+     * The paths are merged into a prefix tree, so the common steps of several paths are only
+     * taken once per document.
+     */
+    class PathQueryBatch
+    {
+      public:
+        typedef PathQuery::StringViewType StringViewType;
+        typedef PathQuery::SizeType SizeType;
+
+      private:
+        struct Node
+        {
+            PathQuery::Segment segment;
+            std::vector<SizeType> children;
+            std::vector<SizeType> results;
+        };
+
+        std::vector<Node> m_nodes;
+        SizeType m_size;
+
+      public:
+        PathQueryBatch() : m_nodes(1), m_size(0) {}
+        PathQueryBatch(const PathQueryBatch &) = default;
+        PathQueryBatch(PathQueryBatch &&) = default;
+        explicit PathQueryBatch(const std::vector<PathQuery> &queries);
+
+        ~PathQueryBatch() = default;
+
+        PathQueryBatch &operator=(const PathQueryBatch &) = default;
+        PathQueryBatch &operator=(PathQueryBatch &&) = default;
+
+        /**
+         * @brief Adds query to the batch
+         *
+         * @return the position of its result in the extracted values
+         */
+        SizeType add(const PathQuery &query);
+
+        /**
+         * @brief Parses expression and adds it to the batch, see PathQuery(StringViewType)
+         */
+        SizeType add(StringViewType expression) { return add(PathQuery(expression)); }
+
+        /**
+         * @brief Number of paths in the batch
+         */
+        SizeType size() const { return m_size; }
+        bool isEmpty() const { return m_size == 0; }
+
+        /**
+         * @brief Gets the node designated by each path in document, in the order they were
+         * added, None for the paths that do not exist
+         */
+        std::vector<DynamicVariable> extract(const DynamicVariable &document) const;
+
+        /**
+         * @brief Same as extract(const DynamicVariable &) but reuses the storage of results
+         */
+        void extract(const DynamicVariable &document, std::vector<DynamicVariable> &results) const;
+
+      private:
+        void extract(SizeType nodeIndex,
+                     const AbstractValue::Ptr &value,
+                     std::vector<DynamicVariable> &results) const;
+    };
+} // namespace FDCore
+
+#endif // FDCORE_PATHQUERY_H
@@ -0,0 +1,225 @@
+#ifndef FDCORE_SHAPEDOBJECTVALUE_H
+#define FDCORE_SHAPEDOBJECTVALUE_H
+
+#include <FDCore/DynamicVariable/AbstractObjectValue.h>
+#include <FDCore/DynamicVariable/ObjectShape.h>
+#include <FDCore/DynamicVariable/ObjectValue.h>
+
+#include <memory>
+#include <vector>
+
+namespace FDCore
+{
+    /**
+     * @brief Object whose member names are stored in a shared ObjectShape.
+     *
+     * The object itself only owns one value slot per member, records with the same layout share
+     * the same key table. Member access is a lookup in the shape followed by an index.
+     *
+     * An object the shapes do not suit, with too many members or keyed like a map, switches to
+     * dictionary mode for good: its members move to a plain ObjectValue and the object has no
+     * shape anymore.
+     */
+    class ShapedObjectValue : public AbstractObjectValue
+    {
+      public:
+        typedef std::vector<AbstractValue::Ptr> ValueContainerType;
+        typedef ObjectShape::SizeType SizeType;
+
+      private:
+        ObjectShape::Ptr m_shape;
+        ValueContainerType m_values;
+        std::unique_ptr<ObjectValue> m_dictionary;
+
+      public:
+        ShapedObjectValue() : m_shape(ObjectShape::root()) {}
+
+        /**
+         * @brief Creates an object with the members of shape, every member is set to None
+         */
+        explicit ShapedObjectValue(ObjectShape::Ptr shape) :
+            m_shape(std::move(shape)),
+            m_values(m_shape->size())
+        {
+        }
+
+        ShapedObjectValue(ShapedObjectValue &&) = default;
+        ShapedObjectValue(const ShapedObjectValue &other) :
+            AbstractObjectValue(other),
+            m_shape(other.m_shape),
+            m_values(other.m_values),
+            m_dictionary(other.m_dictionary ? std::make_unique<ObjectValue>(*other.m_dictionary)
+                                            : nullptr)
+        {
+        }
+
+        ~ShapedObjectValue() override = default;
+
+        ShapedObjectValue &operator=(ShapedObjectValue &&) = default;
+        ShapedObjectValue &operator=(const ShapedObjectValue &other)
+        {
+            ShapedObjectValue copy(other);
+            return *this = std::move(copy);
+        }
+
+        AbstractValue::Ptr copy() const override
+        {
+            return std::make_shared<ShapedObjectValue>(*this);
+        }
+
+        /**
+         * @brief The shape is shared by every object with the same keys and is not counted
+         */
+        ValueFootprint getFootprint() const override
+        {
+            ValueFootprint result { sizeof(*this), 0, 0 };
+            addContainerFootprint(m_values, result);
+            if(m_dictionary)
+            {
+                const ValueFootprint dictionary = m_dictionary->getFootprint();
+                result.payloadBytes += dictionary.headerBytes + dictionary.payloadBytes;
+                result.slackBytes += dictionary.slackBytes;
+            }
+
+            return result;
+        }
+
+        AbstractValue::Ptr clone() const override
+        {
+            auto result = std::make_shared<ShapedObjectValue>(*this);
+            for(AbstractValue::Ptr &value: result->m_values)
+            {
+                if(value)
+                    value = value->clone();
+            }
+
+            if(m_dictionary)
+            {
+                m_dictionary->forEachMember(
+                  [&result](const InternedString &name, const AbstractValue::Ptr &value) {
+                      result->m_dictionary->set(name, value ? value->clone() : value);
+                  });
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Gets the shape of the object, nullptr in dictionary mode
+         */
+        const ObjectShape::Ptr &getShape() const { return m_shape; }
+
+        bool isDictionary() const { return m_dictionary != nullptr; }
+
+        SizeType size() const override
+        {
+            return m_dictionary ? m_dictionary->size() : m_values.size();
+        }
+
+        bool isEmpty() const override { return size() == 0; }
+
+        void forEachMember(const MemberFunction &function) const override
+        {
+            if(m_dictionary)
+                return m_dictionary->forEachMember(function);
+
+            for(SizeType i = 0, imax = m_values.size(); i < imax; ++i)
+                function(m_shape->getKey(i), m_values[i]);
+        }
+
+        /**
+         * @brief Gets the values in the order of the keys of the shape, empty in dictionary mode
+         */
+        const ValueContainerType &getValues() const { return m_values; }
+
+        AbstractValue::Ptr &at(SizeType index) { return m_values[index]; }
+        const AbstractValue::Ptr &at(SizeType index) const { return m_values[index]; }
+
+        AbstractValue::Ptr operator[](StringViewType member) override
+        {
+            const AbstractValue::Ptr *slot = findSlot(member);
+            return slot ? *slot : AbstractValue::Ptr();
+        }
+
+        const AbstractValue::Ptr operator[](StringViewType member) const override
+        {
+            const AbstractValue::Ptr *slot = findSlot(member);
+            return slot ? *slot : AbstractValue::Ptr();
+        }
+
+        const AbstractValue::Ptr *findSlot(const InternedString &member) const override
+        {
+            if(m_dictionary)
+                return m_dictionary->findSlot(member);
+
+            SizeType index = m_shape->indexOf(member);
+            return index == ObjectShape::npos ? nullptr : &m_values[index];
+        }
+
+        const AbstractValue::Ptr *findSlot(StringViewType member) const override
+        {
+            if(m_dictionary)
+                return m_dictionary->findSlot(member);
+
+            SizeType index = m_shape->indexOf(member);
+            return index == ObjectShape::npos ? nullptr : &m_values[index];
+        }
+
+        void set(StringViewType key, AbstractValue::Ptr value) override
+        {
+            if(m_dictionary)
+                return m_dictionary->set(key, std::move(value));
+
+            SizeType index = m_shape->indexOf(key);
+            if(index != ObjectShape::npos)
+            {
+                m_values[index] = std::move(value);
+                return;
+            }
+
+            ObjectShape::Ptr shape = m_shape->withKey(key);
+            if(!shape)
+            {
+                toDictionary();
+                return m_dictionary->set(key, std::move(value));
+            }
+
+            m_shape = std::move(shape);
+            m_values.push_back(std::move(value));
+        }
+
+        void unset(StringViewType key) override
+        {
+            if(m_dictionary)
+                return m_dictionary->unset(key);
+
+            SizeType index = m_shape->indexOf(key);
+            if(index == ObjectShape::npos)
+                return;
+
+            ObjectShape::Ptr shape = m_shape->withoutKey(key);
+            if(!shape)
+            {
+                toDictionary();
+                return m_dictionary->unset(key);
+            }
+
+            m_shape = std::move(shape);
+            m_values.erase(m_values.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+
+      private:
+        void toDictionary()
+        {
+            auto dictionary = std::make_unique<ObjectValue>();
+            for(SizeType i = 0, imax = m_values.size(); i < imax; ++i)
+                dictionary->set(m_shape->getKey(i), std::move(m_values[i]));
+
+            m_dictionary = std::move(dictionary);
+            m_shape.reset();
+            ValueContainerType().swap(m_values);
+        }
+    };
+} // namespace FDCore
+
+#endif // FDCORE_SHAPEDOBJECTVALUE_H
@@ -0,0 +1,264 @@
+#ifndef FDCORE_STRINGINTERNER_H
+#define FDCORE_STRINGINTERNER_H
+
+#ifndef FDCORE_STRING_TYPE
+    #include <string>
+    #include <string_view>
+    #ifndef FDCORE_USE_WIDE_STRING
+        #define FDCORE_STRING_TYPE std::string
+        #define FDCORE_STRING_VIEW_TYPE std::string_view
+    #else
+        #define FDCORE_STRING_TYPE std::wstring
+        #define FDCORE_STRING_VIEW_TYPE std::wstring_view
+    #endif // FDCORE_USE_WIDE_STRING
+#endif     // FDCORE_STRING_TYPE
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace FDCore
+{
+    class StringInterner;
+
+    /**
+     * @brief Handle on an immutable string, owned by a StringInterner, by the handles
+     * themselves or stored in the handle.
+     *
+     * A handle on a long string is a pointer to its entry, which also stores the hash of the
+     * string. Two handles from the same interner are equal if and only if they point to the
+     * same entry, so comparing and hashing them is O(1). Other handles fall back to comparing
+     * the strings when their hashes match.
+     *
+     * A handle made from a string without an interner is detached. Up to InlineCapacity
+     * characters are stored inline in the handle, without allocating. Longer strings get an
+     * entry that is reference counted and released with the last handle on it. An interned
+     * handle must not outlive the interner that produced it, the global interner lives until
+     * the end of the program.
+     */
+    class InternedString
+    {
+        friend class StringInterner;
+
+      public:
+        typedef FDCORE_STRING_TYPE StringType;
+        typedef FDCORE_STRING_VIEW_TYPE StringViewType;
+        typedef StringType::value_type CharType;
+        typedef size_t SizeType;
+
+        struct Entry
+        {
+            StringType value;
+            size_t hash;
+            bool isDetached = false;
+
+            // handles sharing a detached entry, unused for the entries owned by an interner
+            mutable std::atomic<size_t> references { 0 };
+
+            explicit Entry(StringViewType string) :
+                value(string),
+                hash(std::hash<StringViewType>()(string))
+            {
+            }
+        };
+
+        /**
+         * @brief Longest detached string stored in the handle, the handle is two pointers wide
+         */
+        constexpr static SizeType InlineCapacity = 2 * sizeof(void *) / sizeof(CharType) - 1;
+
+      private:
+        constexpr static CharType EntryTag = static_cast<CharType>(InlineCapacity + 1);
+
+        // inline characters padded with zeros, or the entry pointer, then the number of inline
+        // characters or EntryTag
+        alignas(void *) CharType m_storage[InlineCapacity + 1];
+
+        explicit InternedString(const Entry *entry) : m_storage {} { setEntry(entry); }
+
+      public:
+        InternedString() : m_storage {} {}
+
+        /**
+         * @brief Creates a detached handle holding a copy of value
+         */
+        explicit InternedString(StringViewType value);
+
+        InternedString(InternedString &&other) noexcept
+        {
+            std::memcpy(m_storage, other.m_storage, sizeof(m_storage));
+            std::memset(other.m_storage, 0, sizeof(other.m_storage));
+        }
+
+        InternedString(const InternedString &other)
+        {
+            std::memcpy(m_storage, other.m_storage, sizeof(m_storage));
+            retain();
+        }
+
+        ~InternedString() { release(); }
+
+        InternedString &operator=(InternedString &&other) noexcept
+        {
+            std::swap(m_storage, other.m_storage);
+            return *this;
+        }
+
+        InternedString &operator=(const InternedString &other)
+        {
+            InternedString copy(other);
+            std::swap(m_storage, copy.m_storage);
+            return *this;
+        }
+
+        /**
+         * @brief Gets a handle on entry without owning it, to look up a string that is not
+         * stored. The entry must outlive the handle and its copies.
+         */
+        static InternedString borrow(const Entry &entry) { return InternedString(&entry); }
+
+        /**
+         * @brief Gets the string of a handle on an entry, inline strings have none
+         *
+         * @pre !isInline()
+         */
+        const StringType &str() const { return getEntry()->value; }
+
+        StringViewType view() const
+        {
+            return isInline() ? StringViewType(m_storage, inlineSize()) : getEntry()->value;
+        }
+
+        operator StringViewType() const { return view(); }
+
+        size_t hash() const
+        {
+            return isInline() ? std::hash<StringViewType>()(view()) : getEntry()->hash;
+        }
+
+        SizeType size() const { return isInline() ? inlineSize() : getEntry()->value.size(); }
+        bool isEmpty() const { return size() == 0; }
+        bool isInline() const { return m_storage[InlineCapacity] != EntryTag; }
+
+        /**
+         * @brief Checks if the handle holds its own non-empty string instead of an interned one
+         */
+        bool isDetached() const { return isInline() ? !isEmpty() : getEntry()->isDetached; }
+
+        bool operator==(const InternedString &other) const
+        {
+            // unused inline characters are zeros, equal inline strings have the same bytes
+            if(isInline() && other.isInline())
+                return std::memcmp(m_storage, other.m_storage, sizeof(m_storage)) == 0;
+
+            if(isInline() || other.isInline())
+                return view() == other.view();
+
+            const Entry *entry = getEntry();
+            const Entry *otherEntry = other.getEntry();
+            return entry == otherEntry ||
+                   (entry->hash == otherEntry->hash && entry->value == otherEntry->value);
+        }
+
+        bool operator!=(const InternedString &other) const { return !(*this == other); }
+
+        bool operator==(StringViewType other) const { return view() == other; }
+        bool operator!=(StringViewType other) const { return view() != other; }
+
+        bool operator<(const InternedString &other) const { return view() < other.view(); }
+
+      private:
+        SizeType inlineSize() const { return static_cast<SizeType>(m_storage[InlineCapacity]); }
+
+        const Entry *getEntry() const
+        {
+            const Entry *entry;
+            std::memcpy(&entry, m_storage, sizeof(entry));
+            return entry;
+        }
+
+        void setEntry(const Entry *entry)
+        {
+            std::memcpy(m_storage, &entry, sizeof(entry));
+            m_storage[InlineCapacity] = EntryTag;
+        }
+
+        void retain() const
+        {
+            if(!isInline() && getEntry()->isDetached)
+                getEntry()->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() const
+        {
+            if(isInline())
+                return;
+
+            const Entry *entry = getEntry();
+            if(entry->isDetached && entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete entry;
+        }
+    };
+
+    /**
+     * @brief Thread safe table of unique immutable strings.
+     *
+     * Interning is opt-in: object keys and query names are detached InternedString by default.
+     * The global interner is shared by the whole program and never shrinks, it suits a closed
+     * set of names such as the fields of a schema. Independent interners can be created as
+     * arenas for a group of documents, their strings are released when they are destroyed.
+     * Interned strings are never removed individually.
+     */
+    class StringInterner
+    {
+      public:
+        typedef InternedString::StringType StringType;
+        typedef InternedString::StringViewType StringViewType;
+        typedef size_t SizeType;
+
+      private:
+        std::deque<InternedString::Entry> m_entries;
+        std::unordered_map<StringViewType, const InternedString::Entry *> m_index;
+        mutable std::shared_mutex m_mutex;
+
+      public:
+        StringInterner() = default;
+        StringInterner(const StringInterner &) = delete;
+        StringInterner(StringInterner &&) = delete;
+
+        ~StringInterner() = default;
+
+        StringInterner &operator=(const StringInterner &) = delete;
+        StringInterner &operator=(StringInterner &&) = delete;
+
+        static StringInterner &global();
+
+        /**
+         * @brief Gets the handle on value, adding it to the table if needed
+         */
+        InternedString intern(StringViewType value);
+
+        /**
+         * @brief Gets the handle on value if it has already been interned
+         */
+        std::optional<InternedString> find(StringViewType value) const;
+
+        SizeType size() const;
+    };
+} // namespace FDCore
+
+namespace std
+{
+    template<>
+    struct hash<FDCore::InternedString>
+    {
+        size_t operator()(const FDCore::InternedString &value) const { return value.hash(); }
+    };
+} // namespace std
+
+#endif // FDCORE_STRINGINTERNER_H
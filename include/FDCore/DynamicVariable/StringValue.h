@@ -14,10 +14,20 @@
 #endif     // FDCORE_STRING_TYPE
 
 #include <FDCore/DynamicVariable/AbstractValue.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
+#include <functional>
 #include <utility>
 
 namespace FDCore
 {
+    /**
+     * @brief String value, either owning its characters or holding an interned string.
+     *
+     * Interned values share their storage with every other value interned from the same
+     * interner and compare in O(1) with each other. Mutating an interned value copies the
+     * string back into the value first. A handle with an inline string is copied into the
+     * value, where the short string optimisation of StringType keeps it inline too.
+     */
     class StringValue : public AbstractValue
     {
       public:
@@ -27,63 +37,192 @@ namespace FDCore
 
       private:
         StringType m_value;
+        InternedString m_interned;
 
       public:
-        StringValue() = default;
+        StringValue() : AbstractValue(ValueType::String) {}
         StringValue(StringValue &&) = default;
         StringValue(const StringValue &) = default;
-        explicit StringValue(StringViewType value) : m_value(value) {}
+        explicit StringValue(StringViewType value) :
+            AbstractValue(ValueType::String), m_value(value)
+        {
+        }
+
+        explicit StringValue(InternedString value) : AbstractValue(ValueType::String)
+        {
+            *this = std::move(value);
+        }
 
         ~StringValue() noexcept override = default;
 
-        ValueType getValueType() const override { return ValueType::String; }
+        AbstractValue::Ptr copy() const override { return std::make_shared<StringValue>(*this); }
+
+        /**
+         * @brief The storage of an interned value belongs to its interner and is not counted
+         */
+        ValueFootprint getFootprint() const override;
 
         StringValue &operator=(StringValue &&) = default;
         StringValue &operator=(const StringValue &) = default;
 
-        explicit operator const StringType &() const { return m_value; }
+        explicit operator const StringType &() const { return getString(); }
 
         StringValue &operator=(StringViewType value)
         {
             m_value = value;
+            m_interned = InternedString();
+            return *this;
+        }
+
+        StringValue &operator=(InternedString value)
+        {
+            if(value.isInline())
+            {
+                m_value = value.view();
+                m_interned = InternedString();
+            }
+            else
+            {
+                m_value = StringType();
+                m_interned = std::move(value);
+            }
+
             return *this;
         }
 
-        bool operator==(const StringValue &value) const { return m_value == value.m_value; }
+        bool operator==(const StringValue &value) const
+        {
+            if(isInterned() && value.isInterned())
+                return m_interned == value.m_interned;
+
+            return getString() == value.getString();
+        }
 
-        bool operator==(StringViewType value) const { return m_value == value; }
+        bool operator==(StringViewType value) const { return getString() == value; }
 
-        bool operator!=(const StringValue &value) const { return m_value != value.m_value; }
+        bool operator!=(const StringValue &value) const { return !(*this == value); }
 
-        bool operator!=(StringType value) const { return m_value != value; }
+        bool operator!=(StringType value) const { return getString() != value; }
 
         StringValue &operator+=(StringViewType value)
         {
+            detach();
             m_value += value;
             return *this;
         }
 
         StringValue operator+(StringViewType value) const
         {
-            return StringValue(m_value + value.data());
+            return StringValue(getString() + value.data());
+        }
+
+        SizeType size() const { return getString().size(); }
+        bool isEmpty() const { return getString().empty(); }
+
+        StringType::value_type &operator[](size_t pos)
+        {
+            detach();
+            return m_value[pos];
+        }
+
+        const StringType::value_type &operator[](size_t pos) const { return getString()[pos]; }
+
+        void clear()
+        {
+            m_value.clear();
+            m_interned = InternedString();
+        }
+
+        void append(StringViewType str)
+        {
+            detach();
+            m_value.append(str);
+        }
+
+        StringValue subString(SizeType from, SizeType count) const
+        {
+            return StringValue(getString().substr(from, count));
         }
 
-        SizeType size() const { return m_value.size(); }
-        bool isEmpty() const { return m_value.empty(); }
+        /**
+         * @brief Moves the string out of the value, leaving it empty
+         */
+        StringType release()
+        {
+            detach();
+            StringType result = std::move(m_value);
+            m_value.clear();
+            return result;
+        }
+
+        bool isInterned() const { return !m_interned.isEmpty(); }
+
+        /**
+         * @brief Replaces the owned string by its handle in interner
+         */
+        void intern(StringInterner &interner = StringInterner::global())
+        {
+            if(isInterned())
+                return;
+
+            m_interned = interner.intern(m_value);
+            m_value = StringType();
+        }
 
-        StringType::value_type &operator[](size_t pos) { return m_value[pos]; }
+        /**
+         * @brief Gets the interned string, a detached copy of the value if it is not interned
+         */
+        InternedString getInterned() const
+        {
+            return isInterned() ? m_interned : InternedString(m_value);
+        }
 
-        const StringType::value_type &operator[](size_t pos) const { return m_value[pos]; }
+        size_t hash() const
+        {
+            return isInterned() ? m_interned.hash() : std::hash<StringType>()(m_value);
+        }
 
-        void clear() { m_value.clear(); }
+      private:
+        const StringType &getString() const { return isInterned() ? m_interned.str() : m_value; }
 
-        void append(StringViewType str) { m_value.append(str); }
-        StringValue subString(SizeType from, SizeType count)
+        void detach()
         {
-            return StringValue(m_value.substr(from, count));
+            if(!isInterned())
+                return;
+
+            m_value = m_interned.str();
+            m_interned = InternedString();
         }
     };
 
+    /**
+     * @brief Adds the heap storage of value to footprint, strings small enough to be stored
+     * inside their object have none
+     */
+    inline void addStringFootprint(const StringValue::StringType &value, ValueFootprint &footprint)
+    {
+        typedef StringValue::StringType::value_type CharType;
+        const auto *data = reinterpret_cast<const char *>(value.data());
+        const auto *object = reinterpret_cast<const char *>(&value);
+        if(!std::less<const char *>()(data, object) &&
+           std::less<const char *>()(data, object + sizeof(value)))
+        {
+            return;
+        }
+
+        footprint.payloadBytes += (value.size() + 1) * sizeof(CharType);
+        footprint.slackBytes += (value.capacity() - value.size()) * sizeof(CharType);
+    }
+
+    inline ValueFootprint StringValue::getFootprint() const
+    {
+        ValueFootprint result { sizeof(*this), 0, 0 };
+        if(!isInterned())
+            addStringFootprint(m_value, result);
+
+        return result;
+    }
+
     template<>
     struct is_AbstractValue_constructible<StringValue::StringType>
     {
@@ -103,6 +242,25 @@ namespace FDCore
             return std::nullopt;
         }
     };
+
+    template<>
+    struct is_AbstractValue_constructible<InternedString>
+    {
+        constexpr static bool value = true;
+
+        static AbstractValue::Ptr toValue(const InternedString &value)
+        {
+            return AbstractValue::Ptr(new StringValue(value));
+        }
+
+        static std::optional<InternedString> fromValue(const AbstractValue::Ptr &value)
+        {
+            if(value->isType(ValueType::String))
+                return static_cast<const StringValue &>(*value).getInterned();
+
+            return std::nullopt;
+        }
+    };
 } // namespace FDCore
 
 inline bool operator==(const FDCore::StringValue::StringType &value,
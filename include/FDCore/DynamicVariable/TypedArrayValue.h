@@ -0,0 +1,283 @@
+#ifndef FDCORE_TYPEDARRAYVALUE_H
+#define FDCORE_TYPEDARRAYVALUE_H
+
+#include <FDCore/Common/Span.h>
+#include <FDCore/DynamicVariable/AbstractArrayValue.h>
+#include <FDCore/DynamicVariable/ArrayValue.h>
+#include <FDCore/DynamicVariable/BoolValue.h>
+#include <FDCore/DynamicVariable/FloatValue.h>
+#include <FDCore/DynamicVariable/IntValue.h>
+#include <FDCore/DynamicVariable/StringValue.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace FDCore
+{
+    template<typename T>
+    struct TypedArrayTraits
+    {
+        constexpr static bool value = false;
+    };
+
+    template<>
+    struct TypedArrayTraits<IntValue::IntType>
+    {
+        constexpr static bool value = true;
+        constexpr static ValueType elementType = ValueType::Integer;
+        typedef IntValue::IntType StorageType;
+
+        static StorageType unbox(const AbstractValue &value)
+        {
+            return static_cast<StorageType>(static_cast<const IntValue &>(value));
+        }
+
+        static AbstractValue::Ptr box(StorageType value)
+        {
+            return std::make_shared<IntValue>(value);
+        }
+    };
+
+    template<>
+    struct TypedArrayTraits<FloatValue::FloatType>
+    {
+        constexpr static bool value = true;
+        constexpr static ValueType elementType = ValueType::Float;
+        typedef FloatValue::FloatType StorageType;
+
+        static StorageType unbox(const AbstractValue &value)
+        {
+            return static_cast<StorageType>(static_cast<const FloatValue &>(value));
+        }
+
+        static AbstractValue::Ptr box(StorageType value)
+        {
+            return std::make_shared<FloatValue>(value);
+        }
+    };
+
+    /**
+     * @brief Booleans are stored as bytes, std::vector<bool> cannot be viewed as a Span
+     */
+    template<>
+    struct TypedArrayTraits<bool>
+    {
+        constexpr static bool value = true;
+        constexpr static ValueType elementType = ValueType::Boolean;
+        typedef uint8_t StorageType;
+
+        static StorageType unbox(const AbstractValue &value)
+        {
+            return static_cast<StorageType>(
+              static_cast<bool>(static_cast<const BoolValue &>(value)));
+        }
+
+        static AbstractValue::Ptr box(StorageType value)
+        {
+            return std::make_shared<BoolValue>(value != 0);
+        }
+    };
+
+    template<>
+    struct TypedArrayTraits<StringValue::StringType>
+    {
+        constexpr static bool value = true;
+        constexpr static ValueType elementType = ValueType::String;
+        typedef StringValue::StringType StorageType;
+
+        static StorageType unbox(const AbstractValue &value)
+        {
+            return static_cast<const StorageType &>(static_cast<const StringValue &>(value));
+        }
+
+        static AbstractValue::Ptr box(const StorageType &value)
+        {
+            return std::make_shared<StringValue>(value);
+        }
+    };
+
+    template<typename T>
+    inline constexpr bool is_TypedArray_element_v = TypedArrayTraits<T>::value;
+
+    /**
+     * @brief Array whose cells all have the same scalar type, stored contiguously and unboxed.
+     *
+     * The cells are boxed on access through the AbstractArrayValue interface, bulk operations
+     * should use getSpan() to work on the raw storage.
+     */
+    template<typename T>
+    class TypedArrayValue : public AbstractArrayValue
+    {
+      public:
+        typedef TypedArrayTraits<T> TraitsType;
+        typedef typename TraitsType::StorageType StorageType;
+        typedef std::vector<StorageType> ContainerType;
+
+      private:
+        ContainerType m_values;
+
+      public:
+        TypedArrayValue() = default;
+        TypedArrayValue(TypedArrayValue &&) = default;
+        TypedArrayValue(const TypedArrayValue &) = default;
+        explicit TypedArrayValue(ContainerType &&values) : m_values(std::move(values)) {}
+        explicit TypedArrayValue(const ContainerType &values) : m_values(values) {}
+        TypedArrayValue(std::initializer_list<StorageType> l) : m_values(l) {}
+
+        ~TypedArrayValue() override = default;
+
+        TypedArrayValue &operator=(TypedArrayValue &&) = default;
+        TypedArrayValue &operator=(const TypedArrayValue &) = default;
+
+        explicit operator const ContainerType &() const { return m_values; }
+
+        AbstractValue::Ptr copy() const override
+        {
+            return std::make_shared<TypedArrayValue>(*this);
+        }
+
+        ValueFootprint getFootprint() const override
+        {
+            ValueFootprint result { sizeof(*this), 0, 0 };
+            addContainerFootprint(m_values, result);
+            if constexpr(std::is_same_v<StorageType, StringValue::StringType>)
+            {
+                for(const StorageType &value: m_values)
+                    addStringFootprint(value, result);
+            }
+
+            return result;
+        }
+
+        ValueType getElementType() const override { return TraitsType::elementType; }
+
+        bool accepts(const AbstractValue::Ptr &value) const override
+        {
+            return value && value->isType(TraitsType::elementType);
+        }
+
+        SizeType size() const override { return m_values.size(); }
+        bool isEmpty() const override { return m_values.empty(); }
+
+        AbstractValue::Ptr operator[](SizeType pos) override
+        {
+            return TraitsType::box(m_values[pos]);
+        }
+
+        AbstractValue::Ptr operator[](SizeType pos) const override
+        {
+            return TraitsType::box(m_values[pos]);
+        }
+
+        StorageType &at(SizeType pos) { return m_values[pos]; }
+        const StorageType &at(SizeType pos) const { return m_values[pos]; }
+
+        Span<StorageType, SizeType> getSpan() { return { m_values.size(), m_values.data() }; }
+
+        Span<const StorageType, SizeType> getSpan() const
+        {
+            return { m_values.size(), m_values.data() };
+        }
+
+        void reserve(SizeType capacity) { m_values.reserve(capacity); }
+
+        void push(AbstractValue::Ptr value) override { m_values.push_back(unbox(value)); }
+        void push(StorageType value) { m_values.push_back(std::move(value)); }
+
+        AbstractValue::Ptr pop() override
+        {
+            AbstractValue::Ptr result = TraitsType::box(m_values.back());
+            m_values.pop_back();
+            return result;
+        }
+
+        void insert(AbstractValue::Ptr value, SizeType pos) override
+        {
+            m_values.insert(m_values.begin() + static_cast<std::ptrdiff_t>(pos), unbox(value));
+        }
+
+        AbstractValue::Ptr removeAt(SizeType pos) override
+        {
+            AbstractValue::Ptr result = TraitsType::box(m_values[pos]);
+            m_values.erase(m_values.begin() + static_cast<std::ptrdiff_t>(pos));
+            return result;
+        }
+
+        void clear() override { m_values.clear(); }
+
+        /**
+         * @brief Builds a dense array from array if all its cells have the element type
+         *
+         * @return the dense array, or nullptr if a cell has another type
+         */
+        static std::shared_ptr<TypedArrayValue> fromArray(const AbstractArrayValue &array)
+        {
+            auto result = std::make_shared<TypedArrayValue>();
+            result->m_values.reserve(array.size());
+            for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            {
+                AbstractValue::Ptr cell = array[i];
+                if(!cell || !cell->isType(TraitsType::elementType))
+                    return nullptr;
+
+                result->m_values.push_back(TraitsType::unbox(*cell));
+            }
+
+            return result;
+        }
+
+      private:
+        StorageType unbox(const AbstractValue::Ptr &value) const
+        {
+            if(!accepts(value))
+                throw std::invalid_argument("TypedArrayValue: cannot store a value of type " +
+                                            std::to_string(value ? value->getValueType()
+                                                                 : ValueType::None));
+
+            return TraitsType::unbox(*value);
+        }
+    };
+
+    typedef TypedArrayValue<IntValue::IntType> IntArrayValue;
+    typedef TypedArrayValue<FloatValue::FloatType> FloatArrayValue;
+    typedef TypedArrayValue<bool> BoolArrayValue;
+    typedef TypedArrayValue<StringValue::StringType> StringArrayValue;
+
+    template<typename T>
+    struct is_AbstractValue_constructible<std::vector<T>,
+                                          std::enable_if_t<is_TypedArray_element_v<T>>>
+    {
+        constexpr static bool value = true;
+
+        static AbstractValue::Ptr toValue(const std::vector<T> &value)
+        {
+            typename TypedArrayValue<T>::ContainerType values(value.begin(), value.end());
+            return std::make_shared<TypedArrayValue<T>>(std::move(values));
+        }
+
+        static std::optional<std::vector<T>> fromValue(const AbstractValue::Ptr &value)
+        {
+            if(!value->isType(ValueType::Array))
+                return std::nullopt;
+
+            const auto &arr = static_cast<const AbstractArrayValue &>(*value);
+            if(arr.getElementType() == TypedArrayTraits<T>::elementType)
+            {
+                const auto &values =
+                  static_cast<const typename TypedArrayValue<T>::ContainerType &>(
+                    static_cast<const TypedArrayValue<T> &>(arr));
+                return std::vector<T>(values.begin(), values.end());
+            }
+
+            auto dense = TypedArrayValue<T>::fromArray(arr);
+            if(!dense)
+                return std::nullopt;
+
+            const auto &values =
+              static_cast<const typename TypedArrayValue<T>::ContainerType &>(*dense);
+            return std::vector<T>(values.begin(), values.end());
+        }
+    };
+} // namespace FDCore
+
+#endif // FDCORE_TYPEDARRAYVALUE_H
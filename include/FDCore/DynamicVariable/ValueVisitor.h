@@ -0,0 +1,177 @@
+#ifndef FDCORE_VALUEVISITOR_H
+#define FDCORE_VALUEVISITOR_H
+
+#include <FDCore/DynamicVariable/AbstractArrayValue.h>
+#include <FDCore/DynamicVariable/AbstractObjectValue.h>
+#include <FDCore/DynamicVariable/BoolValue.h>
+#include <FDCore/DynamicVariable/FloatValue.h>
+#include <FDCore/DynamicVariable/FunctionValue.h>
+#include <FDCore/DynamicVariable/IntValue.h>
+#include <FDCore/DynamicVariable/StringValue.h>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace FDCore
+{
+    /**
+     * @brief Node class a visitor receives for each ValueType
+     */
+    template<ValueType type>
+    struct ValueNode
+    {
+        typedef AbstractValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Boolean>
+    {
+        typedef BoolValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Integer>
+    {
+        typedef IntValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Float>
+    {
+        typedef FloatValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::String>
+    {
+        typedef StringValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Function>
+    {
+        typedef FunctionValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Array>
+    {
+        typedef AbstractArrayValue Type;
+    };
+
+    template<>
+    struct ValueNode<ValueType::Object>
+    {
+        typedef AbstractObjectValue Type;
+    };
+
+    constexpr size_t ValueTypeCount = static_cast<size_t>(ValueType::Object) + 1;
+
+    inline ValueType getNodeType(const AbstractValue *node)
+    {
+        return node ? node->getValueType() : ValueType::None;
+    }
+
+    /**
+     * @brief Casts node to the class of type, keeping its constness. None nodes are passed as
+     * nullptr.
+     */
+    template<ValueType type, typename Node>
+    decltype(auto) castNode(Node *node)
+    {
+        if constexpr(type == ValueType::None)
+        {
+            return nullptr;
+        }
+        else
+        {
+            typedef typename ValueNode<type>::Type TargetType;
+            typedef std::conditional_t<std::is_const_v<Node>, const TargetType, TargetType>
+              ResultType;
+            return static_cast<ResultType &>(*node);
+        }
+    }
+
+    /**
+     * @brief Table of the instantiations of a unary visitor, indexed by ValueType
+     */
+    template<typename Visitor, typename Node>
+    struct ValueVisitTable
+    {
+        typedef std::invoke_result_t<Visitor &, std::nullptr_t> ResultType;
+        typedef ResultType (*FunctionType)(Visitor &, Node *);
+
+        template<size_t index>
+        static ResultType call(Visitor &visitor, Node *node)
+        {
+            return visitor(castNode<static_cast<ValueType>(index)>(node));
+        }
+
+        template<size_t... indices>
+        static constexpr std::array<FunctionType, sizeof...(indices)> make(
+          std::index_sequence<indices...>)
+        {
+            return { { &call<indices>... } };
+        }
+
+        static constexpr std::array<FunctionType, ValueTypeCount> table =
+          make(std::make_index_sequence<ValueTypeCount>());
+    };
+
+    /**
+     * @brief Table of the instantiations of a binary visitor, indexed by the pair of ValueTypes
+     */
+    template<typename Visitor, typename LhsNode, typename RhsNode>
+    struct BinaryValueVisitTable
+    {
+        typedef std::invoke_result_t<Visitor &, std::nullptr_t, std::nullptr_t> ResultType;
+        typedef ResultType (*FunctionType)(Visitor &, LhsNode *, RhsNode *);
+
+        template<size_t index>
+        static ResultType call(Visitor &visitor, LhsNode *lhs, RhsNode *rhs)
+        {
+            return visitor(castNode<static_cast<ValueType>(index / ValueTypeCount)>(lhs),
+                           castNode<static_cast<ValueType>(index % ValueTypeCount)>(rhs));
+        }
+
+        template<size_t... indices>
+        static constexpr std::array<FunctionType, sizeof...(indices)> make(
+          std::index_sequence<indices...>)
+        {
+            return { { &call<indices>... } };
+        }
+
+        static constexpr std::array<FunctionType, ValueTypeCount * ValueTypeCount> table =
+          make(std::make_index_sequence<ValueTypeCount * ValueTypeCount>());
+    };
+
+    /**
+     * @brief Calls visitor with node cast to the class of its ValueType
+     *
+     * The visitor must accept every node class (a generic overload is enough) and std::nullptr_t
+     * for None, and return the same type for all of them.
+     */
+    template<typename Visitor, typename Node>
+    decltype(auto) visitValue(Visitor &&visitor, Node *node)
+    {
+        typedef ValueVisitTable<std::remove_reference_t<Visitor>, Node> TableType;
+        return TableType::table[static_cast<size_t>(getNodeType(node))](visitor, node);
+    }
+
+    /**
+     * @brief Calls visitor with both nodes cast to their classes, with a single indirect call
+     */
+    template<typename Visitor, typename LhsNode, typename RhsNode>
+    decltype(auto) visitValues(Visitor &&visitor, LhsNode *lhs, RhsNode *rhs)
+    {
+        typedef BinaryValueVisitTable<std::remove_reference_t<Visitor>, LhsNode, RhsNode>
+          TableType;
+        const size_t index = static_cast<size_t>(getNodeType(lhs)) * ValueTypeCount +
+                             static_cast<size_t>(getNodeType(rhs));
+        return TableType::table[index](visitor, lhs, rhs);
+    }
+} // namespace FDCore
+
+#endif // FDCORE_VALUEVISITOR_H
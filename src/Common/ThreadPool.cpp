@@ -11,7 +11,10 @@ FDCore::ThreadPool::ThreadPool(size_t nbThread) : m_run(true)
 
 FDCore::ThreadPool::~ThreadPool()
 {
-    m_run = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_run = false;
+    }
     m_cond.notify_all();
 
     for(size_t i = 0, imax = m_threads.size(); i < imax; ++i)
@@ -37,14 +40,19 @@ void FDCore::ThreadPool::setNumberOfThreads(size_t nbThreads)
 
 void FDCore::ThreadPool::addThread()
 {
-    m_threads.push_back(
-      std::make_pair(true, std::thread(&ThreadPool::workFunction, this, m_threads.size())));
+    // the slot exists before the thread starts, the workers only read it under the lock
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.emplace_back(true, std::thread());
+    m_threads.back().second = std::thread(&ThreadPool::workFunction, this, m_threads.size() - 1);
 }
 
 void FDCore::ThreadPool::removeThreads(size_t nbThread)
 {
-    for(size_t i = m_threads.size() - 1, imax = i - nbThread; i > imax; --i)
-        m_threads[i].first = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(size_t i = m_threads.size() - 1, imax = i - nbThread; i > imax; --i)
+            m_threads[i].first = false;
+    }
 
     m_cond.notify_all();
 
@@ -59,7 +67,7 @@ void FDCore::ThreadPool::removeThreads(size_t nbThread)
 
 void FDCore::ThreadPool::workFunction(size_t threadIndex)
 {
-    while(m_run && m_threads[threadIndex].first)
+    for(;;)
     {
         std::function<void()> task;
         {
@@ -0,0 +1,253 @@
+#include <FDCore/Communication/BufferPool.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    constexpr uint8_t NotPooled = 0xFF;
+} // namespace
+
+struct FDCore::BufferPool::State
+{
+    struct SizeClass
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Buffer>> freeBuffers;
+    };
+
+    std::vector<SizeClass> classes;
+    size_t smallestClassSize;
+    size_t maxCached;
+    size_t threadCacheSize;
+    std::atomic<bool> isClosed;
+
+    State(size_t bufferSize, size_t maxCachedBuffers) :
+        maxCached(maxCachedBuffers),
+        threadCacheSize(std::min(ThreadCacheSize, maxCachedBuffers)),
+        isClosed(false)
+    {
+        size_t largestClassSize = 1;
+        while(largestClassSize < bufferSize)
+            largestClassSize <<= 1;
+
+        smallestClassSize = std::min(MinClassSize, largestClassSize);
+        size_t count = 1;
+        for(size_t size = smallestClassSize; size < largestClassSize; size <<= 1)
+            ++count;
+
+        classes = std::vector<SizeClass>(count);
+    }
+
+    size_t getClassSize(size_t sizeClass) const { return smallestClassSize << sizeClass; }
+
+    /**
+     * @brief Class of the buffers of size bytes, classes.size() if they are not pooled
+     */
+    size_t findClass(size_t size) const
+    {
+        size_t sizeClass = 0;
+        for(size_t classSize = smallestClassSize; classSize < size; classSize <<= 1)
+        {
+            if(++sizeClass == classes.size())
+                break;
+        }
+
+        return sizeClass;
+    }
+
+    /**
+     * @brief Moves the buffers to the pool, those it has no room for are freed
+     */
+    void store(size_t sizeClass, std::vector<std::unique_ptr<Buffer>> &buffers, size_t count)
+    {
+        SizeClass &target = classes[sizeClass];
+        std::lock_guard<std::mutex> lock(target.mutex);
+        for(; count > 0 && !buffers.empty(); --count)
+        {
+            if(target.freeBuffers.size() < maxCached)
+                target.freeBuffers.push_back(std::move(buffers.back()));
+            buffers.pop_back();
+        }
+    }
+
+    /**
+     * @brief Moves up to count buffers of the pool to buffers
+     */
+    void load(size_t sizeClass, std::vector<std::unique_ptr<Buffer>> &buffers, size_t count)
+    {
+        SizeClass &source = classes[sizeClass];
+        std::lock_guard<std::mutex> lock(source.mutex);
+        for(; count > 0 && !source.freeBuffers.empty(); --count)
+        {
+            buffers.push_back(std::move(source.freeBuffers.back()));
+            source.freeBuffers.pop_back();
+        }
+    }
+};
+
+struct FDCore::BufferPool::ThreadCache
+{
+    struct Entry
+    {
+        std::shared_ptr<State> state;
+        std::vector<std::vector<std::unique_ptr<Buffer>>> classes;
+    };
+
+    std::vector<Entry> entries;
+    bool &isDestroyed;
+
+    explicit ThreadCache(bool &destroyed) : isDestroyed(destroyed) {}
+
+    ~ThreadCache()
+    {
+        isDestroyed = true;
+        for(Entry &entry: entries)
+            flush(entry);
+    }
+
+    static void flush(Entry &entry)
+    {
+        if(entry.state->isClosed)
+            return;
+
+        for(size_t i = 0; i < entry.classes.size(); ++i)
+            entry.state->store(i, entry.classes[i], entry.classes[i].size());
+    }
+
+    /**
+     * @brief Cache of the pool with state, nullptr if there is none and create is false
+     */
+    Entry *find(const std::shared_ptr<State> &state, bool create)
+    {
+        for(auto entry = entries.begin(); entry != entries.end();)
+        {
+            if(entry->state == state)
+                return &*entry;
+
+            // the buffers of a destroyed pool are freed the next time the thread looks up a cache
+            if(entry->state->isClosed)
+                entry = entries.erase(entry);
+            else
+                ++entry;
+        }
+
+        if(!create)
+            return nullptr;
+
+        if(entries.size() == MaxThreadCachedPools)
+        {
+            flush(entries.front());
+            entries.erase(entries.begin());
+        }
+
+        entries.push_back({ state, std::vector<std::vector<std::unique_ptr<Buffer>>>(
+                                     state->classes.size()) });
+        return &entries.back();
+    }
+};
+
+FDCore::BufferPool::Buffer::Buffer(size_t size, uint8_t sizeClass) :
+    data(new uint8_t[size]),
+    capacity(size),
+    m_references(1),
+    m_sizeClass(sizeClass)
+{
+}
+
+FDCore::BufferPool::BufferPool(size_t bufferSize, size_t maxCached) :
+    m_state(std::make_shared<State>(std::max<size_t>(bufferSize, 1), maxCached)),
+    m_bufferSize(std::max<size_t>(bufferSize, 1))
+{
+}
+
+FDCore::BufferPool::~BufferPool() { m_state->isClosed = true; }
+
+FDCore::BufferPool::BufferPtr FDCore::BufferPool::acquire(size_t minimumSize)
+{
+    const size_t size = minimumSize == 0 ? m_bufferSize : minimumSize;
+    const size_t sizeClass = m_state->findClass(size);
+    if(sizeClass == m_state->classes.size())
+        return BufferPtr(new Buffer(size, NotPooled));
+
+    std::unique_ptr<Buffer> buffer;
+    ThreadCache *cache = m_state->threadCacheSize > 0 ? getThreadCache() : nullptr;
+    if(cache != nullptr)
+    {
+        std::vector<std::unique_ptr<Buffer>> &buffers =
+          cache->find(m_state, true)->classes[sizeClass];
+        if(buffers.empty())
+            m_state->load(sizeClass, buffers, (m_state->threadCacheSize + 1) / 2);
+
+        if(!buffers.empty())
+        {
+            buffer = std::move(buffers.back());
+            buffers.pop_back();
+        }
+    }
+
+    if(!buffer)
+        buffer.reset(new Buffer(m_state->getClassSize(sizeClass), static_cast<uint8_t>(sizeClass)));
+
+    buffer->m_references.store(1, std::memory_order_relaxed);
+    buffer->m_state = m_state;
+    return BufferPtr(buffer.release());
+}
+
+size_t FDCore::BufferPool::getClassCount() const { return m_state->classes.size(); }
+
+size_t FDCore::BufferPool::getCachedCount() const
+{
+    size_t count = 0;
+    for(State::SizeClass &sizeClass: m_state->classes)
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        count += sizeClass.freeBuffers.size();
+    }
+
+    ThreadCache *cache = getThreadCache();
+    ThreadCache::Entry *entry = cache != nullptr ? cache->find(m_state, false) : nullptr;
+    if(entry != nullptr)
+    {
+        for(const std::vector<std::unique_ptr<Buffer>> &buffers: entry->classes)
+            count += buffers.size();
+    }
+
+    return count;
+}
+
+void FDCore::BufferPool::release(FDCore::BufferPool::Buffer *released)
+{
+    std::unique_ptr<Buffer> buffer(released);
+    const std::shared_ptr<State> state = std::move(buffer->m_state);
+    if(buffer->m_sizeClass == NotPooled || state->isClosed || state->threadCacheSize == 0)
+        return;
+
+    const size_t sizeClass = buffer->m_sizeClass;
+    ThreadCache *cache = getThreadCache();
+    if(cache == nullptr)
+    {
+        // the thread is exiting, the buffer goes straight to the pool
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        buffers.push_back(std::move(buffer));
+        state->store(sizeClass, buffers, 1);
+        return;
+    }
+
+    std::vector<std::unique_ptr<Buffer>> &buffers = cache->find(state, true)->classes[sizeClass];
+    if(buffers.size() >= state->threadCacheSize)
+        state->store(sizeClass, buffers, (state->threadCacheSize + 1) / 2);
+    buffers.push_back(std::move(buffer));
+}
+
+FDCore::BufferPool::ThreadCache *FDCore::BufferPool::getThreadCache()
+{
+    // trivially destructible, so still readable while the cache is destroyed at thread exit
+    thread_local bool isDestroyed = false;
+    if(isDestroyed)
+        return nullptr;
+
+    thread_local ThreadCache cache(isDestroyed);
+    return &cache;
+}
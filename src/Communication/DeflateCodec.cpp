@@ -0,0 +1,173 @@
+#include <FDCore/Communication/DeflateCodec.h>
+
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+struct FDCore::DeflateCodec::State
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<z_stream>> deflaters;
+    std::vector<std::unique_ptr<z_stream>> inflaters;
+    int level;
+
+    explicit State(int compressionLevel) : level(compressionLevel) {}
+
+    ~State()
+    {
+        for(std::unique_ptr<z_stream> &stream: deflaters)
+            deflateEnd(stream.get());
+        for(std::unique_ptr<z_stream> &stream: inflaters)
+            inflateEnd(stream.get());
+    }
+
+    std::unique_ptr<z_stream> acquireDeflater()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!deflaters.empty())
+            {
+                std::unique_ptr<z_stream> stream = std::move(deflaters.back());
+                deflaters.pop_back();
+                return stream;
+            }
+        }
+
+        auto stream = std::make_unique<z_stream>();
+        if(deflateInit2(stream.get(), level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) !=
+           Z_OK)
+            throw std::bad_alloc();
+
+        return stream;
+    }
+
+    std::unique_ptr<z_stream> acquireInflater()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!inflaters.empty())
+            {
+                std::unique_ptr<z_stream> stream = std::move(inflaters.back());
+                inflaters.pop_back();
+                return stream;
+            }
+        }
+
+        auto stream = std::make_unique<z_stream>();
+        if(inflateInit2(stream.get(), -MAX_WBITS) != Z_OK)
+            throw std::bad_alloc();
+
+        return stream;
+    }
+
+    void releaseDeflater(std::unique_ptr<z_stream> stream)
+    {
+        deflateReset(stream.get());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(deflaters.size() < MaxCachedStreams)
+            {
+                deflaters.push_back(std::move(stream));
+                return;
+            }
+        }
+
+        deflateEnd(stream.get());
+    }
+
+    void releaseInflater(std::unique_ptr<z_stream> stream)
+    {
+        inflateReset(stream.get());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(inflaters.size() < MaxCachedStreams)
+            {
+                inflaters.push_back(std::move(stream));
+                return;
+            }
+        }
+
+        inflateEnd(stream.get());
+    }
+};
+
+class FDCore::DeflateCodec::Decompressor : public FDCore::PayloadDecompressor
+{
+  private:
+    std::shared_ptr<State> m_state;
+    std::unique_ptr<z_stream> m_stream;
+    bool m_isFinished;
+
+  public:
+    Decompressor(std::shared_ptr<State> state, FDCore::Span<const uint8_t> dictionary) :
+        m_state(std::move(state)),
+        m_stream(m_state->acquireInflater()),
+        m_isFinished(false)
+    {
+        // a raw stream takes its dictionary before any input
+        if(dictionary.size > 0 &&
+           inflateSetDictionary(m_stream.get(), dictionary.data, dictionary.size) != Z_OK)
+        {
+            m_state->releaseInflater(std::move(m_stream));
+            throw std::invalid_argument("DeflateCodec: invalid dictionary");
+        }
+    }
+
+    ~Decompressor() override { m_state->releaseInflater(std::move(m_stream)); }
+
+    Progress decompress(FDCore::Span<const uint8_t> input, FDCore::Span<uint8_t> output) override
+    {
+        if(m_isFinished)
+            return { 0, 0 };
+
+        m_stream->next_in = const_cast<Bytef *>(input.data);
+        m_stream->avail_in = input.size;
+        m_stream->next_out = output.data;
+        m_stream->avail_out = output.size;
+        const int result = inflate(m_stream.get(), Z_NO_FLUSH);
+        if(result == Z_STREAM_END)
+            m_isFinished = true;
+        else if(result != Z_OK && result != Z_BUF_ERROR)
+            throw std::invalid_argument("DeflateCodec: invalid compressed payload");
+
+        return { input.size - m_stream->avail_in, output.size - m_stream->avail_out };
+    }
+
+    bool isFinished() const override { return m_isFinished; }
+};
+
+FDCore::DeflateCodec::DeflateCodec(int level)
+{
+    if(level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION)
+        throw std::invalid_argument("DeflateCodec: compression level out of range");
+
+    m_state = std::make_shared<State>(level);
+}
+
+size_t FDCore::DeflateCodec::compress(FDCore::Span<const uint8_t> input,
+                                      FDCore::Span<uint8_t> output,
+                                      FDCore::Span<const uint8_t> dictionary) const
+{
+    std::unique_ptr<z_stream> stream = m_state->acquireDeflater();
+    if(dictionary.size > 0)
+        deflateSetDictionary(stream.get(), dictionary.data, dictionary.size);
+
+    stream->next_in = const_cast<Bytef *>(input.data);
+    stream->avail_in = input.size;
+    stream->next_out = output.data;
+    stream->avail_out = output.size;
+    const int result = deflate(stream.get(), Z_FINISH);
+    const size_t written = result == Z_STREAM_END ? stream->total_out : 0;
+
+    m_state->releaseDeflater(std::move(stream));
+    return written;
+}
+
+std::unique_ptr<FDCore::PayloadDecompressor> FDCore::DeflateCodec::createDecompressor(
+  FDCore::Span<const uint8_t> dictionary) const
+{
+    return std::make_unique<Decompressor>(m_state, dictionary);
+}
@@ -0,0 +1,40 @@
+#include <FDCore/Communication/Message.h>
+
+#include <stdexcept>
+#include <utility>
+
+FDCore::Message::Message(FDCore::BufferPool::BufferPtr buffer,
+                         FDCore::Span<const uint8_t> frame,
+                         const FDCore::MessageHeaderLimits &limits) :
+    m_buffer(std::move(buffer)),
+    m_frame(frame)
+{
+    if(!m_header.parse(frame, limits))
+        throw std::invalid_argument("Message: incomplete frame");
+    if(static_cast<uint64_t>(m_header.getHeaderLength()) + m_header.getPayloadLength() !=
+       frame.size)
+        throw std::invalid_argument("Message: frame length does not match its header");
+}
+
+void FDCore::Message::setRequestId(uint32_t requestId)
+{
+    // the frame is read-only for the readers of the message, the buffer itself is writable
+    uint8_t *frame = m_buffer->data.get() + (m_frame.data - m_buffer->data.get());
+    WireFormat::storeUint32(frame + WireFormat::RequestIdOffset, requestId);
+}
+
+FDCore::Message FDCore::Message::encode(FDCore::BufferPool &pool,
+                                        uint8_t type,
+                                        const FDCore::MessageHeader &header,
+                                        FDCore::Span<const uint8_t> payload)
+{
+    const size_t length = header.size() + payload.size;
+    if(length > UINT32_MAX)
+        throw std::length_error("Message::encode: message longer than 4 GiB");
+
+    BufferPool::BufferPtr buffer = pool.acquire(length);
+    const Span<uint8_t> output { static_cast<uint32_t>(length), buffer->data.get() };
+    header.write(output, payload);
+    output.data[WireFormat::TypeOffset] = type;
+    return Message(std::move(buffer), output);
+}
@@ -0,0 +1,161 @@
+#include <FDCore/Communication/MessageClient.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+    constexpr size_t MaxVectors = 64;
+} // namespace
+
+FDCore::MessageClient::MessageClient(FDCore::Socket socket, size_t window) :
+    m_socket(std::move(socket)),
+    m_decoder(m_pool),
+    m_window(window > 0 ? window : 1),
+    m_inFlight(0),
+    m_nextRequestId(1)
+{
+}
+
+uint32_t FDCore::MessageClient::send(FDCore::Request &request)
+{
+    send({ 1, &request });
+    return request.getRequestId();
+}
+
+void FDCore::MessageClient::send(FDCore::Span<FDCore::Request, size_t> requests)
+{
+    size_t next = 0;
+    while(next < requests.size)
+    {
+        while(m_inFlight >= m_window)
+        {
+            Response response = read();
+            const uint32_t requestId = response.getRequestId();
+            m_arrived.emplace(requestId, std::move(response));
+        }
+
+        const size_t count = std::min(m_window - m_inFlight, requests.size - next);
+        for(size_t i = 0; i < count; ++i)
+            requests[next + i].setRequestId(m_nextRequestId++);
+
+        write({ count, requests.data + next });
+        m_inFlight += count;
+        next += count;
+    }
+}
+
+FDCore::Response FDCore::MessageClient::receive(uint32_t requestId)
+{
+    for(;;)
+    {
+        auto arrived = m_arrived.find(requestId);
+        if(arrived != m_arrived.end())
+        {
+            Response response = std::move(arrived->second);
+            m_arrived.erase(arrived);
+            return response;
+        }
+
+        if(m_inFlight == 0)
+            throw std::invalid_argument("MessageClient::receive: request " +
+                                        std::to_string(requestId) + " is not in flight");
+
+        Response response = read();
+        if(response.getRequestId() == requestId)
+            return response;
+
+        m_arrived.emplace(response.getRequestId(), std::move(response));
+    }
+}
+
+FDCore::Response FDCore::MessageClient::receive()
+{
+    if(!m_arrived.empty())
+    {
+        auto arrived = m_arrived.begin();
+        Response response = std::move(arrived->second);
+        m_arrived.erase(arrived);
+        return response;
+    }
+
+    if(m_inFlight == 0)
+        throw std::runtime_error("MessageClient::receive: no request in flight");
+
+    return read();
+}
+
+void FDCore::MessageClient::write(FDCore::Span<FDCore::Request, size_t> requests)
+{
+    iovec vectors[MaxVectors];
+    size_t next = 0;
+    while(next < requests.size)
+    {
+        const size_t count = std::min(MaxVectors, requests.size - next);
+        for(size_t i = 0; i < count; ++i)
+        {
+            const Span<const uint8_t> frame = requests[next + i].getFrame();
+            vectors[i].iov_base = const_cast<uint8_t *>(frame.data);
+            vectors[i].iov_len = frame.size;
+        }
+        next += count;
+
+        iovec *current = vectors;
+        size_t remaining = count;
+        while(remaining > 0)
+        {
+            msghdr message {};
+            message.msg_iov = current;
+            message.msg_iovlen = remaining;
+            ssize_t written = sendmsg(m_socket.getDescriptor(), &message, MSG_NOSIGNAL);
+            if(written < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "MessageClient::send");
+            }
+
+            while(remaining > 0 && static_cast<size_t>(written) >= current->iov_len)
+            {
+                written -= static_cast<ssize_t>(current->iov_len);
+                ++current;
+                --remaining;
+            }
+            if(remaining > 0)
+            {
+                current->iov_base = static_cast<uint8_t *>(current->iov_base) + written;
+                current->iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+}
+
+FDCore::Response FDCore::MessageClient::read()
+{
+    Response response;
+    while(!m_decoder.next(response))
+    {
+        const Span<uint8_t> space = m_decoder.prepare();
+        const ssize_t count = ::read(m_socket.getDescriptor(), space.data, space.size);
+        if(count < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "MessageClient::receive");
+        }
+        if(count == 0)
+            throw std::runtime_error("MessageClient::receive: connection closed by the server");
+
+        m_decoder.commit(static_cast<size_t>(count));
+    }
+
+    --m_inFlight;
+    return response;
+}
@@ -0,0 +1,93 @@
+#include <FDCore/Communication/MessageDecoder.h>
+#include <FDCore/Communication/WireFormat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+FDCore::MessageDecoder::MessageDecoder(FDCore::BufferPool &pool,
+                                       uint32_t maxMessageSize,
+                                       const FDCore::MessageHeaderLimits &limits) :
+    m_pool(pool),
+    m_begin(0),
+    m_end(0),
+    m_maxMessageSize(maxMessageSize),
+    m_limits(limits)
+{
+}
+
+FDCore::Span<uint8_t> FDCore::MessageDecoder::prepare()
+{
+    const size_t pending = m_end - m_begin;
+    const size_t length = messageLength();
+
+    // room for the rest of the current message, or for a read of a useful size
+    const size_t minimumRead = std::min(MinimumReadSize, m_pool.getBufferSize() / 2 + 1);
+    const size_t required = length > pending ? length : pending + minimumRead;
+
+    // full-size buffers, so that one read takes in as many small messages as possible
+    const size_t acquired = std::max(required, m_pool.getBufferSize());
+
+    if(!m_buffer)
+    {
+        m_buffer = m_pool.acquire(acquired);
+        m_begin = m_end = 0;
+    }
+    else if(pending == 0 && m_buffer.use_count() == 1)
+    {
+        m_begin = m_end = 0;
+    }
+
+    if(m_buffer->capacity - m_begin < required)
+    {
+        if(m_buffer.use_count() == 1 && m_buffer->capacity >= required)
+        {
+            // no message refers to the buffer, the pending bytes are moved to its start
+            memmove(m_buffer->data.get(), m_buffer->data.get() + m_begin, pending);
+        }
+        else
+        {
+            BufferPool::BufferPtr buffer = m_pool.acquire(acquired);
+            if(pending > 0)
+                memcpy(buffer->data.get(), m_buffer->data.get() + m_begin, pending);
+            m_buffer = std::move(buffer);
+        }
+
+        m_begin = 0;
+        m_end = pending;
+    }
+
+    return { static_cast<uint32_t>(std::min<size_t>(m_buffer->capacity - m_end, UINT32_MAX)),
+             m_buffer->data.get() + m_end };
+}
+
+size_t FDCore::MessageDecoder::messageLength() const
+{
+    if(m_end - m_begin < WireFormat::PreambleSize)
+        return 0;
+
+    const uint8_t *preamble = m_buffer->data.get() + m_begin;
+    const uint32_t headerLength =
+      WireFormat::loadUint32(preamble + WireFormat::HeaderLengthOffset);
+    const uint32_t payloadLength =
+      WireFormat::loadUint32(preamble + WireFormat::PayloadLengthOffset);
+    if(headerLength < WireFormat::PreambleSize)
+        throw std::invalid_argument("MessageDecoder: header length shorter than the preamble");
+    if(headerLength > m_limits.maxHeaderLength)
+        throw std::length_error("MessageDecoder: header of " + std::to_string(headerLength) +
+                                " bytes longer than " + std::to_string(m_limits.maxHeaderLength));
+
+    const uint64_t length = static_cast<uint64_t>(headerLength) + payloadLength;
+    if(length > m_maxMessageSize)
+        throw std::length_error("MessageDecoder: message of " + std::to_string(length) +
+                                " bytes longer than " + std::to_string(m_maxMessageSize));
+
+    return static_cast<size_t>(length);
+}
+
+size_t FDCore::MessageDecoder::completeMessageLength() const
+{
+    const size_t length = messageLength();
+    return length > 0 && m_end - m_begin >= length ? length : 0;
+}
@@ -1,69 +1,123 @@
 #include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+#include <FDCore/Communication/WireFormat.h>
+
 #include <cstring>
-#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
 bool FDCore::MessageHeader::hasField(std::string_view name) const
 {
-    return m_fields.find(name.data()) != m_fields.end();
+    return m_fields.find(std::string(name)) != m_fields.end();
 }
 
 const std::vector<uint8_t> &FDCore::MessageHeader::getFiled(std::string_view name) const
 {
-    return m_fields.find(name.data())->second;
+    return m_fields.find(std::string(name))->second.value;
 }
 
-void FDCore::MessageHeader::setFiled(std::string_view name, const FDCore::Span<uint8_t> &value)
+void FDCore::MessageHeader::setFiled(std::string_view name,
+                                     const FDCore::Span<const uint8_t> &value)
 {
-    m_fields[name.data()] = std::vector<uint8_t>(value.data, value.data + value.size);
+    if(name.find('\0') != std::string_view::npos)
+        throw std::invalid_argument("MessageHeader::setFiled: field name with a NUL byte");
+
+    m_fields[std::string(name)] = { std::vector<uint8_t>(value.data, value.data + value.size),
+                                    WireFormat::findFieldKey(name) };
 }
 
 size_t FDCore::MessageHeader::size() const
 {
-    return std::accumulate(
-      m_fields.begin(), m_fields.end(), size_t(4),
-      [](size_t total, const std::pair<std::string, std::vector<uint8_t>> &field) -> size_t {
-          return total + field.first.size() + 1 + field.second.size();
-      });
+    size_t total = WireFormat::PreambleSize;
+    for(const auto &[name, field]: m_fields)
+    {
+        total += WireFormat::varintSize(field.key);
+        if(field.key == 0)
+            total += WireFormat::varintSize(static_cast<uint32_t>(name.size())) + name.size();
+        total += WireFormat::varintSize(static_cast<uint32_t>(field.value.size())) +
+                 field.value.size();
+    }
+
+    return total;
 }
 
-uint32_t FDCore::MessageHeader::write(FDCore::Span<uint8_t> &output, uint32_t payloadLength)
+uint32_t FDCore::MessageHeader::write(const FDCore::Span<uint8_t> &output) const
 {
-    uint8_t *current = output.data + 5;
-    memcpy(current, &payloadLength, 4);
-    for(auto &field: m_fields)
-    {
-        uint32_t s = static_cast<uint32_t>(field.first.size()) + 1;
-        memcpy(current, field.first.data(), s);
-        current += s;
-        s = field.second.size();
-        memcpy(current, &s, 4);
-        current += 4;
-        memcpy(current, field.second.data(), s);
-        current += s;
-    }
+    return writeHeader(output, m_payloadLength);
+}
+
+uint32_t FDCore::MessageHeader::write(const FDCore::Span<uint8_t> &output,
+                                      const FDCore::Span<const uint8_t> &payload) const
+{
+    const uint32_t headerLength = writeHeader(output, payload.size);
+    if(output.size - headerLength < payload.size)
+        throw std::length_error("MessageHeader::write: output too small for the payload");
+    if(payload.size > 0)
+        memcpy(output.data + headerLength, payload.data, payload.size);
+
+    return headerLength + payload.size;
+}
+
+int FDCore::MessageHeader::gather(const FDCore::Span<uint8_t> &headerBuffer,
+                                  const FDCore::Span<const uint8_t> &payload,
+                                  IoVectors &vectors) const
+{
+    const uint32_t headerLength = writeHeader(headerBuffer, payload.size);
+    vectors[0].iov_base = headerBuffer.data;
+    vectors[0].iov_len = headerLength;
+    if(payload.size == 0)
+        return 1;
 
-    uint32_t length = current - output.data;
-    memcpy(output.data + 1, &length, 4);
-    return length;
+    vectors[1].iov_base = const_cast<uint8_t *>(payload.data);
+    vectors[1].iov_len = payload.size;
+    return 2;
 }
 
-uint32_t FDCore::MessageHeader::read(const FDCore::Span<uint8_t> &input)
+uint32_t FDCore::MessageHeader::read(const FDCore::Span<const uint8_t> &input,
+                                     const FDCore::MessageHeaderLimits &limits)
 {
-    uint32_t headerLength = 0;
-    const uint8_t *headerData = input.data + 9;
-    memcpy(&headerLength, input.data + 1, 4);
-    uint32_t offset = 0;
-    while(offset < headerLength)
+    MessageHeaderView view;
+    if(!view.parse(input, limits))
+        return 0;
+
+    *this = view.toHeader();
+    return view.getHeaderLength();
+}
+
+uint32_t FDCore::MessageHeader::writeHeader(const FDCore::Span<uint8_t> &output,
+                                            uint32_t payloadLength) const
+{
+    const size_t headerLength = size();
+    if(headerLength > std::numeric_limits<uint32_t>::max())
+        throw std::length_error("MessageHeader::write: header longer than 4 GiB");
+    if(output.size < headerLength)
+        throw std::length_error("MessageHeader::write: output smaller than the header");
+
+    uint8_t *current = output.data;
+    current[WireFormat::TypeOffset] = m_type;
+    WireFormat::storeUint32(current + WireFormat::HeaderLengthOffset,
+                            static_cast<uint32_t>(headerLength));
+    WireFormat::storeUint32(current + WireFormat::PayloadLengthOffset, payloadLength);
+    WireFormat::storeUint32(current + WireFormat::RequestIdOffset, m_requestId);
+    current += WireFormat::PreambleSize;
+
+    for(const auto &[name, field]: m_fields)
     {
-        std::string name(reinterpret_cast<const char *>(headerData) + offset);
-        offset += name.size() + 1;
-        uint32_t fieldLength = 0;
-        memcpy(&fieldLength, headerData + offset, 4);
-        offset += 4;
-        m_fields[name] =
-          std::vector<uint8_t>(headerData + offset, headerData + offset + fieldLength);
-        offset += fieldLength;
+        current += WireFormat::storeVarint(current, field.key);
+        if(field.key == 0)
+        {
+            current += WireFormat::storeVarint(current, static_cast<uint32_t>(name.size()));
+            memcpy(current, name.data(), name.size());
+            current += name.size();
+        }
+
+        const std::vector<uint8_t> &value = field.value;
+        current += WireFormat::storeVarint(current, static_cast<uint32_t>(value.size()));
+        if(!value.empty())
+            memcpy(current, value.data(), value.size());
+        current += value.size();
     }
 
-    return offset;
-}
\ No newline at end of file
+    return static_cast<uint32_t>(headerLength);
+}
@@ -0,0 +1,144 @@
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    std::invalid_argument generateFormatError(const std::string &reason, size_t offset)
+    {
+        return std::invalid_argument("MessageHeaderView: " + reason + " at offset " +
+                                     std::to_string(offset));
+    }
+
+    std::length_error generateLimitError(const std::string &what, size_t length, size_t limit)
+    {
+        return std::length_error("MessageHeaderView: " + what + " of " + std::to_string(length) +
+                                 " bytes longer than " + std::to_string(limit));
+    }
+} // namespace
+
+bool FDCore::MessageHeaderView::parse(FDCore::Span<const uint8_t> input,
+                                      const FDCore::MessageHeaderLimits &limits)
+{
+    m_data = nullptr;
+    m_headerLength = 0;
+    m_fieldCount = 0;
+    m_extraFields.clear();
+    if(input.size < WireFormat::PreambleSize)
+        return false;
+
+    const uint32_t headerLength =
+      WireFormat::loadUint32(input.data + WireFormat::HeaderLengthOffset);
+    if(headerLength < WireFormat::PreambleSize)
+        throw generateFormatError("header length shorter than the preamble",
+                                  WireFormat::HeaderLengthOffset);
+    if(headerLength > limits.maxHeaderLength)
+        throw generateLimitError("header", headerLength, limits.maxHeaderLength);
+    if(headerLength > input.size)
+        return false;
+
+    uint32_t fieldCount = 0;
+    uint32_t offset = WireFormat::PreambleSize;
+    while(offset < headerLength)
+    {
+        FieldEntry &entry = fieldCount < InlineFields ? m_fields[fieldCount]
+                                                      : m_extraFields.emplace_back();
+        ++fieldCount;
+        size_t read = WireFormat::loadVarint(input.data + offset, headerLength - offset, entry.key);
+        if(read == 0)
+            throw generateFormatError("invalid field key", offset);
+        offset += static_cast<uint32_t>(read);
+
+        if(entry.key == 0)
+        {
+            read = WireFormat::loadVarint(input.data + offset, headerLength - offset,
+                                          entry.nameLength);
+            if(read == 0)
+                throw generateFormatError("invalid field name length", offset);
+            offset += static_cast<uint32_t>(read);
+
+            if(entry.nameLength > headerLength - offset)
+                throw generateFormatError("field name past the end of the header", offset);
+            if(entry.nameLength > limits.maxNameLength)
+                throw generateLimitError("field name", entry.nameLength, limits.maxNameLength);
+            entry.name = reinterpret_cast<const char *>(input.data) + offset;
+
+            // MessageHeader refuses these names, a parsed header is always convertible
+            if(memchr(entry.name, '\0', entry.nameLength) != nullptr)
+                throw generateFormatError("field name with a NUL byte", offset);
+            offset += entry.nameLength;
+        }
+        else
+        {
+            if(entry.key > WireFormat::FieldNames.size())
+                throw generateFormatError("unknown field key " + std::to_string(entry.key),
+                                          offset);
+
+            const std::string_view name = WireFormat::FieldNames[entry.key - 1];
+            entry.name = name.data();
+            entry.nameLength = static_cast<uint32_t>(name.size());
+        }
+
+        read = WireFormat::loadVarint(input.data + offset, headerLength - offset,
+                                      entry.valueLength);
+        if(read == 0)
+            throw generateFormatError("invalid field value length", offset);
+        offset += static_cast<uint32_t>(read);
+
+        if(entry.valueLength > headerLength - offset)
+            throw generateFormatError("field value past the end of the header", offset);
+        if(entry.valueLength > limits.maxValueLength)
+            throw generateLimitError("field value", entry.valueLength, limits.maxValueLength);
+        entry.valueOffset = offset;
+        offset += entry.valueLength;
+    }
+
+    m_data = input.data;
+    m_headerLength = headerLength;
+    m_fieldCount = fieldCount;
+    return true;
+}
+
+size_t FDCore::MessageHeaderView::find(std::string_view name) const
+{
+    // well-known names are compared by key, unless a peer sent one in full
+    const uint32_t key = WireFormat::findFieldKey(name);
+    for(size_t i = 0; i < m_fieldCount; ++i)
+    {
+        const FieldEntry &entry = getEntry(i);
+        if(key != 0 && entry.key == key)
+            return i;
+        if(entry.key == 0 && entry.nameLength == name.size() &&
+           memcmp(entry.name, name.data(), name.size()) == 0)
+            return i;
+    }
+
+    return npos;
+}
+
+FDCore::MessageHeaderView::FieldValue FDCore::MessageHeaderView::getField(
+  std::string_view name) const
+{
+    const size_t index = find(name);
+    if(index == npos)
+        throw std::out_of_range("MessageHeaderView::getField: no field " + std::string(name));
+
+    return getValue(index);
+}
+
+FDCore::MessageHeader FDCore::MessageHeaderView::toHeader() const
+{
+    MessageHeader header(getPayloadLength());
+    header.setType(getType());
+    header.setRequestId(getRequestId());
+    for(size_t i = 0; i < m_fieldCount; ++i)
+    {
+        if(!header.hasField(getName(i)))
+            header.setFiled(getName(i), getValue(i));
+    }
+
+    return header;
+}
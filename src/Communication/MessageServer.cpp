@@ -0,0 +1,586 @@
+#include <FDCore/Communication/MessageDecoder.h>
+#include <FDCore/Communication/MessageServer.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+    constexpr int MaxEvents = 64;
+    constexpr size_t MaxVectors = 64;
+
+    /**
+     * @brief Reads a connection receives before the loop moves on to the others
+     */
+    constexpr int MaxReadsPerEvent = 16;
+
+    /**
+     * @brief Delay before the listeners paused for lack of descriptors accept again
+     */
+    constexpr int AcceptRetryMilliseconds = 100;
+
+    constexpr size_t RequestTypeCount = static_cast<size_t>(FDCore::RequestType::Delete) + 1;
+
+    FDCore::Response makeErrorResponse(FDCore::BufferPool &pool, std::string_view message)
+    {
+        const FDCore::Span<const uint8_t> payload {
+            static_cast<uint32_t>(message.size()), reinterpret_cast<const uint8_t *>(message.data())
+        };
+        return FDCore::Response::create(pool, FDCore::ResponseStatus::InternalError,
+                                        FDCore::MessageHeader(), payload);
+    }
+} // namespace
+
+struct FDCore::MessageServer::Connection
+{
+    Socket socket;
+    MessageDecoder decoder;
+
+    // the responses ready to be sent, in the order they were completed
+    std::mutex mutex;
+    std::deque<Response> responses;
+    size_t pendingRequests = 0;
+    size_t sentBytes = 0;
+
+    // owned by the event loop
+    bool isPeerClosed = false;
+    bool isClosed = false;
+    bool isBlocked = false;
+    bool isThrottled = false;
+    uint32_t events = EPOLLIN | EPOLLRDHUP;
+
+    Connection(Socket &&connectionSocket, BufferPool &pool) :
+        socket(std::move(connectionSocket)),
+        decoder(pool)
+    {
+    }
+};
+
+FDCore::MessageServer::MessageServer(FDCore::ThreadPool &threadPool, Handler handler) :
+    MessageServer(threadPool,
+                  BatchHandler([handler = std::move(handler)](Span<const Request, size_t> requests,
+                                                              BufferPool &pool) {
+                      std::vector<Response> responses;
+                      responses.reserve(requests.size);
+                      for(const Request &request: requests)
+                      {
+                          try
+                          {
+                              responses.push_back(handler(request, pool));
+                          }
+                          catch(const std::exception &exception)
+                          {
+                              responses.push_back(makeErrorResponse(pool, exception.what()));
+                          }
+                      }
+
+                      return responses;
+                  }))
+{
+}
+
+FDCore::MessageServer::MessageServer(FDCore::ThreadPool &threadPool, BatchHandler handler) :
+    m_threadPool(threadPool),
+    m_handler(std::move(handler)),
+    m_epoll(epoll_create1(EPOLL_CLOEXEC)),
+    m_wakeup(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    m_running(false),
+    m_maxInFlightRequests(DefaultMaxInFlightRequests),
+    m_isAcceptPaused(false),
+    m_pendingTasks(0)
+{
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeup;
+    if(m_epoll < 0 || m_wakeup < 0 || epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event) != 0)
+    {
+        const int error = errno;
+        if(m_epoll >= 0)
+            ::close(m_epoll);
+        if(m_wakeup >= 0)
+            ::close(m_wakeup);
+        throw std::system_error(error, std::generic_category(), "MessageServer");
+    }
+}
+
+FDCore::MessageServer::~MessageServer()
+{
+    stop();
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_tasksDone.wait(lock, [this] { return m_pendingTasks == 0; });
+    }
+
+    for(const std::string &path: m_socketPaths)
+        unlink(path.c_str());
+    ::close(m_wakeup);
+    ::close(m_epoll);
+}
+
+uint16_t FDCore::MessageServer::listenTcp(const std::string &host, uint16_t port)
+{
+    Socket listener = Socket::listenTcp(host, port);
+    const uint16_t localPort = listener.getLocalPort();
+    addListener(std::move(listener));
+    return localPort;
+}
+
+void FDCore::MessageServer::listenUnix(const std::string &path)
+{
+    addListener(Socket::listenUnix(path));
+    m_socketPaths.push_back(path);
+}
+
+void FDCore::MessageServer::setMaxInFlightRequests(size_t count)
+{
+    if(m_running)
+        throw std::logic_error("MessageServer: cannot change the limits while running");
+    if(count == 0)
+        throw std::invalid_argument("MessageServer: the in-flight limit must be positive");
+
+    m_maxInFlightRequests = count;
+}
+
+void FDCore::MessageServer::start()
+{
+    if(m_running.exchange(true))
+        return;
+
+    m_thread = std::thread(&MessageServer::run, this);
+}
+
+void FDCore::MessageServer::stop()
+{
+    if(!m_running.exchange(false))
+        return;
+
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t written = write(m_wakeup, &one, sizeof(one));
+    m_thread.join();
+
+    for(auto &[descriptor, connection]: m_connections)
+    {
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, descriptor, nullptr);
+        connection->isClosed = true;
+        connection->socket.close();
+    }
+    m_connections.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_completedConnections.clear();
+}
+
+void FDCore::MessageServer::addListener(FDCore::Socket socket)
+{
+    if(m_running)
+        throw std::logic_error("MessageServer: cannot listen while running");
+
+    socket.setNonBlocking(true);
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = socket.getDescriptor();
+    if(epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket.getDescriptor(), &event) != 0)
+        throw std::system_error(errno, std::generic_category(), "MessageServer::listen");
+
+    m_listeners.push_back(std::move(socket));
+}
+
+void FDCore::MessageServer::run()
+{
+    epoll_event events[MaxEvents];
+    while(m_running)
+    {
+        int timeout = -1;
+        if(m_isAcceptPaused)
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+              m_acceptResumeTime - std::chrono::steady_clock::now());
+            timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+        }
+
+        const int count = epoll_wait(m_epoll, events, MaxEvents, timeout);
+
+        // a busy loop never times out, the deadline is checked whatever woke it up
+        if(m_isAcceptPaused && std::chrono::steady_clock::now() >= m_acceptResumeTime)
+            setAccepting(true);
+
+        if(count < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            break;
+        }
+
+        for(int i = 0; i < count; ++i)
+        {
+            const int descriptor = events[i].data.fd;
+            if(descriptor == m_wakeup)
+            {
+                uint64_t value;
+                [[maybe_unused]] const ssize_t read = ::read(m_wakeup, &value, sizeof(value));
+
+                std::vector<std::shared_ptr<Connection>> completed;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    completed.swap(m_completedConnections);
+                }
+                for(const std::shared_ptr<Connection> &connection: completed)
+                {
+                    if(!connection->isClosed)
+                        flush(connection);
+                }
+                continue;
+            }
+
+            auto listener = std::find_if(
+              m_listeners.begin(), m_listeners.end(),
+              [descriptor](const Socket &socket) { return socket.getDescriptor() == descriptor; });
+            if(listener != m_listeners.end())
+            {
+                accept(*listener);
+                continue;
+            }
+
+            auto found = m_connections.find(descriptor);
+            if(found == m_connections.end())
+                continue;
+
+            // both directions are shut down, the responses cannot be delivered anymore
+            const std::shared_ptr<Connection> connection = found->second;
+            if(events[i].events & (EPOLLHUP | EPOLLERR))
+            {
+                close(*connection);
+                continue;
+            }
+
+            if(events[i].events & (EPOLLIN | EPOLLRDHUP))
+                receive(connection);
+            if(!connection->isClosed && (events[i].events & EPOLLOUT))
+                flush(connection);
+        }
+    }
+}
+
+void FDCore::MessageServer::accept(const FDCore::Socket &listener)
+{
+    for(;;)
+    {
+        Socket socket(
+          accept4(listener.getDescriptor(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+        if(!socket.isOpen())
+        {
+            if(errno == EINTR || errno == ECONNABORTED || errno == EPROTO)
+                continue;
+
+            // the pending connection stays queued and the listener readable: out of descriptors
+            // or memory, waiting for the next event would spin
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+                setAccepting(false);
+            return;
+        }
+
+        try
+        {
+            socket.setNoDelay(true);
+        }
+        catch(const std::system_error &)
+        {
+        }
+
+        const int descriptor = socket.getDescriptor();
+        auto connection = std::make_shared<Connection>(std::move(socket), m_pool);
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = descriptor;
+        if(epoll_ctl(m_epoll, EPOLL_CTL_ADD, descriptor, &event) == 0)
+            m_connections.emplace(descriptor, std::move(connection));
+    }
+}
+
+void FDCore::MessageServer::setAccepting(bool accepting)
+{
+    if(m_isAcceptPaused != accepting)
+        return;
+
+    if(!accepting)
+    {
+        m_acceptResumeTime =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(AcceptRetryMilliseconds);
+    }
+
+    for(const Socket &listener: m_listeners)
+    {
+        epoll_event event {};
+        event.events = accepting ? static_cast<uint32_t>(EPOLLIN) : 0;
+        event.data.fd = listener.getDescriptor();
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, event.data.fd, &event);
+    }
+    m_isAcceptPaused = !accepting;
+}
+
+void FDCore::MessageServer::receive(const std::shared_ptr<Connection> &connection)
+{
+    // the requests of the same type received by this event are handled together
+    std::array<std::vector<Request>, RequestTypeCount> batches;
+    auto dispatchBatches = [this, &connection, &batches]() {
+        for(std::vector<Request> &batch: batches)
+        {
+            if(!batch.empty())
+                dispatch(connection, std::move(batch));
+            batch.clear();
+        }
+    };
+
+    size_t inFlight;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        inFlight = connection->pendingRequests + connection->responses.size();
+    }
+
+    try
+    {
+        // the requests decoded past the limit wait in the decoder until the connection resumes
+        bool isDrained = false;
+        for(int reads = 0;; ++reads)
+        {
+            Request request;
+            while(inFlight < m_maxInFlightRequests && connection->decoder.next(request))
+            {
+                ++inFlight;
+                std::vector<Request> &batch =
+                  batches[static_cast<size_t>(request.getRequestType())];
+                batch.push_back(std::move(request));
+                if(batch.size() == MaxBatchSize)
+                {
+                    dispatch(connection, std::move(batch));
+                    batch.clear();
+                }
+            }
+
+            connection->isThrottled = inFlight >= m_maxInFlightRequests;
+            if(connection->isThrottled || connection->isPeerClosed || isDrained ||
+               reads == MaxReadsPerEvent)
+                break;
+
+            const Span<uint8_t> space = connection->decoder.prepare();
+            const ssize_t count = read(connection->socket.getDescriptor(), space.data, space.size);
+            if(count < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                if(errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+
+                close(*connection);
+                return;
+            }
+            if(count == 0)
+            {
+                connection->isPeerClosed = true;
+                break;
+            }
+
+            connection->decoder.commit(static_cast<size_t>(count));
+            isDrained = static_cast<size_t>(count) < space.size;
+        }
+    }
+    catch(const std::exception &)
+    {
+        dispatchBatches();
+        close(*connection);
+        return;
+    }
+
+    dispatchBatches();
+    if(connection->isPeerClosed)
+        flush(connection);
+    else
+        watch(*connection);
+}
+
+void FDCore::MessageServer::dispatch(const std::shared_ptr<Connection> &connection,
+                                     std::vector<Request> &&requests)
+{
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        connection->pendingRequests += requests.size();
+    }
+
+    // the guard is released with the task, even when the pool drops it without running it
+    std::shared_ptr<void> guard;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pendingTasks;
+        guard.reset(this, [](MessageServer *server) { server->finishTask(); });
+    }
+
+    auto batch = std::make_shared<std::vector<Request>>(std::move(requests));
+    m_threadPool.enqueue([this, connection, batch, guard]() {
+        std::vector<Response> responses;
+        std::string error;
+        try
+        {
+            responses = m_handler({ batch->size(), batch->data() }, m_pool);
+        }
+        catch(const std::exception &exception)
+        {
+            responses.clear();
+            error = exception.what();
+        }
+
+        responses.resize(batch->size());
+        for(size_t i = 0; i < responses.size(); ++i)
+        {
+            if(!responses[i].isValid())
+                responses[i] = makeErrorResponse(m_pool, error);
+            responses[i].setRequestId((*batch)[i].getRequestId());
+        }
+
+        complete(connection, std::move(responses));
+    });
+}
+
+void FDCore::MessageServer::complete(const std::shared_ptr<Connection> &connection,
+                                     std::vector<Response> &&responses)
+{
+    bool wasIdle;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        wasIdle = connection->responses.empty();
+        for(Response &response: responses)
+            connection->responses.push_back(std::move(response));
+        connection->pendingRequests -= responses.size();
+    }
+
+    // responses already waiting are flushed by the loop, the new ones go with them
+    if(!wasIdle)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completedConnections.push_back(connection);
+    }
+
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t written = write(m_wakeup, &one, sizeof(one));
+}
+
+void FDCore::MessageServer::flush(const std::shared_ptr<Connection> &connection)
+{
+    bool isBlocked = false;
+    bool isDone;
+    size_t inFlight;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        std::deque<Response> &responses = connection->responses;
+        while(!responses.empty())
+        {
+            iovec vectors[MaxVectors];
+            const size_t count = std::min(MaxVectors, responses.size());
+            for(size_t i = 0; i < count; ++i)
+            {
+                const Span<const uint8_t> frame = responses[i].getFrame();
+                const size_t skipped = i == 0 ? connection->sentBytes : 0;
+                vectors[i].iov_base = const_cast<uint8_t *>(frame.data + skipped);
+                vectors[i].iov_len = frame.size - skipped;
+            }
+
+            msghdr message {};
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+            ssize_t written = sendmsg(connection->socket.getDescriptor(), &message, MSG_NOSIGNAL);
+            if(written < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                if(errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    isBlocked = true;
+                    break;
+                }
+
+                responses.clear();
+                connection->isPeerClosed = true;
+                break;
+            }
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                if(static_cast<size_t>(written) < vectors[i].iov_len)
+                {
+                    connection->sentBytes += static_cast<size_t>(written);
+                    break;
+                }
+
+                written -= static_cast<ssize_t>(vectors[i].iov_len);
+                responses.pop_front();
+                connection->sentBytes = 0;
+            }
+        }
+
+        inFlight = connection->pendingRequests + responses.size();
+        isDone = connection->isPeerClosed && inFlight == 0;
+    }
+
+    connection->isBlocked = isBlocked;
+    if(connection->isThrottled && inFlight < m_maxInFlightRequests)
+    {
+        // the requests left in the decoder come first, the socket may have nothing new to read
+        receive(connection);
+    }
+    else if(isDone)
+        close(*connection);
+    else
+        watch(*connection);
+}
+
+void FDCore::MessageServer::watch(Connection &connection)
+{
+    const bool isReading = !connection.isPeerClosed && !connection.isThrottled;
+    uint32_t events = isReading ? EPOLLIN | EPOLLRDHUP : 0;
+    if(connection.isBlocked)
+        events |= EPOLLOUT;
+    if(events == connection.events)
+        return;
+
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = connection.socket.getDescriptor();
+    epoll_ctl(m_epoll, EPOLL_CTL_MOD, event.data.fd, &event);
+    connection.events = events;
+}
+
+void FDCore::MessageServer::close(Connection &connection)
+{
+    if(connection.isClosed)
+        return;
+
+    const int descriptor = connection.socket.getDescriptor();
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, descriptor, nullptr);
+    connection.isClosed = true;
+    connection.socket.close();
+    m_connections.erase(descriptor);
+
+    // a descriptor was released, the listeners short of them may accept again
+    setAccepting(true);
+}
+
+void FDCore::MessageServer::finishTask()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(--m_pendingTasks == 0)
+        m_tasksDone.notify_all();
+}
@@ -0,0 +1,163 @@
+#include <FDCore/Communication/PayloadCompression.h>
+#include <FDCore/Communication/WireFormat.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    FDCore::Span<const uint8_t> toBytes(std::string_view text)
+    {
+        return { static_cast<uint32_t>(text.size()),
+                 reinterpret_cast<const uint8_t *>(text.data()) };
+    }
+
+    uint32_t loadUint32Field(const FDCore::MessageHeaderView &header, std::string_view name)
+    {
+        const FDCore::MessageHeaderView::FieldValue value = header.getField(name);
+        if(value.size != sizeof(uint32_t))
+            throw std::invalid_argument("PayloadCompression: invalid " + std::string(name) +
+                                        " field");
+
+        return FDCore::WireFormat::loadUint32(value.data);
+    }
+} // namespace
+
+FDCore::PayloadCompression::PayloadCompression(std::shared_ptr<const FDCore::PayloadCodec> codec,
+                                               size_t threshold) :
+    m_codecs { std::move(codec) },
+    m_dictionaryId(0),
+    m_threshold(threshold),
+    m_maxDecodedSize(DefaultMaxDecodedSize)
+{
+}
+
+void FDCore::PayloadCompression::addCodec(std::shared_ptr<const FDCore::PayloadCodec> codec)
+{
+    m_codecs.push_back(std::move(codec));
+}
+
+void FDCore::PayloadCompression::addDictionary(uint32_t identifier,
+                                               std::vector<uint8_t> dictionary)
+{
+    if(identifier == 0)
+        throw std::invalid_argument("PayloadCompression: dictionary identifier 0 is reserved");
+
+    m_dictionaries[identifier] = std::move(dictionary);
+}
+
+void FDCore::PayloadCompression::useDictionary(uint32_t identifier)
+{
+    if(identifier != 0 && m_dictionaries.count(identifier) == 0)
+        throw std::invalid_argument("PayloadCompression: unknown dictionary " +
+                                    std::to_string(identifier));
+
+    m_dictionaryId = identifier;
+}
+
+FDCore::Message FDCore::PayloadCompression::encode(FDCore::BufferPool &pool,
+                                                   uint8_t type,
+                                                   const FDCore::MessageHeader &header,
+                                                   FDCore::Span<const uint8_t> payload) const
+{
+    if(payload.size < m_threshold)
+        return Message::encode(pool, type, header, payload);
+
+    MessageHeader compressedHeader(header);
+    const PayloadCodec &codec = *m_codecs.front();
+    compressedHeader.setFiled(ContentEncodingField, toBytes(codec.getName()));
+
+    uint8_t decodedLength[sizeof(uint32_t)];
+    WireFormat::storeUint32(decodedLength, payload.size);
+    compressedHeader.setFiled(DecodedLengthField, { sizeof(decodedLength), decodedLength });
+
+    Span<const uint8_t> dictionary { 0, nullptr };
+    uint8_t dictionaryId[sizeof(uint32_t)];
+    if(m_dictionaryId != 0)
+    {
+        const std::vector<uint8_t> &bytes = m_dictionaries.find(m_dictionaryId)->second;
+        dictionary = { static_cast<uint32_t>(bytes.size()), bytes.data() };
+        WireFormat::storeUint32(dictionaryId, m_dictionaryId);
+        compressedHeader.setFiled(DictionaryIdField, { sizeof(dictionaryId), dictionaryId });
+    }
+
+    // the compressed payload must save at least the bytes of the added fields
+    const size_t headerLength = compressedHeader.size();
+    const size_t savedLength = headerLength - header.size();
+    if(payload.size <= savedLength)
+        return Message::encode(pool, type, header, payload);
+
+    const size_t maxCompressedLength = payload.size - savedLength - 1;
+    BufferPool::BufferPtr buffer = pool.acquire(headerLength + maxCompressedLength);
+    uint8_t *frame = buffer->data.get();
+    const size_t compressedLength = codec.compress(
+      payload, { static_cast<uint32_t>(maxCompressedLength), frame + headerLength }, dictionary);
+    if(compressedLength == 0)
+        return Message::encode(pool, type, header, payload);
+
+    compressedHeader.setPayloadLength(static_cast<uint32_t>(compressedLength));
+    compressedHeader.write({ static_cast<uint32_t>(headerLength), frame });
+    frame[WireFormat::TypeOffset] = type;
+    return Message(std::move(buffer),
+                   { static_cast<uint32_t>(headerLength + compressedLength), frame });
+}
+
+FDCore::BufferSlice FDCore::PayloadCompression::decode(
+  const FDCore::MessageHeaderView &header,
+  FDCore::Span<const uint8_t> payload,
+  FDCore::BufferPool &pool) const
+{
+    const size_t encodingIndex = header.find(ContentEncodingField);
+    if(encodingIndex == MessageHeaderView::npos)
+        return BufferSlice(nullptr, payload);
+
+    const MessageHeaderView::FieldValue encoding = header.getValue(encodingIndex);
+    const std::string_view encodingName(reinterpret_cast<const char *>(encoding.data),
+                                        encoding.size);
+    const PayloadCodec *codec = findCodec(encodingName);
+    if(codec == nullptr)
+        throw std::invalid_argument("PayloadCompression: unknown content encoding " +
+                                    std::string(encodingName));
+
+    if(!header.hasField(DecodedLengthField))
+        throw std::invalid_argument("PayloadCompression: missing decoded-length field");
+    const uint32_t decodedLength = loadUint32Field(header, DecodedLengthField);
+    if(decodedLength > m_maxDecodedSize)
+        throw std::length_error("PayloadCompression: decoded payload of " +
+                                std::to_string(decodedLength) + " bytes is too large");
+
+    Span<const uint8_t> dictionary { 0, nullptr };
+    if(header.hasField(DictionaryIdField))
+    {
+        const uint32_t dictionaryId = loadUint32Field(header, DictionaryIdField);
+        auto found = m_dictionaries.find(dictionaryId);
+        if(found == m_dictionaries.end())
+            throw std::invalid_argument("PayloadCompression: unknown dictionary " +
+                                        std::to_string(dictionaryId));
+        dictionary = { static_cast<uint32_t>(found->second.size()), found->second.data() };
+    }
+
+    BufferPool::BufferPtr buffer = pool.acquire(decodedLength);
+    const Span<uint8_t> output { decodedLength, buffer->data.get() };
+    const std::unique_ptr<PayloadDecompressor> decompressor =
+      codec->createDecompressor(dictionary);
+    const PayloadDecompressor::Progress progress = decompressor->decompress(payload, output);
+    if(!decompressor->isFinished() || progress.consumed != payload.size ||
+       progress.produced != decodedLength)
+        throw std::invalid_argument("PayloadCompression: payload does not match its "
+                                    "decoded-length field");
+
+    return BufferSlice(std::move(buffer), output);
+}
+
+const FDCore::PayloadCodec *FDCore::PayloadCompression::findCodec(std::string_view name) const
+{
+    for(const std::shared_ptr<const PayloadCodec> &codec: m_codecs)
+    {
+        if(codec->getName() == name)
+            return codec.get();
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,33 @@
+#include <FDCore/Communication/PayloadCompression.h>
+#include <FDCore/Communication/Request.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+FDCore::Request::Request(FDCore::BufferPool::BufferPtr buffer,
+                         FDCore::Span<const uint8_t> frame,
+                         const FDCore::MessageHeaderLimits &limits) :
+    Message(std::move(buffer), frame, limits)
+{
+    if(getType() > static_cast<uint8_t>(RequestType::Delete))
+        throw std::invalid_argument("Request: unknown request type " +
+                                    std::to_string(getType()));
+}
+
+FDCore::Request FDCore::Request::create(FDCore::BufferPool &pool,
+                                        FDCore::RequestType type,
+                                        const FDCore::MessageHeader &header,
+                                        FDCore::Span<const uint8_t> payload)
+{
+    return Request(encode(pool, static_cast<uint8_t>(type), header, payload));
+}
+
+FDCore::Request FDCore::Request::create(FDCore::BufferPool &pool,
+                                        FDCore::RequestType type,
+                                        const FDCore::MessageHeader &header,
+                                        FDCore::Span<const uint8_t> payload,
+                                        const FDCore::PayloadCompression &compression)
+{
+    return Request(compression.encode(pool, static_cast<uint8_t>(type), header, payload));
+}
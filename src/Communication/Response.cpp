@@ -0,0 +1,32 @@
+#include <FDCore/Communication/PayloadCompression.h>
+#include <FDCore/Communication/Response.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+FDCore::Response::Response(FDCore::BufferPool::BufferPtr buffer,
+                           FDCore::Span<const uint8_t> frame,
+                           const FDCore::MessageHeaderLimits &limits) :
+    Message(std::move(buffer), frame, limits)
+{
+    if(getType() > static_cast<uint8_t>(ResponseStatus::InternalError))
+        throw std::invalid_argument("Response: unknown status " + std::to_string(getType()));
+}
+
+FDCore::Response FDCore::Response::create(FDCore::BufferPool &pool,
+                                          FDCore::ResponseStatus status,
+                                          const FDCore::MessageHeader &header,
+                                          FDCore::Span<const uint8_t> payload)
+{
+    return Response(encode(pool, static_cast<uint8_t>(status), header, payload));
+}
+
+FDCore::Response FDCore::Response::create(FDCore::BufferPool &pool,
+                                          FDCore::ResponseStatus status,
+                                          const FDCore::MessageHeader &header,
+                                          FDCore::Span<const uint8_t> payload,
+                                          const FDCore::PayloadCompression &compression)
+{
+    return Response(compression.encode(pool, static_cast<uint8_t>(status), header, payload));
+}
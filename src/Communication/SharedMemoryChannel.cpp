@@ -0,0 +1,376 @@
+#include <FDCore/Communication/SharedMemoryChannel.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * @brief Positions and wait state shared by the processes, in front of the ring
+ */
+struct FDCore::SharedMemoryChannel::Control
+{
+    std::atomic<uint64_t> magic;
+    uint64_t capacity;
+
+    // positions since the creation of the channel, the ring offset is position % capacity
+    alignas(64) std::atomic<uint64_t> readPosition;
+    alignas(64) std::atomic<uint64_t> writePosition;
+
+    alignas(64) std::atomic<uint32_t> dataFutex;
+    std::atomic<uint32_t> isConsumerSleeping;
+
+    alignas(64) std::atomic<uint32_t> spaceFutex;
+    std::atomic<uint32_t> areProducersSleeping;
+};
+
+namespace
+{
+    constexpr uint64_t ChannelMagic = 0x4644534D43484E31; // "FDSMCHN1"
+    constexpr size_t ControlSize = 4096;
+    constexpr size_t MinimumCapacity = 4096;
+    constexpr size_t MaximumCapacity = size_t(1) << 30;
+    constexpr uint32_t PaddingFlag = 0x80000000;
+
+    /**
+     * @brief Checks made before sleeping, none on a single CPU where the other side cannot run
+     * while this one spins
+     */
+    const int SpinCount = std::thread::hardware_concurrency() > 1 ? 200 : 0;
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                    std::atomic<uint64_t>::is_always_lock_free,
+                  "atomics shared between processes must be lock-free");
+
+    std::system_error generateSystemError(const char *caller)
+    {
+        return std::system_error(errno, std::generic_category(), caller);
+    }
+
+    /**
+     * @brief Size of the record holding a frame of frameSize bytes, records are 8 bytes aligned
+     */
+    uint32_t recordSizeOf(uint32_t frameSize)
+    {
+        return (static_cast<uint32_t>(FDCore::SharedMemoryChannel::RecordHeaderSize) + frameSize +
+                7) &
+               ~uint32_t(7);
+    }
+
+    uint32_t loadWord(const uint8_t *record)
+    {
+        return __atomic_load_n(reinterpret_cast<const uint32_t *>(record), __ATOMIC_ACQUIRE);
+    }
+
+    void storeWord(uint8_t *record, uint32_t value)
+    {
+        __atomic_store_n(reinterpret_cast<uint32_t *>(record), value, __ATOMIC_RELEASE);
+    }
+
+    inline void relaxCpu()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    void wakeSleepers(std::atomic<uint32_t> &futex, std::atomic<uint32_t> &sleepers)
+    {
+        // pairs with the fence of waitUntil(), one of the sides sees the other. The sleepers
+        // are woken once, then announce themselves again if they go back to sleep.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleepers.load(std::memory_order_relaxed) == 0 ||
+           sleepers.exchange(0, std::memory_order_relaxed) == 0)
+            return;
+
+        futex.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&futex), FUTEX_WAKE, INT_MAX, nullptr,
+                nullptr, 0);
+    }
+
+    template<typename Ready>
+    bool waitUntil(Ready &&ready,
+                   std::atomic<uint32_t> &futex,
+                   std::atomic<uint32_t> &sleepers,
+                   int timeout)
+    {
+        if(ready())
+            return true;
+        if(timeout == 0)
+            return false;
+
+        for(int i = 0; i < SpinCount; ++i)
+        {
+            relaxCpu();
+            if(ready())
+                return true;
+        }
+
+        const auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        for(;;)
+        {
+            const uint32_t value = futex.load(std::memory_order_acquire);
+            sleepers.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool isReady = ready();
+            if(!isReady)
+            {
+                timespec remaining {};
+                timespec *limit = nullptr;
+                if(timeout > 0)
+                {
+                    const auto left = deadline - std::chrono::steady_clock::now();
+                    if(left <= std::chrono::nanoseconds::zero())
+                        return false;
+
+                    const auto nanoseconds =
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+                    remaining.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+                    remaining.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+                    limit = &remaining;
+                }
+
+                syscall(SYS_futex, reinterpret_cast<uint32_t *>(&futex), FUTEX_WAIT, value, limit,
+                        nullptr, 0);
+            }
+
+            if(isReady || ready())
+                return true;
+        }
+    }
+} // namespace
+
+FDCore::SharedMemoryChannel::SharedMemoryChannel(std::string name,
+                                                 void *mapping,
+                                                 size_t mappingSize) :
+    m_name(std::move(name)),
+    m_mapping(mapping),
+    m_mappingSize(mappingSize),
+    m_control(static_cast<Control *>(mapping)),
+    m_ring(static_cast<uint8_t *>(mapping) + ControlSize)
+{
+}
+
+FDCore::SharedMemoryChannel::SharedMemoryChannel(FDCore::SharedMemoryChannel &&other) noexcept :
+    m_name(std::move(other.m_name)),
+    m_mapping(other.m_mapping),
+    m_mappingSize(other.m_mappingSize),
+    m_control(other.m_control),
+    m_ring(other.m_ring)
+{
+    other.m_mapping = nullptr;
+}
+
+FDCore::SharedMemoryChannel::~SharedMemoryChannel()
+{
+    if(m_mapping)
+        munmap(m_mapping, m_mappingSize);
+}
+
+FDCore::SharedMemoryChannel FDCore::SharedMemoryChannel::create(const std::string &name,
+                                                                size_t capacity)
+{
+    static_assert(sizeof(Control) <= ControlSize);
+    if(capacity > MaximumCapacity)
+        throw std::invalid_argument("SharedMemoryChannel::create: capacity larger than 1 GiB");
+
+    size_t ringSize = MinimumCapacity;
+    while(ringSize < capacity)
+        ringSize <<= 1;
+
+    const int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if(descriptor < 0)
+        throw generateSystemError("SharedMemoryChannel::create");
+
+    const size_t mappingSize = ControlSize + ringSize;
+    void *mapping = MAP_FAILED;
+    if(ftruncate(descriptor, static_cast<off_t>(mappingSize)) == 0)
+        mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+    if(mapping == MAP_FAILED)
+    {
+        const std::system_error error = generateSystemError("SharedMemoryChannel::create");
+        ::close(descriptor);
+        shm_unlink(name.c_str());
+        throw error;
+    }
+    ::close(descriptor);
+
+    // the object is zero-filled, the positions and futexes start at 0
+    Control *control = new(mapping) Control();
+    control->capacity = ringSize;
+    control->magic.store(ChannelMagic, std::memory_order_release);
+    return SharedMemoryChannel(name, mapping, mappingSize);
+}
+
+FDCore::SharedMemoryChannel FDCore::SharedMemoryChannel::open(const std::string &name)
+{
+    const int descriptor = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if(descriptor < 0)
+        throw generateSystemError("SharedMemoryChannel::open");
+
+    struct stat status {};
+    void *mapping = MAP_FAILED;
+    if(fstat(descriptor, &status) == 0 && static_cast<size_t>(status.st_size) > ControlSize)
+        mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, descriptor, 0);
+
+    if(mapping == MAP_FAILED)
+    {
+        const int error = errno != 0 ? errno : EINVAL;
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(), "SharedMemoryChannel::open");
+    }
+    ::close(descriptor);
+
+    const size_t mappingSize = static_cast<size_t>(status.st_size);
+    SharedMemoryChannel channel(name, mapping, mappingSize);
+    const Control *control = static_cast<const Control *>(mapping);
+    if(control->magic.load(std::memory_order_acquire) != ChannelMagic ||
+       control->capacity + ControlSize != mappingSize)
+        throw std::invalid_argument("SharedMemoryChannel::open: " + name + " is not a channel");
+
+    return channel;
+}
+
+void FDCore::SharedMemoryChannel::remove(const std::string &name)
+{
+    shm_unlink(name.c_str());
+}
+
+size_t FDCore::SharedMemoryChannel::getCapacity() const
+{
+    return m_control->capacity;
+}
+
+size_t FDCore::SharedMemoryChannel::getMaxFrameSize() const
+{
+    return m_control->capacity / 2 - RecordHeaderSize;
+}
+
+bool FDCore::SharedMemoryChannel::send(const FDCore::MessageHeader &header,
+                                       FDCore::Span<const uint8_t> payload,
+                                       int timeout)
+{
+    const size_t frameSize = header.size() + payload.size;
+    if(frameSize > getMaxFrameSize())
+        throw std::length_error("SharedMemoryChannel::send: frame larger than half the ring");
+
+    Record record;
+    if(!claim(static_cast<uint32_t>(frameSize), timeout, record))
+        return false;
+
+    header.write({ record.size, record.data }, payload);
+    commit(record);
+    return true;
+}
+
+bool FDCore::SharedMemoryChannel::send(const FDCore::Message &message, int timeout)
+{
+    const Span<const uint8_t> frame = message.getFrame();
+    if(frame.size > getMaxFrameSize())
+        throw std::length_error("SharedMemoryChannel::send: frame larger than half the ring");
+
+    Record record;
+    if(!claim(frame.size, timeout, record))
+        return false;
+
+    memcpy(record.data, frame.data, frame.size);
+    commit(record);
+    return true;
+}
+
+bool FDCore::SharedMemoryChannel::claim(uint32_t frameSize, int timeout, Record &record)
+{
+    Control &control = *m_control;
+    const uint64_t capacity = control.capacity;
+    const uint32_t recordSize = recordSizeOf(frameSize);
+
+    auto tryClaim = [&]() {
+        uint64_t position = control.writePosition.load(std::memory_order_relaxed);
+        uint64_t padding;
+        do
+        {
+            // a record is never split, the end of the ring is skipped when it does not fit
+            const uint64_t contiguous = capacity - (position & (capacity - 1));
+            padding = recordSize > contiguous ? contiguous : 0;
+            const uint64_t read = control.readPosition.load(std::memory_order_acquire);
+            if(position + padding + recordSize - read > capacity)
+                return false;
+        } while(!control.writePosition.compare_exchange_weak(
+          position, position + padding + recordSize, std::memory_order_acq_rel,
+          std::memory_order_relaxed));
+
+        if(padding > 0)
+            storeWord(m_ring + (position & (capacity - 1)),
+                      static_cast<uint32_t>(padding) | PaddingFlag);
+
+        uint8_t *header = m_ring + ((position + padding) & (capacity - 1));
+        memcpy(header + 4, &frameSize, 4);
+        record.data = header + RecordHeaderSize;
+        record.size = frameSize;
+        return true;
+    };
+
+    return waitUntil(tryClaim, control.spaceFutex, control.areProducersSleeping, timeout);
+}
+
+void FDCore::SharedMemoryChannel::commit(const Record &record)
+{
+    storeWord(record.data - RecordHeaderSize, recordSizeOf(record.size));
+    wakeSleepers(m_control->dataFutex, m_control->isConsumerSleeping);
+}
+
+bool FDCore::SharedMemoryChannel::peek(Record &record, int timeout)
+{
+    Control &control = *m_control;
+    const uint64_t capacity = control.capacity;
+
+    auto tryPeek = [&]() {
+        for(;;)
+        {
+            const uint64_t position = control.readPosition.load(std::memory_order_relaxed);
+            uint8_t *header = m_ring + (position & (capacity - 1));
+            const uint32_t word = loadWord(header);
+            if(word == 0)
+                return false;
+
+            if((word & PaddingFlag) == 0)
+            {
+                memcpy(&record.size, header + 4, 4);
+                record.data = header + RecordHeaderSize;
+                return true;
+            }
+
+            // the space is zeroed before being given back, an unpublished record reads as 0
+            const uint32_t padding = word & ~PaddingFlag;
+            memset(header, 0, padding);
+            control.readPosition.store(position + padding, std::memory_order_release);
+            wakeSleepers(control.spaceFutex, control.areProducersSleeping);
+        }
+    };
+
+    return waitUntil(tryPeek, control.dataFutex, control.isConsumerSleeping, timeout);
+}
+
+void FDCore::SharedMemoryChannel::release(const Record &record)
+{
+    Control &control = *m_control;
+    const uint32_t recordSize = recordSizeOf(record.size);
+    memset(record.data - RecordHeaderSize, 0, recordSize);
+    control.readPosition.fetch_add(recordSize, std::memory_order_release);
+    wakeSleepers(control.spaceFutex, control.areProducersSleeping);
+}
@@ -0,0 +1,172 @@
+#include <FDCore/Communication/Socket.h>
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace
+{
+    std::system_error generateSystemError(const char *caller)
+    {
+        return std::system_error(errno, std::generic_category(), caller);
+    }
+
+    struct AddressInfo
+    {
+        addrinfo *list = nullptr;
+
+        ~AddressInfo()
+        {
+            if(list)
+                freeaddrinfo(list);
+        }
+    };
+
+    FDCore::Socket openTcp(const char *caller,
+                           const std::string &host,
+                           uint16_t port,
+                           bool passive,
+                           int backlog)
+    {
+        addrinfo hints {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV | (passive ? AI_PASSIVE : 0);
+
+        AddressInfo addresses;
+        const int status =
+          getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses.list);
+        if(status != 0)
+            throw std::invalid_argument(std::string(caller) + ": " + gai_strerror(status));
+
+        const addrinfo *address = addresses.list;
+        FDCore::Socket socket(
+          ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol));
+        if(!socket.isOpen())
+            throw generateSystemError(caller);
+
+        if(passive)
+        {
+            const int enable = 1;
+            setsockopt(socket.getDescriptor(), SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+            if(bind(socket.getDescriptor(), address->ai_addr, address->ai_addrlen) != 0 ||
+               listen(socket.getDescriptor(), backlog) != 0)
+                throw generateSystemError(caller);
+        }
+        else if(connect(socket.getDescriptor(), address->ai_addr, address->ai_addrlen) != 0)
+            throw generateSystemError(caller);
+
+        return socket;
+    }
+
+    FDCore::Socket openUnix(const char *caller, const std::string &path, bool passive, int backlog)
+    {
+        sockaddr_un address {};
+        if(path.size() >= sizeof(address.sun_path))
+            throw std::invalid_argument(std::string(caller) + ": socket path too long");
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        FDCore::Socket socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        if(!socket.isOpen())
+            throw generateSystemError(caller);
+
+        const sockaddr *socketAddress = reinterpret_cast<const sockaddr *>(&address);
+        if(passive)
+        {
+            if(bind(socket.getDescriptor(), socketAddress, sizeof(address)) != 0 ||
+               listen(socket.getDescriptor(), backlog) != 0)
+                throw generateSystemError(caller);
+        }
+        else if(connect(socket.getDescriptor(), socketAddress, sizeof(address)) != 0)
+            throw generateSystemError(caller);
+
+        return socket;
+    }
+} // namespace
+
+FDCore::Socket &FDCore::Socket::operator=(FDCore::Socket &&other) noexcept
+{
+    if(this != &other)
+    {
+        close();
+        m_descriptor = other.release();
+    }
+
+    return *this;
+}
+
+FDCore::Socket FDCore::Socket::listenTcp(const std::string &host, uint16_t port, int backlog)
+{
+    return openTcp("Socket::listenTcp", host, port, true, backlog);
+}
+
+FDCore::Socket FDCore::Socket::listenUnix(const std::string &path, int backlog)
+{
+    return openUnix("Socket::listenUnix", path, true, backlog);
+}
+
+FDCore::Socket FDCore::Socket::connectTcp(const std::string &host, uint16_t port)
+{
+    Socket socket = openTcp("Socket::connectTcp", host, port, false, 0);
+    socket.setNoDelay(true);
+    return socket;
+}
+
+FDCore::Socket FDCore::Socket::connectUnix(const std::string &path)
+{
+    return openUnix("Socket::connectUnix", path, false, 0);
+}
+
+uint16_t FDCore::Socket::getLocalPort() const
+{
+    sockaddr_storage address {};
+    socklen_t length = sizeof(address);
+    if(getsockname(m_descriptor, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+        throw generateSystemError("Socket::getLocalPort");
+
+    if(address.ss_family == AF_INET)
+        return ntohs(reinterpret_cast<const sockaddr_in &>(address).sin_port);
+    if(address.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6 &>(address).sin6_port);
+    return 0;
+}
+
+void FDCore::Socket::setNonBlocking(bool nonBlocking)
+{
+    const int flags = fcntl(m_descriptor, F_GETFL);
+    if(flags < 0 ||
+       fcntl(m_descriptor, F_SETFL, nonBlocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) < 0)
+        throw generateSystemError("Socket::setNonBlocking");
+}
+
+void FDCore::Socket::setNoDelay(bool noDelay)
+{
+    const int enable = noDelay ? 1 : 0;
+    if(setsockopt(m_descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) != 0 &&
+       errno != EOPNOTSUPP && errno != ENOPROTOOPT)
+        throw generateSystemError("Socket::setNoDelay");
+}
+
+int FDCore::Socket::release()
+{
+    const int descriptor = m_descriptor;
+    m_descriptor = -1;
+    return descriptor;
+}
+
+void FDCore::Socket::close()
+{
+    if(m_descriptor >= 0)
+        ::close(m_descriptor);
+    m_descriptor = -1;
+}
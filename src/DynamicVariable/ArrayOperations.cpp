@@ -0,0 +1,724 @@
+#include <FDCore/DynamicVariable/ArrayOperations.h>
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef DynamicVariable::IntType IntType;
+    typedef DynamicVariable::FloatType FloatType;
+    typedef DynamicVariable::SizeType SizeType;
+
+    /**
+     * @brief Numeric scalar or numeric array, viewed as contiguous storage
+     *
+     * Generic arrays are densified on a private copy, arrays mixing integers and floats are
+     * converted to floats. The operand must not be copied once built since its pointers may
+     * refer to the storage it owns.
+     */
+    struct NumericOperand
+    {
+        bool isArray = false;
+        bool isFloat = false;
+        SizeType size = 0;
+        const IntType *ints = nullptr;
+        const FloatType *floats = nullptr;
+        IntType intValue = 0;
+        FloatType floatValue = 0.0;
+
+        DynamicVariable dense;
+        std::vector<FloatType> converted;
+
+        NumericOperand() = default;
+        NumericOperand(const NumericOperand &) = delete;
+        NumericOperand &operator=(const NumericOperand &) = delete;
+    };
+
+    bool loadDenseArray(NumericOperand &operand)
+    {
+        switch(operand.dense.getElementType())
+        {
+            case ValueType::Integer:
+                operand.ints = std::as_const(operand.dense).getSpan<IntType>().data;
+                return true;
+
+            case ValueType::Float:
+                operand.isFloat = true;
+                operand.floats = std::as_const(operand.dense).getSpan<FloatType>().data;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool loadMixedArray(NumericOperand &operand)
+    {
+        operand.converted.reserve(operand.size);
+        for(SizeType i = 0; i < operand.size; ++i)
+        {
+            DynamicVariable cell = operand.dense[i];
+            switch(cell.getValueType())
+            {
+                case ValueType::Integer:
+                    operand.converted.push_back(
+                      static_cast<FloatType>(static_cast<IntType>(cell)));
+                    break;
+
+                case ValueType::Float:
+                    operand.converted.push_back(static_cast<FloatType>(cell));
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        operand.isFloat = true;
+        operand.floats = operand.converted.data();
+        return true;
+    }
+
+    bool toNumericOperand(const DynamicVariable &value, NumericOperand &operand)
+    {
+        switch(value.getValueType())
+        {
+            case ValueType::Integer:
+                operand.intValue = static_cast<IntType>(value);
+                return true;
+
+            case ValueType::Float:
+                operand.isFloat = true;
+                operand.floatValue = static_cast<FloatType>(value);
+                return true;
+
+            case ValueType::Array:
+                break;
+
+            default:
+                return false;
+        }
+
+        operand.isArray = true;
+        operand.size = value.size();
+        operand.dense = value;
+        if(operand.size == 0)
+            return true;
+
+        if(operand.dense.getElementType() == ValueType::None)
+            operand.dense.makeDense();
+
+        if(loadDenseArray(operand))
+            return true;
+
+        return operand.dense.getElementType() == ValueType::None && loadMixedArray(operand);
+    }
+
+    std::runtime_error generateCastException(const std::string &caller,
+                                             const DynamicVariable &value)
+    {
+        return std::runtime_error(caller + ": unsupported action on type " +
+                                  std::to_string(value.getValueType()));
+    }
+
+    SizeType checkSizes(const DynamicVariable &a, const DynamicVariable &b)
+    {
+        const bool aIsArray = a.isType(ValueType::Array);
+        const bool bIsArray = b.isType(ValueType::Array);
+        if(aIsArray && bIsArray && a.size() != b.size())
+            throw std::invalid_argument("array operations require arrays of the same size (" +
+                                        std::to_string(a.size()) + " and " +
+                                        std::to_string(b.size()) + ")");
+
+        return aIsArray ? a.size() : (bIsArray ? b.size() : 0);
+    }
+
+    /**
+     * @brief Calls f(begin, end) on the whole range, or on one chunk per thread of pool
+     */
+    template<typename F>
+    void forEachChunk(SizeType size, ThreadPool *pool, F &&f)
+    {
+        const SizeType nbThreads = pool ? static_cast<SizeType>(pool->getNumberOfThreads()) : 0;
+        if(nbThreads < 2 || size < ArrayOperationParallelThreshold)
+        {
+            f(SizeType(0), size);
+            return;
+        }
+
+        const SizeType chunkSize = (size + nbThreads - 1) / nbThreads;
+        std::vector<std::future<void>> chunks;
+        chunks.reserve(nbThreads);
+        for(SizeType begin = 0; begin < size; begin += chunkSize)
+        {
+            const SizeType end = std::min(size, begin + chunkSize);
+            chunks.push_back(pool->enqueue([&f, begin, end]() { f(begin, end); }));
+        }
+
+        for(auto &chunk: chunks)
+            chunk.get();
+    }
+
+    template<typename T>
+    inline T load(const T *values, SizeType i)
+    {
+        return values[i];
+    }
+
+    template<typename T>
+    inline T load(T value, SizeType /*i*/)
+    {
+        return value;
+    }
+
+    /**
+     * @brief Element-wise loop, L and R are either a pointer to the cells or a scalar
+     *
+     * The loop has no branch nor aliasing between inputs and output so that the compiler
+     * vectorizes it.
+     */
+    template<typename Operation, typename ResultType, typename L, typename R>
+    void applyRange(ResultType *__restrict result, L lhs, R rhs, SizeType begin, SizeType end)
+    {
+        for(SizeType i = begin; i < end; ++i)
+            result[i] = Operation::template apply<ResultType>(load(lhs, i), load(rhs, i));
+    }
+
+    template<typename T>
+    struct DenseArrayOf;
+
+    template<>
+    struct DenseArrayOf<IntType>
+    {
+        typedef IntArrayValue type;
+    };
+
+    template<>
+    struct DenseArrayOf<FloatType>
+    {
+        typedef FloatArrayValue type;
+    };
+
+    template<>
+    struct DenseArrayOf<uint8_t>
+    {
+        typedef BoolArrayValue type;
+    };
+
+    template<typename Operation, typename ResultType, typename L, typename R>
+    DynamicVariable applyDense(L lhs, R rhs, SizeType size, ThreadPool *pool)
+    {
+        std::vector<ResultType> values(size);
+        ResultType *result = values.data();
+        forEachChunk(size, pool, [result, lhs, rhs](SizeType begin, SizeType end) {
+            applyRange<Operation>(result, lhs, rhs, begin, end);
+        });
+
+        return DynamicVariable(
+          std::make_shared<typename DenseArrayOf<ResultType>::type>(std::move(values)));
+    }
+
+    template<typename Operation, typename ResultType, typename L>
+    DynamicVariable applyDenseRhs(L lhs, const NumericOperand &b, SizeType size, ThreadPool *pool)
+    {
+        if(!b.isArray)
+        {
+            return b.isFloat ? applyDense<Operation, ResultType>(lhs, b.floatValue, size, pool)
+                             : applyDense<Operation, ResultType>(lhs, b.intValue, size, pool);
+        }
+
+        return b.isFloat ? applyDense<Operation, ResultType>(lhs, b.floats, size, pool)
+                         : applyDense<Operation, ResultType>(lhs, b.ints, size, pool);
+    }
+
+    template<typename Operation, typename ResultType>
+    DynamicVariable applyDenseOperands(const NumericOperand &a,
+                                       const NumericOperand &b,
+                                       SizeType size,
+                                       ThreadPool *pool)
+    {
+        if(!a.isArray)
+        {
+            return a.isFloat ? applyDenseRhs<Operation, ResultType>(a.floatValue, b, size, pool)
+                             : applyDenseRhs<Operation, ResultType>(a.intValue, b, size, pool);
+        }
+
+        return a.isFloat ? applyDenseRhs<Operation, ResultType>(a.floats, b, size, pool)
+                         : applyDenseRhs<Operation, ResultType>(a.ints, b, size, pool);
+    }
+
+    /**
+     * @brief Cell by cell fallback for operands that are not numeric
+     */
+    template<typename Operation>
+    DynamicVariable applyGeneric(const DynamicVariable &a, const DynamicVariable &b, SizeType size)
+    {
+        const bool aIsArray = a.isType(ValueType::Array);
+        const bool bIsArray = b.isType(ValueType::Array);
+        if(!aIsArray && !bIsArray)
+            return Operation::apply(a, b);
+
+        DynamicVariable result(ValueType::Array);
+        for(SizeType i = 0; i < size; ++i)
+        {
+            DynamicVariable lhs = aIsArray ? a[i] : a;
+            DynamicVariable rhs = bIsArray ? b[i] : b;
+            result.push(Operation::apply(lhs, rhs));
+        }
+
+        return result;
+    }
+
+    struct AddOperation
+    {
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            return a + b;
+        }
+
+        static DynamicVariable apply(const DynamicVariable &a, const DynamicVariable &b)
+        {
+            return a + b;
+        }
+    };
+
+    struct SubOperation
+    {
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            return a - b;
+        }
+
+        static DynamicVariable apply(const DynamicVariable &a, const DynamicVariable &b)
+        {
+            return a - b;
+        }
+    };
+
+    struct MulOperation
+    {
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            return a * b;
+        }
+
+        static DynamicVariable apply(const DynamicVariable &a, const DynamicVariable &b)
+        {
+            return a * b;
+        }
+    };
+
+    struct DivOperation
+    {
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            return a / b;
+        }
+
+        static DynamicVariable apply(const DynamicVariable &a, const DynamicVariable &b)
+        {
+            return a / b;
+        }
+    };
+
+    /**
+     * @brief Rejects the cells whose integer division is undefined, by zero or the one of the
+     * smallest integer by -1, which does not fit
+     */
+    void checkIntegerDivision(const NumericOperand &a, const NumericOperand &b, SizeType size)
+    {
+        for(SizeType i = 0; i < size; ++i)
+        {
+            const IntType divisor = b.isArray ? b.ints[i] : b.intValue;
+            if(divisor == 0)
+                throw std::domain_error("arrayDiv: integer division by zero");
+
+            const IntType dividend = a.isArray ? a.ints[i] : a.intValue;
+            if(divisor == -1 && dividend == std::numeric_limits<IntType>::min())
+                throw std::overflow_error("arrayDiv: integer division overflow");
+        }
+    }
+
+    template<typename Operation>
+    DynamicVariable applyArithmetic(const DynamicVariable &a,
+                                    const DynamicVariable &b,
+                                    ThreadPool *pool)
+    {
+        const SizeType size = checkSizes(a, b);
+        if(!a.isType(ValueType::Array) && !b.isType(ValueType::Array))
+            return Operation::apply(a, b);
+
+        NumericOperand lhs, rhs;
+        if(!toNumericOperand(a, lhs) || !toNumericOperand(b, rhs))
+            return applyGeneric<Operation>(a, b, size);
+
+        if(lhs.isFloat || rhs.isFloat)
+            return applyDenseOperands<Operation, FloatType>(lhs, rhs, size, pool);
+
+        if constexpr(std::is_same_v<Operation, DivOperation>)
+            checkIntegerDivision(lhs, rhs, size);
+
+        return applyDenseOperands<Operation, IntType>(lhs, rhs, size, pool);
+    }
+
+    template<ComparisonOperator op>
+    struct CompareOperation
+    {
+        template<typename ResultType, typename T, typename U>
+        static ResultType apply(T a, U b)
+        {
+            typedef std::common_type_t<T, U> CommonType;
+            const auto lhs = static_cast<CommonType>(a);
+            const auto rhs = static_cast<CommonType>(b);
+            if constexpr(op == ComparisonOperator::Equal)
+                return lhs == rhs;
+            else if constexpr(op == ComparisonOperator::NotEqual)
+                return lhs != rhs;
+            else if constexpr(op == ComparisonOperator::Less)
+                return lhs < rhs;
+            else if constexpr(op == ComparisonOperator::LessOrEqual)
+                return lhs <= rhs;
+            else if constexpr(op == ComparisonOperator::Greater)
+                return lhs > rhs;
+            else
+                return lhs >= rhs;
+        }
+    };
+
+    template<ComparisonOperator op>
+    DynamicVariable applyCompare(const NumericOperand &a,
+                                 const NumericOperand &b,
+                                 SizeType size,
+                                 ThreadPool *pool)
+    {
+        if(a.isArray || b.isArray)
+            return applyDenseOperands<CompareOperation<op>, uint8_t>(a, b, size, pool);
+
+        typedef CompareOperation<op> Operation;
+        if(a.isFloat || b.isFloat)
+        {
+            const FloatType lhs = a.isFloat ? a.floatValue : static_cast<FloatType>(a.intValue);
+            const FloatType rhs = b.isFloat ? b.floatValue : static_cast<FloatType>(b.intValue);
+            return DynamicVariable(Operation::template apply<bool>(lhs, rhs));
+        }
+
+        return DynamicVariable(Operation::template apply<bool>(a.intValue, b.intValue));
+    }
+
+    DynamicVariable compare(const DynamicVariable &a,
+                            const DynamicVariable &b,
+                            ComparisonOperator op,
+                            ThreadPool *pool)
+    {
+        const SizeType size = checkSizes(a, b);
+        NumericOperand lhs, rhs;
+        if(!toNumericOperand(a, lhs))
+            throw generateCastException("arrayCompare", a);
+
+        if(!toNumericOperand(b, rhs))
+            throw generateCastException("arrayCompare", b);
+
+        switch(op)
+        {
+            case ComparisonOperator::Equal:
+                return applyCompare<ComparisonOperator::Equal>(lhs, rhs, size, pool);
+
+            case ComparisonOperator::NotEqual:
+                return applyCompare<ComparisonOperator::NotEqual>(lhs, rhs, size, pool);
+
+            case ComparisonOperator::Less:
+                return applyCompare<ComparisonOperator::Less>(lhs, rhs, size, pool);
+
+            case ComparisonOperator::LessOrEqual:
+                return applyCompare<ComparisonOperator::LessOrEqual>(lhs, rhs, size, pool);
+
+            case ComparisonOperator::Greater:
+                return applyCompare<ComparisonOperator::Greater>(lhs, rhs, size, pool);
+
+            case ComparisonOperator::GreaterOrEqual:
+                return applyCompare<ComparisonOperator::GreaterOrEqual>(lhs, rhs, size, pool);
+        }
+
+        throw std::invalid_argument("arrayCompare: unknown comparison operator");
+    }
+
+    /**
+     * @brief Integer sums wrap around on overflow, computed on the unsigned type so that it is
+     * defined behaviour
+     */
+    struct SumReduction
+    {
+        template<typename T>
+        static T identity(const T * /*values*/)
+        {
+            return T(0);
+        }
+
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            if constexpr(std::is_integral_v<T>)
+            {
+                typedef std::make_unsigned_t<T> UnsignedType;
+                return static_cast<T>(static_cast<UnsignedType>(a) + static_cast<UnsignedType>(b));
+            }
+            else
+            {
+                return a + b;
+            }
+        }
+    };
+
+    /**
+     * @brief NaN sorts after every number, so the minimum is NaN only if every cell is NaN
+     */
+    struct MinReduction
+    {
+        template<typename T>
+        static T identity(const T *values)
+        {
+            return values[0];
+        }
+
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                if(std::isnan(a))
+                    return b;
+
+                if(std::isnan(b))
+                    return a;
+            }
+
+            return b < a ? b : a;
+        }
+    };
+
+    /**
+     * @brief NaN sorts after every number, so the maximum is NaN as soon as a cell is NaN
+     */
+    struct MaxReduction
+    {
+        template<typename T>
+        static T identity(const T *values)
+        {
+            return values[0];
+        }
+
+        template<typename T>
+        static T apply(T a, T b)
+        {
+            if constexpr(std::is_floating_point_v<T>)
+            {
+                if(std::isnan(a))
+                    return a;
+
+                if(std::isnan(b))
+                    return b;
+            }
+
+            return a < b ? b : a;
+        }
+    };
+
+    /**
+     * @brief Reduces values[begin, end) with four independent accumulators, which breaks the
+     * dependency chain of the loop and lets the compiler keep them in vector registers
+     *
+     * The cells are converted to AccumulatorType before being reduced.
+     */
+    template<typename Reduction, typename AccumulatorType, typename T>
+    AccumulatorType reduceRange(const T *__restrict values, SizeType begin, SizeType end)
+    {
+        const auto identity = static_cast<AccumulatorType>(Reduction::identity(values + begin));
+        AccumulatorType acc[4] = { identity, identity, identity, identity };
+        SizeType i = begin;
+        for(; i + 4 <= end; i += 4)
+        {
+            acc[0] = Reduction::apply(acc[0], static_cast<AccumulatorType>(values[i]));
+            acc[1] = Reduction::apply(acc[1], static_cast<AccumulatorType>(values[i + 1]));
+            acc[2] = Reduction::apply(acc[2], static_cast<AccumulatorType>(values[i + 2]));
+            acc[3] = Reduction::apply(acc[3], static_cast<AccumulatorType>(values[i + 3]));
+        }
+
+        for(; i < end; ++i)
+            acc[0] = Reduction::apply(acc[0], static_cast<AccumulatorType>(values[i]));
+
+        return Reduction::apply(Reduction::apply(acc[0], acc[1]),
+                                Reduction::apply(acc[2], acc[3]));
+    }
+
+    template<typename Reduction, typename AccumulatorType, typename T>
+    AccumulatorType reduce(const T *values, SizeType size, ThreadPool *pool)
+    {
+        std::mutex mutex;
+        auto result = static_cast<AccumulatorType>(Reduction::identity(values));
+        forEachChunk(size, pool, [values, &mutex, &result](SizeType begin, SizeType end) {
+            const auto partial = reduceRange<Reduction, AccumulatorType>(values, begin, end);
+            std::lock_guard<std::mutex> lock(mutex);
+            result = Reduction::apply(result, partial);
+        });
+
+        return result;
+    }
+
+    template<typename Reduction>
+    DynamicVariable reduce(const DynamicVariable &array, const char *caller, ThreadPool *pool)
+    {
+        NumericOperand operand;
+        if(!toNumericOperand(array, operand) || !operand.isArray)
+            throw generateCastException(caller, array);
+
+        if(operand.size == 0)
+        {
+            if constexpr(std::is_same_v<Reduction, SumReduction>)
+                return DynamicVariable(IntType(0));
+            else
+                return DynamicVariable();
+        }
+
+        if(operand.isFloat)
+            return DynamicVariable(
+              reduce<Reduction, FloatType>(operand.floats, operand.size, pool));
+
+        return DynamicVariable(reduce<Reduction, IntType>(operand.ints, operand.size, pool));
+    }
+
+    /**
+     * @brief Integer cells are summed as floats, so that the mean of large integers cannot
+     * overflow
+     */
+    DynamicVariable mean(const DynamicVariable &array, ThreadPool *pool)
+    {
+        NumericOperand operand;
+        if(!toNumericOperand(array, operand) || !operand.isArray)
+            throw generateCastException("arrayMean", array);
+
+        if(operand.size == 0)
+            return DynamicVariable();
+
+        const FloatType total =
+          operand.isFloat ? reduce<SumReduction, FloatType>(operand.floats, operand.size, pool)
+                          : reduce<SumReduction, FloatType>(operand.ints, operand.size, pool);
+        return DynamicVariable(total / static_cast<FloatType>(operand.size));
+    }
+} // namespace
+
+DynamicVariable FDCore::arrayAdd(const DynamicVariable &a, const DynamicVariable &b)
+{
+    return applyArithmetic<AddOperation>(a, b, nullptr);
+}
+
+DynamicVariable FDCore::arraySub(const DynamicVariable &a, const DynamicVariable &b)
+{
+    return applyArithmetic<SubOperation>(a, b, nullptr);
+}
+
+DynamicVariable FDCore::arrayMul(const DynamicVariable &a, const DynamicVariable &b)
+{
+    return applyArithmetic<MulOperation>(a, b, nullptr);
+}
+
+DynamicVariable FDCore::arrayDiv(const DynamicVariable &a, const DynamicVariable &b)
+{
+    return applyArithmetic<DivOperation>(a, b, nullptr);
+}
+
+DynamicVariable FDCore::arrayAdd(const DynamicVariable &a,
+                                 const DynamicVariable &b,
+                                 ThreadPool &pool)
+{
+    return applyArithmetic<AddOperation>(a, b, &pool);
+}
+
+DynamicVariable FDCore::arraySub(const DynamicVariable &a,
+                                 const DynamicVariable &b,
+                                 ThreadPool &pool)
+{
+    return applyArithmetic<SubOperation>(a, b, &pool);
+}
+
+DynamicVariable FDCore::arrayMul(const DynamicVariable &a,
+                                 const DynamicVariable &b,
+                                 ThreadPool &pool)
+{
+    return applyArithmetic<MulOperation>(a, b, &pool);
+}
+
+DynamicVariable FDCore::arrayDiv(const DynamicVariable &a,
+                                 const DynamicVariable &b,
+                                 ThreadPool &pool)
+{
+    return applyArithmetic<DivOperation>(a, b, &pool);
+}
+
+DynamicVariable FDCore::arrayCompare(const DynamicVariable &a,
+                                     const DynamicVariable &b,
+                                     ComparisonOperator op)
+{
+    return compare(a, b, op, nullptr);
+}
+
+DynamicVariable FDCore::arrayCompare(const DynamicVariable &a,
+                                     const DynamicVariable &b,
+                                     ComparisonOperator op,
+                                     ThreadPool &pool)
+{
+    return compare(a, b, op, &pool);
+}
+
+DynamicVariable FDCore::arraySum(const DynamicVariable &array)
+{
+    return reduce<SumReduction>(array, "arraySum", nullptr);
+}
+
+DynamicVariable FDCore::arrayMin(const DynamicVariable &array)
+{
+    return reduce<MinReduction>(array, "arrayMin", nullptr);
+}
+
+DynamicVariable FDCore::arrayMax(const DynamicVariable &array)
+{
+    return reduce<MaxReduction>(array, "arrayMax", nullptr);
+}
+
+DynamicVariable FDCore::arrayMean(const DynamicVariable &array)
+{
+    return mean(array, nullptr);
+}
+
+DynamicVariable FDCore::arraySum(const DynamicVariable &array, ThreadPool &pool)
+{
+    return reduce<SumReduction>(array, "arraySum", &pool);
+}
+
+DynamicVariable FDCore::arrayMin(const DynamicVariable &array, ThreadPool &pool)
+{
+    return reduce<MinReduction>(array, "arrayMin", &pool);
+}
+
+DynamicVariable FDCore::arrayMax(const DynamicVariable &array, ThreadPool &pool)
+{
+    return reduce<MaxReduction>(array, "arrayMax", &pool);
+}
+
+DynamicVariable FDCore::arrayMean(const DynamicVariable &array, ThreadPool &pool)
+{
+    return mean(array, &pool);
+}
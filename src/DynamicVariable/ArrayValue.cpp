@@ -16,6 +16,16 @@ FDCore::AbstractValue::Ptr FDCore::ArrayValue::removeAt(FDCore::ArrayValue::Size
     return result;
 }
 
+FDCore::AbstractValue::Ptr FDCore::ArrayValue::clone() const
+{
+    ArrayType values;
+    values.reserve(m_values.size());
+    for(const AbstractValue::Ptr &cell: m_values)
+        values.push_back(cell ? cell->clone() : cell);
+
+    return std::make_shared<ArrayValue>(std::move(values));
+}
+
 FDCore::AbstractValue::Ptr FDCore::ArrayValue::pop()
 {
     FDCore::AbstractValue::Ptr result = m_values.back();
@@ -0,0 +1,420 @@
+#include <FDCore/DynamicVariable/DocumentPatch.h>
+
+#include <FDCore/DynamicVariable/ValueVisitor.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef DynamicVariable::SizeType SizeType;
+    typedef PathQuery::Segment Segment;
+
+    Segment makeMemberSegment(const InternedString &member)
+    {
+        Segment segment;
+        segment.member = member;
+        segment.matchesMember = true;
+        return segment;
+    }
+
+    Segment makeIndexSegment(SizeType index)
+    {
+        Segment segment;
+        segment.index = index;
+        return segment;
+    }
+
+    struct DiffContext
+    {
+        std::vector<Segment> path;
+        DocumentPatch patch;
+
+        void emit(PatchOperationType type, const AbstractValue::Ptr &value)
+        {
+            // the names of the compared objects may belong to an interner the patch outlives
+            std::vector<Segment> segments(path);
+            for(Segment &segment: segments)
+            {
+                if(segment.matchesMember && !segment.member.isDetached())
+                    segment.member = InternedString(segment.member.view());
+            }
+
+            patch.push_back({ type, PathQuery(std::move(segments)), DynamicVariable(value) });
+        }
+    };
+
+    const AbstractValue::Ptr &getCell(const AbstractArrayValue &array,
+                                      SizeType pos,
+                                      AbstractValue::Ptr &boxed)
+    {
+        const AbstractValue::Ptr *slot = array.findSlot(pos);
+        if(slot)
+            return *slot;
+
+        boxed = array[pos];
+        return boxed;
+    }
+
+    void diffNodes(DiffContext &context,
+                   const AbstractValue::Ptr &from,
+                   const AbstractValue::Ptr &to);
+
+    void diffObjects(DiffContext &context,
+                     const AbstractObjectValue &from,
+                     const AbstractObjectValue &to)
+    {
+        from.forEachMember([&](const InternedString &member, const AbstractValue::Ptr &value) {
+            const AbstractValue::Ptr *slot = to.findSlot(member);
+            context.path.push_back(makeMemberSegment(member));
+            if(slot)
+                diffNodes(context, value, *slot);
+            else
+                context.emit(PatchOperationType::Remove, nullptr);
+
+            context.path.pop_back();
+        });
+
+        to.forEachMember([&](const InternedString &member, const AbstractValue::Ptr &value) {
+            if(from.findSlot(member))
+                return;
+
+            context.path.push_back(makeMemberSegment(member));
+            context.emit(PatchOperationType::Add, value);
+            context.path.pop_back();
+        });
+    }
+
+    void diffArrays(DiffContext &context,
+                    const AbstractArrayValue &from,
+                    const AbstractArrayValue &to)
+    {
+        const SizeType fromSize = from.size();
+        const SizeType toSize = to.size();
+        AbstractValue::Ptr fromBoxed;
+        AbstractValue::Ptr toBoxed;
+        for(SizeType i = 0, imax = std::min(fromSize, toSize); i < imax; ++i)
+        {
+            context.path.push_back(makeIndexSegment(i));
+            diffNodes(context, getCell(from, i, fromBoxed), getCell(to, i, toBoxed));
+            context.path.pop_back();
+        }
+
+        // removed from the end so that the index of each removal is still valid when applied
+        for(SizeType i = fromSize; i > toSize; --i)
+        {
+            context.path.push_back(makeIndexSegment(i - 1));
+            context.emit(PatchOperationType::Remove, nullptr);
+            context.path.pop_back();
+        }
+
+        for(SizeType i = fromSize; i < toSize; ++i)
+        {
+            context.path.push_back(makeIndexSegment(i));
+            context.emit(PatchOperationType::Add, getCell(to, i, toBoxed));
+            context.path.pop_back();
+        }
+    }
+
+    void diffNodes(DiffContext &context,
+                   const AbstractValue::Ptr &from,
+                   const AbstractValue::Ptr &to)
+    {
+        if(from == to)
+            return;
+
+        const ValueType type = getNodeType(from.get());
+        if(type != getNodeType(to.get()))
+        {
+            context.emit(PatchOperationType::Replace, to);
+            return;
+        }
+
+        switch(type)
+        {
+            case ValueType::Object:
+                diffObjects(context,
+                            static_cast<const AbstractObjectValue &>(*from),
+                            static_cast<const AbstractObjectValue &>(*to));
+                return;
+
+            case ValueType::Array:
+                diffArrays(context,
+                           static_cast<const AbstractArrayValue &>(*from),
+                           static_cast<const AbstractArrayValue &>(*to));
+                return;
+
+            case ValueType::Boolean:
+            case ValueType::Integer:
+            case ValueType::Float:
+            case ValueType::String:
+                if(DynamicVariable(from) != DynamicVariable(to))
+                    context.emit(PatchOperationType::Replace, to);
+
+                return;
+
+            case ValueType::None:
+                return;
+
+            default:
+                context.emit(PatchOperationType::Replace, to);
+                return;
+        }
+    }
+
+    std::invalid_argument generatePatchException(SizeType operation, const std::string &reason)
+    {
+        return std::invalid_argument("applyPatch: operation " + std::to_string(operation) + " " +
+                                     reason);
+    }
+
+    /**
+     * @brief Gets the modifiable slot of the child of node selected by segment. node must be
+     * owned by the caller only, so its slots can be written.
+     */
+    AbstractValue::Ptr *findMutableSlot(AbstractValue &node, const Segment &segment)
+    {
+        const AbstractValue::Ptr *slot = nullptr;
+        if(node.isType(ValueType::Object) && segment.matchesMember)
+            slot = static_cast<const AbstractObjectValue &>(node).findSlot(segment.member);
+        else if(node.isType(ValueType::Array) && segment.index != PathQuery::npos)
+            slot = static_cast<const AbstractArrayValue &>(node).findSlot(segment.index);
+
+        return const_cast<AbstractValue::Ptr *>(slot);
+    }
+
+    void applyToObject(AbstractObjectValue &object,
+                       const Segment &segment,
+                       const PatchOperation &operation,
+                       SizeType operationIndex)
+    {
+        if(!segment.matchesMember)
+            throw generatePatchException(operationIndex, "targets an index of an object");
+
+        AbstractValue::Ptr *slot = findMutableSlot(object, segment);
+        if(operation.type == PatchOperationType::Add)
+        {
+            if(slot)
+                *slot = operation.value.internalValue();
+            else
+                object.set(segment.member.view(), operation.value.internalValue());
+
+            return;
+        }
+
+        if(!slot)
+            throw generatePatchException(operationIndex, "targets a missing member");
+
+        if(operation.type == PatchOperationType::Replace)
+            *slot = operation.value.internalValue();
+        else
+            object.unset(segment.member.view());
+    }
+
+    /**
+     * @brief Copies a dense array into the equivalent generic array, which accepts any cell
+     */
+    AbstractValue::Ptr toGenericArray(const AbstractArrayValue &array)
+    {
+        ArrayValue::ArrayType cells;
+        cells.reserve(array.size());
+        for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            cells.push_back(array[i]);
+
+        return std::make_shared<ArrayValue>(std::move(cells));
+    }
+
+    void applyToArray(AbstractArrayValue &array,
+                      const Segment &segment,
+                      const PatchOperation &operation,
+                      SizeType operationIndex)
+    {
+        const SizeType size = array.size();
+        SizeType index = segment.index;
+        if(operation.type == PatchOperationType::Add && index == PathQuery::npos &&
+           segment.matchesMember && segment.member == DynamicVariable::StringViewType("-"))
+        {
+            index = size;
+        }
+
+        if(index == PathQuery::npos || index > size ||
+           (index == size && operation.type != PatchOperationType::Add))
+        {
+            throw generatePatchException(operationIndex, "targets a missing cell");
+        }
+
+        switch(operation.type)
+        {
+            case PatchOperationType::Add:
+                array.insert(operation.value.internalValue(), index);
+                return;
+
+            case PatchOperationType::Remove:
+                array.removeAt(index);
+                return;
+
+            case PatchOperationType::Replace:
+            {
+                AbstractValue::Ptr *slot = findMutableSlot(array, segment);
+                if(slot)
+                {
+                    *slot = operation.value.internalValue();
+                    return;
+                }
+
+                array.removeAt(index);
+                array.insert(operation.value.internalValue(), index);
+                return;
+            }
+        }
+    }
+
+    AbstractValue::Ptr applyOperation(AbstractValue::Ptr node,
+                                      const PatchOperation &operation,
+                                      SizeType depth,
+                                      SizeType operationIndex)
+    {
+        const std::vector<Segment> &segments = operation.path.getSegments();
+        if(depth == segments.size())
+        {
+            if(operation.type == PatchOperationType::Remove)
+                return nullptr;
+
+            return operation.value.internalValue();
+        }
+
+        if(!node)
+            throw generatePatchException(operationIndex, "goes through a missing node");
+
+        if(node.use_count() > 1 || node->isFrozen())
+            node = node->copy();
+        else
+            node->resetCachedHash();
+
+        const Segment &segment = segments[depth];
+        if(depth + 1 < segments.size())
+        {
+            AbstractValue::Ptr *slot = findMutableSlot(*node, segment);
+            if(!slot)
+                throw generatePatchException(operationIndex, "goes through a missing node");
+
+            *slot = applyOperation(std::move(*slot), operation, depth + 1, operationIndex);
+            return node;
+        }
+
+        if(node->isType(ValueType::Object))
+            applyToObject(static_cast<AbstractObjectValue &>(*node), segment, operation,
+                          operationIndex);
+        else if(node->isType(ValueType::Array))
+        {
+            const auto &array = static_cast<const AbstractArrayValue &>(*node);
+            if(operation.type != PatchOperationType::Remove &&
+               !array.accepts(operation.value.internalValue()))
+            {
+                node = toGenericArray(array);
+            }
+
+            applyToArray(static_cast<AbstractArrayValue &>(*node), segment, operation,
+                         operationIndex);
+        }
+        else
+            throw generatePatchException(operationIndex, "targets a child of a scalar");
+
+        return node;
+    }
+
+    const char *getOperationName(PatchOperationType type)
+    {
+        switch(type)
+        {
+            case PatchOperationType::Add:
+                return "add";
+
+            case PatchOperationType::Remove:
+                return "remove";
+
+            case PatchOperationType::Replace:
+                return "replace";
+        }
+
+        return "";
+    }
+} // namespace
+
+DocumentPatch FDCore::diff(const DynamicVariable &from, const DynamicVariable &to)
+{
+    DiffContext context;
+    diffNodes(context, from.internalValue(), to.internalValue());
+    return std::move(context.patch);
+}
+
+void FDCore::applyPatch(DynamicVariable &document, const DocumentPatch &patch)
+{
+    // document keeps the original tree until every operation succeeded, so each node on the
+    // path of an operation is copied the first time it is modified and then changed in place
+    AbstractValue::Ptr root = document.internalValue();
+    for(SizeType i = 0, imax = patch.size(); i < imax; ++i)
+        root = applyOperation(std::move(root), patch[i], 0, i);
+
+    document = DynamicVariable(std::move(root));
+}
+
+DynamicVariable FDCore::toJsonPatch(const DocumentPatch &patch)
+{
+    DynamicVariable result(ValueType::Array);
+    for(const PatchOperation &operation: patch)
+    {
+        DynamicVariable entry(ValueType::Object);
+        entry.set("op", DynamicVariable::StringViewType(getOperationName(operation.type)));
+        entry.set("path", DynamicVariable(operation.path.toPointer()));
+        if(operation.type != PatchOperationType::Remove)
+            entry.set("value", operation.value);
+
+        result.push(entry);
+    }
+
+    return result;
+}
+
+DocumentPatch FDCore::fromJsonPatch(const DynamicVariable &patch)
+{
+    if(!patch.isType(ValueType::Array))
+        throw std::invalid_argument("fromJsonPatch: a patch must be an array");
+
+    DocumentPatch result;
+    result.reserve(patch.size());
+    for(SizeType i = 0, imax = patch.size(); i < imax; ++i)
+    {
+        DynamicVariable entry = patch[i];
+        if(!entry.isType(ValueType::Object) || !entry["op"].isType(ValueType::String) ||
+           !entry["path"].isType(ValueType::String))
+        {
+            throw std::invalid_argument("fromJsonPatch: operation " + std::to_string(i) +
+                                        " must have an op and a path");
+        }
+
+        const DynamicVariable op = entry["op"];
+        PatchOperation operation;
+        if(op == DynamicVariable::StringType("add"))
+            operation.type = PatchOperationType::Add;
+        else if(op == DynamicVariable::StringType("remove"))
+            operation.type = PatchOperationType::Remove;
+        else if(op == DynamicVariable::StringType("replace"))
+            operation.type = PatchOperationType::Replace;
+        else
+            throw std::invalid_argument("fromJsonPatch: operation " + std::to_string(i) +
+                                        " is not supported");
+
+        operation.path = PathQuery::fromPointer(
+          static_cast<const DynamicVariable::StringType &>(entry["path"]));
+        if(operation.type != PatchOperationType::Remove)
+            operation.value = entry["value"];
+
+        result.push_back(std::move(operation));
+    }
+
+    return result;
+}
@@ -1,8 +1,714 @@
 #include <FDCore/DynamicVariable/DynamicVariable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 using namespace FDCore;
 
+namespace
+{
+    typedef DynamicVariable::IntType IntType;
+    typedef DynamicVariable::FloatType FloatType;
+    typedef DynamicVariable::SizeType SizeType;
+    typedef DynamicVariable::StringType StringType;
+
+    template<typename Node>
+    ValueType getTypeOf(const Node &node)
+    {
+        return node.getValueType();
+    }
+
+    ValueType getTypeOf(std::nullptr_t) { return ValueType::None; }
+
+    std::runtime_error generateCastException(const std::string &caller, ValueType type)
+    {
+        return std::runtime_error(caller + ": unsupported action on type " +
+                                  std::to_string(type));
+    }
+
+    struct AddOperation
+    {
+        template<typename T>
+        static T apply(T lhs, T rhs)
+        {
+            return lhs + rhs;
+        }
+    };
+
+    struct SubOperation
+    {
+        template<typename T>
+        static T apply(T lhs, T rhs)
+        {
+            return lhs - rhs;
+        }
+    };
+
+    struct MulOperation
+    {
+        template<typename T>
+        static T apply(T lhs, T rhs)
+        {
+            return lhs * rhs;
+        }
+    };
+
+    struct DivOperation
+    {
+        template<typename T>
+        static T apply(T lhs, T rhs)
+        {
+            return lhs / rhs;
+        }
+    };
+
+    /**
+     * @brief Only defined for integers, the other type pairs are rejected by the visitors
+     */
+    struct ModOperation
+    {
+        static IntType apply(IntType lhs, IntType rhs) { return lhs % rhs; }
+    };
+
+    template<typename Operation>
+    constexpr bool supportsFloat()
+    {
+        return !std::is_same_v<Operation, ModOperation>;
+    }
+
+    template<typename Operation>
+    constexpr bool supportsString()
+    {
+        return std::is_same_v<Operation, AddOperation>;
+    }
+
+    /**
+     * @brief Numeric binary operators: integers stay integers, any float operand gives a float
+     */
+    template<typename Operation>
+    struct ArithmeticVisitor
+    {
+        const char *caller;
+
+        DynamicVariable operator()(const IntValue &lhs, const IntValue &rhs) const
+        {
+            return DynamicVariable(
+              Operation::apply(static_cast<IntType>(lhs), static_cast<IntType>(rhs)));
+        }
+
+        DynamicVariable operator()(const IntValue &lhs, const FloatValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Integer);
+            else
+                return DynamicVariable(Operation::apply(
+                  static_cast<FloatType>(static_cast<IntType>(lhs)), static_cast<FloatType>(rhs)));
+        }
+
+        DynamicVariable operator()(const FloatValue &lhs, const IntValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Float);
+            else
+                return DynamicVariable(Operation::apply(
+                  static_cast<FloatType>(lhs), static_cast<FloatType>(static_cast<IntType>(rhs))));
+        }
+
+        DynamicVariable operator()(const FloatValue &lhs, const FloatValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Float);
+            else
+                return DynamicVariable(
+                  Operation::apply(static_cast<FloatType>(lhs), static_cast<FloatType>(rhs)));
+        }
+
+        DynamicVariable operator()(const StringValue &lhs, const StringValue &rhs) const
+        {
+            if constexpr(!supportsString<Operation>())
+                throw generateCastException(caller, ValueType::String);
+            else
+                return DynamicVariable(lhs + static_cast<const DynamicVariable::StringType &>(rhs));
+        }
+
+        template<typename L, typename R>
+        DynamicVariable operator()(const L &lhs, const R & /*rhs*/) const
+        {
+            throw generateCastException(caller, getTypeOf(lhs));
+        }
+    };
+
+    /**
+     * @brief Compound assignments, computed in place unless the type of the result changes
+     */
+    template<typename Operation>
+    struct AssignmentVisitor
+    {
+        DynamicVariable &self;
+        const char *caller;
+
+        void operator()(IntValue &lhs, const IntValue &rhs) const
+        {
+            lhs = Operation::apply(static_cast<IntType>(lhs), static_cast<IntType>(rhs));
+        }
+
+        void operator()(IntValue &lhs, const FloatValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Integer);
+            else
+                self = DynamicVariable(Operation::apply(
+                  static_cast<FloatType>(static_cast<IntType>(lhs)), static_cast<FloatType>(rhs)));
+        }
+
+        void operator()(FloatValue &lhs, const IntValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Float);
+            else
+                lhs = Operation::apply(static_cast<FloatType>(lhs),
+                                       static_cast<FloatType>(static_cast<IntType>(rhs)));
+        }
+
+        void operator()(FloatValue &lhs, const FloatValue &rhs) const
+        {
+            if constexpr(!supportsFloat<Operation>())
+                throw generateCastException(caller, ValueType::Float);
+            else
+                lhs = Operation::apply(static_cast<FloatType>(lhs), static_cast<FloatType>(rhs));
+        }
+
+        void operator()(StringValue &lhs, const StringValue &rhs) const
+        {
+            if constexpr(!supportsString<Operation>())
+                throw generateCastException(caller, ValueType::String);
+            else
+                lhs.append(static_cast<const DynamicVariable::StringType &>(rhs));
+        }
+
+        template<typename L, typename R>
+        void operator()(const L &lhs, const R & /*rhs*/) const
+        {
+            throw generateCastException(caller, getTypeOf(lhs));
+        }
+    };
+
+    const AbstractValue *getCell(const AbstractArrayValue &array,
+                                 SizeType pos,
+                                 AbstractValue::Ptr &boxed)
+    {
+        const AbstractValue::Ptr *slot = array.findSlot(pos);
+        if(slot)
+            return slot->get();
+
+        boxed = array[pos];
+        return boxed.get();
+    }
+
+    size_t combineHash(size_t seed, size_t value)
+    {
+        return seed ^ (value + static_cast<size_t>(0x9e3779b97f4a7c15ULL) + (seed << 6) +
+                       (seed >> 2));
+    }
+
+    size_t hashType(ValueType type) { return combineHash(0, static_cast<size_t>(type)); }
+
+    size_t hashCell(bool value) { return combineHash(hashType(ValueType::Boolean), value); }
+
+    size_t hashCell(IntType value)
+    {
+        return combineHash(hashType(ValueType::Integer), std::hash<IntType>()(value));
+    }
+
+    /**
+     * @brief -0.0 and 0.0 are equal so they get the same hash, every NaN gets the same hash too
+     */
+    size_t hashCell(FloatType value)
+    {
+        if(value == 0)
+            value = 0;
+        else if(std::isnan(value))
+            value = std::numeric_limits<FloatType>::quiet_NaN();
+
+        return combineHash(hashType(ValueType::Float), std::hash<FloatType>()(value));
+    }
+
+    template<typename T>
+    bool equalCells(const T &lhs, const T &rhs)
+    {
+        return lhs == rhs;
+    }
+
+    /**
+     * @brief NaN is equal to NaN, as for hashCell() and compare()
+     */
+    bool equalCells(FloatType lhs, FloatType rhs)
+    {
+        return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+    }
+
+    size_t hashCell(const StringType &value)
+    {
+        // same hash as StringValue::hash(), interned or not
+        return combineHash(hashType(ValueType::String),
+                           std::hash<DynamicVariable::StringViewType>()(value));
+    }
+
+    size_t hashNode(const AbstractValue *node);
+
+    template<typename T>
+    size_t hashDenseArray(size_t seed, const AbstractArrayValue &array)
+    {
+        auto cells = static_cast<const TypedArrayValue<T> &>(array).getSpan();
+        for(SizeType i = 0; i < cells.size; ++i)
+            seed = combineHash(seed, hashCell(static_cast<const T &>(cells.data[i])));
+
+        return seed;
+    }
+
+    /**
+     * @brief Dense arrays hash their raw cells the way their boxed cells would be hashed, so
+     * they get the same hash as the generic array they are equal to
+     */
+    size_t hashArray(const AbstractArrayValue &array)
+    {
+        size_t result = combineHash(hashType(ValueType::Array), array.size());
+        switch(array.getElementType())
+        {
+            case ValueType::Boolean:
+                return hashDenseArray<bool>(result, array);
+
+            case ValueType::Integer:
+                return hashDenseArray<IntType>(result, array);
+
+            case ValueType::Float:
+                return hashDenseArray<FloatType>(result, array);
+
+            case ValueType::String:
+                return hashDenseArray<StringType>(result, array);
+
+            default:
+                break;
+        }
+
+        AbstractValue::Ptr boxed;
+        for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            result = combineHash(result, hashNode(getCell(array, i, boxed)));
+
+        return result;
+    }
+
+    /**
+     * @brief The hashes of the members are summed so that the order of the members does not
+     * change the result
+     */
+    size_t hashObject(const AbstractObjectValue &object)
+    {
+        size_t members = 0;
+        object.forEachMember([&members](const InternedString &name,
+                                        const AbstractValue::Ptr &value) {
+            members += combineHash(name.hash(), hashNode(value.get()));
+        });
+
+        return combineHash(combineHash(hashType(ValueType::Object), object.size()), members);
+    }
+
+    size_t hashNode(const AbstractValue *node)
+    {
+        const ValueType type = getNodeType(node);
+        switch(type)
+        {
+            case ValueType::None:
+                return hashType(type);
+
+            case ValueType::Boolean:
+                return hashCell(static_cast<bool>(static_cast<const BoolValue &>(*node)));
+
+            case ValueType::Integer:
+                return hashCell(static_cast<IntType>(static_cast<const IntValue &>(*node)));
+
+            case ValueType::Float:
+                return hashCell(static_cast<FloatType>(static_cast<const FloatValue &>(*node)));
+
+            default:
+                break;
+        }
+
+        size_t result = node->getCachedHash();
+        if(result != 0)
+            return result;
+
+        switch(type)
+        {
+            case ValueType::String:
+                result =
+                  combineHash(hashType(type), static_cast<const StringValue &>(*node).hash());
+                break;
+
+            case ValueType::Array:
+                result = hashArray(static_cast<const AbstractArrayValue &>(*node));
+                break;
+
+            case ValueType::Object:
+                result = hashObject(static_cast<const AbstractObjectValue &>(*node));
+                break;
+
+            default:
+                // nodes without a structural equality are only equal to themselves
+                result = combineHash(hashType(type), std::hash<const void *>()(node));
+                break;
+        }
+
+        // 0 marks a hash that is not cached
+        if(result == 0)
+            result = 1;
+
+        node->setCachedHash(result);
+        return result;
+    }
+
+    bool equalNodes(const AbstractValue *lhs, const AbstractValue *rhs);
+
+    template<typename T>
+    bool equalDenseArrays(const AbstractArrayValue &lhs, const AbstractArrayValue &rhs)
+    {
+        auto lhsCells = static_cast<const TypedArrayValue<T> &>(lhs).getSpan();
+        auto rhsCells = static_cast<const TypedArrayValue<T> &>(rhs).getSpan();
+        return std::equal(lhsCells.data, lhsCells.data + lhsCells.size, rhsCells.data,
+                          [](const T &lhs, const T &rhs) { return equalCells(lhs, rhs); });
+    }
+
+    bool equalArrays(const AbstractArrayValue &lhs, const AbstractArrayValue &rhs)
+    {
+        const SizeType size = lhs.size();
+        if(size != rhs.size())
+            return false;
+
+        const ValueType elementType = lhs.getElementType();
+        if(elementType == rhs.getElementType())
+        {
+            switch(elementType)
+            {
+                case ValueType::Boolean:
+                    return equalDenseArrays<bool>(lhs, rhs);
+
+                case ValueType::Integer:
+                    return equalDenseArrays<IntType>(lhs, rhs);
+
+                case ValueType::Float:
+                    return equalDenseArrays<FloatType>(lhs, rhs);
+
+                case ValueType::String:
+                    return equalDenseArrays<StringType>(lhs, rhs);
+
+                default:
+                    break;
+            }
+        }
+
+        AbstractValue::Ptr lhsBoxed;
+        AbstractValue::Ptr rhsBoxed;
+        for(SizeType i = 0; i < size; ++i)
+        {
+            if(!equalNodes(getCell(lhs, i, lhsBoxed), getCell(rhs, i, rhsBoxed)))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Objects are equal if they have the same members with equal values, in any order
+     */
+    bool equalObjects(const AbstractObjectValue &lhs, const AbstractObjectValue &rhs)
+    {
+        if(lhs.size() != rhs.size())
+            return false;
+
+        bool result = true;
+        lhs.forEachMember([&result, &rhs](const InternedString &name,
+                                          const AbstractValue::Ptr &value) {
+            if(!result)
+                return;
+
+            const AbstractValue::Ptr *slot = rhs.findSlot(name);
+            result = slot && equalNodes(value.get(), slot->get());
+        });
+
+        return result;
+    }
+
+    bool equalNodes(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        if(lhs == rhs)
+            return true;
+
+        const ValueType type = getNodeType(lhs);
+        if(type != getNodeType(rhs))
+            return false;
+
+        switch(type)
+        {
+            case ValueType::None:
+                return true;
+
+            case ValueType::Boolean:
+                return static_cast<const BoolValue &>(*lhs) == static_cast<const BoolValue &>(*rhs);
+
+            case ValueType::Integer:
+                return static_cast<const IntValue &>(*lhs) == static_cast<const IntValue &>(*rhs);
+
+            case ValueType::Float:
+                return equalCells(static_cast<FloatType>(static_cast<const FloatValue &>(*lhs)),
+                                  static_cast<FloatType>(static_cast<const FloatValue &>(*rhs)));
+
+            case ValueType::String:
+                return static_cast<const StringValue &>(*lhs) ==
+                       static_cast<const StringValue &>(*rhs);
+
+            default:
+                break;
+        }
+
+        // both hashes are only cached when the nodes were already hashed, for instance as keys
+        const size_t lhsHash = lhs->getCachedHash();
+        const size_t rhsHash = rhs->getCachedHash();
+        if(lhsHash != 0 && rhsHash != 0 && lhsHash != rhsHash)
+            return false;
+
+        if(type == ValueType::Array)
+            return equalArrays(static_cast<const AbstractArrayValue &>(*lhs),
+                               static_cast<const AbstractArrayValue &>(*rhs));
+
+        if(type == ValueType::Object)
+            return equalObjects(static_cast<const AbstractObjectValue &>(*lhs),
+                                static_cast<const AbstractObjectValue &>(*rhs));
+
+        return false;
+    }
+
+    template<typename T>
+    int compareValues(const T &lhs, const T &rhs)
+    {
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+
+    /**
+     * @brief Orders floats with NaN after every number
+     */
+    int compareFloats(FloatType lhs, FloatType rhs)
+    {
+        const bool lhsNaN = std::isnan(lhs);
+        const bool rhsNaN = std::isnan(rhs);
+        if(lhsNaN || rhsNaN)
+            return compareValues(lhsNaN, rhsNaN);
+
+        return compareValues(lhs, rhs);
+    }
+
+    /**
+     * @brief Exact comparison of an integer and a float, without converting lhs to a float
+     */
+    int compareIntFloat(IntType lhs, FloatType rhs)
+    {
+        // 2^63, the first float above every IntType
+        constexpr FloatType upperBound = 9223372036854775808.0;
+        if(std::isnan(rhs) || rhs >= upperBound)
+            return -1;
+
+        if(rhs < -upperBound)
+            return 1;
+
+        const IntType truncated = static_cast<IntType>(rhs);
+        if(lhs != truncated)
+            return compareValues(lhs, truncated);
+
+        return compareValues(static_cast<FloatType>(0), rhs - static_cast<FloatType>(truncated));
+    }
+
+    int compareNumbers(const AbstractValue &lhs, const AbstractValue &rhs)
+    {
+        const bool lhsInt = lhs.isType(ValueType::Integer);
+        const bool rhsInt = rhs.isType(ValueType::Integer);
+        if(lhsInt && rhsInt)
+            return compareValues(static_cast<IntType>(static_cast<const IntValue &>(lhs)),
+                                 static_cast<IntType>(static_cast<const IntValue &>(rhs)));
+
+        if(lhsInt)
+            return compareIntFloat(static_cast<IntType>(static_cast<const IntValue &>(lhs)),
+                                   static_cast<FloatType>(static_cast<const FloatValue &>(rhs)));
+
+        if(rhsInt)
+            return -compareIntFloat(static_cast<IntType>(static_cast<const IntValue &>(rhs)),
+                                    static_cast<FloatType>(static_cast<const FloatValue &>(lhs)));
+
+        return compareFloats(static_cast<FloatType>(static_cast<const FloatValue &>(lhs)),
+                             static_cast<FloatType>(static_cast<const FloatValue &>(rhs)));
+    }
+
+    bool isNumber(ValueType type) { return type == ValueType::Integer || type == ValueType::Float; }
+
+    int compareNodes(const AbstractValue *lhs, const AbstractValue *rhs);
+
+    int compareArrays(const AbstractArrayValue &lhs, const AbstractArrayValue &rhs)
+    {
+        const SizeType lhsSize = lhs.size();
+        const SizeType rhsSize = rhs.size();
+        AbstractValue::Ptr lhsBoxed;
+        AbstractValue::Ptr rhsBoxed;
+        for(SizeType i = 0, imax = std::min(lhsSize, rhsSize); i < imax; ++i)
+        {
+            const int result = compareNodes(getCell(lhs, i, lhsBoxed), getCell(rhs, i, rhsBoxed));
+            if(result != 0)
+                return result;
+        }
+
+        return compareValues(lhsSize, rhsSize);
+    }
+
+    typedef std::vector<std::pair<DynamicVariable::StringViewType, const AbstractValue *>>
+      SortedMembers;
+
+    SortedMembers getSortedMembers(const AbstractObjectValue &object)
+    {
+        SortedMembers result;
+        result.reserve(object.size());
+        object.forEachMember([&result](const InternedString &name,
+                                       const AbstractValue::Ptr &value) {
+            result.emplace_back(name.view(), value.get());
+        });
+
+        std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        return result;
+    }
+
+    /**
+     * @brief Orders objects by their number of members, then by their members sorted by name
+     */
+    int compareObjects(const AbstractObjectValue &lhs, const AbstractObjectValue &rhs)
+    {
+        int result = compareValues(lhs.size(), rhs.size());
+        if(result != 0)
+            return result;
+
+        const SortedMembers lhsMembers = getSortedMembers(lhs);
+        const SortedMembers rhsMembers = getSortedMembers(rhs);
+        for(SizeType i = 0, imax = lhsMembers.size(); i < imax && result == 0; ++i)
+        {
+            result = lhsMembers[i].first.compare(rhsMembers[i].first);
+            if(result == 0)
+                result = compareNodes(lhsMembers[i].second, rhsMembers[i].second);
+        }
+
+        return compareValues(result, 0);
+    }
+
+    int compareNodes(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        if(lhs == rhs)
+            return 0;
+
+        const ValueType lhsType = getNodeType(lhs);
+        const ValueType rhsType = getNodeType(rhs);
+        if(isNumber(lhsType) && isNumber(rhsType))
+        {
+            const int result = compareNumbers(*lhs, *rhs);
+            return result != 0 ? result : compareValues(lhsType, rhsType);
+        }
+
+        if(lhsType != rhsType)
+            return compareValues(lhsType, rhsType);
+
+        switch(lhsType)
+        {
+            case ValueType::None:
+                return 0;
+
+            case ValueType::Boolean:
+                return compareValues(static_cast<bool>(static_cast<const BoolValue &>(*lhs)),
+                                     static_cast<bool>(static_cast<const BoolValue &>(*rhs)));
+
+            case ValueType::String:
+                return compareValues(
+                  static_cast<const StringType &>(static_cast<const StringValue &>(*lhs)),
+                  static_cast<const StringType &>(static_cast<const StringValue &>(*rhs)));
+
+            case ValueType::Array:
+                return compareArrays(static_cast<const AbstractArrayValue &>(*lhs),
+                                     static_cast<const AbstractArrayValue &>(*rhs));
+
+            case ValueType::Object:
+                return compareObjects(static_cast<const AbstractObjectValue &>(*lhs),
+                                      static_cast<const AbstractObjectValue &>(*rhs));
+
+            default:
+                return compareValues(lhs, rhs);
+        }
+    }
+
+    /**
+     * @brief Freezes node and its children, the frozen subtrees are not walked again
+     */
+    void freezeNode(AbstractValue *node)
+    {
+        if(!node || node->isFrozen())
+            return;
+
+        node->freeze();
+        if(node->isType(ValueType::Object))
+        {
+            static_cast<const AbstractObjectValue &>(*node).forEachMember(
+              [](const InternedString &, const AbstractValue::Ptr &value) {
+                  freezeNode(value.get());
+              });
+        }
+        else if(node->isType(ValueType::Array))
+        {
+            const auto &array = static_cast<const AbstractArrayValue &>(*node);
+            for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            {
+                const AbstractValue::Ptr *slot = array.findSlot(i);
+                if(slot)
+                    freezeNode(slot->get());
+            }
+        }
+    }
+
+    /**
+     * @brief Values of different types are never equal, containers are compared structurally
+     */
+    struct EqualVisitor
+    {
+        bool operator()(std::nullptr_t, std::nullptr_t) const { return true; }
+        bool operator()(const BoolValue &lhs, const BoolValue &rhs) const { return lhs == rhs; }
+        bool operator()(const IntValue &lhs, const IntValue &rhs) const { return lhs == rhs; }
+
+        bool operator()(const FloatValue &lhs, const FloatValue &rhs) const
+        {
+            return equalCells(static_cast<FloatType>(lhs), static_cast<FloatType>(rhs));
+        }
+
+        bool operator()(const StringValue &lhs, const StringValue &rhs) const
+        {
+            return lhs == rhs;
+        }
+
+        template<typename L, typename R>
+        bool operator()(const L &lhs, const R &rhs) const
+        {
+            if constexpr(std::is_same_v<L, R>)
+                return equalNodes(&lhs, &rhs);
+            else
+                return false;
+        }
+    };
+} // namespace
+
 DynamicVariable::DynamicVariable() {}
 
 
@@ -26,38 +732,20 @@ DynamicVariable::DynamicVariable(ValueType type)
             m_value = std::make_shared<StringValue>();
             break;
 
-        case ValueType::Array:
-            m_value = std::make_shared<ArrayValue>();
+        case ValueType::Function:
+            m_value = std::make_shared<FunctionValue>();
             break;
 
-        default:
-            throw generateCastException(__func__);
-    }
-}
-
-DynamicVariable::DynamicVariable(const DynamicVariable &other)
-{
-    switch(other.getValueType())
-    {
-        case ValueType::Boolean:
-            m_value.reset(new BoolValue(other.toBool()));
-            break;
-
-        case ValueType::Integer:
-            m_value.reset(new IntValue(other.toInteger()));
-            break;
-
-        case ValueType::Float:
-            m_value.reset(new FloatValue(other.toFloat()));
+        case ValueType::Array:
+            m_value = std::make_shared<ArrayValue>();
             break;
 
-        case ValueType::String:
-            m_value.reset(new StringValue(other.toString()));
+        case ValueType::Object:
+            m_value = std::make_shared<ShapedObjectValue>();
             break;
 
         default:
-            m_value = other.m_value;
-            break;
+            throw generateCastException(__func__);
     }
 }
 
@@ -99,15 +787,14 @@ DynamicVariable::operator const StringType &() const
     return static_cast<const StringType &>(toString());
 }
 
-DynamicVariable::operator const ArrayType &() const
+DynamicVariable::operator const ArrayType &()
 {
-    if(!isType(ValueType::Array))
-        throw generateCastException(__func__);
-
-    return static_cast<const ArrayType &>(static_cast<const ArrayValue &>(toArray()));
+    makeGeneric();
+    return static_cast<const ArrayType &>(
+      static_cast<const ArrayValue &>(std::as_const(*this).toArray()));
 }
 
-DynamicVariable::operator StringType() const
+DynamicVariable::operator StringType() const &
 {
     if(!isType(ValueType::String))
         throw generateCastException(__func__);
@@ -115,72 +802,54 @@ DynamicVariable::operator StringType() const
     return static_cast<StringType>(toString());
 }
 
-DynamicVariable::operator ArrayType() const
+DynamicVariable::operator StringType() &&
 {
-    if(!isType(ValueType::Array))
+    if(!isType(ValueType::String))
         throw generateCastException(__func__);
 
-    return static_cast<ArrayType>(static_cast<const ArrayValue &>(toArray()));
+    if(!m_value.isWritable())
+        return static_cast<StringType>(std::as_const(*this).toString());
+
+    return toString().release();
 }
 
-bool DynamicVariable::operator==(const DynamicVariable &value) const
+DynamicVariable::operator ArrayType() &&
 {
-    ValueType type = getValueType();
-    if(type != value.getValueType())
-    {
-        return false;
-    }
-
-    switch(type)
-    {
-        case ValueType::None:
-            return true;
+    if(getElementType() != ValueType::None || !m_value.isWritable())
+        return std::as_const(*this).operator ArrayType();
 
-        case ValueType::Boolean:
-            return toBool() == value.toBool();
+    return static_cast<ArrayValue &>(toArray()).release();
+}
 
-        case ValueType::Integer:
-            return toInteger() == value.toInteger();
+DynamicVariable::operator ArrayType() const &
+{
+    const AbstractArrayValue &arr = toArray();
+    if(arr.getElementType() == ValueType::None)
+        return static_cast<ArrayType>(static_cast<const ArrayValue &>(arr));
 
-        case ValueType::Float:
-            return toFloat() == value.toFloat();
+    ArrayType result;
+    result.reserve(arr.size());
+    for(SizeType i = 0, imax = arr.size(); i < imax; ++i)
+        result.push_back(arr[i]);
 
-        case ValueType::String:
-            return toString() == value.toString();
+    return result;
+}
 
-        default:
-            throw generateCastException(__func__);
-    }
+bool DynamicVariable::operator==(const DynamicVariable &value) const
+{
+    return visit(EqualVisitor {}, *this, value);
 }
 
 bool DynamicVariable::operator!=(const DynamicVariable &value) const
 {
-    ValueType type = getValueType();
-    if(type != value.getValueType())
-    {
-        return true;
-    }
-
-    switch(type)
-    {
-        case ValueType::None:
-            return false;
-
-        case ValueType::Boolean:
-            return toBool() != value.toBool();
-
-        case ValueType::Integer:
-            return toInteger() != value.toInteger();
-
-        case ValueType::Float:
-            return toFloat() != value.toFloat();
+    return !visit(EqualVisitor {}, *this, value);
+}
 
-        case ValueType::String:
-            return toString() != value.toString();
+size_t DynamicVariable::hash() const { return hashNode(m_value.get()); }
 
-        default:
-            throw generateCastException(__func__);
-    }
+int DynamicVariable::compare(const DynamicVariable &value) const
+{
+    return compareNodes(m_value.get(), value.m_value.get());
 }
 
 bool DynamicVariable::operator==(std::nullptr_t) const { return isType(ValueType::None); }
@@ -209,17 +878,17 @@ bool DynamicVariable::operator!=(StringViewType value) const
 
 DynamicVariable DynamicVariable::operator-() const
 {
-    if(isType(ValueType::Integer))
+    switch(getValueType())
     {
-        return DynamicVariable(-toInteger());
-    }
+        case ValueType::Integer:
+            return DynamicVariable(-nodeAs<IntValue>());
 
-    if(isType(ValueType::Float))
-    {
-        return DynamicVariable(-toFloat());
-    }
+        case ValueType::Float:
+            return DynamicVariable(-nodeAs<FloatValue>());
 
-    throw generateCastException(__func__);
+        default:
+            throw generateCastException(__func__);
+    }
 }
 
 DynamicVariable DynamicVariable::operator~() const
@@ -232,17 +901,17 @@ DynamicVariable DynamicVariable::operator~() const
 
 DynamicVariable DynamicVariable::operator+() const
 {
-    if(isType(ValueType::Integer))
+    switch(getValueType())
     {
-        return DynamicVariable(+toInteger());
-    }
+        case ValueType::Integer:
+            return DynamicVariable(+nodeAs<IntValue>());
 
-    if(isType(ValueType::Float))
-    {
-        return DynamicVariable(+toFloat());
-    }
+        case ValueType::Float:
+            return DynamicVariable(+nodeAs<FloatValue>());
 
-    throw generateCastException(__func__);
+        default:
+            throw generateCastException(__func__);
+    }
 }
 
 DynamicVariable &DynamicVariable::operator++()
@@ -290,35 +959,14 @@ DynamicVariable &DynamicVariable::operator+=(StringViewType value)
 
 DynamicVariable &DynamicVariable::operator+=(const DynamicVariable &value)
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this += static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this += static_cast<FloatType>(value.toFloat());
-
-        case ValueType::String:
-            return *this += static_cast<StringType>(value.toString());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    visitMutable(AssignmentVisitor<AddOperation> { *this, "operator+=" }, *this, value);
+    return *this;
 }
 
 DynamicVariable &DynamicVariable::operator-=(const DynamicVariable &value)
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this -= static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this -= static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    visitMutable(AssignmentVisitor<SubOperation> { *this, "operator-=" }, *this, value);
+    return *this;
 }
 
 DynamicVariable DynamicVariable::operator+(StringViewType value) const
@@ -331,111 +979,45 @@ DynamicVariable DynamicVariable::operator+(StringViewType value) const
 
 DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) const
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this + static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this + static_cast<FloatType>(value.toFloat());
-
-        case ValueType::String:
-            return *this + static_cast<StringType>(value.toString());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    return visit(ArithmeticVisitor<AddOperation> { "operator+" }, *this, value);
 }
 
 DynamicVariable DynamicVariable::operator-(const DynamicVariable &value) const
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this - static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this - static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    return visit(ArithmeticVisitor<SubOperation> { "operator-" }, *this, value);
 }
 
 DynamicVariable &DynamicVariable::operator*=(const DynamicVariable &value)
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this *= static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this *= static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    visitMutable(AssignmentVisitor<MulOperation> { *this, "operator*=" }, *this, value);
+    return *this;
 }
 
 DynamicVariable DynamicVariable::operator*(const DynamicVariable &value) const
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this * static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this * static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    return visit(ArithmeticVisitor<MulOperation> { "operator*" }, *this, value);
 }
 
 DynamicVariable &DynamicVariable::operator/=(const DynamicVariable &value)
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this /= static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this /= static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    visitMutable(AssignmentVisitor<DivOperation> { *this, "operator/=" }, *this, value);
+    return *this;
 }
 
 DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) const
 {
-    switch(value.getValueType())
-    {
-        case ValueType::Integer:
-            return *this / static_cast<IntType>(value.toInteger());
-
-        case ValueType::Float:
-            return *this / static_cast<FloatType>(value.toFloat());
-
-        default:
-            throw generateCastException(__func__);
-    }
+    return visit(ArithmeticVisitor<DivOperation> { "operator/" }, *this, value);
 }
 
 DynamicVariable &DynamicVariable::operator%=(const DynamicVariable &value)
 {
-    if(!value.isType(ValueType::Integer))
-        throw generateCastException(__func__);
-
-    return *this %= static_cast<IntType>(value.toInteger());
+    visitMutable(AssignmentVisitor<ModOperation> { *this, "operator%=" }, *this, value);
+    return *this;
 }
 
 DynamicVariable DynamicVariable::operator%(const DynamicVariable &value) const
 {
-    if(!value.isType(ValueType::Integer))
-        throw generateCastException(__func__);
-
-    return *this % static_cast<IntType>(value.toInteger());
+    return visit(ArithmeticVisitor<ModOperation> { "operator%" }, *this, value);
 }
 
 DynamicVariable::SizeType DynamicVariable::size() const
@@ -450,6 +1032,11 @@ DynamicVariable::SizeType DynamicVariable::size() const
         return toString().size();
     }
 
+    if(isType(ValueType::Object))
+    {
+        return toObject().size();
+    }
+
     throw generateCastException(__func__);
 }
 
@@ -465,11 +1052,16 @@ bool DynamicVariable::isEmpty() const
         return toString().isEmpty();
     }
 
+    if(isType(ValueType::Object))
+    {
+        return toObject().isEmpty();
+    }
+
     throw generateCastException(__func__);
 }
 
 
-DynamicVariable DynamicVariable::operator[](DynamicVariable::SizeType pos)
+DynamicVariable DynamicVariable::operator[](DynamicVariable::SizeType pos) const
 {
     if(isType(ValueType::String))
     {
@@ -485,7 +1077,7 @@ DynamicVariable DynamicVariable::operator[](DynamicVariable::SizeType pos)
 }
 
 
-DynamicVariable DynamicVariable::operator[](StringViewType member)
+DynamicVariable DynamicVariable::operator[](StringViewType member) const
 {
     if(!isType(ValueType::Object))
         throw generateCastException(__func__);
@@ -493,7 +1085,7 @@ DynamicVariable DynamicVariable::operator[](StringViewType member)
     return toObject()[member];
 }
 
-DynamicVariable DynamicVariable::get(StringViewType member)
+DynamicVariable DynamicVariable::get(StringViewType member) const
 {
     if(!isType(ValueType::Object))
         throw generateCastException(__func__);
@@ -506,7 +1098,7 @@ void DynamicVariable::set(StringViewType key, DynamicVariable value)
     if(!isType(ValueType::Object))
         throw generateCastException(__func__);
 
-    return toObject().set(key, value.m_value);
+    return toObject().set(key, value.internalValue());
 }
 void DynamicVariable::unset(StringViewType key)
 {
@@ -516,13 +1108,22 @@ void DynamicVariable::unset(StringViewType key)
     return toObject().unset(key);
 }
 
-void DynamicVariable::push(const DynamicVariable &value) { toArray().push(value.m_value); }
+void DynamicVariable::push(const DynamicVariable &value)
+{
+    if(!std::as_const(*this).toArray().accepts(value.internalValue()))
+        makeGeneric();
+
+    toArray().push(value.internalValue());
+}
 
 DynamicVariable DynamicVariable::pop() { return toArray().pop(); }
 
 void DynamicVariable::insert(const DynamicVariable &value, DynamicVariable::SizeType pos)
 {
-    toArray().insert(value.m_value, pos);
+    if(!std::as_const(*this).toArray().accepts(value.internalValue()))
+        makeGeneric();
+
+    toArray().insert(value.internalValue(), pos);
 }
 
 DynamicVariable DynamicVariable::removeAt(DynamicVariable::SizeType pos)
@@ -530,6 +1131,55 @@ DynamicVariable DynamicVariable::removeAt(DynamicVariable::SizeType pos)
     return toArray().removeAt(pos);
 }
 
+ValueType DynamicVariable::getElementType() const { return toArray().getElementType(); }
+
+bool DynamicVariable::makeDense()
+{
+    const AbstractArrayValue &arr = std::as_const(*this).toArray();
+    if(arr.getElementType() != ValueType::None)
+        return true;
+
+    if(arr.isEmpty() || !arr[0])
+        return false;
+
+    AbstractValue::Ptr dense;
+    switch(arr[0]->getValueType())
+    {
+        case ValueType::Boolean:
+            dense = BoolArrayValue::fromArray(arr);
+            break;
+
+        case ValueType::Integer:
+            dense = IntArrayValue::fromArray(arr);
+            break;
+
+        case ValueType::Float:
+            dense = FloatArrayValue::fromArray(arr);
+            break;
+
+        case ValueType::String:
+            dense = StringArrayValue::fromArray(arr);
+            break;
+
+        default:
+            break;
+    }
+
+    if(!dense)
+        return false;
+
+    m_value = std::move(dense);
+    return true;
+}
+
+void DynamicVariable::makeGeneric()
+{
+    if(getElementType() == ValueType::None)
+        return;
+
+    m_value = std::make_shared<ArrayValue>(operator ArrayType());
+}
+
 void DynamicVariable::clear()
 {
     if(isType(ValueType::Array))
@@ -549,7 +1199,32 @@ void DynamicVariable::clear()
 void DynamicVariable::append(StringViewType str) { toString().append(str); }
 
 DynamicVariable DynamicVariable::subString(DynamicVariable::SizeType from,
-                                           DynamicVariable::SizeType count)
+                                           DynamicVariable::SizeType count) const
 {
     return toString().subString(from, count);
 }
+
+DynamicVariable DynamicVariable::call(FunctionValue::Arguments arguments) const
+{
+    if(!isType(ValueType::Function))
+        throw generateCastException(__func__);
+
+    return nodeAs<FunctionValue>().call(arguments);
+}
+
+void DynamicVariable::freeze() { freezeNode(m_value.get()); }
+
+MemoryUsage DynamicVariable::memoryUsage() const
+{
+    MemoryUsageCounter counter;
+    counter.add(m_value.get());
+    return counter.getUsage();
+}
+
+DynamicVariable DynamicVariable::clone() const
+{
+    if(!m_value)
+        return DynamicVariable();
+
+    return DynamicVariable(m_value->clone());
+}
@@ -0,0 +1,172 @@
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/DynamicVariableRef.h>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef DynamicVariableRef::SizeType SizeType;
+    typedef DynamicVariableRef::StringType StringType;
+
+    const AbstractArrayValue &asArray(const AbstractValue *node)
+    {
+        return static_cast<const AbstractArrayValue &>(*node);
+    }
+
+    template<typename T>
+    const typename TypedArrayTraits<T>::StorageType &getDenseCell(const AbstractValue *array,
+                                                                  SizeType pos)
+    {
+        return static_cast<const TypedArrayValue<T> &>(*array).at(pos);
+    }
+} // namespace
+
+ValueType DynamicVariableRef::getValueType() const
+{
+    if(m_cell == npos)
+        return getNodeType(m_node);
+
+    return asArray(m_node).getElementType();
+}
+
+DynamicVariableRef::SizeType DynamicVariableRef::size() const
+{
+    switch(getValueType())
+    {
+        case ValueType::String:
+            return static_cast<StringViewType>(*this).size();
+
+        case ValueType::Array:
+            return asArray(m_node).size();
+
+        case ValueType::Object:
+            return static_cast<const AbstractObjectValue &>(*m_node).size();
+
+        default:
+            throw generateCastException(__func__);
+    }
+}
+
+DynamicVariableRef DynamicVariableRef::operator[](SizeType pos) const
+{
+    if(!isType(ValueType::Array))
+        throw generateCastException(__func__);
+
+    const AbstractArrayValue &array = asArray(m_node);
+    if(pos >= array.size())
+        throw std::out_of_range("DynamicVariableRef: index " + std::to_string(pos) +
+                                " is out of range");
+
+    if(array.getElementType() != ValueType::None)
+        return DynamicVariableRef(m_node, pos);
+
+    return makeChild(array.findSlot(pos));
+}
+
+DynamicVariableRef DynamicVariableRef::operator[](StringViewType member) const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    return makeChild(static_cast<const AbstractObjectValue &>(*m_node).findSlot(member));
+}
+
+DynamicVariableRef DynamicVariableRef::operator[](const InternedString &member) const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    return makeChild(static_cast<const AbstractObjectValue &>(*m_node).findSlot(member));
+}
+
+bool DynamicVariableRef::hasMember(StringViewType member) const
+{
+    return isType(ValueType::Object) &&
+           static_cast<const AbstractObjectValue &>(*m_node).findSlot(member) != nullptr;
+}
+
+void DynamicVariableRef::forEachCell(
+  const std::function<void(const DynamicVariableRef &)> &function) const
+{
+    for(SizeType i = 0, imax = size(); i < imax; ++i)
+        function(operator[](i));
+}
+
+void DynamicVariableRef::forEachMember(
+  const std::function<void(const InternedString &, const DynamicVariableRef &)> &function) const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    static_cast<const AbstractObjectValue &>(*m_node).forEachMember(
+      [&function](const InternedString &member, const AbstractValue::Ptr &value) {
+          function(member, DynamicVariableRef(value.get()));
+      });
+}
+
+DynamicVariableRef::operator bool() const
+{
+    if(!isType(ValueType::Boolean))
+        throw generateCastException(__func__);
+
+    if(m_cell != npos)
+        return getDenseCell<bool>(m_node, m_cell) != 0;
+
+    return static_cast<bool>(static_cast<const BoolValue &>(*m_node));
+}
+
+DynamicVariableRef::operator StringViewType() const
+{
+    if(!isType(ValueType::String))
+        throw generateCastException(__func__);
+
+    if(m_cell != npos)
+        return getDenseCell<StringType>(m_node, m_cell);
+
+    return static_cast<const StringType &>(static_cast<const StringValue &>(*m_node));
+}
+
+bool DynamicVariableRef::operator==(StringViewType value) const
+{
+    return isType(ValueType::String) && static_cast<StringViewType>(*this) == value;
+}
+
+DynamicVariable DynamicVariableRef::toVariable() const
+{
+    switch(getValueType())
+    {
+        case ValueType::None:
+            return DynamicVariable();
+
+        case ValueType::Boolean:
+            return DynamicVariable(static_cast<bool>(*this));
+
+        case ValueType::Integer:
+            return DynamicVariable(toInteger());
+
+        case ValueType::Float:
+            return DynamicVariable(toFloat());
+
+        case ValueType::String:
+            return DynamicVariable(static_cast<StringViewType>(*this));
+
+        default:
+            return DynamicVariable(m_node->copy());
+    }
+}
+
+DynamicVariableRef::IntType DynamicVariableRef::toInteger() const
+{
+    if(m_cell != npos)
+        return getDenseCell<IntType>(m_node, m_cell);
+
+    return static_cast<IntType>(static_cast<const IntValue &>(*m_node));
+}
+
+DynamicVariableRef::FloatType DynamicVariableRef::toFloat() const
+{
+    if(m_cell != npos)
+        return getDenseCell<FloatType>(m_node, m_cell);
+
+    return static_cast<FloatType>(static_cast<const FloatValue &>(*m_node));
+}
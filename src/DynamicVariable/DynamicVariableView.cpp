@@ -0,0 +1,600 @@
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/DynamicVariableView.h>
+
+#include <charconv>
+#include <string>
+#include <type_traits>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef DynamicVariableView::StringViewType StringViewType;
+    typedef DynamicVariableView::StringType StringType;
+    typedef DynamicVariableView::CharType CharType;
+
+    std::runtime_error generateParseException(const std::string &what, size_t pos)
+    {
+        return std::runtime_error("DynamicVariableView: " + what + " at offset " +
+                                  std::to_string(pos));
+    }
+
+    bool isWhitespace(CharType c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+    bool isDelimiter(CharType c) { return isWhitespace(c) || c == ',' || c == ']' || c == '}'; }
+
+    size_t skipWhitespace(StringViewType buffer, size_t pos)
+    {
+        while(pos < buffer.size() && isWhitespace(buffer[pos]))
+            ++pos;
+
+        return pos;
+    }
+
+    size_t expect(StringViewType buffer, size_t pos, CharType c)
+    {
+        pos = skipWhitespace(buffer, pos);
+        if(pos >= buffer.size() || buffer[pos] != c)
+            throw generateParseException(std::string("expected '") + static_cast<char>(c) + "'",
+                                         pos);
+
+        return pos + 1;
+    }
+
+    size_t skipString(StringViewType buffer, size_t pos)
+    {
+        for(++pos; pos < buffer.size(); ++pos)
+        {
+            if(buffer[pos] == '\\')
+                ++pos;
+            else if(buffer[pos] == '"')
+                return pos + 1;
+        }
+
+        throw generateParseException("unterminated string", pos);
+    }
+
+    size_t skipValue(StringViewType buffer, size_t pos)
+    {
+        pos = skipWhitespace(buffer, pos);
+        if(pos >= buffer.size())
+            throw generateParseException("unexpected end of buffer", pos);
+
+        if(buffer[pos] == '"')
+            return skipString(buffer, pos);
+
+        if(buffer[pos] != '{' && buffer[pos] != '[')
+        {
+            size_t end = pos;
+            while(end < buffer.size() && !isDelimiter(buffer[end]))
+                ++end;
+
+            return end;
+        }
+
+        size_t depth = 0;
+        while(pos < buffer.size())
+        {
+            CharType c = buffer[pos];
+            if(c == '"')
+            {
+                pos = skipString(buffer, pos);
+                continue;
+            }
+
+            if(c == '{' || c == '[')
+            {
+                ++depth;
+            }
+            else if((c == '}' || c == ']') && --depth == 0)
+            {
+                return pos + 1;
+            }
+
+            ++pos;
+        }
+
+        throw generateParseException("unterminated container", pos);
+    }
+
+    /**
+     * @brief Calls f(keyPos, valuePos) for each member of the object starting at pos, or
+     * f(valuePos, valuePos) for each cell of an array. Iteration stops when f returns false.
+     */
+    template<typename F>
+    void forEachChild(StringViewType buffer, F f)
+    {
+        const bool isObject = buffer[0] == '{';
+        const CharType closing = isObject ? '}' : ']';
+        size_t pos = skipWhitespace(buffer, 1);
+        if(pos < buffer.size() && buffer[pos] == closing)
+            return;
+
+        while(true)
+        {
+            pos = skipWhitespace(buffer, pos);
+            size_t keyPos = pos;
+            if(isObject)
+            {
+                if(pos >= buffer.size() || buffer[pos] != '"')
+                    throw generateParseException("expected member name", pos);
+
+                pos = expect(buffer, skipString(buffer, pos), ':');
+                pos = skipWhitespace(buffer, pos);
+            }
+
+            if(!f(keyPos, pos))
+                return;
+
+            pos = skipWhitespace(buffer, skipValue(buffer, pos));
+            if(pos >= buffer.size())
+                throw generateParseException("unterminated container", pos);
+
+            if(buffer[pos] == closing)
+                return;
+
+            if(buffer[pos] != ',')
+                throw generateParseException("expected ','", pos);
+
+            ++pos;
+        }
+    }
+
+    void appendCodePoint(StringType &result, uint32_t codePoint)
+    {
+        if constexpr(sizeof(CharType) == 1)
+        {
+            if(codePoint < 0x80)
+            {
+                result.push_back(static_cast<CharType>(codePoint));
+            }
+            else if(codePoint < 0x800)
+            {
+                result.push_back(static_cast<CharType>(0xC0 | (codePoint >> 6)));
+                result.push_back(static_cast<CharType>(0x80 | (codePoint & 0x3F)));
+            }
+            else if(codePoint < 0x10000)
+            {
+                result.push_back(static_cast<CharType>(0xE0 | (codePoint >> 12)));
+                result.push_back(static_cast<CharType>(0x80 | ((codePoint >> 6) & 0x3F)));
+                result.push_back(static_cast<CharType>(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                result.push_back(static_cast<CharType>(0xF0 | (codePoint >> 18)));
+                result.push_back(static_cast<CharType>(0x80 | ((codePoint >> 12) & 0x3F)));
+                result.push_back(static_cast<CharType>(0x80 | ((codePoint >> 6) & 0x3F)));
+                result.push_back(static_cast<CharType>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+        else
+        {
+            result.push_back(static_cast<CharType>(codePoint));
+        }
+    }
+
+    uint32_t parseHex4(StringViewType buffer, size_t pos)
+    {
+        if(pos + 4 > buffer.size())
+            throw generateParseException("truncated unicode escape", pos);
+
+        uint32_t result = 0;
+        for(size_t i = pos; i < pos + 4; ++i)
+        {
+            CharType c = buffer[i];
+            result <<= 4;
+            if(c >= '0' && c <= '9')
+                result |= static_cast<uint32_t>(c - '0');
+            else if(c >= 'a' && c <= 'f')
+                result |= static_cast<uint32_t>(c - 'a' + 10);
+            else if(c >= 'A' && c <= 'F')
+                result |= static_cast<uint32_t>(c - 'A' + 10);
+            else
+                throw generateParseException("invalid unicode escape", i);
+        }
+
+        return result;
+    }
+
+    StringType decodeString(StringViewType buffer, size_t pos)
+    {
+        size_t end = skipString(buffer, pos) - 1;
+        StringType result;
+        result.reserve(end - pos - 1);
+        for(++pos; pos < end; ++pos)
+        {
+            if(buffer[pos] != '\\')
+            {
+                result.push_back(buffer[pos]);
+                continue;
+            }
+
+            switch(buffer[++pos])
+            {
+                case 'b':
+                    result.push_back('\b');
+                    break;
+
+                case 'f':
+                    result.push_back('\f');
+                    break;
+
+                case 'n':
+                    result.push_back('\n');
+                    break;
+
+                case 'r':
+                    result.push_back('\r');
+                    break;
+
+                case 't':
+                    result.push_back('\t');
+                    break;
+
+                case 'u':
+                {
+                    uint32_t codePoint = parseHex4(buffer, pos + 1);
+                    pos += 4;
+                    if(codePoint >= 0xD800 && codePoint < 0xDC00 && pos + 2 < end &&
+                       buffer[pos + 1] == '\\' && buffer[pos + 2] == 'u')
+                    {
+                        uint32_t low = parseHex4(buffer, pos + 3);
+                        if(low >= 0xDC00 && low < 0xE000)
+                        {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                            pos += 6;
+                        }
+                    }
+
+                    appendCodePoint(result, codePoint);
+                    break;
+                }
+
+                default:
+                    result.push_back(buffer[pos]);
+                    break;
+            }
+        }
+
+        return result;
+    }
+
+    bool stringEquals(StringViewType buffer, size_t pos, StringViewType value)
+    {
+        size_t end = skipString(buffer, pos) - 1;
+        StringViewType raw = buffer.substr(pos + 1, end - pos - 1);
+        if(raw.find('\\') == StringViewType::npos)
+            return raw == value;
+
+        return decodeString(buffer, pos) == value;
+    }
+
+    /**
+     * @brief Parses the whole number token at the beginning of buffer, whatever its length
+     *
+     * @return false if the token is not a number of type T
+     */
+    template<typename T>
+    bool parseNumber(StringViewType buffer, T &result)
+    {
+        size_t size = 0;
+        while(size < buffer.size() && !isDelimiter(buffer[size]))
+            ++size;
+
+        if constexpr(std::is_same_v<CharType, char>)
+        {
+            auto [end, error] = std::from_chars(buffer.data(), buffer.data() + size, result);
+            return error == std::errc() && end == buffer.data() + size;
+        }
+        else
+        {
+            std::string narrow;
+            narrow.reserve(size);
+            for(size_t i = 0; i < size; ++i)
+            {
+                if(static_cast<uint32_t>(buffer[i]) > 0x7F)
+                    return false;
+
+                narrow.push_back(static_cast<char>(buffer[i]));
+            }
+
+            auto [end, error] = std::from_chars(narrow.data(), narrow.data() + size, result);
+            return error == std::errc() && end == narrow.data() + size;
+        }
+    }
+
+    /**
+     * @brief Checks that buffer starts with the whole token literal
+     */
+    bool isLiteral(StringViewType buffer, const char *literal)
+    {
+        size_t size = 0;
+        for(; literal[size] != '\0'; ++size)
+        {
+            if(size >= buffer.size() || buffer[size] != static_cast<CharType>(literal[size]))
+                return false;
+        }
+
+        return size == buffer.size() || isDelimiter(buffer[size]);
+    }
+} // namespace
+
+DynamicVariableView::DynamicVariableView(StringViewType buffer)
+{
+    size_t pos = skipWhitespace(buffer, 0);
+    m_node = buffer.substr(pos);
+}
+
+ValueType DynamicVariableView::getValueType() const
+{
+    if(m_node.empty())
+        return ValueType::None;
+
+    switch(m_node[0])
+    {
+        case '{':
+            return ValueType::Object;
+
+        case '[':
+            return ValueType::Array;
+
+        case '"':
+            return ValueType::String;
+
+        case 't':
+        case 'f':
+            if(!isLiteral(m_node, m_node[0] == 't' ? "true" : "false"))
+                throw generateParseException("invalid value", 0);
+
+            return ValueType::Boolean;
+
+        case 'n':
+            if(!isLiteral(m_node, "null"))
+                throw generateParseException("invalid value", 0);
+
+            return ValueType::None;
+
+        default:
+            break;
+    }
+
+    if(m_node[0] != '-' && (m_node[0] < '0' || m_node[0] > '9'))
+        throw generateParseException("invalid value", 0);
+
+    for(CharType c: m_node)
+    {
+        if(isDelimiter(c))
+            break;
+
+        if(c == '.' || c == 'e' || c == 'E')
+            return ValueType::Float;
+    }
+
+    return ValueType::Integer;
+}
+
+DynamicVariableView::SizeType DynamicVariableView::size() const
+{
+    switch(getValueType())
+    {
+        case ValueType::String:
+            return decodeString(m_node, 0).size();
+
+        case ValueType::Array:
+        case ValueType::Object:
+        {
+            SizeType result = 0;
+            forEachChild(m_node, [&result](size_t, size_t) {
+                ++result;
+                return true;
+            });
+
+            return result;
+        }
+
+        default:
+            throw generateCastException(__func__);
+    }
+}
+
+bool DynamicVariableView::isEmpty() const
+{
+    switch(getValueType())
+    {
+        case ValueType::String:
+            return m_node.size() > 1 && m_node[1] == '"';
+
+        case ValueType::Array:
+        case ValueType::Object:
+        {
+            bool result = true;
+            forEachChild(m_node, [&result](size_t, size_t) {
+                result = false;
+                return false;
+            });
+
+            return result;
+        }
+
+        default:
+            throw generateCastException(__func__);
+    }
+}
+
+DynamicVariableView DynamicVariableView::operator[](SizeType pos) const
+{
+    if(!isType(ValueType::Array))
+        throw generateCastException(__func__);
+
+    DynamicVariableView result;
+    SizeType current = 0;
+    forEachChild(m_node, [this, &result, &current, pos](size_t, size_t valuePos) {
+        if(current++ != pos)
+            return true;
+
+        result.m_node = m_node.substr(valuePos);
+        return false;
+    });
+
+    if(result.m_node.empty())
+        throw std::out_of_range(std::string(__func__) + ": index out of range");
+
+    return result;
+}
+
+DynamicVariableView DynamicVariableView::operator[](StringViewType member) const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    DynamicVariableView result;
+    forEachChild(m_node, [this, &result, member](size_t keyPos, size_t valuePos) {
+        if(!stringEquals(m_node, keyPos, member))
+            return true;
+
+        result.m_node = m_node.substr(valuePos);
+        return false;
+    });
+
+    return result;
+}
+
+bool DynamicVariableView::hasMember(StringViewType member) const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    bool result = false;
+    forEachChild(m_node, [this, &result, member](size_t keyPos, size_t) {
+        result = stringEquals(m_node, keyPos, member);
+        return !result;
+    });
+
+    return result;
+}
+
+void DynamicVariableView::forEachCell(
+  const std::function<void(const DynamicVariableView &)> &function) const
+{
+    if(!isType(ValueType::Array))
+        throw generateCastException(__func__);
+
+    forEachChild(m_node, [this, &function](size_t, size_t valuePos) {
+        function(DynamicVariableView(m_node.substr(valuePos)));
+        return true;
+    });
+}
+
+void DynamicVariableView::forEachMember(
+  const std::function<void(const DynamicVariableView &, const DynamicVariableView &)> &function)
+  const
+{
+    if(!isType(ValueType::Object))
+        throw generateCastException(__func__);
+
+    forEachChild(m_node, [this, &function](size_t keyPos, size_t valuePos) {
+        function(DynamicVariableView(m_node.substr(keyPos)),
+                 DynamicVariableView(m_node.substr(valuePos)));
+        return true;
+    });
+}
+
+DynamicVariableView::operator bool() const
+{
+    if(!isType(ValueType::Boolean))
+        throw generateCastException(__func__);
+
+    return m_node[0] == 't';
+}
+
+DynamicVariableView::operator StringType() const
+{
+    if(!isType(ValueType::String))
+        throw generateCastException(__func__);
+
+    return decodeString(m_node, 0);
+}
+
+bool DynamicVariableView::operator==(StringViewType value) const
+{
+    return isType(ValueType::String) && stringEquals(m_node, 0, value);
+}
+
+DynamicVariableView::StringViewType DynamicVariableView::getEncodedValue() const
+{
+    if(m_node.empty())
+        return m_node;
+
+    return m_node.substr(0, skipValue(m_node, 0));
+}
+
+DynamicVariableView::IntType DynamicVariableView::toInteger() const
+{
+    IntType result = 0;
+    if(!parseNumber(m_node, result))
+        throw generateParseException("invalid integer", 0);
+
+    return result;
+}
+
+DynamicVariableView::FloatType DynamicVariableView::toFloat() const
+{
+    double result = 0.0;
+    if(!parseNumber(m_node, result))
+        throw generateParseException("invalid float", 0);
+
+    return static_cast<FloatType>(result);
+}
+
+DynamicVariable DynamicVariableView::toVariable() const { return toVariable(0); }
+
+DynamicVariable DynamicVariableView::toVariable(SizeType depth) const
+{
+    const ValueType type = getValueType();
+    if((type == ValueType::Array || type == ValueType::Object) && depth == MaxDepth)
+        throw generateParseException("nested too deeply", 0);
+
+    switch(type)
+    {
+        case ValueType::None:
+            return DynamicVariable();
+
+        case ValueType::Boolean:
+            return DynamicVariable(static_cast<bool>(*this));
+
+        case ValueType::Integer:
+            return DynamicVariable(toInteger());
+
+        case ValueType::Float:
+            return DynamicVariable(toFloat());
+
+        case ValueType::String:
+            return DynamicVariable(static_cast<StringType>(*this));
+
+        case ValueType::Array:
+        {
+            DynamicVariable result(ValueType::Array);
+            forEachChild(m_node, [this, &result, depth](size_t, size_t valuePos) {
+                result.push(DynamicVariableView(m_node.substr(valuePos)).toVariable(depth + 1));
+                return true;
+            });
+
+            return result;
+        }
+
+        case ValueType::Object:
+        {
+            DynamicVariable result(ValueType::Object);
+            forEachChild(m_node, [this, &result, depth](size_t keyPos, size_t valuePos) {
+                result.set(decodeString(m_node, keyPos),
+                           DynamicVariableView(m_node.substr(valuePos)).toVariable(depth + 1));
+                return true;
+            });
+
+            return result;
+        }
+
+        default:
+            throw generateCastException(__func__);
+    }
+}
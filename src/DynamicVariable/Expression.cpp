@@ -0,0 +1,1574 @@
+#include <FDCore/DynamicVariable/Expression.h>
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef Expression::IntType IntType;
+    typedef Expression::FloatType FloatType;
+    typedef Expression::StringType StringType;
+    typedef Expression::StringViewType StringViewType;
+    typedef Expression::SizeType SizeType;
+    typedef Expression::OpCode OpCode;
+    typedef StringViewType::value_type CharType;
+
+    std::runtime_error generateCastException(const std::string &caller, ValueType type)
+    {
+        return std::runtime_error(caller + ": unsupported action on type " +
+                                  std::to_string(type));
+    }
+
+    std::invalid_argument generateSyntaxError(const std::string &reason, SizeType pos)
+    {
+        return std::invalid_argument("Expression: " + reason + " at position " +
+                                     std::to_string(pos));
+    }
+
+    bool isNumber(ValueType type) { return type == ValueType::Integer || type == ValueType::Float; }
+
+    bool isScalar(ValueType type)
+    {
+        return type == ValueType::Boolean || type == ValueType::Integer ||
+               type == ValueType::Float;
+    }
+
+    int compareFloats(FloatType lhs, FloatType rhs)
+    {
+        const bool lhsNaN = std::isnan(lhs);
+        const bool rhsNaN = std::isnan(rhs);
+        if(lhsNaN || rhsNaN)
+            return static_cast<int>(lhsNaN) - static_cast<int>(rhsNaN);
+
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+
+    IntType divideIntegers(IntType lhs, IntType rhs)
+    {
+        if(rhs == 0)
+            throw std::domain_error("Expression: integer division by zero");
+        if(rhs == -1 && lhs == std::numeric_limits<IntType>::min())
+            throw std::overflow_error("Expression: integer division overflow");
+
+        return lhs / rhs;
+    }
+
+    IntType moduloIntegers(IntType lhs, IntType rhs)
+    {
+        if(rhs == 0)
+            throw std::domain_error("Expression: integer division by zero");
+
+        // the remainder by -1 is always 0, computing it traps for the smallest integer
+        return rhs == -1 ? 0 : lhs % rhs;
+    }
+
+    struct AddOperation
+    {
+        constexpr static bool supportsFloat = true;
+
+        template<typename T>
+        static T apply(const T &lhs, const T &rhs)
+        {
+            return lhs + rhs;
+        }
+    };
+
+    struct SubtractOperation
+    {
+        constexpr static bool supportsFloat = true;
+
+        template<typename T>
+        static T apply(const T &lhs, const T &rhs)
+        {
+            return lhs - rhs;
+        }
+    };
+
+    struct MultiplyOperation
+    {
+        constexpr static bool supportsFloat = true;
+
+        template<typename T>
+        static T apply(const T &lhs, const T &rhs)
+        {
+            return lhs * rhs;
+        }
+    };
+
+    struct DivideOperation
+    {
+        constexpr static bool supportsFloat = true;
+
+        static IntType apply(IntType lhs, IntType rhs) { return divideIntegers(lhs, rhs); }
+        static FloatType apply(FloatType lhs, FloatType rhs) { return lhs / rhs; }
+
+        static DynamicVariable apply(const DynamicVariable &lhs, const DynamicVariable &rhs)
+        {
+            return lhs / rhs;
+        }
+    };
+
+    /**
+     * @brief Only defined for integers, the other types are rejected by DynamicVariable
+     */
+    struct ModuloOperation
+    {
+        constexpr static bool supportsFloat = false;
+
+        static IntType apply(IntType lhs, IntType rhs) { return moduloIntegers(lhs, rhs); }
+
+        static DynamicVariable apply(const DynamicVariable &lhs, const DynamicVariable &rhs)
+        {
+            return lhs % rhs;
+        }
+    };
+} // namespace
+
+struct Expression::Register
+{
+    ValueType type;
+
+    union
+    {
+        bool boolean;
+        IntType integer;
+        FloatType real;
+    };
+
+    /**
+     * @brief Node of a record or of a constant, valid during the evaluation
+     */
+    const AbstractValue::Ptr *borrowed;
+
+    /**
+     * @brief Node computed during the evaluation
+     */
+    AbstractValue::Ptr owned;
+
+    Register() : type(ValueType::None), integer(0), borrowed(nullptr) {}
+
+    const AbstractValue::Ptr &getPointer() const { return borrowed ? *borrowed : owned; }
+
+    void setNone() { type = ValueType::None; }
+
+    void setBoolean(bool value)
+    {
+        type = ValueType::Boolean;
+        boolean = value;
+    }
+
+    void setInteger(IntType value)
+    {
+        type = ValueType::Integer;
+        integer = value;
+    }
+
+    void setFloat(FloatType value)
+    {
+        type = ValueType::Float;
+        real = value;
+    }
+
+    /**
+     * @brief Loads the node of slot, unboxing scalars and borrowing the other nodes
+     */
+    void load(const AbstractValue::Ptr *slot)
+    {
+        if(!loadScalar(slot ? slot->get() : nullptr))
+        {
+            type = (*slot)->getValueType();
+            borrowed = slot;
+        }
+    }
+
+    void load(AbstractValue::Ptr node)
+    {
+        if(!loadScalar(node.get()))
+        {
+            type = node->getValueType();
+            borrowed = nullptr;
+            owned = std::move(node);
+        }
+    }
+
+    void load(const DynamicVariable &value) { load(value.internalValue()); }
+
+    DynamicVariable toVariable() const
+    {
+        switch(type)
+        {
+            case ValueType::None:
+                return DynamicVariable();
+
+            case ValueType::Boolean:
+                return DynamicVariable(boolean);
+
+            case ValueType::Integer:
+                return DynamicVariable(integer);
+
+            case ValueType::Float:
+                return DynamicVariable(real);
+
+            default:
+                return DynamicVariable(getPointer());
+        }
+    }
+
+    FloatType toFloat() const
+    {
+        return type == ValueType::Integer ? static_cast<FloatType>(integer) : real;
+    }
+
+    bool toBoolean(const char *caller) const
+    {
+        if(type != ValueType::Boolean)
+            throw generateCastException(caller, type);
+
+        return boolean;
+    }
+
+  private:
+    bool loadScalar(const AbstractValue *node)
+    {
+        switch(getNodeType(node))
+        {
+            case ValueType::None:
+                setNone();
+                return true;
+
+            case ValueType::Boolean:
+                setBoolean(static_cast<bool>(static_cast<const BoolValue &>(*node)));
+                return true;
+
+            case ValueType::Integer:
+                setInteger(static_cast<IntType>(static_cast<const IntValue &>(*node)));
+                return true;
+
+            case ValueType::Float:
+                setFloat(static_cast<FloatType>(static_cast<const FloatValue &>(*node)));
+                return true;
+
+            default:
+                return false;
+        }
+    }
+};
+
+namespace
+{
+    typedef Expression::Register Register;
+
+    template<typename Operation>
+    void applyArithmetic(Register &lhs, const Register &rhs)
+    {
+        if(lhs.type == ValueType::Integer && rhs.type == ValueType::Integer)
+        {
+            lhs.integer = Operation::apply(lhs.integer, rhs.integer);
+            return;
+        }
+
+        if constexpr(Operation::supportsFloat)
+        {
+            if(isNumber(lhs.type) && isNumber(rhs.type))
+            {
+                lhs.setFloat(Operation::apply(lhs.toFloat(), rhs.toFloat()));
+                return;
+            }
+        }
+
+        lhs.load(Operation::apply(lhs.toVariable(), rhs.toVariable()));
+    }
+
+    void applyNegate(Register &value)
+    {
+        if(value.type == ValueType::Integer)
+            value.integer = -value.integer;
+        else if(value.type == ValueType::Float)
+            value.real = -value.real;
+        else
+            value.load(-value.toVariable());
+    }
+
+    /**
+     * @brief NaN is equal to NaN, as for DynamicVariable::operator==()
+     */
+    bool equalFloats(FloatType lhs, FloatType rhs)
+    {
+        return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+    }
+
+    bool equalRegisters(const Register &lhs, const Register &rhs)
+    {
+        if(lhs.type != rhs.type)
+            return false;
+
+        switch(lhs.type)
+        {
+            case ValueType::None:
+                return true;
+
+            case ValueType::Boolean:
+                return lhs.boolean == rhs.boolean;
+
+            case ValueType::Integer:
+                return lhs.integer == rhs.integer;
+
+            case ValueType::Float:
+                return equalFloats(lhs.real, rhs.real);
+
+            case ValueType::String:
+                return static_cast<const StringValue &>(*lhs.getPointer()) ==
+                       static_cast<const StringValue &>(*rhs.getPointer());
+
+            default:
+                return lhs.toVariable() == rhs.toVariable();
+        }
+    }
+
+    /**
+     * @brief Same order as DynamicVariable::compare()
+     */
+    int compareRegisters(const Register &lhs, const Register &rhs)
+    {
+        if(lhs.type == ValueType::Integer && rhs.type == ValueType::Integer)
+            return lhs.integer < rhs.integer ? -1 : (rhs.integer < lhs.integer ? 1 : 0);
+
+        if(lhs.type == ValueType::Float && rhs.type == ValueType::Float)
+            return compareFloats(lhs.real, rhs.real);
+
+        return lhs.toVariable().compare(rhs.toVariable());
+    }
+
+    template<typename Compare>
+    void applyComparison(Register &lhs, const Register &rhs)
+    {
+        lhs.setBoolean(Compare()(compareRegisters(lhs, rhs), 0));
+    }
+
+    template<typename Compare>
+    void applyFloatComparison(Register &lhs, const Register &rhs)
+    {
+        lhs.setBoolean(Compare()(compareFloats(lhs.real, rhs.real), 0));
+    }
+
+    template<typename Compare>
+    void applyIntegerComparison(Register &lhs, const Register &rhs)
+    {
+        lhs.setBoolean(Compare()(lhs.integer, rhs.integer));
+    }
+} // namespace
+
+/**
+ * @brief Parses the source into a tree of operations, folds its constant subtrees and emits the
+ * bytecode of the tree
+ */
+class Expression::Compiler
+{
+  private:
+    enum class NodeKind
+    {
+        Constant,
+        Field,
+        Unary,
+        Binary,
+        And,
+        Or,
+        Conditional,
+        Call
+    };
+
+    struct Node
+    {
+        NodeKind kind;
+        OpCode code = OpCode::Constant;
+        SizeType index = 0;
+        DynamicVariable value;
+        std::vector<Node> children;
+
+        /**
+         * @brief Type of the value of the node when typed is true
+         */
+        ValueType type = ValueType::None;
+        bool typed = false;
+
+        /**
+         * @brief Number of nodes on the longest path from this node to a leaf
+         */
+        SizeType height = 1;
+    };
+
+    /**
+     * @brief Counts the nested calls of the recursive descent, which runs on the native stack
+     */
+    class NestingGuard
+    {
+      private:
+        SizeType &m_nesting;
+
+      public:
+        NestingGuard(SizeType &nesting, SizeType pos) : m_nesting(nesting)
+        {
+            if(m_nesting == MaxDepth)
+                throw generateSyntaxError("expression nested too deeply", pos);
+            ++m_nesting;
+        }
+
+        ~NestingGuard() { --m_nesting; }
+    };
+
+    StringViewType m_source;
+    SizeType m_pos;
+    const ExpressionEnvironment &m_environment;
+    Expression &m_target;
+    std::unordered_map<StringType, SizeType> m_fieldIndices;
+    std::vector<ValueType> m_fieldTypes;
+    SizeType m_depth;
+    SizeType m_nesting;
+
+  public:
+    Compiler(StringViewType source, const ExpressionEnvironment &environment, Expression &target) :
+        m_source(source),
+        m_pos(0),
+        m_environment(environment),
+        m_target(target),
+        m_depth(0),
+        m_nesting(0)
+    {
+    }
+
+    void compile()
+    {
+        Node root = parseConditional();
+        skipSpaces();
+        if(m_pos != m_source.size())
+            throw generateSyntaxError("unexpected character", m_pos);
+
+        reset();
+        emit(root);
+        m_target.m_resultType = root.type;
+        m_target.m_isResultTyped = root.typed;
+    }
+
+  private:
+    void reset()
+    {
+        m_target.m_code.clear();
+        m_target.m_constants.clear();
+        m_target.m_stackSize = 0;
+        m_depth = 0;
+    }
+
+    static Node makeConstant(DynamicVariable value)
+    {
+        Node result;
+        result.kind = NodeKind::Constant;
+        result.type = value.getValueType();
+        result.typed = true;
+        result.value = std::move(value);
+        return result;
+    }
+
+    static Node makeOperation(NodeKind kind, OpCode code, std::vector<Node> children)
+    {
+        Node result;
+        result.kind = kind;
+        result.code = code;
+        result.children = std::move(children);
+        return result;
+    }
+
+    /**
+     * @brief Types the result of node and replaces it by a constant if all its operands are
+     * constant. Operations that throw are not folded, they throw when they are evaluated.
+     */
+    Node finish(Node node)
+    {
+        measure(node);
+        inferType(node);
+        if(node.kind == NodeKind::Field || node.kind == NodeKind::Call ||
+           node.kind == NodeKind::Constant)
+            return node;
+
+        for(const Node &child: node.children)
+        {
+            if(child.kind != NodeKind::Constant)
+                return node;
+        }
+
+        Expression folded;
+        Compiler compiler(m_source, m_environment, folded);
+        compiler.reset();
+        compiler.emit(node);
+        try
+        {
+            return makeConstant(folded.evaluate(DynamicVariable()));
+        }
+        catch(const std::exception &)
+        {
+            return node;
+        }
+    }
+
+    /**
+     * @brief Sets the height of node, the compiler and the machine recurse on it
+     */
+    void measure(Node &node) const
+    {
+        node.height = 1;
+        for(const Node &child: node.children)
+            node.height = std::max<SizeType>(node.height, child.height + 1);
+
+        if(node.height > MaxDepth)
+            throw generateSyntaxError("expression nested too deeply", m_pos);
+    }
+
+    static bool isTyped(const Node &node, ValueType type)
+    {
+        return node.typed && node.type == type;
+    }
+
+    static void setType(Node &node, ValueType type)
+    {
+        node.type = type;
+        node.typed = true;
+    }
+
+    static void inferType(Node &node)
+    {
+        switch(node.kind)
+        {
+            case NodeKind::Unary:
+            {
+                const Node &operand = node.children[0];
+                if(node.code == OpCode::Not)
+                    setType(node, ValueType::Boolean);
+                else if(operand.typed && isNumber(operand.type))
+                    setType(node, operand.type);
+
+                break;
+            }
+
+            case NodeKind::Binary:
+                inferBinaryType(node);
+                break;
+
+            case NodeKind::And:
+            case NodeKind::Or:
+                setType(node, ValueType::Boolean);
+                break;
+
+            case NodeKind::Conditional:
+                if(node.children[1].typed && isTyped(node.children[2], node.children[1].type))
+                    setType(node, node.children[1].type);
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    static void inferBinaryType(Node &node)
+    {
+        const Node &lhs = node.children[0];
+        const Node &rhs = node.children[1];
+        switch(node.code)
+        {
+            case OpCode::Add:
+                if(isTyped(lhs, ValueType::String) && isTyped(rhs, ValueType::String))
+                {
+                    setType(node, ValueType::String);
+                    break;
+                }
+
+                [[fallthrough]];
+
+            case OpCode::Subtract:
+            case OpCode::Multiply:
+            case OpCode::Divide:
+                if(isTyped(lhs, ValueType::Integer) && isTyped(rhs, ValueType::Integer))
+                    setType(node, ValueType::Integer);
+                else if(lhs.typed && rhs.typed && isNumber(lhs.type) && isNumber(rhs.type))
+                    setType(node, ValueType::Float);
+
+                break;
+
+            case OpCode::Modulo:
+                if(isTyped(lhs, ValueType::Integer) && isTyped(rhs, ValueType::Integer))
+                    setType(node, ValueType::Integer);
+
+                break;
+
+            default:
+                setType(node, ValueType::Boolean);
+                break;
+        }
+    }
+
+    /**
+     * @brief Instruction specialized for the types of the operands of node, code itself if
+     * they are not known or differ
+     */
+    static OpCode specialize(const Node &node)
+    {
+        constexpr int integerOffset = static_cast<int>(OpCode::AddInteger) -
+                                      static_cast<int>(OpCode::Add);
+        constexpr int floatOffset = static_cast<int>(OpCode::AddFloat) -
+                                    static_cast<int>(OpCode::Add);
+        constexpr int integerComparisonOffset = static_cast<int>(OpCode::EqualInteger) -
+                                                static_cast<int>(OpCode::Equal);
+        constexpr int floatComparisonOffset = static_cast<int>(OpCode::EqualFloat) -
+                                              static_cast<int>(OpCode::Equal);
+
+        const int code = static_cast<int>(node.code);
+        const Node &operand = node.children[0];
+        if(node.kind == NodeKind::Unary)
+        {
+            if(node.code == OpCode::Negate && isTyped(operand, ValueType::Integer))
+                return OpCode::NegateInteger;
+
+            if(node.code == OpCode::Negate && isTyped(operand, ValueType::Float))
+                return OpCode::NegateFloat;
+
+            return node.code;
+        }
+
+        const Node &rhs = node.children[1];
+        const bool integers = isTyped(operand, ValueType::Integer) &&
+                              isTyped(rhs, ValueType::Integer);
+        const bool floats = isTyped(operand, ValueType::Float) && isTyped(rhs, ValueType::Float);
+        if(node.code >= OpCode::Add && node.code <= OpCode::Modulo)
+        {
+            if(integers)
+                return static_cast<OpCode>(code + integerOffset);
+
+            if(floats && node.code != OpCode::Modulo)
+                return static_cast<OpCode>(code + floatOffset);
+        }
+        else if(integers)
+        {
+            return static_cast<OpCode>(code + integerComparisonOffset);
+        }
+        else if(floats)
+        {
+            return static_cast<OpCode>(code + floatComparisonOffset);
+        }
+
+        return node.code;
+    }
+
+    void push(OpCode code, uint32_t operand = 0, uint8_t count = 0)
+    {
+        m_target.m_code.push_back({ code, count, operand });
+    }
+
+    /**
+     * @brief Adds a jump whose target is set later by bind()
+     */
+    SizeType pushJump(OpCode code)
+    {
+        push(code);
+        return m_target.m_code.size() - 1;
+    }
+
+    void bind(SizeType jump)
+    {
+        m_target.m_code[jump].operand = static_cast<uint32_t>(m_target.m_code.size());
+    }
+
+    void grow(SizeType count)
+    {
+        m_depth += count;
+        m_target.m_stackSize = std::max(m_target.m_stackSize, m_depth);
+    }
+
+    void pushConstant(const DynamicVariable &value)
+    {
+        push(OpCode::Constant, static_cast<uint32_t>(m_target.m_constants.size()));
+        m_target.m_constants.push_back(value.internalValue());
+        grow(1);
+    }
+
+    void emit(const Node &node)
+    {
+        switch(node.kind)
+        {
+            case NodeKind::Constant:
+                pushConstant(node.value);
+                break;
+
+            case NodeKind::Field:
+                emitField(node);
+                break;
+
+            case NodeKind::Unary:
+                emit(node.children[0]);
+                push(specialize(node));
+                break;
+
+            case NodeKind::Binary:
+                emit(node.children[0]);
+                emit(node.children[1]);
+                push(specialize(node));
+                --m_depth;
+                break;
+
+            case NodeKind::And:
+            case NodeKind::Or:
+            {
+                const bool isAnd = node.kind == NodeKind::And;
+                emit(node.children[0]);
+                const SizeType shortCut =
+                  pushJump(isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue);
+                --m_depth;
+                emit(node.children[1]);
+                push(OpCode::CheckBoolean);
+                const SizeType end = pushJump(OpCode::Jump);
+                --m_depth;
+                bind(shortCut);
+                pushConstant(DynamicVariable(!isAnd));
+                bind(end);
+                break;
+            }
+
+            case NodeKind::Conditional:
+            {
+                emit(node.children[0]);
+                const SizeType otherwise = pushJump(OpCode::JumpIfFalse);
+                --m_depth;
+                emit(node.children[1]);
+                const SizeType end = pushJump(OpCode::Jump);
+                --m_depth;
+                bind(otherwise);
+                emit(node.children[2]);
+                bind(end);
+                break;
+            }
+
+            case NodeKind::Call:
+                for(const Node &argument: node.children)
+                    emit(argument);
+
+                push(OpCode::Call, static_cast<uint32_t>(node.index),
+                     static_cast<uint8_t>(node.children.size()));
+                m_depth -= node.children.size();
+                grow(1);
+                break;
+        }
+    }
+
+    void emitField(const Node &node)
+    {
+        OpCode code = OpCode::Field;
+        if(node.typed)
+        {
+            if(node.type == ValueType::Boolean)
+                code = OpCode::FieldBoolean;
+            else if(node.type == ValueType::Integer)
+                code = OpCode::FieldInteger;
+            else if(node.type == ValueType::Float)
+                code = OpCode::FieldFloat;
+        }
+
+        push(code, static_cast<uint32_t>(node.index));
+        grow(1);
+    }
+
+    void skipSpaces()
+    {
+        while(m_pos < m_source.size() && std::isspace(static_cast<unsigned char>(m_source[m_pos])))
+            ++m_pos;
+    }
+
+    /**
+     * @brief Consumes token if it is the next token of the source
+     */
+    bool accept(StringViewType token)
+    {
+        skipSpaces();
+        if(m_source.substr(m_pos, token.size()) != token)
+            return false;
+
+        m_pos += token.size();
+        return true;
+    }
+
+    void expect(StringViewType token)
+    {
+        if(!accept(token))
+            throw generateSyntaxError("expected '" + std::string(token) + "'", m_pos);
+    }
+
+    Node parseConditional()
+    {
+        Node condition = parseOr();
+        if(!accept("?"))
+            return condition;
+
+        const NestingGuard guard(m_nesting, m_pos);
+        Node then = parseConditional();
+        expect(":");
+        Node otherwise = parseConditional();
+
+        // the branch is chosen when compiling if the condition is constant
+        if(condition.kind == NodeKind::Constant && condition.value.isType(ValueType::Boolean))
+            return static_cast<bool>(condition.value) ? std::move(then) : std::move(otherwise);
+
+        std::vector<Node> children;
+        children.push_back(std::move(condition));
+        children.push_back(std::move(then));
+        children.push_back(std::move(otherwise));
+        return finish(makeOperation(NodeKind::Conditional, OpCode::Jump, std::move(children)));
+    }
+
+    Node parseOr()
+    {
+        Node result = parseAnd();
+        while(accept("||"))
+            result = makeLogical(NodeKind::Or, std::move(result), parseAnd());
+
+        return result;
+    }
+
+    Node parseAnd()
+    {
+        Node result = parseEquality();
+        while(accept("&&"))
+            result = makeLogical(NodeKind::And, std::move(result), parseEquality());
+
+        return result;
+    }
+
+    /**
+     * @brief A constant left operand decides the result or is dropped
+     */
+    Node makeLogical(NodeKind kind, Node lhs, Node rhs)
+    {
+        if(lhs.kind == NodeKind::Constant && lhs.value.isType(ValueType::Boolean))
+        {
+            const bool value = static_cast<bool>(lhs.value);
+            if(value == (kind == NodeKind::Or))
+                return lhs;
+
+            if(isTyped(rhs, ValueType::Boolean))
+                return rhs;
+        }
+
+        std::vector<Node> children;
+        children.push_back(std::move(lhs));
+        children.push_back(std::move(rhs));
+        return finish(makeOperation(kind, OpCode::Jump, std::move(children)));
+    }
+
+    Node makeBinary(OpCode code, Node lhs, Node rhs)
+    {
+        std::vector<Node> children;
+        children.push_back(std::move(lhs));
+        children.push_back(std::move(rhs));
+        return finish(makeOperation(NodeKind::Binary, code, std::move(children)));
+    }
+
+    Node parseEquality()
+    {
+        Node result = parseRelational();
+        while(true)
+        {
+            if(accept("=="))
+                result = makeBinary(OpCode::Equal, std::move(result), parseRelational());
+            else if(accept("!="))
+                result = makeBinary(OpCode::NotEqual, std::move(result), parseRelational());
+            else
+                return result;
+        }
+    }
+
+    Node parseRelational()
+    {
+        Node result = parseAdditive();
+        while(true)
+        {
+            if(accept("<="))
+                result = makeBinary(OpCode::LessEqual, std::move(result), parseAdditive());
+            else if(accept(">="))
+                result = makeBinary(OpCode::GreaterEqual, std::move(result), parseAdditive());
+            else if(accept("<"))
+                result = makeBinary(OpCode::Less, std::move(result), parseAdditive());
+            else if(accept(">"))
+                result = makeBinary(OpCode::Greater, std::move(result), parseAdditive());
+            else
+                return result;
+        }
+    }
+
+    Node parseAdditive()
+    {
+        Node result = parseMultiplicative();
+        while(true)
+        {
+            if(accept("+"))
+                result = makeBinary(OpCode::Add, std::move(result), parseMultiplicative());
+            else if(accept("-"))
+                result = makeBinary(OpCode::Subtract, std::move(result), parseMultiplicative());
+            else
+                return result;
+        }
+    }
+
+    Node parseMultiplicative()
+    {
+        Node result = parseUnary();
+        while(true)
+        {
+            if(accept("*"))
+                result = makeBinary(OpCode::Multiply, std::move(result), parseUnary());
+            else if(accept("/"))
+                result = makeBinary(OpCode::Divide, std::move(result), parseUnary());
+            else if(accept("%"))
+                result = makeBinary(OpCode::Modulo, std::move(result), parseUnary());
+            else
+                return result;
+        }
+    }
+
+    Node parseUnary()
+    {
+        OpCode code;
+        if(accept("-"))
+            code = OpCode::Negate;
+        else if(accept("!"))
+            code = OpCode::Not;
+        else
+            return parsePrimary();
+
+        const NestingGuard guard(m_nesting, m_pos);
+        std::vector<Node> children;
+        children.push_back(parseUnary());
+        return finish(makeOperation(NodeKind::Unary, code, std::move(children)));
+    }
+
+    static bool isIdentifierStart(CharType c)
+    {
+        return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    static bool isDigit(CharType c) { return c >= '0' && c <= '9'; }
+
+    static bool isIdentifierPart(CharType c) { return isIdentifierStart(c) || isDigit(c); }
+
+    StringViewType parseIdentifier()
+    {
+        skipSpaces();
+        const SizeType first = m_pos;
+        if(m_pos < m_source.size() && isIdentifierStart(m_source[m_pos]))
+        {
+            while(m_pos < m_source.size() && isIdentifierPart(m_source[m_pos]))
+                ++m_pos;
+        }
+
+        if(first == m_pos)
+            throw generateSyntaxError("expected a name", m_pos);
+
+        return m_source.substr(first, m_pos - first);
+    }
+
+    Node parsePrimary()
+    {
+        skipSpaces();
+        if(m_pos == m_source.size())
+            throw generateSyntaxError("unexpected end of expression", m_pos);
+
+        const CharType c = m_source[m_pos];
+        if(c == '(')
+        {
+            const NestingGuard guard(m_nesting, m_pos);
+            ++m_pos;
+            Node result = parseConditional();
+            expect(")");
+            return result;
+        }
+
+        if(isDigit(c) || (c == '.' && m_pos + 1 < m_source.size() && isDigit(m_source[m_pos + 1])))
+            return parseNumber();
+
+        if(c == '\'' || c == '"')
+            return makeConstant(DynamicVariable(parseString()));
+
+        if(c == '$')
+        {
+            ++m_pos;
+            return parseField({});
+        }
+
+        const SizeType first = m_pos;
+        const StringViewType name = parseIdentifier();
+        if(name == "true" || name == "false")
+            return makeConstant(DynamicVariable(name == "true"));
+
+        if(name == "null")
+            return makeConstant(DynamicVariable());
+
+        if(accept("("))
+            return parseCall(name, first);
+
+        return parseField({ makeMember(name) });
+    }
+
+    Node parseNumber()
+    {
+        const SizeType first = m_pos;
+        bool isFloat = false;
+        while(m_pos < m_source.size())
+        {
+            const CharType c = m_source[m_pos];
+            if(c == '.' || c == 'e' || c == 'E')
+            {
+                isFloat = true;
+                if(c != '.' && m_pos + 1 < m_source.size() &&
+                   (m_source[m_pos + 1] == '+' || m_source[m_pos + 1] == '-'))
+                    ++m_pos;
+            }
+            else if(!isDigit(c))
+            {
+                break;
+            }
+
+            ++m_pos;
+        }
+
+        const StringViewType token = m_source.substr(first, m_pos - first);
+        const char *end = token.data() + token.size();
+        std::from_chars_result result;
+        DynamicVariable value;
+        if(isFloat)
+        {
+            FloatType number = 0;
+            result = std::from_chars(token.data(), end, number);
+            value = DynamicVariable(number);
+        }
+        else
+        {
+            IntType number = 0;
+            result = std::from_chars(token.data(), end, number);
+            value = DynamicVariable(number);
+        }
+
+        if(result.ec != std::errc() || result.ptr != end)
+            throw generateSyntaxError("invalid number", first);
+
+        return makeConstant(std::move(value));
+    }
+
+    StringType parseString()
+    {
+        const SizeType first = m_pos;
+        const CharType quote = m_source[m_pos++];
+        StringType result;
+        while(m_pos < m_source.size() && m_source[m_pos] != quote)
+        {
+            CharType c = m_source[m_pos++];
+            if(c == '\\' && m_pos < m_source.size())
+            {
+                c = m_source[m_pos++];
+                if(c == 'n')
+                    c = '\n';
+                else if(c == 't')
+                    c = '\t';
+            }
+
+            result.push_back(c);
+        }
+
+        if(m_pos == m_source.size())
+            throw generateSyntaxError("unterminated string", first);
+
+        ++m_pos;
+        return result;
+    }
+
+    static PathQuery::Segment makeMember(StringViewType name)
+    {
+        PathQuery::Segment segment;
+        segment.member = InternedString(name);
+        segment.matchesMember = true;
+        return segment;
+    }
+
+    Node parseField(std::vector<PathQuery::Segment> segments)
+    {
+        while(m_pos < m_source.size())
+        {
+            if(m_source[m_pos] == '.')
+            {
+                ++m_pos;
+                segments.push_back(makeMember(parseIdentifier()));
+            }
+            else if(m_source[m_pos] == '[')
+            {
+                const SizeType first = ++m_pos;
+                while(m_pos < m_source.size() && isDigit(m_source[m_pos]))
+                    ++m_pos;
+
+                PathQuery::Segment segment;
+                const char *end = m_source.data() + m_pos;
+                if(first == m_pos ||
+                   std::from_chars(m_source.data() + first, end, segment.index).ptr != end)
+                    throw generateSyntaxError("expected an index", first);
+
+                expect("]");
+                segments.push_back(segment);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        PathQuery path(std::move(segments));
+        const StringType pointer = path.toPointer();
+        Node result;
+        result.kind = NodeKind::Field;
+        auto it = m_fieldIndices.find(pointer);
+        if(it == m_fieldIndices.end())
+        {
+            it = m_fieldIndices.emplace(pointer, m_target.m_fields.size()).first;
+            m_target.m_fields.push_back(std::move(path));
+        }
+
+        result.index = it->second;
+        auto type = m_environment.fieldTypes.find(pointer);
+        if(type != m_environment.fieldTypes.end() && isScalar(type->second))
+            setType(result, type->second);
+
+        return result;
+    }
+
+    Node parseCall(StringViewType name, SizeType first)
+    {
+        const DynamicVariable &functions = m_environment.functions;
+        DynamicVariable function;
+        if(functions.isType(ValueType::Object))
+            function = functions.get(name);
+
+        if(!function.isType(ValueType::Function))
+            throw generateSyntaxError("unknown function '" + StringType(name) + "'", first);
+
+        Node result;
+        result.kind = NodeKind::Call;
+        result.index = m_target.m_functions.size();
+        m_target.m_functions.push_back(std::move(function));
+        const NestingGuard guard(m_nesting, m_pos);
+        if(!accept(")"))
+        {
+            do
+            {
+                result.children.push_back(parseConditional());
+            } while(accept(","));
+
+            expect(")");
+        }
+
+        if(result.children.size() > std::numeric_limits<uint8_t>::max())
+            throw generateSyntaxError("too many arguments", first);
+
+        measure(result);
+        return result;
+    }
+};
+
+Expression::Expression() :
+    m_code { { OpCode::Constant, 0, 0 } },
+    m_constants { nullptr },
+    m_stackSize(1),
+    m_resultType(ValueType::None),
+    m_isResultTyped(true)
+{
+}
+
+Expression::Expression(StringViewType source, const ExpressionEnvironment &environment) :
+    m_stackSize(0),
+    m_resultType(ValueType::None),
+    m_isResultTyped(false)
+{
+    Compiler(source, environment, *this).compile();
+}
+
+void Expression::run(const AbstractValue::Ptr &record, std::vector<Register> &stack) const
+{
+    if(stack.size() < m_stackSize)
+        stack.resize(m_stackSize);
+
+    Register *top = stack.data() - 1;
+    AbstractValue::Ptr boxed;
+    std::vector<DynamicVariable> arguments;
+    for(size_t pc = 0, end = m_code.size(); pc < end; ++pc)
+    {
+        const Instruction &instruction = m_code[pc];
+        switch(instruction.code)
+        {
+            case OpCode::Constant:
+                (++top)->load(&m_constants[instruction.operand]);
+                break;
+
+            case OpCode::Field:
+            case OpCode::FieldBoolean:
+            case OpCode::FieldInteger:
+            case OpCode::FieldFloat:
+            {
+                const PathQuery &field = m_fields[instruction.operand];
+                const AbstractValue::Ptr *slot = &record;
+                for(const PathQuery::Segment &segment: field.getSegments())
+                {
+                    slot = *slot ? PathQuery::step(**slot, segment, boxed) : nullptr;
+                    if(!slot)
+                        break;
+                }
+
+                ++top;
+                if(slot == &boxed)
+                    top->load(std::move(boxed));
+                else
+                    top->load(slot);
+
+                if(instruction.code == OpCode::Field)
+                    break;
+
+                const ValueType expected =
+                  instruction.code == OpCode::FieldBoolean ?
+                    ValueType::Boolean :
+                    (instruction.code == OpCode::FieldInteger ? ValueType::Integer :
+                                                                ValueType::Float);
+                if(top->type != expected)
+                    throw std::runtime_error("evaluate: field " + field.toPointer() + " is not " +
+                                             std::to_string(expected));
+
+                break;
+            }
+
+            case OpCode::Negate:
+                applyNegate(*top);
+                break;
+
+            case OpCode::NegateInteger:
+                top->integer = -top->integer;
+                break;
+
+            case OpCode::NegateFloat:
+                top->real = -top->real;
+                break;
+
+            case OpCode::Not:
+                top->setBoolean(!top->toBoolean("operator!"));
+                break;
+
+            case OpCode::Add:
+                --top;
+                applyArithmetic<AddOperation>(*top, top[1]);
+                break;
+
+            case OpCode::Subtract:
+                --top;
+                applyArithmetic<SubtractOperation>(*top, top[1]);
+                break;
+
+            case OpCode::Multiply:
+                --top;
+                applyArithmetic<MultiplyOperation>(*top, top[1]);
+                break;
+
+            case OpCode::Divide:
+                --top;
+                applyArithmetic<DivideOperation>(*top, top[1]);
+                break;
+
+            case OpCode::Modulo:
+                --top;
+                applyArithmetic<ModuloOperation>(*top, top[1]);
+                break;
+
+            case OpCode::AddInteger:
+                --top;
+                top->integer += top[1].integer;
+                break;
+
+            case OpCode::SubtractInteger:
+                --top;
+                top->integer -= top[1].integer;
+                break;
+
+            case OpCode::MultiplyInteger:
+                --top;
+                top->integer *= top[1].integer;
+                break;
+
+            case OpCode::DivideInteger:
+                --top;
+                top->integer = divideIntegers(top->integer, top[1].integer);
+                break;
+
+            case OpCode::ModuloInteger:
+                --top;
+                top->integer = moduloIntegers(top->integer, top[1].integer);
+                break;
+
+            case OpCode::AddFloat:
+                --top;
+                top->real += top[1].real;
+                break;
+
+            case OpCode::SubtractFloat:
+                --top;
+                top->real -= top[1].real;
+                break;
+
+            case OpCode::MultiplyFloat:
+                --top;
+                top->real *= top[1].real;
+                break;
+
+            case OpCode::DivideFloat:
+                --top;
+                top->real /= top[1].real;
+                break;
+
+            case OpCode::Equal:
+                --top;
+                top->setBoolean(equalRegisters(*top, top[1]));
+                break;
+
+            case OpCode::NotEqual:
+                --top;
+                top->setBoolean(!equalRegisters(*top, top[1]));
+                break;
+
+            case OpCode::Less:
+                --top;
+                applyComparison<std::less<int>>(*top, top[1]);
+                break;
+
+            case OpCode::LessEqual:
+                --top;
+                applyComparison<std::less_equal<int>>(*top, top[1]);
+                break;
+
+            case OpCode::Greater:
+                --top;
+                applyComparison<std::greater<int>>(*top, top[1]);
+                break;
+
+            case OpCode::GreaterEqual:
+                --top;
+                applyComparison<std::greater_equal<int>>(*top, top[1]);
+                break;
+
+            case OpCode::EqualInteger:
+                --top;
+                applyIntegerComparison<std::equal_to<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::NotEqualInteger:
+                --top;
+                applyIntegerComparison<std::not_equal_to<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::LessInteger:
+                --top;
+                applyIntegerComparison<std::less<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::LessEqualInteger:
+                --top;
+                applyIntegerComparison<std::less_equal<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::GreaterInteger:
+                --top;
+                applyIntegerComparison<std::greater<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::GreaterEqualInteger:
+                --top;
+                applyIntegerComparison<std::greater_equal<IntType>>(*top, top[1]);
+                break;
+
+            case OpCode::EqualFloat:
+                --top;
+                top->setBoolean(equalFloats(top->real, top[1].real));
+                break;
+
+            case OpCode::NotEqualFloat:
+                --top;
+                top->setBoolean(!equalFloats(top->real, top[1].real));
+                break;
+
+            case OpCode::LessFloat:
+                --top;
+                applyFloatComparison<std::less<int>>(*top, top[1]);
+                break;
+
+            case OpCode::LessEqualFloat:
+                --top;
+                applyFloatComparison<std::less_equal<int>>(*top, top[1]);
+                break;
+
+            case OpCode::GreaterFloat:
+                --top;
+                applyFloatComparison<std::greater<int>>(*top, top[1]);
+                break;
+
+            case OpCode::GreaterEqualFloat:
+                --top;
+                applyFloatComparison<std::greater_equal<int>>(*top, top[1]);
+                break;
+
+            case OpCode::Jump:
+                pc = instruction.operand - 1;
+                break;
+
+            case OpCode::JumpIfFalse:
+                if(!(top--)->toBoolean("operator&&"))
+                    pc = instruction.operand - 1;
+
+                break;
+
+            case OpCode::JumpIfTrue:
+                if((top--)->toBoolean("operator||"))
+                    pc = instruction.operand - 1;
+
+                break;
+
+            case OpCode::CheckBoolean:
+                top->toBoolean("operator bool");
+                break;
+
+            case OpCode::Call:
+            {
+                top -= instruction.count;
+                arguments.clear();
+                for(uint8_t i = 1; i <= instruction.count; ++i)
+                    arguments.push_back(top[i].toVariable());
+
+                (++top)->load(m_functions[instruction.operand].call(
+                  { arguments.size(), arguments.data() }));
+                break;
+            }
+        }
+    }
+}
+
+template<typename Function>
+void Expression::forEachRecord(const DynamicVariable &records, Function &&function) const
+{
+    if(!records.isType(ValueType::Array))
+        throw generateCastException(__func__, records.getValueType());
+
+    const auto &array = static_cast<const AbstractArrayValue &>(*records.internalNode());
+    AbstractValue::Ptr boxed;
+    for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+    {
+        const AbstractValue::Ptr *slot = array.findSlot(i);
+        if(!slot)
+        {
+            boxed = array[i];
+            slot = &boxed;
+        }
+
+        function(*slot);
+    }
+}
+
+DynamicVariable Expression::evaluate(const DynamicVariable &record) const
+{
+    // the result of "$" borrows the slot of the record, it must outlive the conversion
+    const AbstractValue::Ptr root = record.internalValue();
+    std::vector<Register> stack;
+    run(root, stack);
+    return stack.front().toVariable();
+}
+
+void Expression::evaluate(const DynamicVariable &records,
+                          std::vector<DynamicVariable> &results) const
+{
+    std::vector<Register> stack;
+    results.clear();
+    results.reserve(records.isType(ValueType::Array) ? records.size() : 0);
+    forEachRecord(records, [this, &stack, &results](const AbstractValue::Ptr &record) {
+        run(record, stack);
+        results.push_back(stack.front().toVariable());
+    });
+}
+
+namespace
+{
+    template<typename T>
+    AbstractValue::Ptr makeDenseResults(SizeType size)
+    {
+        auto result = std::make_shared<TypedArrayValue<T>>();
+        result->reserve(size);
+        return result;
+    }
+} // namespace
+
+DynamicVariable Expression::evaluateAll(const DynamicVariable &records) const
+{
+    std::vector<Register> stack;
+    const SizeType size = records.isType(ValueType::Array) ? records.size() : 0;
+    const ValueType type = getResultType();
+    if(type == ValueType::Integer)
+    {
+        auto results = makeDenseResults<IntType>(size);
+        auto &values = static_cast<TypedArrayValue<IntType> &>(*results);
+        forEachRecord(records, [this, &stack, &values](const AbstractValue::Ptr &record) {
+            run(record, stack);
+            values.push(stack.front().integer);
+        });
+        return DynamicVariable(std::move(results));
+    }
+
+    if(type == ValueType::Float)
+    {
+        auto results = makeDenseResults<FloatType>(size);
+        auto &values = static_cast<TypedArrayValue<FloatType> &>(*results);
+        forEachRecord(records, [this, &stack, &values](const AbstractValue::Ptr &record) {
+            run(record, stack);
+            values.push(stack.front().real);
+        });
+        return DynamicVariable(std::move(results));
+    }
+
+    if(type == ValueType::Boolean)
+    {
+        auto results = makeDenseResults<bool>(size);
+        auto &values = static_cast<TypedArrayValue<bool> &>(*results);
+        forEachRecord(records, [this, &stack, &values](const AbstractValue::Ptr &record) {
+            run(record, stack);
+            values.push(static_cast<uint8_t>(stack.front().boolean));
+        });
+        return DynamicVariable(std::move(results));
+    }
+
+    DynamicVariable::ArrayType results;
+    results.reserve(size);
+    forEachRecord(records, [this, &stack, &results](const AbstractValue::Ptr &record) {
+        run(record, stack);
+        results.push_back(stack.front().toVariable().internalValue());
+    });
+    return DynamicVariable(std::move(results));
+}
+
+DynamicVariable Expression::filter(const DynamicVariable &records) const
+{
+    std::vector<Register> stack;
+    DynamicVariable::ArrayType results;
+    forEachRecord(records, [this, &stack, &results](const AbstractValue::Ptr &record) {
+        run(record, stack);
+        if(stack.front().toBoolean("filter"))
+            results.push_back(record);
+    });
+    return DynamicVariable(std::move(results));
+}
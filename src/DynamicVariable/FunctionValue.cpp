@@ -0,0 +1,12 @@
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/FunctionValue.h>
+
+FDCore::DynamicVariable FDCore::FunctionValue::call(Arguments arguments) const
+{
+    if(!m_operations)
+        throw std::runtime_error("call: empty function");
+
+    DynamicVariable result;
+    m_operations->invoke(m_storage, arguments, result);
+    return result;
+}
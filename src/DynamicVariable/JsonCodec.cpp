@@ -0,0 +1,179 @@
+#include <FDCore/DynamicVariable/JsonCodec.h>
+
+#include <cmath>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef DynamicVariable::StringType StringType;
+    typedef DynamicVariable::StringViewType StringViewType;
+
+    void writeNode(const AbstractValue *node, StringType &output)
+    {
+        const ValueType type = getNodeType(node);
+        switch(type)
+        {
+            case ValueType::None:
+                output.append({ 'n', 'u', 'l', 'l' });
+                return;
+
+            case ValueType::Boolean:
+                JsonCodec<bool>::write(static_cast<bool>(static_cast<const BoolValue &>(*node)),
+                                       output);
+                return;
+
+            case ValueType::Integer:
+                writeJsonInteger(
+                  static_cast<IntValue::IntType>(static_cast<const IntValue &>(*node)), output);
+                return;
+
+            case ValueType::Float:
+                writeJsonFloat(
+                  static_cast<FloatValue::FloatType>(static_cast<const FloatValue &>(*node)),
+                  output);
+                return;
+
+            case ValueType::String:
+                writeJsonString(
+                  static_cast<const StringType &>(static_cast<const StringValue &>(*node)), output);
+                return;
+
+            case ValueType::Array:
+            {
+                const auto &array = static_cast<const AbstractArrayValue &>(*node);
+                AbstractValue::Ptr boxed;
+                output.push_back('[');
+                for(size_t i = 0, imax = array.size(); i < imax; ++i)
+                {
+                    if(i != 0)
+                        output.push_back(',');
+
+                    const AbstractValue::Ptr *slot = array.findSlot(i);
+                    if(!slot)
+                    {
+                        boxed = array[i];
+                        slot = &boxed;
+                    }
+
+                    writeNode(slot->get(), output);
+                }
+
+                output.push_back(']');
+                return;
+            }
+
+            case ValueType::Object:
+            {
+                bool first = true;
+                output.push_back('{');
+                static_cast<const AbstractObjectValue &>(*node).forEachMember(
+                  [&first, &output](const InternedString &member, const AbstractValue::Ptr &value) {
+                      if(!first)
+                          output.push_back(',');
+
+                      first = false;
+                      writeJsonString(member.view(), output);
+                      output.push_back(':');
+                      writeNode(value.get(), output);
+                  });
+
+                output.push_back('}');
+                return;
+            }
+
+            default:
+                throw std::runtime_error("writeJson: unsupported action on type " +
+                                         std::to_string(type));
+        }
+    }
+} // namespace
+
+void FDCore::writeJsonString(StringViewType value, StringType &output)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+
+    output.push_back('"');
+    for(auto c: value)
+    {
+        switch(c)
+        {
+            case '"':
+                output.append({ '\\', '"' });
+                break;
+
+            case '\\':
+                output.append({ '\\', '\\' });
+                break;
+
+            case '\b':
+                output.append({ '\\', 'b' });
+                break;
+
+            case '\f':
+                output.append({ '\\', 'f' });
+                break;
+
+            case '\n':
+                output.append({ '\\', 'n' });
+                break;
+
+            case '\r':
+                output.append({ '\\', 'r' });
+                break;
+
+            case '\t':
+                output.append({ '\\', 't' });
+                break;
+
+            default:
+                if(static_cast<unsigned>(c) < 0x20)
+                {
+                    output.append({ '\\', 'u', '0', '0' });
+                    output.push_back(hexDigits[(c >> 4) & 0xF]);
+                    output.push_back(hexDigits[c & 0xF]);
+                }
+                else
+                {
+                    output.push_back(c);
+                }
+
+                break;
+        }
+    }
+
+    output.push_back('"');
+}
+
+void FDCore::writeJsonFloat(DynamicVariable::FloatType value, StringType &output)
+{
+    if(!std::isfinite(value))
+    {
+        output.append({ 'n', 'u', 'l', 'l' });
+        return;
+    }
+
+    char buffer[32];
+    char *end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    output.append(buffer, end);
+
+    for(const char *it = buffer; it != end; ++it)
+    {
+        if(*it == '.' || *it == 'e')
+            return;
+    }
+
+    output.append({ '.', '0' });
+}
+
+void FDCore::writeJson(const DynamicVariable &value, StringType &output)
+{
+    writeNode(value.internalValue().get(), output);
+}
+
+StringType FDCore::toJson(const DynamicVariable &value)
+{
+    StringType result;
+    writeJson(value, result);
+    return result;
+}
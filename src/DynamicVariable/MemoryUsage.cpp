@@ -0,0 +1,93 @@
+#include <FDCore/DynamicVariable/MemoryUsage.h>
+
+#include <vector>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef AbstractArrayValue::SizeType SizeType;
+
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+    std::array<std::atomic<size_t>, ValueTypeCount> &getCounters()
+    {
+        static std::array<std::atomic<size_t>, ValueTypeCount> counters {};
+        return counters;
+    }
+#endif
+} // namespace
+
+void MemoryUsageCounter::add(const AbstractValue *root)
+{
+    // explicit stack, documents can be deeper than the call stack allows
+    std::vector<const AbstractValue *> pending { root };
+    while(!pending.empty())
+    {
+        const AbstractValue *node = pending.back();
+        pending.pop_back();
+        if(!node)
+            continue;
+
+        if(!m_counted.insert(node).second)
+        {
+            ++m_usage.sharedReferences;
+            continue;
+        }
+
+        const ValueFootprint footprint = node->getFootprint();
+        ValueMemoryUsage &usage = m_usage[node->getValueType()];
+        ++usage.nodes;
+        usage.headerBytes += footprint.headerBytes;
+        usage.payloadBytes += footprint.payloadBytes;
+        usage.slackBytes += footprint.slackBytes;
+
+        if(node->isType(ValueType::Object))
+        {
+            static_cast<const AbstractObjectValue &>(*node).forEachMember(
+              [&pending](const InternedString &, const AbstractValue::Ptr &value) {
+                  pending.push_back(value.get());
+              });
+        }
+        else if(node->isType(ValueType::Array))
+        {
+            // the cells of dense arrays are part of the footprint of the array
+            const auto &array = static_cast<const AbstractArrayValue &>(*node);
+            for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            {
+                const AbstractValue::Ptr *slot = array.findSlot(i);
+                if(!slot)
+                    break;
+
+                pending.push_back(slot->get());
+            }
+        }
+    }
+}
+
+void MemoryUsageCounter::clear()
+{
+    m_usage = MemoryUsage();
+    m_counted.clear();
+}
+
+std::array<size_t, ValueTypeCount> FDCore::getLiveValueCounts()
+{
+    std::array<size_t, ValueTypeCount> result {};
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+    for(size_t i = 0; i < ValueTypeCount; ++i)
+        result[i] = getCounters()[i].load(std::memory_order_relaxed);
+#endif
+
+    return result;
+}
+
+#ifdef FDCORE_TRACK_VALUE_ALLOCATIONS
+void FDCore::trackValueAllocation(ValueType type, bool allocated)
+{
+    std::atomic<size_t> &counter = getCounters()[static_cast<size_t>(type)];
+    if(allocated)
+        counter.fetch_add(1, std::memory_order_relaxed);
+    else
+        counter.fetch_sub(1, std::memory_order_relaxed);
+}
+#endif
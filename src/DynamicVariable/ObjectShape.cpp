@@ -0,0 +1,108 @@
+#include <FDCore/DynamicVariable/ObjectShape.h>
+
+#include <mutex>
+
+using namespace FDCore;
+
+ObjectShape::ObjectShape(Ptr parent, InternedString key) : m_parent(std::move(parent))
+{
+    m_keys.reserve(m_parent->m_keys.size() + 1);
+    m_keys = m_parent->m_keys;
+    m_keys.push_back(std::move(key));
+    if(m_keys.size() <= LinearSearchLimit)
+        return;
+
+    // the keys share their entries with the parent, so do the views of its index
+    if(m_parent->m_indices.empty())
+    {
+        m_indices.reserve(m_keys.size());
+        for(SizeType i = 0, imax = m_keys.size() - 1; i < imax; ++i)
+            m_indices.emplace(m_keys[i].view(), i);
+    }
+    else
+        m_indices = m_parent->m_indices;
+
+    m_indices.emplace(m_keys.back().view(), m_keys.size() - 1);
+}
+
+const ObjectShape::Ptr &ObjectShape::root()
+{
+    static const Ptr root = std::make_shared<ObjectShape>();
+    return root;
+}
+
+ObjectShape::Ptr ObjectShape::fromKeys(const std::vector<StringType> &keys)
+{
+    Ptr result = root();
+    for(const StringType &key: keys)
+        result = result->derive(key, true);
+
+    return result;
+}
+
+ObjectShape::Ptr ObjectShape::withKey(StringViewType key) const { return derive(key, false); }
+
+ObjectShape::Ptr ObjectShape::withoutKey(StringViewType key) const
+{
+    if(!hasKey(key))
+        return shared_from_this();
+
+    Ptr result = root();
+    for(const InternedString &current: m_keys)
+    {
+        if(current != key)
+        {
+            result = result->withKey(current.view());
+            if(!result)
+                break;
+        }
+    }
+
+    return result;
+}
+
+ObjectShape::Ptr ObjectShape::derive(StringViewType key, bool isRequired) const
+{
+    if(hasKey(key))
+        return shared_from_this();
+
+    if(!isRequired && m_keys.size() >= MaxKeys)
+        return Ptr();
+
+    const InternedString::Entry probe(key);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_transitionMutex);
+        auto it = m_transitions.find(InternedString::borrow(probe));
+        if(it != m_transitions.end())
+        {
+            if(Ptr result = it->second.lock())
+                return result;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_transitionMutex);
+    auto it = m_transitions.find(InternedString::borrow(probe));
+    if(it != m_transitions.end())
+    {
+        if(Ptr result = it->second.lock())
+            return result;
+
+        m_transitions.erase(it);
+    }
+
+    if(m_transitions.size() >= MaxTransitions)
+    {
+        for(auto current = m_transitions.begin(); current != m_transitions.end();)
+            current = current->second.expired() ? m_transitions.erase(current) : ++current;
+    }
+
+    const bool isFull = m_transitions.size() >= MaxTransitions;
+    if(isFull && !isRequired)
+        return Ptr();
+
+    Ptr result = std::make_shared<ObjectShape>(shared_from_this(), InternedString(key));
+    if(!isFull)
+        m_transitions.emplace(result->m_keys.back(), result);
+
+    return result;
+}
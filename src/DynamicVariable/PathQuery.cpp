@@ -0,0 +1,344 @@
+#include <FDCore/DynamicVariable/PathQuery.h>
+
+#include <stdexcept>
+
+using namespace FDCore;
+
+namespace
+{
+    typedef PathQuery::StringType StringType;
+    typedef PathQuery::StringViewType StringViewType;
+    typedef PathQuery::SizeType SizeType;
+    typedef StringViewType::value_type CharType;
+
+    /**
+     * @brief Parses token as an array index, npos if it is not made of decimal digits or if it
+     * overflows. Leading zeros are only allowed when allowLeadingZeros is true.
+     */
+    SizeType parseIndex(StringViewType token, bool allowLeadingZeros)
+    {
+        if(token.empty() || (!allowLeadingZeros && token.size() > 1 && token[0] == '0'))
+            return PathQuery::npos;
+
+        SizeType result = 0;
+        for(CharType c: token)
+        {
+            if(c < '0' || c > '9')
+                return PathQuery::npos;
+
+            SizeType digit = static_cast<SizeType>(c - '0');
+            if(result > (PathQuery::npos - 1 - digit) / 10)
+                return PathQuery::npos;
+
+            result = result * 10 + digit;
+        }
+
+        return result;
+    }
+
+    PathQuery::Segment makeMember(StringViewType name)
+    {
+        PathQuery::Segment segment;
+        segment.member = InternedString(name);
+        segment.matchesMember = true;
+        return segment;
+    }
+
+    PathQuery::Segment makeIndex(SizeType index)
+    {
+        PathQuery::Segment segment;
+        segment.index = index;
+        return segment;
+    }
+
+    std::invalid_argument generateSyntaxError(const char *caller,
+                                              const std::string &reason,
+                                              SizeType pos)
+    {
+        return std::invalid_argument(std::string(caller) + ": " + reason + " at position " +
+                                     std::to_string(pos));
+    }
+} // namespace
+
+PathQuery::PathQuery(StringViewType expression) :
+    PathQuery(!expression.empty() && expression[0] == '$' ? fromPath(expression) :
+                                                            fromPointer(expression))
+{
+}
+
+PathQuery PathQuery::fromPointer(StringViewType pointer)
+{
+    PathQuery result;
+    if(pointer.empty())
+        return result;
+
+    if(pointer[0] != '/')
+        throw generateSyntaxError(__func__, "pointer must start with '/'", 0);
+
+    StringType token;
+    for(SizeType pos = 1, end = pointer.size(); pos <= end; ++pos)
+    {
+        if(pos == end || pointer[pos] == '/')
+        {
+            Segment segment = makeMember(token);
+            segment.index = parseIndex(token, false);
+            result.m_segments.push_back(std::move(segment));
+            token.clear();
+            continue;
+        }
+
+        if(pointer[pos] != '~')
+        {
+            token.push_back(pointer[pos]);
+            continue;
+        }
+
+        CharType escaped = pos + 1 < end ? pointer[pos + 1] : CharType(0);
+        if(escaped == '0')
+            token.push_back('~');
+        else if(escaped == '1')
+            token.push_back('/');
+        else
+            throw generateSyntaxError(__func__, "invalid escape sequence", pos);
+
+        ++pos;
+    }
+
+    return result;
+}
+
+PathQuery PathQuery::fromPath(StringViewType path)
+{
+    if(path.empty() || path[0] != '$')
+        throw generateSyntaxError(__func__, "path must start with '$'", 0);
+
+    PathQuery result;
+    SizeType pos = 1;
+    const SizeType end = path.size();
+    while(pos < end)
+    {
+        if(path[pos] == '.')
+        {
+            SizeType first = ++pos;
+            while(pos < end && path[pos] != '.' && path[pos] != '[')
+                ++pos;
+
+            StringViewType name = path.substr(first, pos - first);
+            if(name.empty())
+                throw generateSyntaxError(__func__, "expected a member name", first);
+
+            if(name.size() == 1 && name[0] == '*')
+                throw generateSyntaxError(__func__, "wildcards are not supported", first);
+
+            result.m_segments.push_back(makeMember(name));
+            continue;
+        }
+
+        if(path[pos] != '[')
+            throw generateSyntaxError(__func__, "expected '.' or '['", pos);
+
+        ++pos;
+        if(pos < end && (path[pos] == '\'' || path[pos] == '"'))
+        {
+            const CharType quote = path[pos++];
+            StringType name;
+            while(pos < end && path[pos] != quote)
+            {
+                if(path[pos] == '\\' && pos + 1 < end)
+                    ++pos;
+
+                name.push_back(path[pos++]);
+            }
+
+            if(pos == end)
+                throw generateSyntaxError(__func__, "unterminated member name", pos);
+
+            result.m_segments.push_back(makeMember(name));
+            ++pos;
+        }
+        else
+        {
+            SizeType first = pos;
+            while(pos < end && path[pos] != ']')
+                ++pos;
+
+            SizeType index = parseIndex(path.substr(first, pos - first), true);
+            if(index == npos)
+                throw generateSyntaxError(__func__, "expected an index or a quoted name", first);
+
+            result.m_segments.push_back(makeIndex(index));
+        }
+
+        if(pos == end || path[pos] != ']')
+            throw generateSyntaxError(__func__, "expected ']'", pos);
+
+        ++pos;
+    }
+
+    return result;
+}
+
+PathQuery::StringType PathQuery::toPointer() const
+{
+    StringType result;
+    for(const Segment &segment: m_segments)
+    {
+        result.push_back('/');
+        if(!segment.matchesMember)
+        {
+            std::string index = std::to_string(segment.index);
+            result.append(index.begin(), index.end());
+            continue;
+        }
+
+        for(CharType c: segment.member.view())
+        {
+            if(c == '~')
+                result.append({ '~', '0' });
+            else if(c == '/')
+                result.append({ '~', '1' });
+            else
+                result.push_back(c);
+        }
+    }
+
+    return result;
+}
+
+const AbstractValue::Ptr *PathQuery::step(const AbstractValue &node,
+                                          const Segment &segment,
+                                          AbstractValue::Ptr &boxed)
+{
+    switch(node.getValueType())
+    {
+        case ValueType::Object:
+            if(!segment.matchesMember)
+                return nullptr;
+
+            return static_cast<const AbstractObjectValue &>(node).findSlot(segment.member);
+
+        case ValueType::Array:
+        {
+            const AbstractArrayValue &array = static_cast<const AbstractArrayValue &>(node);
+            if(segment.index == npos || segment.index >= array.size())
+                return nullptr;
+
+            const AbstractValue::Ptr *slot = array.findSlot(segment.index);
+            if(slot)
+                return slot;
+
+            // the cell is built before boxed is replaced, boxed may own the array
+            AbstractValue::Ptr cell = array[segment.index];
+            boxed = std::move(cell);
+            return &boxed;
+        }
+
+        default:
+            return nullptr;
+    }
+}
+
+DynamicVariable PathQuery::get(const DynamicVariable &document) const
+{
+    AbstractValue::Ptr root = document.internalValue();
+    AbstractValue::Ptr boxed;
+    const AbstractValue::Ptr *slot = &root;
+    for(const Segment &segment: m_segments)
+    {
+        if(!*slot)
+            return DynamicVariable();
+
+        slot = step(**slot, segment, boxed);
+        if(!slot)
+            return DynamicVariable();
+    }
+
+    return DynamicVariable(*slot);
+}
+
+bool PathQuery::exists(const DynamicVariable &document) const
+{
+    AbstractValue::Ptr root = document.internalValue();
+    AbstractValue::Ptr boxed;
+    const AbstractValue::Ptr *slot = &root;
+    for(const Segment &segment: m_segments)
+    {
+        if(!*slot)
+            return false;
+
+        slot = step(**slot, segment, boxed);
+        if(!slot)
+            return false;
+    }
+
+    return true;
+}
+
+PathQueryBatch::PathQueryBatch(const std::vector<PathQuery> &queries) : PathQueryBatch()
+{
+    for(const PathQuery &query: queries)
+        add(query);
+}
+
+PathQueryBatch::SizeType PathQueryBatch::add(const PathQuery &query)
+{
+    SizeType current = 0;
+    for(const PathQuery::Segment &segment: query.getSegments())
+    {
+        SizeType next = PathQuery::npos;
+        for(SizeType child: m_nodes[current].children)
+        {
+            if(m_nodes[child].segment == segment)
+            {
+                next = child;
+                break;
+            }
+        }
+
+        if(next == PathQuery::npos)
+        {
+            next = m_nodes.size();
+            m_nodes.push_back({ segment, {}, {} });
+            m_nodes[current].children.push_back(next);
+        }
+
+        current = next;
+    }
+
+    m_nodes[current].results.push_back(m_size);
+    return m_size++;
+}
+
+std::vector<DynamicVariable> PathQueryBatch::extract(const DynamicVariable &document) const
+{
+    std::vector<DynamicVariable> results;
+    extract(document, results);
+    return results;
+}
+
+void PathQueryBatch::extract(const DynamicVariable &document,
+                             std::vector<DynamicVariable> &results) const
+{
+    results.assign(m_size, DynamicVariable());
+    extract(0, document.internalValue(), results);
+}
+
+void PathQueryBatch::extract(SizeType nodeIndex,
+                             const AbstractValue::Ptr &value,
+                             std::vector<DynamicVariable> &results) const
+{
+    const Node &node = m_nodes[nodeIndex];
+    for(SizeType result: node.results)
+        results[result] = DynamicVariable(value);
+
+    if(!value)
+        return;
+
+    AbstractValue::Ptr boxed;
+    for(SizeType child: node.children)
+    {
+        const AbstractValue::Ptr *slot = PathQuery::step(*value, m_nodes[child].segment, boxed);
+        if(slot)
+            extract(child, *slot, results);
+    }
+}
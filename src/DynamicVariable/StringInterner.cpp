@@ -0,0 +1,69 @@
+#include <FDCore/DynamicVariable/StringInterner.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace FDCore;
+
+InternedString::InternedString(StringViewType value) : m_storage {}
+{
+    if(value.size() <= InlineCapacity)
+    {
+        std::copy(value.begin(), value.end(), m_storage);
+        m_storage[InlineCapacity] = static_cast<CharType>(value.size());
+        return;
+    }
+
+    Entry *entry = new Entry(value);
+    entry->isDetached = true;
+    entry->references.store(1, std::memory_order_relaxed);
+    setEntry(entry);
+}
+
+StringInterner &StringInterner::global()
+{
+    static StringInterner interner;
+    return interner;
+}
+
+InternedString StringInterner::intern(StringViewType value)
+{
+    if(value.empty())
+        return InternedString();
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_index.find(value);
+        if(it != m_index.end())
+            return InternedString(it->second);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_index.find(value);
+    if(it != m_index.end())
+        return InternedString(it->second);
+
+    // deque never moves its elements, the index keys can view the stored strings
+    const InternedString::Entry &entry = m_entries.emplace_back(value);
+    m_index.emplace(StringViewType(entry.value), &entry);
+    return InternedString(&entry);
+}
+
+std::optional<InternedString> StringInterner::find(StringViewType value) const
+{
+    if(value.empty())
+        return InternedString();
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_index.find(value);
+    if(it == m_index.end())
+        return std::nullopt;
+
+    return InternedString(it->second);
+}
+
+StringInterner::SizeType StringInterner::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_entries.size();
+}
@@ -0,0 +1,135 @@
+#ifndef FDCORE_BUFFERPOOL_TEST_H
+#define FDCORE_BUFFERPOOL_TEST_H
+
+#include <FDCore/Communication/BufferPool.h>
+#include <FDCore/Communication/BufferSlice.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(BufferPool_test, test_reuse)
+{
+    FDCore::BufferPool pool(256, 2);
+    ASSERT_EQ(pool.getBufferSize(), 256u);
+    ASSERT_EQ(pool.getClassCount(), 1u);
+
+    const uint8_t *first = nullptr;
+    {
+        FDCore::BufferPool::BufferPtr buffer = pool.acquire();
+        ASSERT_EQ(buffer->capacity, 256u);
+        first = buffer->data.get();
+
+        FDCore::BufferPool::BufferPtr shared = buffer;
+        ASSERT_EQ(shared.use_count(), 2);
+        buffer.reset();
+        ASSERT_EQ(shared.use_count(), 1);
+        ASSERT_EQ(pool.getCachedCount(), 0u);
+    }
+    ASSERT_EQ(pool.getCachedCount(), 1u);
+    ASSERT_EQ(pool.acquire(100)->data.get(), first);
+
+    // the thread keeps 2 buffers and the pool 2 more, the others are freed
+    {
+        std::vector<FDCore::BufferPool::BufferPtr> buffers;
+        for(int i = 0; i < 6; ++i)
+            buffers.push_back(pool.acquire());
+    }
+    ASSERT_EQ(pool.getCachedCount(), 4u);
+}
+
+TEST(BufferPool_test, test_size_classes)
+{
+    FDCore::BufferPool pool(3000);
+    ASSERT_EQ(pool.getClassCount(), 5u);
+
+    FDCore::BufferPool::BufferPtr small = pool.acquire(10);
+    ASSERT_EQ(small->capacity, FDCore::BufferPool::MinClassSize);
+    FDCore::BufferPool::BufferPtr medium = pool.acquire(600);
+    ASSERT_EQ(medium->capacity, 1024u);
+    FDCore::BufferPool::BufferPtr full = pool.acquire();
+    ASSERT_EQ(full->capacity, 4096u);
+
+    const uint8_t *mediumData = medium->data.get();
+    medium.reset();
+    ASSERT_NE(pool.acquire(300)->data.get(), mediumData);
+    ASSERT_EQ(pool.acquire(1000)->data.get(), mediumData);
+}
+
+TEST(BufferPool_test, test_large)
+{
+    FDCore::BufferPool::BufferPtr outlived;
+    {
+        FDCore::BufferPool pool(64);
+        FDCore::BufferPool::BufferPtr large = pool.acquire(1000);
+        ASSERT_EQ(large->capacity, 1000u);
+        large.reset();
+        ASSERT_EQ(pool.getCachedCount(), 0u);
+
+        outlived = pool.acquire();
+    }
+
+    // the buffer is released after its pool
+    outlived->data[63] = 1;
+    outlived.reset();
+
+    FDCore::BufferPool unpooled(64, 0);
+    unpooled.acquire();
+    ASSERT_EQ(unpooled.getCachedCount(), 0u);
+}
+
+TEST(BufferPool_test, test_threads)
+{
+    FDCore::BufferPool pool(1024);
+    std::vector<FDCore::BufferPool::BufferPtr> buffers;
+    for(size_t i = 0; i < 4 * FDCore::BufferPool::ThreadCacheSize; ++i)
+        buffers.push_back(pool.acquire());
+
+    // buffers released by another thread reach the pool when that thread exits
+    std::thread releaser([&buffers]() { buffers.clear(); });
+    releaser.join();
+    ASSERT_EQ(pool.getCachedCount(), 4 * FDCore::BufferPool::ThreadCacheSize);
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&pool]() {
+            for(int j = 0; j < 1000; ++j)
+            {
+                FDCore::BufferPool::BufferPtr buffer = pool.acquire(j % 1024 + 1);
+                buffer->data[0] = static_cast<uint8_t>(j);
+                FDCore::BufferPool::BufferPtr shared = buffer;
+            }
+        });
+    }
+
+    for(std::thread &thread: threads)
+        thread.join();
+    ASSERT_LE(pool.getCachedCount(), pool.getClassCount() * FDCore::BufferPool::DefaultMaxCached);
+}
+
+TEST(BufferPool_test, test_slice)
+{
+    FDCore::BufferPool pool(256);
+    FDCore::BufferPool::BufferPtr buffer = pool.acquire();
+    for(uint8_t i = 0; i < 16; ++i)
+        buffer->data[i] = i;
+
+    const FDCore::BufferSlice slice(buffer, { 16, buffer->data.get() });
+    buffer.reset();
+    ASSERT_TRUE(slice.isOwning());
+    ASSERT_EQ(slice.size(), 16u);
+
+    const FDCore::BufferSlice part = slice.slice(4, 8);
+    ASSERT_EQ(part.size(), 8u);
+    ASSERT_EQ(part.data()[0], 4);
+    ASSERT_EQ(part.getBuffer(), slice.getBuffer());
+    ASSERT_EQ(slice.getBuffer().use_count(), 2);
+    ASSERT_EQ(slice.slice(16, 0).size(), 0u);
+    ASSERT_THROW(slice.slice(10, 7), std::out_of_range);
+    ASSERT_THROW(slice.slice(17, 0), std::out_of_range);
+    ASSERT_FALSE(FDCore::BufferSlice().isOwning());
+}
+
+#endif // FDCORE_BUFFERPOOL_TEST_H
@@ -0,0 +1,23 @@
+#ifndef FDCORE_COMMUNICATION_TEST_HELPERS_H
+#define FDCORE_COMMUNICATION_TEST_HELPERS_H
+
+#include <FDCore/Common/Span.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Views the characters of text as bytes, text must outlive the span
+ */
+static FDCore::Span<const uint8_t> textBytes(std::string_view text)
+{
+    return { static_cast<uint32_t>(text.size()), reinterpret_cast<const uint8_t *>(text.data()) };
+}
+
+static std::string bytesText(FDCore::Span<const uint8_t> bytes)
+{
+    return std::string(bytes.begin(), bytes.end());
+}
+
+#endif // FDCORE_COMMUNICATION_TEST_HELPERS_H
@@ -0,0 +1,15 @@
+#ifndef FDCORE_COMMUNICATION_TEST_H
+#define FDCORE_COMMUNICATION_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include "BufferPool_test.h"
+#include "MessageDecoder_test.h"
+#include "MessageHeader_test.h"
+#include "MessageHeaderView_test.h"
+#include "MessageServer_test.h"
+#include "PayloadCompression_test.h"
+#include "SharedMemoryChannel_test.h"
+#include "WireFormat_test.h"
+
+#endif // FDCORE_COMMUNICATION_TEST_H
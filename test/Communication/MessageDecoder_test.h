@@ -0,0 +1,173 @@
+#ifndef FDCORE_MESSAGEDECODER_TEST_H
+#define FDCORE_MESSAGEDECODER_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Communication/MessageDecoder.h>
+#include <FDCore/Communication/Request.h>
+#include <FDCore/Communication/Response.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<uint8_t> makeRequestStream(FDCore::BufferPool &pool, size_t count)
+{
+    std::vector<uint8_t> stream;
+    for(size_t i = 0; i < count; ++i)
+    {
+        FDCore::MessageHeader header;
+        header.setFiled("path", textBytes("/items/" + std::to_string(i)));
+        const std::string payload(i % 7, static_cast<char>('a' + i % 26));
+        FDCore::Request request =
+          FDCore::Request::create(pool, FDCore::RequestType::Read, header, textBytes(payload));
+        stream.insert(stream.end(), request.getFrame().begin(), request.getFrame().end());
+    }
+
+    return stream;
+}
+
+/**
+ * @brief Feeds stream to decoder by reads of at most chunk bytes, decoding after each read
+ */
+static std::vector<FDCore::Request> decodeStream(FDCore::MessageDecoder &decoder,
+                                                 const std::vector<uint8_t> &stream,
+                                                 size_t chunk)
+{
+    std::vector<FDCore::Request> requests;
+    size_t offset = 0;
+    while(offset < stream.size())
+    {
+        FDCore::Span<uint8_t> space = decoder.prepare();
+        const size_t count = std::min({ chunk, size_t(space.size), stream.size() - offset });
+        memcpy(space.data, stream.data() + offset, count);
+        decoder.commit(count);
+        offset += count;
+
+        FDCore::Request request;
+        while(decoder.next(request))
+            requests.push_back(std::move(request));
+    }
+
+    return requests;
+}
+
+TEST(MessageDecoder_test, test_codec)
+{
+    FDCore::BufferPool pool(1024);
+    FDCore::MessageHeader header;
+    header.setFiled("path", textBytes("/users/1"));
+
+    FDCore::Request request =
+      FDCore::Request::create(pool, FDCore::RequestType::Update, header, textBytes("{}"));
+    ASSERT_TRUE(request.isValid());
+    ASSERT_EQ(request.getRequestType(), FDCore::RequestType::Update);
+    ASSERT_EQ(bytesText(request.getHeader().getField("path")), "/users/1");
+    ASSERT_EQ(bytesText(request.getPayload()), "{}");
+    ASSERT_EQ(request.getFrame().size, header.size() + 2);
+
+    FDCore::Request moved = std::move(request);
+    ASSERT_EQ(bytesText(moved.getPayload()), "{}");
+
+    FDCore::Response response = FDCore::Response::create(
+      pool, FDCore::ResponseStatus::NotFound, FDCore::MessageHeader(), textBytes(""));
+    ASSERT_EQ(response.getStatus(), FDCore::ResponseStatus::NotFound);
+    ASSERT_EQ(response.getPayload().size, 0u);
+    ASSERT_EQ(response.getHeader().getFieldCount(), 0u);
+
+    std::vector<uint8_t> frame(moved.getFrame().begin(), moved.getFrame().end());
+    frame[0] = 9;
+    ASSERT_THROW(FDCore::Request(pool.acquire(), { static_cast<uint32_t>(frame.size()),
+                                                   frame.data() }),
+                 std::invalid_argument);
+    ASSERT_THROW(FDCore::Message(pool.acquire(), { static_cast<uint32_t>(frame.size() - 1),
+                                                   frame.data() }),
+                 std::invalid_argument);
+}
+
+TEST(MessageDecoder_test, test_partial_reads)
+{
+    FDCore::BufferPool pool(4096);
+    const std::vector<uint8_t> stream = makeRequestStream(pool, 50);
+
+    for(size_t chunk: { size_t(1), size_t(5), size_t(64), size_t(1000) })
+    {
+        FDCore::MessageDecoder decoder(pool);
+        std::vector<FDCore::Request> requests = decodeStream(decoder, stream, chunk);
+        ASSERT_EQ(requests.size(), 50u);
+        ASSERT_EQ(decoder.getPendingSize(), 0u);
+        for(size_t i = 0; i < requests.size(); ++i)
+        {
+            ASSERT_EQ(bytesText(requests[i].getHeader().getField("path")),
+                      "/items/" + std::to_string(i));
+            ASSERT_EQ(requests[i].getPayload().size, i % 7);
+        }
+    }
+}
+
+TEST(MessageDecoder_test, test_pipelining)
+{
+    FDCore::BufferPool pool(64 * 1024);
+    const std::vector<uint8_t> stream = makeRequestStream(pool, 1000);
+    ASSERT_LT(stream.size(), pool.getBufferSize());
+
+    FDCore::MessageDecoder decoder(pool);
+    FDCore::Span<uint8_t> space = decoder.prepare();
+    ASSERT_GE(space.size, stream.size());
+    memcpy(space.data, stream.data(), stream.size());
+    decoder.commit(stream.size());
+
+    std::vector<FDCore::Request> requests;
+    FDCore::Request request;
+    while(decoder.next(request))
+        requests.push_back(std::move(request));
+
+    // every payload is a view of the buffer the stream was read into
+    ASSERT_EQ(requests.size(), 1000u);
+    ASSERT_EQ(requests.front().getFrame().data, space.data);
+    ASSERT_EQ(requests.back().getPayload().data + requests.back().getPayload().size,
+              space.data + stream.size());
+}
+
+TEST(MessageDecoder_test, test_buffers)
+{
+    FDCore::BufferPool pool(256);
+    FDCore::MessageHeader header;
+    const std::string payload(1000, 'x');
+    FDCore::Request large =
+      FDCore::Request::create(pool, FDCore::RequestType::Create, header, textBytes(payload));
+    const std::vector<uint8_t> stream(large.getFrame().begin(), large.getFrame().end());
+
+    // a message longer than the pooled buffers is gathered in a buffer of its size
+    FDCore::MessageDecoder decoder(pool);
+    std::vector<FDCore::Request> requests = decodeStream(decoder, stream, 100);
+    ASSERT_EQ(requests.size(), 1u);
+    ASSERT_EQ(bytesText(requests[0].getPayload()), payload);
+
+    FDCore::MessageDecoder limited(pool, 512);
+    ASSERT_THROW(decodeStream(limited, stream, 100), std::length_error);
+
+    std::vector<uint8_t> malformed(stream.begin(),
+                                   stream.begin() + FDCore::WireFormat::PreambleSize);
+    FDCore::WireFormat::storeUint32(malformed.data() + 1, 3);
+    FDCore::MessageDecoder invalid(pool);
+    ASSERT_THROW(decodeStream(invalid, malformed, 100), std::invalid_argument);
+
+    // a header over the limit is refused from its preamble, before it is buffered
+    FDCore::WireFormat::storeUint32(malformed.data() + 1, 1024 * 1024);
+    FDCore::MessageDecoder hostile(pool);
+    ASSERT_THROW(decodeStream(hostile, malformed, 100), std::length_error);
+
+    FDCore::MessageHeaderLimits limits;
+    limits.maxValueLength = 8;
+    header.setFiled("path", textBytes("/items/1234"));
+    FDCore::Request withPath =
+      FDCore::Request::create(pool, FDCore::RequestType::Read, header, textBytes(""));
+    const std::vector<uint8_t> pathStream(withPath.getFrame().begin(), withPath.getFrame().end());
+    FDCore::MessageDecoder strict(pool, FDCore::MessageDecoder::DefaultMaxMessageSize, limits);
+    ASSERT_THROW(decodeStream(strict, pathStream, 100), std::length_error);
+}
+
+#endif // FDCORE_MESSAGEDECODER_TEST_H
@@ -0,0 +1,233 @@
+#ifndef FDCORE_MESSAGEHEADERVIEW_TEST_H
+#define FDCORE_MESSAGEHEADERVIEW_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+#include <FDCore/Communication/Request.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+static void appendWireUint32(std::vector<uint8_t> &buffer, uint32_t value)
+{
+    buffer.resize(buffer.size() + 4);
+    FDCore::WireFormat::storeUint32(buffer.data() + buffer.size() - 4, value);
+}
+
+/**
+ * @brief Header whose field names are all sent in full
+ */
+static std::vector<uint8_t> makeWireHeader(
+  uint8_t type, uint32_t payloadLength,
+  const std::vector<std::pair<std::string, std::string>> &fields)
+{
+    std::vector<uint8_t> buffer { type };
+    appendWireUint32(buffer, 0);
+    appendWireUint32(buffer, payloadLength);
+    appendWireUint32(buffer, 77);
+    for(const auto &[name, value]: fields)
+    {
+        buffer.push_back(0);
+        buffer.push_back(static_cast<uint8_t>(name.size()));
+        buffer.insert(buffer.end(), name.begin(), name.end());
+        buffer.push_back(static_cast<uint8_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    FDCore::WireFormat::storeUint32(buffer.data() + 1, static_cast<uint32_t>(buffer.size()));
+    return buffer;
+}
+
+static FDCore::Span<const uint8_t> wireSpan(const std::vector<uint8_t> &buffer)
+{
+    return { static_cast<uint32_t>(buffer.size()), buffer.data() };
+}
+
+TEST(MessageHeaderView_test, test_parse)
+{
+    std::vector<uint8_t> buffer =
+      makeWireHeader(2, 120, { { "path", "/users/1" }, { "empty", "" }, { "token", "abc" } });
+    const size_t headerLength = buffer.size();
+    buffer.resize(headerLength + 120, 0xFF);
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse(wireSpan(buffer)));
+    ASSERT_TRUE(view.isValid());
+    ASSERT_EQ(view.getType(), 2);
+    ASSERT_EQ(view.getHeaderLength(), headerLength);
+    ASSERT_EQ(view.getPayloadLength(), 120u);
+    ASSERT_EQ(view.getRequestId(), 77u);
+    ASSERT_EQ(view.getFieldCount(), 3u);
+
+    ASSERT_EQ(view.getName(0), "path");
+    ASSERT_EQ(bytesText(view.getValue(0)), "/users/1");
+    ASSERT_EQ(view.getField("empty").size, 0u);
+    ASSERT_EQ(bytesText(view.getField("token")), "abc");
+    ASSERT_TRUE(view.hasField("path"));
+    ASSERT_FALSE(view.hasField("pat"));
+    ASSERT_EQ(view.find("missing"), FDCore::MessageHeaderView::npos);
+    ASSERT_THROW(view.getField("missing"), std::out_of_range);
+
+    // names and values point into the input buffer
+    ASSERT_EQ(reinterpret_cast<const uint8_t *>(view.getName(0).data()), buffer.data() + 15);
+    ASSERT_EQ(view.getValue(0).data, buffer.data() + 15 + 4 + 1);
+    ASSERT_EQ(view.getKey(0), 0u);
+
+    FDCore::MessageHeaderView noFields;
+    const std::vector<uint8_t> preamble = makeWireHeader(0, 0, {});
+    ASSERT_TRUE(noFields.parse(wireSpan(preamble)));
+    ASSERT_EQ(noFields.getFieldCount(), 0u);
+}
+
+TEST(MessageHeaderView_test, test_incomplete)
+{
+    const std::vector<uint8_t> buffer = makeWireHeader(1, 0, { { "name", "value" } });
+
+    FDCore::MessageHeaderView view;
+    for(uint32_t size = 0; size < buffer.size(); ++size)
+    {
+        ASSERT_FALSE(view.parse({ size, buffer.data() }));
+        ASSERT_FALSE(view.isValid());
+    }
+    ASSERT_TRUE(view.parse(wireSpan(buffer)));
+}
+
+TEST(MessageHeaderView_test, test_malformed)
+{
+    FDCore::MessageHeaderView view;
+
+    std::vector<uint8_t> shortLength = makeWireHeader(0, 0, {});
+    FDCore::WireFormat::storeUint32(shortLength.data() + 1, 12);
+    ASSERT_THROW(view.parse(wireSpan(shortLength)), std::invalid_argument);
+
+    std::vector<uint8_t> longName = makeWireHeader(0, 0, {});
+    longName.insert(longName.end(), { 0, 5, 'a', 'b' });
+    FDCore::WireFormat::storeUint32(longName.data() + 1, 17);
+    ASSERT_THROW(view.parse(wireSpan(longName)), std::invalid_argument);
+
+    std::vector<uint8_t> truncatedLength = makeWireHeader(0, 0, { { "a", "" } });
+    FDCore::WireFormat::storeUint32(truncatedLength.data() + 1, 16);
+    ASSERT_THROW(view.parse(wireSpan(truncatedLength)), std::invalid_argument);
+
+    std::vector<uint8_t> longValue = makeWireHeader(0, 0, { { "a", "xyz" } });
+    longValue[16] = 4;
+    ASSERT_THROW(view.parse(wireSpan(longValue)), std::invalid_argument);
+    longValue[16] = 0xFF;
+    ASSERT_THROW(view.parse(wireSpan(longValue)), std::invalid_argument);
+    ASSERT_FALSE(view.isValid());
+
+    // a key past the end of the dictionary, then a varint longer than 5 bytes
+    std::vector<uint8_t> unknownKey = makeWireHeader(0, 0, {});
+    unknownKey.insert(unknownKey.end(),
+                      { static_cast<uint8_t>(FDCore::WireFormat::FieldNames.size() + 1), 0 });
+    FDCore::WireFormat::storeUint32(unknownKey.data() + 1, 15);
+    ASSERT_THROW(view.parse(wireSpan(unknownKey)), std::invalid_argument);
+    unknownKey.insert(unknownKey.end() - 2, { 0x80, 0x80, 0x80, 0x80, 0x80 });
+    unknownKey[unknownKey.size() - 2] = 0;
+    FDCore::WireFormat::storeUint32(unknownKey.data() + 1, 20);
+    ASSERT_THROW(view.parse(wireSpan(unknownKey)), std::invalid_argument);
+
+}
+
+TEST(MessageHeaderView_test, test_many_fields)
+{
+    std::vector<std::pair<std::string, std::string>> fields;
+    for(size_t i = 0; i < FDCore::MessageHeaderView::InlineFields + 8; ++i)
+        fields.emplace_back("f" + std::to_string(i), std::to_string(i));
+
+    const std::vector<uint8_t> buffer = makeWireHeader(0, 0, fields);
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse(wireSpan(buffer)));
+    ASSERT_EQ(view.getFieldCount(), fields.size());
+    ASSERT_EQ(view.getName(fields.size() - 1), fields.back().first);
+    ASSERT_EQ(bytesText(view.getField("f39")), "39");
+    ASSERT_EQ(view.find("f33"), 33u);
+
+    FDCore::MessageHeader header = view.toHeader();
+    ASSERT_EQ(header.getFiled("f35"), std::vector<uint8_t>({ '3', '5' }));
+
+    FDCore::BufferPool pool(4096);
+    FDCore::Request request =
+      FDCore::Request::create(pool, FDCore::RequestType::Read, header, textBytes(""));
+    ASSERT_EQ(request.getHeader().getFieldCount(), fields.size());
+    ASSERT_EQ(bytesText(request.getHeader().getField("f0")), "0");
+}
+
+TEST(MessageHeaderView_test, test_limits)
+{
+    FDCore::MessageHeaderLimits limits;
+    limits.maxHeaderLength = 100;
+    limits.maxNameLength = 8;
+    limits.maxValueLength = 16;
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse(wireSpan(makeWireHeader(0, 0, { { "name", std::string(16, 'v') } })),
+                           limits));
+    ASSERT_THROW(view.parse(wireSpan(makeWireHeader(0, 0, { { "name", std::string(17, 'v') } })),
+                            limits),
+                 std::length_error);
+    ASSERT_THROW(view.parse(wireSpan(makeWireHeader(0, 0, { { "long-name", "" } })), limits),
+                 std::length_error);
+    ASSERT_FALSE(view.isValid());
+
+    // the length of the header is checked before the rest of it is received
+    std::vector<uint8_t> large = makeWireHeader(0, 0, {});
+    FDCore::WireFormat::storeUint32(large.data() + 1, 101);
+    ASSERT_THROW(view.parse(wireSpan(large), limits), std::length_error);
+    FDCore::WireFormat::storeUint32(large.data() + 1, 0xFFFFFFFF);
+    ASSERT_THROW(view.parse(wireSpan(large)), std::length_error);
+
+    FDCore::MessageHeader header;
+    ASSERT_THROW(header.read(wireSpan(makeWireHeader(0, 0, { { "long-name", "" } })), limits),
+                 std::length_error);
+
+    // names MessageHeader would refuse are refused by the parser too
+    ASSERT_THROW(view.parse(wireSpan(makeWireHeader(0, 0, { { std::string("a\0b", 3), "" } }))),
+                 std::invalid_argument);
+}
+
+TEST(MessageHeaderView_test, test_read)
+{
+    const std::vector<uint8_t> buffer =
+      makeWireHeader(3, 42, { { "path", "/a" }, { "path", "/b" }, { "id", "7" } });
+
+    FDCore::MessageHeader header;
+    ASSERT_EQ(header.read({ 5, buffer.data() }), 0u);
+    ASSERT_EQ(header.read(wireSpan(buffer)), buffer.size());
+    ASSERT_EQ(header.getPayloadLength(), 42u);
+    ASSERT_TRUE(header.hasField("id"));
+    ASSERT_EQ(header.getFiled("path"), std::vector<uint8_t>({ '/', 'a' }));
+
+    const std::string name = "idx";
+    ASSERT_TRUE(header.hasField(std::string_view(name).substr(0, 2)));
+}
+
+TEST(MessageHeaderView_test, test_keys)
+{
+    FDCore::MessageHeader header;
+    header.setFiled("content-type", { 4, reinterpret_cast<const uint8_t *>("json") });
+    header.setFiled("x-shard", { 1, reinterpret_cast<const uint8_t *>("7") });
+    std::vector<uint8_t> buffer(header.size());
+    header.write({ static_cast<uint32_t>(buffer.size()), buffer.data() });
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse(wireSpan(buffer)));
+    const size_t index = view.find("content-type");
+    ASSERT_NE(index, FDCore::MessageHeaderView::npos);
+    ASSERT_EQ(view.getKey(index), FDCore::WireFormat::findFieldKey("content-type"));
+    ASSERT_EQ(view.getName(index).data(), FDCore::WireFormat::FieldNames[2].data());
+    ASSERT_EQ(bytesText(view.getField("x-shard")), "7");
+    ASSERT_EQ(view.getKey(view.find("x-shard")), 0u);
+
+    // a well-known name sent in full is found as well
+    const std::vector<uint8_t> full = makeWireHeader(0, 0, { { "path", "/a" } });
+    ASSERT_TRUE(view.parse(wireSpan(full)));
+    ASSERT_EQ(view.getKey(0), 0u);
+    ASSERT_EQ(bytesText(view.getField("path")), "/a");
+}
+
+#endif // FDCORE_MESSAGEHEADERVIEW_TEST_H
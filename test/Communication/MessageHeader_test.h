@@ -0,0 +1,112 @@
+#ifndef FDCORE_MESSAGEHEADER_TEST_H
+#define FDCORE_MESSAGEHEADER_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Communication/MessageHeader.h>
+#include <FDCore/Communication/MessageHeaderView.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static FDCore::MessageHeader makeMessageHeader()
+{
+    FDCore::MessageHeader header(3);
+    header.setType(4);
+    header.setRequestId(99);
+    header.setFiled("path", textBytes("/users/1"));
+    header.setFiled("token", textBytes("abc"));
+    header.setFiled("empty", textBytes(""));
+    return header;
+}
+
+TEST(MessageHeader_test, test_write)
+{
+    const FDCore::MessageHeader header = makeMessageHeader();
+    // path and token are well-known names, empty is sent in full
+    ASSERT_EQ(header.size(), 13u + (1 + 1 + 8) + (1 + 1 + 3) + (1 + 1 + 5 + 1));
+    ASSERT_EQ(FDCore::MessageHeader().size(), 13u);
+
+    std::vector<uint8_t> buffer(header.size() + 8, 0xFF);
+    const uint32_t length = header.write({ static_cast<uint32_t>(buffer.size()), buffer.data() });
+    ASSERT_EQ(length, header.size());
+    ASSERT_EQ(buffer[length], 0xFF);
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse({ length, buffer.data() }));
+    ASSERT_EQ(view.getType(), 4);
+    ASSERT_EQ(view.getHeaderLength(), length);
+    ASSERT_EQ(view.getPayloadLength(), 3u);
+    ASSERT_EQ(view.getFieldCount(), 3u);
+    ASSERT_EQ(view.getField("path").size, 8u);
+
+    FDCore::MessageHeader copy;
+    ASSERT_EQ(copy.read({ length, buffer.data() }), length);
+    ASSERT_EQ(copy.getType(), 4);
+    ASSERT_EQ(copy.getRequestId(), 99u);
+    ASSERT_EQ(copy.getPayloadLength(), 3u);
+    ASSERT_EQ(copy.getFiled("token"), std::vector<uint8_t>({ 'a', 'b', 'c' }));
+    ASSERT_EQ(copy.size(), header.size());
+
+    ASSERT_THROW(copy.setFiled(std::string_view("a\0b", 3), textBytes("")), std::invalid_argument);
+}
+
+TEST(MessageHeader_test, test_bounds)
+{
+    const FDCore::MessageHeader header = makeMessageHeader();
+    std::vector<uint8_t> buffer(header.size() + 2, 0xFF);
+
+    ASSERT_THROW(header.write({ static_cast<uint32_t>(header.size() - 1), buffer.data() }),
+                 std::length_error);
+    ASSERT_EQ(buffer[0], 0xFF);
+
+    const FDCore::Span<uint8_t> output { static_cast<uint32_t>(buffer.size()), buffer.data() };
+    ASSERT_THROW(header.write(output, textBytes("xyz")), std::length_error);
+
+    const uint32_t length = header.write(output, textBytes("xy"));
+    ASSERT_EQ(length, buffer.size());
+    ASSERT_EQ(buffer[length - 1], 'y');
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse(output));
+    ASSERT_EQ(view.getPayloadLength(), 2u);
+}
+
+TEST(MessageHeader_test, test_gather)
+{
+    const FDCore::MessageHeader header = makeMessageHeader();
+    const std::string payload = "payload bytes";
+    std::vector<uint8_t> headerBuffer(header.size());
+
+    FDCore::MessageHeader::IoVectors vectors;
+    const int count = header.gather({ static_cast<uint32_t>(headerBuffer.size()),
+                                      headerBuffer.data() },
+                                    textBytes(payload), vectors);
+    ASSERT_EQ(count, 2);
+    ASSERT_EQ(vectors[1].iov_base, payload.data());
+
+    int pipe[2];
+    ASSERT_EQ(::pipe(pipe), 0);
+    const ssize_t written = ::writev(pipe[1], vectors.data(), count);
+    ASSERT_EQ(static_cast<size_t>(written), headerBuffer.size() + payload.size());
+
+    std::vector<uint8_t> received(static_cast<size_t>(written));
+    ASSERT_EQ(::read(pipe[0], received.data(), received.size()), written);
+    ::close(pipe[0]);
+    ::close(pipe[1]);
+
+    FDCore::MessageHeaderView view;
+    ASSERT_TRUE(view.parse({ static_cast<uint32_t>(received.size()), received.data() }));
+    ASSERT_EQ(view.getPayloadLength(), payload.size());
+    ASSERT_EQ(std::string(received.begin() + view.getHeaderLength(), received.end()), payload);
+
+    ASSERT_EQ(header.gather({ static_cast<uint32_t>(headerBuffer.size()), headerBuffer.data() },
+                            textBytes(""), vectors),
+              1);
+    ASSERT_THROW(header.gather({ 4, headerBuffer.data() }, textBytes(payload), vectors),
+                 std::length_error);
+}
+
+#endif // FDCORE_MESSAGEHEADER_TEST_H
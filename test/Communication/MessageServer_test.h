@@ -0,0 +1,366 @@
+#ifndef FDCORE_MESSAGESERVER_TEST_H
+#define FDCORE_MESSAGESERVER_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/Communication/MessageClient.h>
+#include <FDCore/Communication/MessageServer.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <fcntl.h>
+#include <future>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Answers the payload of Read requests reversed, fails on Delete requests
+ */
+static FDCore::Response reverseHandler(const FDCore::Request &request, FDCore::BufferPool &pool)
+{
+    if(request.getRequestType() == FDCore::RequestType::Delete)
+        throw std::runtime_error("delete refused");
+
+    std::string payload = bytesText(request.getPayload());
+    std::reverse(payload.begin(), payload.end());
+    FDCore::MessageHeader header;
+    if(request.getHeader().hasField("id"))
+        header.setFiled("id", request.getHeader().getField("id"));
+
+    return FDCore::Response::create(pool, FDCore::ResponseStatus::Ok, header, textBytes(payload));
+}
+
+static FDCore::Request makeServerRequest(FDCore::MessageClient &client,
+                                         FDCore::RequestType type,
+                                         std::string_view payload,
+                                         std::string_view id = "")
+{
+    FDCore::MessageHeader header;
+    if(!id.empty())
+        header.setFiled("id", textBytes(id));
+
+    return FDCore::Request::create(client.getPool(), type, header, textBytes(payload));
+}
+
+TEST(MessageServer_test, test_tcp)
+{
+    FDCore::ThreadPool threads(4);
+    FDCore::MessageServer server(threads, &reverseHandler);
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    ASSERT_NE(port, 0);
+    server.start();
+    ASSERT_TRUE(server.isRunning());
+
+    FDCore::MessageClient client(FDCore::Socket::connectTcp("127.0.0.1", port));
+    FDCore::Request request = makeServerRequest(client, FDCore::RequestType::Read, "hello");
+    FDCore::Response response = client.call(request);
+    ASSERT_EQ(response.getStatus(), FDCore::ResponseStatus::Ok);
+    ASSERT_EQ(response.getRequestId(), request.getRequestId());
+    ASSERT_EQ(bytesText(response.getPayload()), "olleh");
+
+    FDCore::Request refused = makeServerRequest(client, FDCore::RequestType::Delete, "");
+    FDCore::Response failure = client.call(refused);
+    ASSERT_EQ(failure.getStatus(), FDCore::ResponseStatus::InternalError);
+    ASSERT_EQ(bytesText(failure.getPayload()), "delete refused");
+
+    // the connection is still usable after a failed request
+    FDCore::Request next = makeServerRequest(client, FDCore::RequestType::Read, "ab");
+    ASSERT_EQ(bytesText(client.call(next).getPayload()), "ba");
+    ASSERT_EQ(client.getInFlightCount(), 0u);
+    ASSERT_THROW(client.receive(next.getRequestId()), std::invalid_argument);
+    server.stop();
+    ASSERT_FALSE(server.isRunning());
+}
+
+TEST(MessageServer_test, test_pipelining)
+{
+    FDCore::ThreadPool threads(4);
+    FDCore::MessageServer server(threads, &reverseHandler);
+    const std::string path = "/tmp/fdcore_server_test_" + std::to_string(getpid()) + ".sock";
+    unlink(path.c_str());
+    server.listenUnix(path);
+    server.start();
+
+    // the window is smaller than the batch, sending waits for some of the responses
+    FDCore::MessageClient client(FDCore::Socket::connectUnix(path), 100);
+    std::vector<FDCore::Request> requests;
+    for(size_t i = 0; i < 500; ++i)
+        requests.push_back(makeServerRequest(client, FDCore::RequestType::Read,
+                                             std::string(i % 50, 'x') + "y", std::to_string(i)));
+    client.send({ requests.size(), requests.data() });
+    ASSERT_LE(client.getInFlightCount(), 100u);
+    ASSERT_EQ(client.getInFlightCount() + client.getArrivedCount(), requests.size());
+
+    // each response is matched with its request by its identifier, whatever the order
+    for(size_t i = requests.size(); i-- > 0;)
+    {
+        FDCore::Response response = client.receive(requests[i].getRequestId());
+        ASSERT_EQ(bytesText(response.getHeader().getField("id")), std::to_string(i));
+        ASSERT_EQ(response.getPayload().size, i % 50 + 1);
+        ASSERT_EQ(response.getPayload()[0], 'y');
+    }
+    ASSERT_EQ(client.getInFlightCount(), 0u);
+    ASSERT_EQ(client.getArrivedCount(), 0u);
+}
+
+TEST(MessageServer_test, test_out_of_order)
+{
+    // Create requests are slow, the Read requests sent after them are answered first
+    FDCore::ThreadPool threads(2);
+    FDCore::MessageServer server(
+      threads, [](const FDCore::Request &request, FDCore::BufferPool &pool) {
+          if(request.getRequestType() == FDCore::RequestType::Create)
+              std::this_thread::sleep_for(std::chrono::milliseconds(100));
+          return reverseHandler(request, pool);
+      });
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+
+    FDCore::MessageClient client(FDCore::Socket::connectTcp("127.0.0.1", port));
+    FDCore::Request slow = makeServerRequest(client, FDCore::RequestType::Create, "slow");
+    FDCore::Request fast = makeServerRequest(client, FDCore::RequestType::Read, "fast");
+    const uint32_t slowId = client.send(slow);
+    const uint32_t fastId = client.send(fast);
+    ASSERT_NE(slowId, fastId);
+
+    FDCore::Response first = client.receive();
+    ASSERT_EQ(first.getRequestId(), fastId);
+    ASSERT_EQ(bytesText(first.getPayload()), "tsaf");
+    ASSERT_EQ(bytesText(client.receive(slowId).getPayload()), "wols");
+}
+
+TEST(MessageServer_test, test_batches)
+{
+    FDCore::ThreadPool threads(2);
+    std::vector<size_t> batchSizes;
+    std::mutex mutex;
+    FDCore::MessageServer server(
+      threads, [&](FDCore::Span<const FDCore::Request, size_t> requests, FDCore::BufferPool &pool) {
+          {
+              std::lock_guard<std::mutex> lock(mutex);
+              batchSizes.push_back(requests.size);
+          }
+
+          // a batch handler may answer fewer requests, the others fail
+          std::vector<FDCore::Response> responses;
+          for(size_t i = 0; i + 1 < requests.size; ++i)
+              responses.push_back(reverseHandler(requests[i], pool));
+          return responses;
+      });
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+
+    FDCore::MessageClient client(FDCore::Socket::connectTcp("127.0.0.1", port));
+    std::vector<FDCore::Request> requests;
+    for(size_t i = 0; i < 200; ++i)
+        requests.push_back(makeServerRequest(client, FDCore::RequestType::Read, "ab"));
+    client.send({ requests.size(), requests.data() });
+
+    size_t failures = 0;
+    for(FDCore::Request &request: requests)
+    {
+        FDCore::Response response = client.receive(request.getRequestId());
+        if(response.getStatus() == FDCore::ResponseStatus::InternalError)
+            ++failures;
+        else
+            ASSERT_EQ(bytesText(response.getPayload()), "ba");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t handled = 0;
+    for(size_t size: batchSizes)
+    {
+        ASSERT_LE(size, FDCore::MessageServer::MaxBatchSize);
+        handled += size;
+    }
+    ASSERT_EQ(handled, requests.size());
+    ASSERT_EQ(failures, batchSizes.size());
+    ASSERT_LT(batchSizes.size(), requests.size());
+}
+
+TEST(MessageServer_test, test_connections)
+{
+    FDCore::ThreadPool threads(2);
+    FDCore::MessageServer server(threads, &reverseHandler);
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+
+    std::vector<std::thread> clients;
+    std::vector<size_t> answered(8, 0);
+    for(size_t c = 0; c < answered.size(); ++c)
+    {
+        clients.emplace_back([port, c, &answered]() {
+            FDCore::MessageClient client(FDCore::Socket::connectTcp("127.0.0.1", port));
+            for(size_t i = 0; i < 100; ++i)
+            {
+                const std::string payload = std::to_string(c * 1000 + i);
+                FDCore::Request request =
+                  makeServerRequest(client, FDCore::RequestType::Read, payload);
+                FDCore::Response response = client.call(request);
+                std::string expected = payload;
+                std::reverse(expected.begin(), expected.end());
+                if(bytesText(response.getPayload()) == expected)
+                    ++answered[c];
+            }
+        });
+    }
+
+    for(std::thread &client: clients)
+        client.join();
+    for(size_t count: answered)
+        ASSERT_EQ(count, 100u);
+}
+
+TEST(MessageServer_test, test_malformed)
+{
+    FDCore::ThreadPool threads(1);
+    FDCore::MessageServer server(threads, &reverseHandler);
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+
+    // a frame whose header length is shorter than the preamble closes the connection
+    FDCore::Socket socket = FDCore::Socket::connectTcp("127.0.0.1", port);
+    const uint8_t frame[13] = { 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    ASSERT_EQ(write(socket.getDescriptor(), frame, sizeof(frame)), 13);
+    FDCore::MessageClient client(std::move(socket));
+    FDCore::Request ignored = makeServerRequest(client, FDCore::RequestType::Read, "abc");
+    ASSERT_THROW(client.call(ignored), std::runtime_error);
+
+    // the requests already received are still answered after the client stops sending
+    FDCore::Socket halfClosed = FDCore::Socket::connectTcp("127.0.0.1", port);
+    const int descriptor = halfClosed.getDescriptor();
+    FDCore::MessageClient halfClosedClient(std::move(halfClosed));
+    FDCore::Request request = makeServerRequest(halfClosedClient, FDCore::RequestType::Read, "xyz");
+    const uint32_t requestId = halfClosedClient.send(request);
+    shutdown(descriptor, SHUT_WR);
+    ASSERT_EQ(bytesText(halfClosedClient.receive(requestId).getPayload()), "zyx");
+    char byte;
+    ASSERT_EQ(read(descriptor, &byte, 1), 0);
+}
+
+TEST(MessageServer_test, test_in_flight_limit)
+{
+    FDCore::ThreadPool threads(2);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<size_t> received(0);
+    FDCore::MessageServer server(
+      threads, [&](FDCore::Span<const FDCore::Request, size_t> requests, FDCore::BufferPool &pool) {
+          received += requests.size;
+          released.wait();
+          std::vector<FDCore::Response> responses;
+          for(const FDCore::Request &request: requests)
+              responses.push_back(reverseHandler(request, pool));
+          return responses;
+      });
+    ASSERT_THROW(server.setMaxInFlightRequests(0), std::invalid_argument);
+    server.setMaxInFlightRequests(8);
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+    ASSERT_THROW(server.setMaxInFlightRequests(16), std::logic_error);
+
+    // the requests past the limit are not handed to the handlers until some are answered
+    FDCore::MessageClient client(FDCore::Socket::connectTcp("127.0.0.1", port));
+    std::vector<FDCore::Request> requests;
+    for(size_t i = 0; i < 100; ++i)
+        requests.push_back(makeServerRequest(client, FDCore::RequestType::Read, std::to_string(i)));
+    client.send({ requests.size(), requests.data() });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_GT(received.load(), 0u);
+    ASSERT_LE(received.load(), 8u);
+
+    release.set_value();
+    for(size_t i = 0; i < requests.size(); ++i)
+    {
+        std::string expected = std::to_string(i);
+        std::reverse(expected.begin(), expected.end());
+        ASSERT_EQ(bytesText(client.receive(requests[i].getRequestId()).getPayload()), expected);
+    }
+    ASSERT_EQ(received.load(), requests.size());
+}
+
+static double processSeconds()
+{
+    timespec time {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+}
+
+TEST(MessageServer_test, test_descriptor_exhaustion)
+{
+    FDCore::ThreadPool threads(1);
+    FDCore::MessageServer server(threads, &reverseHandler);
+    const uint16_t port = server.listenTcp("127.0.0.1", 0);
+    server.start();
+    FDCore::MessageClient busy(FDCore::Socket::connectTcp("127.0.0.1", port));
+
+    // the client descriptor is taken before the others run out, connecting needs no new one
+    const int descriptor = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(descriptor, 0);
+    rlimit limit {};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &limit), 0);
+    rlimit lowered = limit;
+    lowered.rlim_cur = std::min<rlim_t>(limit.rlim_cur, 1024);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &lowered), 0);
+    std::vector<int> spares;
+    for(int spare; (spare = open("/dev/null", O_RDONLY | O_CLOEXEC)) >= 0;)
+        spares.push_back(spare);
+    const int error = errno;
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    const int connected =
+      connect(descriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+
+    // the listener that cannot accept is paused instead of waking the loop again and again
+    const double start = processSeconds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const double spent = processSeconds() - start;
+
+    // traffic on another connection wakes the loop before the retry delay runs out
+    std::atomic<bool> stopped(false);
+    std::thread traffic([&busy, &stopped]() {
+        while(!stopped)
+        {
+            FDCore::Request request = makeServerRequest(busy, FDCore::RequestType::Read, "x");
+            busy.call(request);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    for(int spare: spares)
+        ::close(spare);
+    setrlimit(RLIMIT_NOFILE, &limit);
+
+    // the connection is accepted once descriptors are available again, even on a busy loop
+    FDCore::MessageClient client { FDCore::Socket(descriptor) };
+    FDCore::Request request = makeServerRequest(client, FDCore::RequestType::Read, "abc");
+    client.send(request);
+    pollfd answer { descriptor, POLLIN, 0 };
+    const int ready = poll(&answer, 1, 2000);
+    stopped = true;
+    traffic.join();
+
+    ASSERT_EQ(error, EMFILE);
+    ASSERT_EQ(connected, 0);
+    ASSERT_LT(spent, 0.15);
+    ASSERT_EQ(ready, 1);
+    ASSERT_EQ(bytesText(client.receive(request.getRequestId()).getPayload()), "cba");
+}
+
+#endif // FDCORE_MESSAGESERVER_TEST_H
@@ -0,0 +1,159 @@
+#ifndef FDCORE_PAYLOADCOMPRESSION_TEST_H
+#define FDCORE_PAYLOADCOMPRESSION_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Communication/DeflateCodec.h>
+#include <FDCore/Communication/PayloadCompression.h>
+#include <FDCore/Communication/Request.h>
+#include <FDCore/Communication/Response.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::string makeRepetitivePayload(size_t records)
+{
+    std::string payload = "[";
+    for(size_t i = 0; i < records; ++i)
+        payload += "{\"id\":" + std::to_string(i) + ",\"status\":\"active\",\"kind\":\"item\"},";
+    payload.back() = ']';
+    return payload;
+}
+
+TEST(PayloadCompression_test, test_round_trip)
+{
+    FDCore::BufferPool pool;
+    FDCore::PayloadCompression compression(std::make_shared<FDCore::DeflateCodec>());
+    FDCore::MessageHeader header;
+    header.setFiled("path", textBytes("/items"));
+
+    const std::string payload = makeRepetitivePayload(200);
+    FDCore::Request request = FDCore::Request::create(pool, FDCore::RequestType::Create, header,
+                                                      textBytes(payload), compression);
+    ASSERT_EQ(request.getRequestType(), FDCore::RequestType::Create);
+    ASSERT_TRUE(FDCore::PayloadCompression::isCompressed(request.getHeader()));
+    ASSERT_EQ(bytesText(request.getHeader().getField("content-encoding")), "deflate");
+    ASSERT_EQ(bytesText(request.getHeader().getField("path")), "/items");
+    ASSERT_LT(request.getPayload().size, payload.size() / 4);
+
+    const FDCore::BufferSlice decoded = compression.decode(request, pool);
+    ASSERT_TRUE(decoded.isOwning());
+    ASSERT_EQ(bytesText(decoded.getData()), payload);
+
+    // small and incompressible payloads are sent as is
+    const std::string small = "{\"id\":1}";
+    FDCore::Response response = FDCore::Response::create(
+      pool, FDCore::ResponseStatus::Ok, header, textBytes(small), compression);
+    ASSERT_FALSE(FDCore::PayloadCompression::isCompressed(response.getHeader()));
+    const FDCore::BufferSlice plain = compression.decode(response, pool);
+    ASSERT_EQ(plain.data(), response.getPayload().data);
+    ASSERT_EQ(plain.getBuffer().use_count(), 2);
+
+    std::string noise(4096, '\0');
+    std::mt19937 random(42);
+    std::generate(noise.begin(), noise.end(), [&random]() { return static_cast<char>(random()); });
+    FDCore::Message message = compression.encode(pool, 0, header, textBytes(noise));
+    ASSERT_FALSE(FDCore::PayloadCompression::isCompressed(message.getHeader()));
+    ASSERT_EQ(bytesText(message.getPayload()), noise);
+}
+
+TEST(PayloadCompression_test, test_dictionary)
+{
+    FDCore::BufferPool pool;
+    auto codec = std::make_shared<FDCore::DeflateCodec>();
+    FDCore::PayloadCompression plain(codec, 0);
+    FDCore::PayloadCompression primed(codec, 0);
+    const std::string sample = makeRepetitivePayload(8);
+    primed.addDictionary(7, std::vector<uint8_t>(sample.begin(), sample.end()));
+    primed.useDictionary(7);
+
+    const std::string payload = "{\"id\":12,\"status\":\"active\",\"kind\":\"item\"}";
+    FDCore::Message withDictionary =
+      primed.encode(pool, 0, FDCore::MessageHeader(), textBytes(payload));
+    ASSERT_TRUE(FDCore::PayloadCompression::isCompressed(withDictionary.getHeader()));
+    ASSERT_TRUE(withDictionary.getHeader().hasField("dictionary-id"));
+    ASSERT_EQ(bytesText(primed.decode(withDictionary, pool).getData()), payload);
+
+    // the small payload only compresses thanks to the dictionary
+    FDCore::Message withoutDictionary =
+      plain.encode(pool, 0, FDCore::MessageHeader(), textBytes(payload));
+    ASSERT_LT(withDictionary.getFrame().size, withoutDictionary.getFrame().size);
+
+    ASSERT_THROW(plain.decode(withDictionary, pool), std::invalid_argument);
+    ASSERT_THROW(primed.addDictionary(0, {}), std::invalid_argument);
+    ASSERT_THROW(primed.useDictionary(8), std::invalid_argument);
+}
+
+TEST(PayloadCompression_test, test_errors)
+{
+    FDCore::BufferPool pool;
+    FDCore::PayloadCompression compression(std::make_shared<FDCore::DeflateCodec>(), 0);
+    const std::string payload = makeRepetitivePayload(50);
+    FDCore::Message message =
+      compression.encode(pool, 0, FDCore::MessageHeader(), textBytes(payload));
+    ASSERT_TRUE(FDCore::PayloadCompression::isCompressed(message.getHeader()));
+
+    compression.setMaxDecodedSize(payload.size() - 1);
+    ASSERT_THROW(compression.decode(message, pool), std::length_error);
+    compression.setMaxDecodedSize(payload.size());
+    ASSERT_EQ(bytesText(compression.decode(message, pool).getData()), payload);
+
+    // a truncated payload, and a payload claiming another encoding
+    FDCore::Span<const uint8_t> truncated = message.getPayload();
+    truncated.size /= 2;
+    ASSERT_THROW(compression.decode(message.getHeader(), truncated, pool), std::invalid_argument);
+
+    FDCore::MessageHeader header = message.getHeader().toHeader();
+    header.setFiled("content-encoding", textBytes("lz4"));
+    FDCore::Message unknown = FDCore::Message::encode(pool, 0, header, message.getPayload());
+    ASSERT_THROW(compression.decode(unknown, pool), std::invalid_argument);
+
+    header.setFiled("content-encoding", textBytes("deflate"));
+    header.setFiled("decoded-length", textBytes("1"));
+    FDCore::Message invalidLength = FDCore::Message::encode(pool, 0, header, message.getPayload());
+    ASSERT_THROW(compression.decode(invalidLength, pool), std::invalid_argument);
+
+    ASSERT_THROW(FDCore::DeflateCodec(0), std::invalid_argument);
+}
+
+TEST(PayloadCompression_test, test_streaming)
+{
+    const FDCore::DeflateCodec codec(6);
+    const std::string payload = makeRepetitivePayload(100);
+    std::vector<uint8_t> compressed(payload.size());
+    const size_t compressedSize = codec.compress(
+      textBytes(payload), { static_cast<uint32_t>(compressed.size()), compressed.data() },
+      { 0, nullptr });
+    ASSERT_GT(compressedSize, 0u);
+    ASSERT_EQ(codec.compress(textBytes(payload), { 8, compressed.data() }, { 0, nullptr }), 0u);
+
+    // the compressed bytes arrive 7 at a time and are decompressed 100 bytes at a time
+    std::unique_ptr<FDCore::PayloadDecompressor> decompressor =
+      codec.createDecompressor({ 0, nullptr });
+    std::string decoded;
+    uint8_t chunk[100];
+    size_t offset = 0;
+    while(!decompressor->isFinished())
+    {
+        const size_t available = std::min<size_t>(7, compressedSize - offset);
+        const FDCore::PayloadDecompressor::Progress progress = decompressor->decompress(
+          { static_cast<uint32_t>(available), compressed.data() + offset }, { 100, chunk });
+        offset += progress.consumed;
+        decoded.append(chunk, chunk + progress.produced);
+        ASSERT_TRUE(progress.consumed > 0 || progress.produced > 0);
+    }
+    ASSERT_EQ(offset, compressedSize);
+    ASSERT_EQ(decoded, payload);
+
+    std::unique_ptr<FDCore::PayloadDecompressor> corrupted =
+      codec.createDecompressor({ 0, nullptr });
+    const uint8_t garbage[] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    ASSERT_THROW(corrupted->decompress({ sizeof(garbage), garbage }, { 100, chunk }),
+                 std::invalid_argument);
+}
+
+#endif // FDCORE_PAYLOADCOMPRESSION_TEST_H
@@ -0,0 +1,161 @@
+#ifndef FDCORE_SHAREDMEMORYCHANNEL_TEST_H
+#define FDCORE_SHAREDMEMORYCHANNEL_TEST_H
+
+#include "CommunicationTestHelpers.h"
+
+#include <FDCore/Communication/Request.h>
+#include <FDCore/Communication/SharedMemoryChannel.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static std::string channelName(const std::string &suffix)
+{
+    const std::string name = "/fdcore_test_" + std::to_string(getpid()) + "_" + suffix;
+    FDCore::SharedMemoryChannel::remove(name);
+    return name;
+}
+
+static FDCore::MessageHeader channelHeader(uint8_t type, std::string_view id)
+{
+    FDCore::MessageHeader header;
+    header.setType(type);
+    header.setFiled("id", textBytes(id));
+    return header;
+}
+
+TEST(SharedMemoryChannel_test, test_send_receive)
+{
+    const std::string name = channelName("basic");
+    FDCore::SharedMemoryChannel producer = FDCore::SharedMemoryChannel::create(name, 10000);
+    FDCore::SharedMemoryChannel consumer = FDCore::SharedMemoryChannel::open(name);
+    FDCore::SharedMemoryChannel::remove(name);
+    ASSERT_EQ(producer.getCapacity(), 16384u);
+    ASSERT_EQ(consumer.getCapacity(), 16384u);
+    ASSERT_THROW(FDCore::SharedMemoryChannel::open(name), std::system_error);
+
+    FDCore::BufferPool pool;
+    FDCore::Request request;
+    ASSERT_FALSE(consumer.receive(request, pool, 0));
+    ASSERT_FALSE(consumer.receive(request, pool, 5));
+
+    ASSERT_TRUE(producer.send(channelHeader(1, "first"), textBytes("payload")));
+    ASSERT_TRUE(consumer.receive(request, pool));
+    ASSERT_EQ(request.getRequestType(), FDCore::RequestType::Read);
+    ASSERT_EQ(std::string(request.getPayload().begin(), request.getPayload().end()), "payload");
+
+    FDCore::Request built = FDCore::Request::create(pool, FDCore::RequestType::Delete,
+                                                    channelHeader(0, "second"), textBytes(""));
+    ASSERT_TRUE(producer.send(built));
+
+    // frames are read in place
+    ASSERT_TRUE(consumer.read([&built](FDCore::Span<const uint8_t> frame) {
+        ASSERT_EQ(frame.size, built.getFrame().size);
+        ASSERT_EQ(memcmp(frame.data, built.getFrame().data, frame.size), 0);
+    }));
+    ASSERT_FALSE(consumer.read([](FDCore::Span<const uint8_t>) {}, 0));
+}
+
+TEST(SharedMemoryChannel_test, test_wrap)
+{
+    const std::string name = channelName("wrap");
+    FDCore::SharedMemoryChannel channel = FDCore::SharedMemoryChannel::create(name, 4096);
+    FDCore::SharedMemoryChannel::remove(name);
+    ASSERT_EQ(channel.getMaxFrameSize(), 2040u);
+
+    const std::string large(channel.getMaxFrameSize(), 'x');
+    ASSERT_THROW(channel.send(FDCore::MessageHeader(), textBytes(large)), std::length_error);
+
+    // records of every size go around the ring many times
+    FDCore::BufferPool pool;
+    size_t sent = 0;
+    size_t received = 0;
+    for(size_t round = 0; round < 200; ++round)
+    {
+        while(channel.send(channelHeader(0, std::to_string(sent)),
+                           textBytes(std::string(sent * 37 % 900, 'a' + sent % 26)), 0))
+            ++sent;
+
+        const size_t target = received + (sent - received) / 2 + 1;
+        for(; received < target; ++received)
+        {
+            FDCore::Message message;
+            ASSERT_TRUE(channel.receive(message, pool, 0));
+            ASSERT_EQ(message.getHeader().getField("id").size, std::to_string(received).size());
+            ASSERT_EQ(message.getPayload().size, received * 37 % 900);
+        }
+    }
+
+    ASSERT_GT(sent, 400u);
+}
+
+TEST(SharedMemoryChannel_test, test_producers)
+{
+    const std::string name = channelName("producers");
+    FDCore::SharedMemoryChannel consumer = FDCore::SharedMemoryChannel::create(name, 8192);
+    constexpr size_t producerCount = 4;
+    constexpr size_t messageCount = 5000;
+
+    std::vector<std::thread> producers;
+    for(size_t p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&name, p]() {
+            FDCore::SharedMemoryChannel producer = FDCore::SharedMemoryChannel::open(name);
+            for(size_t i = 0; i < messageCount; ++i)
+                producer.send(channelHeader(static_cast<uint8_t>(p), std::to_string(i)),
+                              textBytes(std::string(i % 100, 'p')));
+        });
+    }
+
+    // the messages of each producer arrive in order
+    FDCore::BufferPool pool;
+    std::vector<size_t> next(producerCount, 0);
+    for(size_t i = 0; i < producerCount * messageCount; ++i)
+    {
+        FDCore::Message message;
+        ASSERT_TRUE(consumer.receive(message, pool, 10000));
+        const size_t producer = message.getType();
+        const FDCore::Span<const uint8_t> id = message.getHeader().getField("id");
+        ASSERT_EQ(std::string(id.begin(), id.end()), std::to_string(next[producer]));
+        ++next[producer];
+    }
+
+    for(std::thread &producer: producers)
+        producer.join();
+    FDCore::SharedMemoryChannel::remove(name);
+}
+
+TEST(SharedMemoryChannel_test, test_processes)
+{
+    const std::string name = channelName("processes");
+    FDCore::SharedMemoryChannel consumer = FDCore::SharedMemoryChannel::create(name, 4096);
+
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0)
+    {
+        FDCore::SharedMemoryChannel producer = FDCore::SharedMemoryChannel::open(name);
+        for(size_t i = 0; i < 1000; ++i)
+            producer.send(channelHeader(2, std::to_string(i)), textBytes("from child"));
+        _exit(0);
+    }
+
+    FDCore::BufferPool pool;
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        FDCore::Request request;
+        ASSERT_TRUE(consumer.receive(request, pool, 10000));
+        ASSERT_EQ(request.getRequestType(), FDCore::RequestType::Update);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    FDCore::SharedMemoryChannel::remove(name);
+}
+
+#endif // FDCORE_SHAREDMEMORYCHANNEL_TEST_H
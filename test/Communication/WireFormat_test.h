@@ -0,0 +1,50 @@
+#ifndef FDCORE_WIREFORMAT_TEST_H
+#define FDCORE_WIREFORMAT_TEST_H
+
+#include <FDCore/Communication/WireFormat.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+
+TEST(WireFormat_test, test_varint)
+{
+    for(uint32_t value: { 0u, 1u, 127u, 128u, 300u, 16383u, 16384u, 0x0FFFFFFFu, 0xFFFFFFFFu })
+    {
+        uint8_t buffer[FDCore::WireFormat::MaxVarintSize];
+        const size_t size = FDCore::WireFormat::storeVarint(buffer, value);
+        ASSERT_EQ(size, FDCore::WireFormat::varintSize(value));
+
+        uint32_t loaded = 0;
+        ASSERT_EQ(FDCore::WireFormat::loadVarint(buffer, size, loaded), size);
+        ASSERT_EQ(loaded, value);
+        ASSERT_EQ(FDCore::WireFormat::loadVarint(buffer, size - 1, loaded), 0u);
+    }
+
+    ASSERT_EQ(FDCore::WireFormat::varintSize(127), 1u);
+    ASSERT_EQ(FDCore::WireFormat::varintSize(128), 2u);
+    ASSERT_EQ(FDCore::WireFormat::varintSize(0xFFFFFFFF), 5u);
+
+    // more than 32 bits, and more than 5 bytes
+    uint32_t value = 0;
+    const uint8_t overflow[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x1F };
+    ASSERT_EQ(FDCore::WireFormat::loadVarint(overflow, sizeof(overflow), value), 0u);
+    const uint8_t tooLong[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+    ASSERT_EQ(FDCore::WireFormat::loadVarint(tooLong, sizeof(tooLong), value), 0u);
+    ASSERT_EQ(FDCore::WireFormat::loadVarint(tooLong, 0, value), 0u);
+}
+
+TEST(WireFormat_test, test_field_names)
+{
+    std::set<std::string_view> names(FDCore::WireFormat::FieldNames.begin(),
+                                     FDCore::WireFormat::FieldNames.end());
+    ASSERT_EQ(names.size(), FDCore::WireFormat::FieldNames.size());
+
+    ASSERT_EQ(FDCore::WireFormat::findFieldKey("path"), 1u);
+    ASSERT_EQ(FDCore::WireFormat::findFieldKey(FDCore::WireFormat::FieldNames.back()),
+              FDCore::WireFormat::FieldNames.size());
+    ASSERT_EQ(FDCore::WireFormat::findFieldKey("pat"), 0u);
+    ASSERT_EQ(FDCore::WireFormat::findFieldKey(""), 0u);
+}
+
+#endif // FDCORE_WIREFORMAT_TEST_H
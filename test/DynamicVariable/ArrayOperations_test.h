@@ -0,0 +1,138 @@
+#ifndef FDCORE_ARRAYOPERATIONS_TEST_H
+#define FDCORE_ARRAYOPERATIONS_TEST_H
+
+#include <FDCore/DynamicVariable/ArrayOperations.h>
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using FDCore::operator""_var;
+
+TEST(ArrayOperations_test, test_arithmetic)
+{
+    FDCore::DynamicVariable ints(std::vector<FDCore::DynamicVariable::IntType> { 1, 2, 3, 4, 5 });
+    FDCore::DynamicVariable floats { 0.5_var, 1.5_var, 2.5_var, 3.5_var, 4.5_var };
+
+    FDCore::DynamicVariable sum = FDCore::arrayAdd(ints, ints);
+    ASSERT_EQ(sum.getElementType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(sum[4], 10);
+
+    FDCore::DynamicVariable mixed = FDCore::arraySub(floats, ints);
+    ASSERT_EQ(mixed.getElementType(), FDCore::ValueType::Float);
+    ASSERT_DOUBLE_EQ(static_cast<double>(mixed[2]), -0.5);
+    ASSERT_EQ(floats.getElementType(), FDCore::ValueType::None);
+
+    FDCore::DynamicVariable scaled = FDCore::arrayMul(2_var, ints);
+    ASSERT_EQ(scaled[3], 8);
+    ASSERT_DOUBLE_EQ(static_cast<double>(FDCore::arrayDiv(ints, 2.0_var)[0]), 0.5);
+    ASSERT_EQ(FDCore::arrayDiv(ints, 2_var)[2], 1);
+
+    ASSERT_THROW(FDCore::arrayDiv(ints, 0_var), std::domain_error);
+
+    // the quotient of the smallest integer by -1 does not fit
+    const FDCore::DynamicVariable::IntType smallest =
+      std::numeric_limits<FDCore::DynamicVariable::IntType>::min();
+    FDCore::DynamicVariable extremes(
+      std::vector<FDCore::DynamicVariable::IntType> { 7, smallest });
+    FDCore::DynamicVariable divisors(std::vector<FDCore::DynamicVariable::IntType> { -1, 2 });
+    ASSERT_THROW(FDCore::arrayDiv(extremes, -1_var), std::overflow_error);
+    ASSERT_THROW(FDCore::arrayDiv(FDCore::DynamicVariable(smallest), divisors),
+                 std::overflow_error);
+    ASSERT_EQ(FDCore::arrayDiv(extremes, 1_var)[1], smallest);
+    ASSERT_EQ(FDCore::arrayDiv(extremes, divisors)[0], -7);
+    ASSERT_THROW(FDCore::arrayAdd(ints, FDCore::DynamicVariable { 1_var }),
+                 std::invalid_argument);
+
+    FDCore::DynamicVariable strings { "a"_var, "b"_var };
+    FDCore::DynamicVariable concatenated = FDCore::arrayAdd(strings, "c"_var);
+    ASSERT_EQ(concatenated[1], FDCore::DynamicVariable::StringType("bc"));
+}
+
+TEST(ArrayOperations_test, test_compare)
+{
+    FDCore::DynamicVariable ints(std::vector<FDCore::DynamicVariable::IntType> { 1, 2, 3 });
+    FDCore::DynamicVariable mask =
+      FDCore::arrayCompare(ints, 2_var, FDCore::ComparisonOperator::GreaterOrEqual);
+    ASSERT_EQ(mask.getElementType(), FDCore::ValueType::Boolean);
+    ASSERT_FALSE(static_cast<bool>(mask[0]));
+    ASSERT_TRUE(static_cast<bool>(mask[1]));
+    ASSERT_TRUE(static_cast<bool>(mask[2]));
+
+    FDCore::DynamicVariable equal =
+      FDCore::arrayCompare(ints, FDCore::DynamicVariable { 1.0_var, 2.5_var, 3.0_var },
+                           FDCore::ComparisonOperator::Equal);
+    ASSERT_TRUE(static_cast<bool>(equal[0]));
+    ASSERT_FALSE(static_cast<bool>(equal[1]));
+
+    ASSERT_THROW(FDCore::arrayCompare(ints, "a"_var, FDCore::ComparisonOperator::Less),
+                 std::runtime_error);
+}
+
+TEST(ArrayOperations_test, test_reductions)
+{
+    FDCore::DynamicVariable ints(std::vector<FDCore::DynamicVariable::IntType> { 4, -2, 9, 1, 3 });
+    ASSERT_EQ(FDCore::arraySum(ints), 15);
+    ASSERT_EQ(FDCore::arrayMin(ints), -2);
+    ASSERT_EQ(FDCore::arrayMax(ints), 9);
+    ASSERT_DOUBLE_EQ(static_cast<double>(FDCore::arrayMean(ints)), 3.0);
+
+    FDCore::DynamicVariable mixed { 1_var, 2.5_var };
+    ASSERT_DOUBLE_EQ(static_cast<double>(FDCore::arraySum(mixed)), 3.5);
+
+    FDCore::DynamicVariable empty(FDCore::ValueType::Array);
+    ASSERT_EQ(FDCore::arraySum(empty), 0);
+    ASSERT_TRUE(FDCore::arrayMin(empty) == nullptr);
+    ASSERT_THROW(FDCore::arraySum(3_var), std::runtime_error);
+
+    const FDCore::DynamicVariable::IntType largest =
+      std::numeric_limits<FDCore::DynamicVariable::IntType>::max();
+    FDCore::DynamicVariable large(
+      std::vector<FDCore::DynamicVariable::IntType> { largest, largest });
+    ASSERT_DOUBLE_EQ(static_cast<double>(FDCore::arrayMean(large)),
+                     static_cast<double>(largest));
+    ASSERT_EQ(FDCore::arraySum(large), -2);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for(size_t position = 0; position < 3; ++position)
+    {
+        std::vector<double> values { 2.0, -1.0, 5.0 };
+        values[position] = nan;
+        FDCore::DynamicVariable floats(values);
+        ASSERT_TRUE(std::isnan(static_cast<double>(FDCore::arrayMax(floats))));
+        ASSERT_FALSE(std::isnan(static_cast<double>(FDCore::arrayMin(floats))));
+    }
+
+    FDCore::DynamicVariable nans(std::vector<double> { nan, nan });
+    ASSERT_TRUE(std::isnan(static_cast<double>(FDCore::arrayMin(nans))));
+}
+
+TEST(ArrayOperations_test, test_thread_pool)
+{
+    const size_t size = FDCore::ArrayOperationParallelThreshold * 2 + 3;
+    std::vector<FDCore::DynamicVariable::IntType> values(size);
+    std::iota(values.begin(), values.end(), 0);
+
+    FDCore::ThreadPool pool(4);
+    FDCore::DynamicVariable ints(values);
+    FDCore::DynamicVariable doubled = FDCore::arrayAdd(ints, ints, pool);
+    ASSERT_EQ(doubled.size(), size);
+    ASSERT_EQ(doubled[size - 1], static_cast<FDCore::DynamicVariable::IntType>(size - 1) * 2);
+    ASSERT_EQ(FDCore::arraySum(ints, pool), FDCore::arraySum(ints));
+    ASSERT_EQ(FDCore::arrayMax(ints, pool),
+              static_cast<FDCore::DynamicVariable::IntType>(size - 1));
+    ASSERT_EQ(FDCore::arrayMin(doubled, pool), 0);
+
+    std::vector<double> floatValues(values.begin(), values.end());
+    floatValues.front() = std::numeric_limits<double>::quiet_NaN();
+    floatValues.back() = std::numeric_limits<double>::quiet_NaN();
+    FDCore::DynamicVariable floats(floatValues);
+    ASSERT_EQ(FDCore::arrayMin(floats, pool), FDCore::arrayMin(floats));
+    ASSERT_DOUBLE_EQ(static_cast<double>(FDCore::arrayMin(floats, pool)), 1.0);
+    ASSERT_TRUE(std::isnan(static_cast<double>(FDCore::arrayMax(floats, pool))));
+    ASSERT_TRUE(std::isnan(static_cast<double>(FDCore::arrayMax(floats))));
+}
+
+#endif // FDCORE_ARRAYOPERATIONS_TEST_H
@@ -0,0 +1,159 @@
+#ifndef FDCORE_DOCUMENTPATCH_TEST_H
+#define FDCORE_DOCUMENTPATCH_TEST_H
+
+#include "DynamicVariableTestHelpers.h"
+
+#include <FDCore/DynamicVariable/DocumentPatch.h>
+#include <gtest/gtest.h>
+
+using FDCore::operator""_var;
+
+TEST(DocumentPatch_test, test_diff)
+{
+    FDCore::DynamicVariable from = makeSampleDocument();
+    ASSERT_TRUE(FDCore::diff(from, from).empty());
+    ASSERT_TRUE(FDCore::diff(from, makeSampleDocument()).empty());
+
+    FDCore::DynamicVariable to = from;
+    FDCore::DynamicVariable settings = to["settings"];
+    settings.set("port", 9090_var);
+    settings.unset("ratio");
+    settings.set("debug", FDCore::DynamicVariable(true));
+    to.set("settings", settings);
+
+    FDCore::DocumentPatch patch = FDCore::diff(from, to);
+    ASSERT_EQ(patch.size(), 3u);
+    for(const FDCore::PatchOperation &operation: patch)
+    {
+        ASSERT_EQ(operation.path.size(), 2u);
+        if(operation.type == FDCore::PatchOperationType::Replace)
+        {
+            ASSERT_EQ(operation.path.toPointer(), "/settings/port");
+            ASSERT_EQ(operation.value, 9090);
+        }
+        else if(operation.type == FDCore::PatchOperationType::Remove)
+        {
+            ASSERT_EQ(operation.path.toPointer(), "/settings/ratio");
+        }
+        else
+        {
+            ASSERT_EQ(operation.path.toPointer(), "/settings/debug");
+        }
+    }
+
+    FDCore::DynamicVariable shorter = from;
+    shorter.set("tags", FDCore::DynamicVariable { "a"_var });
+    patch = FDCore::diff(from, shorter);
+    ASSERT_EQ(patch.size(), 2u);
+    ASSERT_EQ(patch[0].path.toPointer(), "/tags/2");
+    ASSERT_EQ(patch[1].path.toPointer(), "/tags/1");
+
+    patch = FDCore::diff(from, 1_var);
+    ASSERT_EQ(patch.size(), 1u);
+    ASSERT_EQ(patch[0].type, FDCore::PatchOperationType::Replace);
+    ASSERT_TRUE(patch[0].path.isEmpty());
+}
+
+TEST(DocumentPatch_test, test_apply)
+{
+    FDCore::DynamicVariable from = makeSampleDocument();
+    FDCore::DynamicVariable to = from;
+    FDCore::DynamicVariable settings = to["settings"];
+    settings.set("port", 9090_var);
+    settings.unset("name");
+    to.set("settings", settings);
+    to.set("tags", FDCore::DynamicVariable { "a"_var, "x"_var, "c"_var, "d"_var });
+    to.set("ids", FDCore::DynamicVariable(std::vector<FDCore::DynamicVariable::IntType> { 1, 5 }));
+
+    FDCore::DynamicVariable document = from;
+    FDCore::applyPatch(document, FDCore::diff(from, to));
+    ASSERT_TRUE(FDCore::diff(document, to).empty());
+    ASSERT_EQ(document["settings"]["port"], 9090);
+    ASSERT_EQ(document["ids"].size(), 2u);
+
+    ASSERT_EQ(from["settings"]["port"], 8080);
+    ASSERT_EQ(from["tags"].size(), 3u);
+    ASSERT_EQ(document["settings"]["ratio"].internalValue(),
+              from["settings"]["ratio"].internalValue());
+
+    FDCore::DocumentPatch patch;
+    patch.push_back({ FDCore::PatchOperationType::Add, FDCore::PathQuery("/tags/-"), "e"_var });
+    patch.push_back({ FDCore::PatchOperationType::Add, FDCore::PathQuery("/tags/0"), "z"_var });
+    patch.push_back({ FDCore::PatchOperationType::Remove, FDCore::PathQuery("/ids/0"), {} });
+    FDCore::applyPatch(document, patch);
+    ASSERT_EQ(document["tags"].size(), 6u);
+    ASSERT_EQ(document["tags"][0], FDCore::DynamicVariable::StringType("z"));
+    ASSERT_EQ(document["tags"][5], FDCore::DynamicVariable::StringType("e"));
+    ASSERT_EQ(document["ids"][0], 5);
+
+    FDCore::DynamicVariable before = document;
+    patch.clear();
+    patch.push_back({ FDCore::PatchOperationType::Replace, FDCore::PathQuery("/tags/0"), 1_var });
+    patch.push_back({ FDCore::PatchOperationType::Remove, FDCore::PathQuery("/missing"), {} });
+    ASSERT_THROW(FDCore::applyPatch(document, patch), std::invalid_argument);
+    ASSERT_EQ(document.internalValue(), before.internalValue());
+    ASSERT_EQ(document["tags"][0], FDCore::DynamicVariable::StringType("z"));
+
+    patch.clear();
+    patch.push_back(
+      { FDCore::PatchOperationType::Add, FDCore::PathQuery("/ids/0/value"), "a"_var });
+    ASSERT_THROW(FDCore::applyPatch(document, patch), std::invalid_argument);
+}
+
+TEST(DocumentPatch_test, test_dense_arrays)
+{
+    typedef std::vector<FDCore::DynamicVariable::IntType> IntVector;
+    FDCore::DynamicVariable from(FDCore::ValueType::Object);
+    from.set("ids", FDCore::DynamicVariable(IntVector { 1, 2, 3 }));
+    ASSERT_EQ(from["ids"].getElementType(), FDCore::ValueType::Integer);
+
+    FDCore::DynamicVariable replaced(FDCore::ValueType::Object);
+    replaced.set("ids", FDCore::DynamicVariable { 1_var, "x"_var, 3_var });
+    FDCore::DynamicVariable document = from;
+    FDCore::applyPatch(document, FDCore::diff(from, replaced));
+    ASSERT_TRUE(FDCore::diff(document, replaced).empty());
+    ASSERT_EQ(document["ids"].getElementType(), FDCore::ValueType::None);
+    ASSERT_EQ(from["ids"].getElementType(), FDCore::ValueType::Integer);
+
+    FDCore::DynamicVariable grown(FDCore::ValueType::Object);
+    grown.set("ids", FDCore::DynamicVariable { 1_var, 2_var, 3_var, "y"_var });
+    document = from;
+    FDCore::applyPatch(document, FDCore::diff(from, grown));
+    ASSERT_TRUE(FDCore::diff(document, grown).empty());
+
+    FDCore::DocumentPatch patch;
+    patch.push_back({ FDCore::PatchOperationType::Add, FDCore::PathQuery("/ids/0"), "a"_var });
+    patch.push_back({ FDCore::PatchOperationType::Replace, FDCore::PathQuery("/ids/1"), 0.5_var });
+    document = from;
+    FDCore::applyPatch(document, patch);
+    ASSERT_EQ(document["ids"].size(), 4u);
+    ASSERT_EQ(document["ids"][0], FDCore::DynamicVariable::StringType("a"));
+    ASSERT_EQ(document["ids"][1], 0.5);
+    ASSERT_EQ(document["ids"][2], 2);
+}
+
+TEST(DocumentPatch_test, test_json_patch)
+{
+    FDCore::DynamicVariable from = makeSampleDocument();
+    FDCore::DynamicVariable to = from;
+    to.set("tags", FDCore::DynamicVariable { "a"_var });
+    to.set("a/b", 3_var);
+
+    FDCore::DynamicVariable json = FDCore::toJsonPatch(FDCore::diff(from, to));
+    ASSERT_EQ(json.size(), 3u);
+    ASSERT_EQ(json[0]["op"], FDCore::DynamicVariable::StringType("remove"));
+    ASSERT_TRUE(json[0]["value"] == nullptr);
+
+    FDCore::DocumentPatch patch = FDCore::fromJsonPatch(json);
+    FDCore::applyPatch(from, patch);
+    ASSERT_TRUE(FDCore::diff(from, to).empty());
+    ASSERT_EQ(from["a/b"], 3);
+
+    FDCore::DynamicVariable move(FDCore::ValueType::Object);
+    move.set("op", "move"_var);
+    move.set("path", "/a"_var);
+    ASSERT_THROW(FDCore::fromJsonPatch(FDCore::DynamicVariable { move }), std::invalid_argument);
+    ASSERT_THROW(FDCore::fromJsonPatch(move), std::invalid_argument);
+}
+
+#endif // FDCORE_DOCUMENTPATCH_TEST_H
@@ -0,0 +1,148 @@
+#ifndef FDCORE_DYNAMICVARIABLEHASH_TEST_H
+#define FDCORE_DYNAMICVARIABLEHASH_TEST_H
+
+#include <FDCore/Common/ContiguousMap.h>
+#include <FDCore/Common/ContiguousSet.h>
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+using FDCore::operator""_var;
+
+static FDCore::DynamicVariable makeHashKey(FDCore::DynamicVariable::IntType id)
+{
+    FDCore::DynamicVariable key(FDCore::ValueType::Object);
+    key.set("id", FDCore::DynamicVariable(id));
+    key.set("tags", FDCore::DynamicVariable { "a"_var, "b"_var });
+    return key;
+}
+
+TEST(DynamicVariableHash_test, test_equality)
+{
+    ASSERT_EQ(makeHashKey(1), makeHashKey(1));
+    ASSERT_NE(makeHashKey(1), makeHashKey(2));
+    const FDCore::DynamicVariable one { 1_var };
+    const FDCore::DynamicVariable oneTwo { 1_var, 2_var };
+    ASSERT_NE(one, oneTwo);
+
+    FDCore::DynamicVariable reordered(FDCore::ValueType::Object);
+    reordered.set("tags", FDCore::DynamicVariable { "a"_var, "b"_var });
+    reordered.set("id", 1_var);
+    ASSERT_EQ(reordered, makeHashKey(1));
+
+    FDCore::DynamicVariable dense(std::vector<FDCore::DynamicVariable::IntType> { 1, 2, 3 });
+    FDCore::DynamicVariable generic { 1_var, 2_var, 3_var };
+    ASSERT_EQ(dense, generic);
+    ASSERT_EQ(dense.hash(), generic.hash());
+    const FDCore::DynamicVariable withFloat { 1_var, 2_var, 3.0_var };
+    ASSERT_NE(dense, withFloat);
+}
+
+TEST(DynamicVariableHash_test, test_hash)
+{
+    ASSERT_EQ(makeHashKey(1).hash(), makeHashKey(1).hash());
+    ASSERT_NE(makeHashKey(1).hash(), makeHashKey(2).hash());
+    ASSERT_NE(1_var .hash(), 1.0_var .hash());
+    ASSERT_EQ(0.0_var .hash(), FDCore::DynamicVariable(-0.0).hash());
+    ASSERT_EQ(FDCore::DynamicVariable().hash(), FDCore::DynamicVariable().hash());
+
+    auto interned = std::make_shared<FDCore::StringValue>("key");
+    interned->intern();
+    ASSERT_EQ(FDCore::DynamicVariable(interned).hash(), "key"_var .hash());
+
+    FDCore::DynamicVariable key = makeHashKey(1);
+    const size_t hash = key.hash();
+    ASSERT_EQ(key.internalValue()->getCachedHash(), hash);
+
+    FDCore::DynamicVariable copy = key;
+    copy.set("id", 2_var);
+    ASSERT_EQ(key.hash(), hash);
+    ASSERT_EQ(copy.hash(), makeHashKey(2).hash());
+
+    key.set("id", 2_var);
+    ASSERT_EQ(key.internalValue()->getCachedHash(), 0u);
+    ASSERT_EQ(key.hash(), copy.hash());
+}
+
+TEST(DynamicVariableHash_test, test_compare)
+{
+    ASSERT_LT(FDCore::DynamicVariable(), FDCore::DynamicVariable(false));
+    ASSERT_LT(FDCore::DynamicVariable(true), 0_var);
+    ASSERT_LT(1_var, 1.5_var);
+    ASSERT_LT(1_var, 1.0_var);
+    ASSERT_LT(1.5_var, 2_var);
+    ASSERT_LT(FDCore::DynamicVariable(std::nan("")), "a"_var);
+    ASSERT_GT(FDCore::DynamicVariable(std::nan("")), 1e300_var);
+    ASSERT_LT(FDCore::DynamicVariable(9007199254740993), 9007199254740994.0_var);
+    ASSERT_LT("a"_var, "b"_var);
+
+    const FDCore::DynamicVariable one { 1_var };
+    const FDCore::DynamicVariable oneZero { 1_var, 0_var };
+    const FDCore::DynamicVariable oneTwo { 1_var, 2_var };
+    const FDCore::DynamicVariable two { 2_var };
+    ASSERT_LT("b"_var, one);
+    ASSERT_LT(one, oneZero);
+    ASSERT_LT(oneTwo, two);
+    ASSERT_LT(makeHashKey(1), makeHashKey(2));
+    ASSERT_EQ(makeHashKey(1).compare(makeHashKey(1)), 0);
+    ASSERT_GE(makeHashKey(1), makeHashKey(1));
+    ASSERT_LT(two, FDCore::DynamicVariable(FDCore::ValueType::Object));
+}
+
+TEST(DynamicVariableHash_test, test_containers)
+{
+    std::vector<FDCore::DynamicVariable> keys { makeHashKey(1), "a"_var, 1_var, 1.0_var,
+                                                FDCore::DynamicVariable { 1_var, 2_var },
+                                                makeHashKey(2), FDCore::DynamicVariable() };
+
+    std::unordered_set<FDCore::DynamicVariable> unorderedSet(keys.begin(), keys.end());
+    unorderedSet.insert(makeHashKey(1));
+    ASSERT_EQ(unorderedSet.size(), keys.size());
+    ASSERT_EQ(unorderedSet.count(keys[4]), 1u);
+
+    // NaN keys are deduplicated like any other value
+    std::unordered_set<FDCore::DynamicVariable> floats { FDCore::DynamicVariable(std::nan("")),
+                                                         FDCore::DynamicVariable(-std::nan("")),
+                                                         0.0_var, FDCore::DynamicVariable(-0.0) };
+    ASSERT_EQ(floats.size(), 2u);
+    ASSERT_EQ(floats.count(FDCore::DynamicVariable(std::nan(""))), 1u);
+    ASSERT_EQ(FDCore::DynamicVariable(std::nan("")), FDCore::DynamicVariable(std::nan("")));
+    const FDCore::DynamicVariable nans(
+      std::vector<FDCore::DynamicVariable::FloatType> { 1.0, std::nan("") });
+    const FDCore::DynamicVariable boxedNans { 1.0_var, FDCore::DynamicVariable(std::nan("")) };
+    ASSERT_EQ(nans, boxedNans);
+    ASSERT_EQ(nans.hash(), boxedNans.hash());
+
+    std::set<FDCore::DynamicVariable> orderedSet(keys.begin(), keys.end());
+    orderedSet.insert(makeHashKey(2));
+    ASSERT_EQ(orderedSet.size(), keys.size());
+    ASSERT_TRUE(orderedSet.begin()->isType(FDCore::ValueType::None));
+    ASSERT_EQ(*orderedSet.rbegin(), makeHashKey(2));
+
+    std::unordered_map<FDCore::DynamicVariable, int> unorderedMap;
+    unorderedMap[makeHashKey(1)] = 1;
+    unorderedMap[makeHashKey(1)] += 1;
+    ASSERT_EQ(unorderedMap.size(), 1u);
+    ASSERT_EQ(unorderedMap[makeHashKey(1)], 2);
+
+    FDCore::ContiguousSet<FDCore::DynamicVariable> contiguousSet;
+    for(const FDCore::DynamicVariable &key: keys)
+        contiguousSet.insert(key);
+
+    ASSERT_TRUE(contiguousSet.contains(makeHashKey(2)));
+    ASSERT_FALSE(contiguousSet.contains(makeHashKey(3)));
+
+    FDCore::ContiguousMap<FDCore::DynamicVariable, int> contiguousMap;
+    contiguousMap.insert(makeHashKey(1), 1);
+    contiguousMap.insert("a"_var, 2);
+    ASSERT_NE(contiguousMap.find(makeHashKey(1)), contiguousMap.end());
+    ASSERT_EQ(*contiguousMap.at("a"_var), 2);
+    ASSERT_EQ(contiguousMap.at(makeHashKey(3)), nullptr);
+}
+
+#endif // FDCORE_DYNAMICVARIABLEHASH_TEST_H
@@ -0,0 +1,122 @@
+#ifndef FDCORE_DYNAMICVARIABLEREF_TEST_H
+#define FDCORE_DYNAMICVARIABLEREF_TEST_H
+
+#include "DynamicVariableTestHelpers.h"
+
+#include <FDCore/Common/ThreadPool.h>
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/DynamicVariableRef.h>
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+using FDCore::operator""_var;
+
+TEST(DynamicVariableRef_test, test_freeze)
+{
+    FDCore::DynamicVariable document = makeSampleDocument();
+    ASSERT_FALSE(document.isFrozen());
+
+    document.freeze();
+    ASSERT_TRUE(document.isFrozen());
+    ASSERT_TRUE(document["settings"].isFrozen());
+    ASSERT_TRUE(document["tags"][0].isFrozen());
+
+    const FDCore::AbstractValue *root = document.internalNode();
+    FDCore::DynamicVariable frozen = document;
+    document.set("extra", 1_var);
+    ASSERT_NE(document.internalNode(), root);
+    ASSERT_FALSE(document.isFrozen());
+    ASSERT_FALSE(frozen.get("extra") != nullptr);
+
+    // the only owner of a frozen node copies it too
+    FDCore::DynamicVariable settings = frozen["settings"];
+    frozen = FDCore::DynamicVariable();
+    document = FDCore::DynamicVariable();
+    const FDCore::AbstractValue *node = settings.internalNode();
+    settings.set("port", 9090_var);
+    ASSERT_NE(settings.internalNode(), node);
+    ASSERT_EQ(settings["port"], 9090);
+
+    FDCore::DynamicVariable text = "text"_var;
+    text.freeze();
+    FDCore::DynamicVariable::StringType moved = static_cast<FDCore::DynamicVariable::StringType>(
+      std::move(text));
+    ASSERT_EQ(moved, "text");
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::StringType>(text), "text");
+}
+
+TEST(DynamicVariableRef_test, test_navigation)
+{
+    FDCore::DynamicVariable document = makeSampleDocument();
+    document.freeze();
+
+    FDCore::DynamicVariableRef root(document);
+    ASSERT_TRUE(root.isType(FDCore::ValueType::Object));
+    ASSERT_EQ(root.size(), 3u);
+    ASSERT_EQ(root["settings"]["name"], "server");
+    ASSERT_EQ(static_cast<int>(root["settings"]["port"]), 8080);
+    ASSERT_EQ(root["settings"].getNode(), document["settings"].internalNode());
+    ASSERT_TRUE(root["missing"] == nullptr);
+    ASSERT_TRUE(root.hasMember("tags"));
+
+    FDCore::InternedString interned = FDCore::StringInterner::global().intern("tags");
+    FDCore::DynamicVariableRef tags = root[interned];
+    ASSERT_EQ(tags.size(), 3u);
+    ASSERT_EQ(tags[0], "a");
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::IntType>(tags[1]), 2);
+    ASSERT_DOUBLE_EQ(static_cast<double>(tags[2]), 0.5);
+    ASSERT_THROW(tags[3], std::out_of_range);
+
+    FDCore::DynamicVariableRef ids = root["ids"];
+    ASSERT_TRUE(ids[1].isType(FDCore::ValueType::Integer));
+    ASSERT_EQ(ids[1].getNode(), nullptr);
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::IntType>(ids[2]), 3);
+    ASSERT_EQ(ids[2].toVariable(), 3);
+    ASSERT_EQ(ids.toVariable(), document["ids"]);
+
+    FDCore::DynamicVariable::IntType sum = 0;
+    ids.forEachCell([&sum](const FDCore::DynamicVariableRef &cell) {
+        sum += static_cast<FDCore::DynamicVariable::IntType>(cell);
+    });
+    ASSERT_EQ(sum, 6);
+
+    size_t members = 0;
+    root.forEachMember(
+      [&members](const FDCore::InternedString &, const FDCore::DynamicVariableRef &) {
+          ++members;
+      });
+    ASSERT_EQ(members, 3u);
+    ASSERT_THROW(static_cast<bool>(tags), std::runtime_error);
+}
+
+TEST(DynamicVariableRef_test, test_concurrent_readers)
+{
+    FDCore::DynamicVariable document = makeSampleDocument();
+    document.freeze();
+
+    const FDCore::InternedString settings = FDCore::StringInterner::global().intern("settings");
+    const FDCore::InternedString port = FDCore::StringInterner::global().intern("port");
+    const FDCore::DynamicVariableRef root(document);
+
+    FDCore::ThreadPool pool(4);
+    std::vector<std::future<FDCore::DynamicVariable::IntType>> results;
+    for(size_t i = 0; i < 16; ++i)
+    {
+        results.push_back(pool.enqueue([root, settings, port]() {
+            FDCore::DynamicVariable::IntType sum = 0;
+            for(size_t j = 0; j < 1000; ++j)
+                sum += static_cast<FDCore::DynamicVariable::IntType>(root[settings][port]);
+
+            return sum;
+        }));
+    }
+
+    for(auto &result: results)
+        ASSERT_EQ(result.get(), 8080000);
+
+    ASSERT_EQ(document.internalValue().use_count(), 2);
+}
+
+#endif // FDCORE_DYNAMICVARIABLEREF_TEST_H
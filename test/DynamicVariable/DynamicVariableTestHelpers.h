@@ -0,0 +1,28 @@
+#ifndef FDCORE_DYNAMICVARIABLE_TEST_HELPERS_H
+#define FDCORE_DYNAMICVARIABLE_TEST_HELPERS_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+
+#include <vector>
+
+/**
+ * @brief Document of nested objects and arrays, a boxed and a dense one, shared by the tests
+ */
+static FDCore::DynamicVariable makeSampleDocument()
+{
+    using FDCore::operator""_var;
+
+    FDCore::DynamicVariable settings(FDCore::ValueType::Object);
+    settings.set("name", "server"_var);
+    settings.set("port", 8080_var);
+    settings.set("ratio", 0.5_var);
+
+    FDCore::DynamicVariable document(FDCore::ValueType::Object);
+    document.set("settings", settings);
+    document.set("tags", FDCore::DynamicVariable { "a"_var, 2_var, 0.5_var });
+    document.set("ids", FDCore::DynamicVariable(std::vector<FDCore::DynamicVariable::IntType> {
+                          1, 2, 3 }));
+    return document;
+}
+
+#endif // FDCORE_DYNAMICVARIABLE_TEST_HELPERS_H
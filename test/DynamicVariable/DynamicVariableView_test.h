@@ -0,0 +1,112 @@
+#ifndef FDCORE_DYNAMICVARIABLEVIEW_TEST_H
+#define FDCORE_DYNAMICVARIABLEVIEW_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/DynamicVariableView.h>
+#include <gtest/gtest.h>
+
+static const FDCore::DynamicVariableView::StringType TEST_VIEW_DOCUMENT = R"json(
+{
+    "name": "record \"one\"",
+    "id": 42,
+    "ratio": -1.5e2,
+    "valid": true,
+    "missing": null,
+    "tags": ["a", "bé", "c"],
+    "nested": { "values": [1, [2, 3], { "deep": "}" }] }
+})json";
+
+TEST(DynamicVariableView_test, test_types)
+{
+    FDCore::DynamicVariableView root(TEST_VIEW_DOCUMENT);
+    ASSERT_EQ(root.getValueType(), FDCore::ValueType::Object);
+    ASSERT_EQ(root["name"].getValueType(), FDCore::ValueType::String);
+    ASSERT_EQ(root["id"].getValueType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(root["ratio"].getValueType(), FDCore::ValueType::Float);
+    ASSERT_EQ(root["valid"].getValueType(), FDCore::ValueType::Boolean);
+    ASSERT_EQ(root["missing"].getValueType(), FDCore::ValueType::None);
+    ASSERT_EQ(root["tags"].getValueType(), FDCore::ValueType::Array);
+    ASSERT_TRUE(root["not a member"] == nullptr);
+    ASSERT_TRUE(FDCore::DynamicVariableView() == nullptr);
+}
+
+TEST(DynamicVariableView_test, test_conversions)
+{
+    FDCore::DynamicVariableView root(TEST_VIEW_DOCUMENT);
+    ASSERT_EQ(static_cast<FDCore::DynamicVariableView::StringType>(root["name"]),
+              "record \"one\"");
+    ASSERT_EQ(static_cast<int>(root["id"]), 42);
+    ASSERT_DOUBLE_EQ(static_cast<double>(root["ratio"]), -150.0);
+    ASSERT_TRUE(static_cast<bool>(root["valid"]));
+    ASSERT_TRUE(root["tags"][1] == "b\xc3\xa9");
+    ASSERT_THROW(static_cast<bool>(root["id"]), std::runtime_error);
+
+    FDCore::DynamicVariableView floats("[0.5, 1.5e, 1e999]");
+    ASSERT_DOUBLE_EQ(static_cast<double>(floats[0]), 0.5);
+    ASSERT_THROW(static_cast<double>(floats[1]), std::runtime_error);
+    ASSERT_THROW(static_cast<double>(floats[2]), std::runtime_error);
+
+    const std::string longDocument =
+        "[1." + std::string(70, '0') + "e300, 1" + std::string(70, '0') + "]";
+    FDCore::DynamicVariableView longNumbers(longDocument);
+    ASSERT_DOUBLE_EQ(static_cast<double>(longNumbers[0]), 1e300);
+    ASSERT_THROW(static_cast<int64_t>(longNumbers[1]), std::runtime_error);
+}
+
+TEST(DynamicVariableView_test, test_invalid_literals)
+{
+    FDCore::DynamicVariableView literals("[tru, fx, nul, nulls, true, false, null]");
+    ASSERT_THROW(literals[0].getValueType(), std::runtime_error);
+    ASSERT_THROW(literals[1].getValueType(), std::runtime_error);
+    ASSERT_THROW(literals[2].getValueType(), std::runtime_error);
+    ASSERT_THROW(literals[3].getValueType(), std::runtime_error);
+    ASSERT_THROW(static_cast<bool>(literals[0]), std::runtime_error);
+    ASSERT_EQ(literals[4].getValueType(), FDCore::ValueType::Boolean);
+    ASSERT_FALSE(static_cast<bool>(literals[5]));
+    ASSERT_EQ(literals[6].getValueType(), FDCore::ValueType::None);
+}
+
+TEST(DynamicVariableView_test, test_navigation)
+{
+    FDCore::DynamicVariableView root(TEST_VIEW_DOCUMENT);
+    ASSERT_EQ(root.size(), 7u);
+    ASSERT_EQ(root["tags"].size(), 3u);
+    ASSERT_FALSE(root["tags"].isEmpty());
+    ASSERT_TRUE(FDCore::DynamicVariableView("[ ]").isEmpty());
+    ASSERT_TRUE(root.hasMember("nested"));
+    ASSERT_FALSE(root.hasMember("values"));
+
+    FDCore::DynamicVariableView values = root["nested"]["values"];
+    ASSERT_EQ(values.size(), 3u);
+    ASSERT_EQ(static_cast<int>(values[1][1]), 3);
+    ASSERT_TRUE(values[2]["deep"] == "}");
+    ASSERT_EQ(values[1].getEncodedValue(), "[2, 3]");
+    ASSERT_THROW(values[3], std::out_of_range);
+}
+
+TEST(DynamicVariableView_test, test_to_variable)
+{
+    FDCore::DynamicVariableView root(TEST_VIEW_DOCUMENT);
+    FDCore::DynamicVariable tags = root["tags"].toVariable();
+    ASSERT_EQ(tags.size(), 3u);
+    ASSERT_EQ(tags[0], FDCore::DynamicVariable::StringType("a"));
+
+    FDCore::DynamicVariable nested = root["nested"].toVariable();
+    ASSERT_EQ(nested["values"][1][0], 2);
+    ASSERT_EQ(nested["values"][2]["deep"], FDCore::DynamicVariable::StringType("}"));
+}
+
+TEST(DynamicVariableView_test, test_to_variable_depth)
+{
+    const size_t maxDepth = FDCore::DynamicVariableView::MaxDepth;
+    std::string accepted = std::string(maxDepth, '[') + std::string(maxDepth, ']');
+    ASSERT_EQ(FDCore::DynamicVariableView(accepted).toVariable().size(), 1u);
+
+    std::string rejected = std::string(maxDepth + 1, '[') + std::string(maxDepth + 1, ']');
+    ASSERT_THROW(FDCore::DynamicVariableView(rejected).toVariable(), std::runtime_error);
+
+    std::string hostile = std::string(200000, '[') + std::string(200000, ']');
+    ASSERT_THROW(FDCore::DynamicVariableView(hostile).toVariable(), std::runtime_error);
+}
+
+#endif // FDCORE_DYNAMICVARIABLEVIEW_TEST_H
@@ -4,11 +4,26 @@
 #include <iostream>
 #include <sstream>
 
+#include "DynamicVariableTestHelpers.h"
+
+#include "ArrayOperations_test.h"
 #include "ArrayValue_test.h"
 #include "BoolValue_test.h"
+#include "DocumentPatch_test.h"
+#include "DynamicVariableHash_test.h"
+#include "DynamicVariableRef_test.h"
+#include "DynamicVariableView_test.h"
+#include "Expression_test.h"
 #include "FloatValue_test.h"
+#include "FunctionValue_test.h"
 #include "IntValue_test.h"
+#include "JsonCodec_test.h"
+#include "MemoryUsage_test.h"
+#include "PathQuery_test.h"
+#include "ShapedObjectValue_test.h"
+#include "StringInterner_test.h"
 #include "StringValue_test.h"
+#include "TypedArrayValue_test.h"
 
 #include <FDCore/DynamicVariable/DynamicVariable.h>
 
@@ -449,4 +464,67 @@ TEST(DynamicVariable_test, test_array_operators)
     }
 }
 
+TEST(DynamicVariable_test, test_copy_semantics)
+{
+    FDCore::DynamicVariable value(TEST_DYN_INT_VALUE);
+    FDCore::DynamicVariable copy(value);
+    ASSERT_EQ(copy.internalValue(), value.internalValue());
+    ++copy;
+    ASSERT_EQ(value, TEST_DYN_INT_VALUE);
+    ASSERT_EQ(copy, TEST_DYN_INT_VALUE + 1);
+
+    FDCore::DynamicVariable arr(TEST_ARRAY_VALUE);
+    FDCore::DynamicVariable arrCopy(arr);
+    arrCopy.push(FDCore::DynamicVariable(TEST_DYN_INT_VALUE));
+    ASSERT_EQ(arr.size(), TEST_ARRAY_VALUE.size());
+    ASSERT_EQ(arrCopy.size(), TEST_ARRAY_VALUE.size() + 1);
+    ASSERT_EQ(arrCopy[0].internalValue(), arr[0].internalValue());
+
+    FDCore::DynamicVariable cell = arr[0];
+    cell += 1;
+    ASSERT_NE(arr[0], cell);
+
+    FDCore::DynamicVariable clone = arr.clone();
+    ASSERT_NE(clone.internalValue(), arr.internalValue());
+    ASSERT_NE(clone[0].internalValue(), arr[0].internalValue());
+    ASSERT_EQ(clone[0], arr[0]);
+
+    FDCore::DynamicVariable str(TEST_DYN_STRING_VALUE);
+    FDCore::DynamicVariable strCopy(str);
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::StringType>(std::move(strCopy)),
+              TEST_DYN_STRING_VALUE);
+    ASSERT_EQ(str, FDCore::DynamicVariable::StringType(TEST_DYN_STRING_VALUE));
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::StringType>(std::move(str)),
+              TEST_DYN_STRING_VALUE);
+}
+
+TEST(DynamicVariable_test, test_visit)
+{
+    struct TypeNameVisitor
+    {
+        std::string operator()(std::nullptr_t) const { return "none"; }
+        std::string operator()(const FDCore::IntValue &) const { return "int"; }
+        std::string operator()(const FDCore::FloatValue &) const { return "float"; }
+        std::string operator()(const FDCore::AbstractValue &) const { return "other"; }
+    };
+
+    ASSERT_EQ(FDCore::DynamicVariable().visit(TypeNameVisitor()), "none");
+    ASSERT_EQ(FDCore::DynamicVariable(TEST_DYN_INT_VALUE).visit(TypeNameVisitor()), "int");
+    ASSERT_EQ(FDCore::DynamicVariable(TEST_DYN_FLOAT_VALUE).visit(TypeNameVisitor()), "float");
+    ASSERT_EQ(FDCore::DynamicVariable(TEST_ARRAY_VALUE).visit(TypeNameVisitor()), "other");
+
+    auto sameType = [](const auto &lhs, const auto &rhs) {
+        return std::is_same_v<std::decay_t<decltype(lhs)>, std::decay_t<decltype(rhs)>>;
+    };
+    FDCore::DynamicVariable i(TEST_DYN_INT_VALUE), f(TEST_DYN_FLOAT_VALUE);
+    ASSERT_TRUE(FDCore::DynamicVariable::visit(sameType, i, i));
+    ASSERT_FALSE(FDCore::DynamicVariable::visit(sameType, i, f));
+    ASSERT_TRUE(FDCore::DynamicVariable::visit(sameType, FDCore::DynamicVariable(), {}));
+
+    ASSERT_EQ(i + f, TEST_DYN_INT_VALUE + TEST_DYN_FLOAT_VALUE);
+    i *= f;
+    ASSERT_EQ(i.getValueType(), FDCore::ValueType::Float);
+    ASSERT_FALSE(FDCore::DynamicVariable(TEST_ARRAY_VALUE) == i);
+}
+
 #endif // FDCORE_DYNAMICVARIABLE_TEST_H
@@ -0,0 +1,239 @@
+#ifndef FDCORE_EXPRESSION_TEST_H
+#define FDCORE_EXPRESSION_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/Expression.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+using FDCore::operator""_var;
+
+static FDCore::DynamicVariable makeExpressionRecord(FDCore::DynamicVariable::IntType quantity,
+                                                    double price,
+                                                    FDCore::DynamicVariable::StringViewType status)
+{
+    FDCore::DynamicVariable item(FDCore::ValueType::Object);
+    item.set("price", FDCore::DynamicVariable(price));
+    item.set("tags", FDCore::DynamicVariable { "new"_var, "sale"_var });
+
+    FDCore::DynamicVariable record(FDCore::ValueType::Object);
+    record.set("quantity", FDCore::DynamicVariable(quantity));
+    record.set("status", FDCore::DynamicVariable(status));
+    record.set("item", item);
+    return record;
+}
+
+TEST(Expression_test, test_evaluate)
+{
+    const FDCore::DynamicVariable record = makeExpressionRecord(3, 2.5, "active");
+
+    ASSERT_EQ(FDCore::Expression("quantity * 2 + 1").evaluate(record), 7);
+    ASSERT_EQ(FDCore::Expression("quantity * item.price").evaluate(record), 7.5);
+    ASSERT_EQ(FDCore::Expression("7 / 2").evaluate(record), 3);
+    ASSERT_EQ(FDCore::Expression("7 % quantity").evaluate(record), 1);
+    ASSERT_EQ(FDCore::Expression("-(quantity - 5)").evaluate(record), 2);
+    ASSERT_EQ(FDCore::Expression("item.tags[1]").evaluate(record), "sale"_var);
+    ASSERT_EQ(FDCore::Expression("status + '-' + \"x\"").evaluate(record), "active-x"_var);
+    ASSERT_EQ(FDCore::Expression("$.quantity").evaluate(record), 3);
+    ASSERT_EQ(FDCore::Expression("$").evaluate(record), record);
+    ASSERT_EQ(FDCore::Expression("missing").evaluate(record), nullptr);
+    ASSERT_EQ(FDCore::Expression().evaluate(record), nullptr);
+
+    ASSERT_EQ(FDCore::Expression("status == 'active' && quantity >= 3").evaluate(record), true);
+    ASSERT_EQ(FDCore::Expression("status != 'active' || !(quantity < 3)").evaluate(record), true);
+    ASSERT_EQ(FDCore::Expression("quantity > 3 ? 'many' : 'few'").evaluate(record), "few"_var);
+    ASSERT_EQ(FDCore::Expression("1 == 1.0").evaluate(record), false);
+    ASSERT_EQ(FDCore::Expression("1 < 1.0").evaluate(record), true);
+    ASSERT_EQ(FDCore::Expression("quantity <= 2.5e0 || missing == null").evaluate(record), true);
+
+    // the right operand is not evaluated once the result is known
+    ASSERT_EQ(FDCore::Expression("quantity > 5 && missing + 1").evaluate(record), false);
+}
+
+TEST(Expression_test, test_errors)
+{
+    const FDCore::DynamicVariable record = makeExpressionRecord(3, 2.5, "active");
+
+    ASSERT_THROW(FDCore::Expression("1 +"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression("(1"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression("1 2"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression("'text"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression("item.tags[x]"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression("unknown(1)"), std::invalid_argument);
+
+    ASSERT_THROW(FDCore::Expression("quantity / 0").evaluate(record), std::domain_error);
+    ASSERT_THROW(FDCore::Expression("status - 1").evaluate(record), std::runtime_error);
+    ASSERT_THROW(FDCore::Expression("quantity && true").evaluate(record), std::runtime_error);
+    ASSERT_THROW(FDCore::Expression("!status").evaluate(record), std::runtime_error);
+
+    // the quotient of the smallest integer by -1 does not fit, its remainder is 0
+    FDCore::DynamicVariable extremes(FDCore::ValueType::Object);
+    extremes.set("a", FDCore::DynamicVariable(std::numeric_limits<int64_t>::min()));
+    extremes.set("b", FDCore::DynamicVariable(-1));
+    ASSERT_THROW(FDCore::Expression("(-9223372036854775807 - 1) / -1").evaluate(record),
+                 std::overflow_error);
+    ASSERT_THROW(FDCore::Expression("a / b").evaluate(extremes), std::overflow_error);
+    ASSERT_EQ(FDCore::Expression("a % b").evaluate(extremes), 0);
+    ASSERT_EQ(FDCore::Expression("(-9223372036854775807 - 1) % -1").evaluate(record), 0);
+
+    FDCore::ExpressionEnvironment integers;
+    integers.fieldTypes["/a"] = FDCore::ValueType::Integer;
+    integers.fieldTypes["/b"] = FDCore::ValueType::Integer;
+    ASSERT_THROW(FDCore::Expression("a / b", integers).evaluate(extremes), std::overflow_error);
+    ASSERT_EQ(FDCore::Expression("a % b", integers).evaluate(extremes), 0);
+
+    // constant operations that throw are not folded but fail when they are evaluated
+    FDCore::Expression invalid("quantity > 5 ? 'a' - 1 : 0");
+    ASSERT_EQ(invalid.evaluate(record), 0);
+    ASSERT_THROW(FDCore::Expression("1 / 0").evaluate(record), std::domain_error);
+}
+
+TEST(Expression_test, test_depth)
+{
+    const FDCore::DynamicVariable record = makeExpressionRecord(3, 2.5, "active");
+    const size_t depth = FDCore::Expression::MaxDepth;
+
+    std::string nested = std::string(depth - 1, '(') + "quantity" + std::string(depth - 1, ')');
+    ASSERT_EQ(FDCore::Expression(nested).evaluate(record), 3);
+    ASSERT_THROW(FDCore::Expression(std::string(200000, '(') + "1"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression(std::string(200000, '-') + "1"), std::invalid_argument);
+    ASSERT_THROW(FDCore::Expression(std::string(200000, '!') + "true"), std::invalid_argument);
+
+    std::string sum = "quantity";
+    for(size_t i = 0; i < depth; ++i)
+        sum += " + quantity";
+    ASSERT_THROW(FDCore::Expression { sum }, std::invalid_argument);
+
+    std::string conditional;
+    for(size_t i = 0; i < 100000; ++i)
+        conditional += "quantity > 1 ? 1 : ";
+    ASSERT_THROW(FDCore::Expression(conditional + "0"), std::invalid_argument);
+}
+
+TEST(Expression_test, test_folding)
+{
+    FDCore::Expression constant("(1 + 2) * 3 - 4 / 2");
+    ASSERT_TRUE(constant.isConstant());
+    ASSERT_EQ(constant.evaluate(FDCore::DynamicVariable()), 7);
+
+    ASSERT_TRUE(FDCore::Expression("'a' + 'b' == 'ab'").isConstant());
+    ASSERT_TRUE(FDCore::Expression("true || quantity").isConstant());
+    ASSERT_TRUE(FDCore::Expression("2 > 1 ? 'yes' : quantity").isConstant());
+
+    FDCore::Expression partial("quantity * (2 + 3)");
+    ASSERT_FALSE(partial.isConstant());
+    ASSERT_EQ(partial.getCode().size(), 3u);
+
+    // a constant true operand of && is dropped when the other one is known to be a Boolean
+    FDCore::Expression logical("true && quantity > 1");
+    ASSERT_EQ(logical.getCode().size(), 3u);
+    ASSERT_EQ(logical.evaluate(makeExpressionRecord(3, 2.5, "active")), true);
+}
+
+TEST(Expression_test, test_specialization)
+{
+    FDCore::ExpressionEnvironment environment;
+    environment.fieldTypes["/quantity"] = FDCore::ValueType::Integer;
+    environment.fieldTypes["/item/price"] = FDCore::ValueType::Float;
+
+    FDCore::Expression total("quantity * 2 + 1", environment);
+    ASSERT_EQ(total.getResultType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(total.getCode()[0].code, FDCore::Expression::OpCode::FieldInteger);
+    ASSERT_EQ(total.getCode()[2].code, FDCore::Expression::OpCode::MultiplyInteger);
+    ASSERT_EQ(total.getCode()[4].code, FDCore::Expression::OpCode::AddInteger);
+    ASSERT_EQ(total.evaluate(makeExpressionRecord(4, 1.0, "active")), 9);
+
+    FDCore::Expression cheap("item.price < 2.0", environment);
+    ASSERT_EQ(cheap.getResultType(), FDCore::ValueType::Boolean);
+    ASSERT_EQ(cheap.getCode()[2].code, FDCore::Expression::OpCode::LessFloat);
+    ASSERT_EQ(cheap.evaluate(makeExpressionRecord(4, 1.0, "active")), true);
+    ASSERT_EQ(cheap.evaluate(makeExpressionRecord(4, std::nan(""), "active")), false);
+
+    // equality treats NaN as DynamicVariable does, specialized or not
+    const FDCore::DynamicVariable nanRecord = makeExpressionRecord(4, std::nan(""), "active");
+    ASSERT_EQ(FDCore::Expression("item.price == item.price", environment).evaluate(nanRecord),
+              true);
+    ASSERT_EQ(FDCore::Expression("item.price != item.price").evaluate(nanRecord), false);
+
+    FDCore::Expression mixed("quantity * item.price", environment);
+    ASSERT_EQ(mixed.getResultType(), FDCore::ValueType::Float);
+    ASSERT_EQ(mixed.getCode()[2].code, FDCore::Expression::OpCode::Multiply);
+    ASSERT_EQ(mixed.evaluate(makeExpressionRecord(4, 1.5, "active")), 6.0);
+
+    // the generic operators give the same results
+    ASSERT_EQ(FDCore::Expression("quantity * 2 + 1").getResultType(), FDCore::ValueType::None);
+    ASSERT_EQ(FDCore::Expression("quantity * 2 + 1").evaluate(makeExpressionRecord(4, 1, "")), 9);
+
+    FDCore::DynamicVariable wrongType = makeExpressionRecord(4, 1.0, "active");
+    wrongType.set("quantity", 4.0_var);
+    ASSERT_THROW(total.evaluate(wrongType), std::runtime_error);
+    ASSERT_THROW(total.evaluate(FDCore::DynamicVariable(FDCore::ValueType::Object)),
+                 std::runtime_error);
+}
+
+TEST(Expression_test, test_functions)
+{
+    FDCore::ExpressionEnvironment environment;
+    environment.functions = FDCore::DynamicVariable(FDCore::ValueType::Object);
+    environment.functions.set(
+      "max", FDCore::DynamicVariable(
+               FDCore::FunctionValue([](FDCore::FunctionValue::Arguments arguments) {
+                   return arguments[0] < arguments[1] ? arguments[1] : arguments[0];
+               })));
+    environment.functions.set(
+      "size", FDCore::DynamicVariable(FDCore::FunctionValue(
+                [](FDCore::FunctionValue::Arguments arguments) {
+                    return FDCore::DynamicVariable(
+                      static_cast<FDCore::DynamicVariable::IntType>(arguments[0].size()));
+                })));
+
+    FDCore::Expression expression("max(quantity, size(item.tags)) * 10", environment);
+    ASSERT_FALSE(expression.isConstant());
+    ASSERT_EQ(expression.evaluate(makeExpressionRecord(1, 1.0, "")), 20);
+    ASSERT_EQ(expression.evaluate(makeExpressionRecord(5, 1.0, "")), 50);
+    ASSERT_THROW(FDCore::Expression("size(item.tags", environment), std::invalid_argument);
+}
+
+TEST(Expression_test, test_batch)
+{
+    FDCore::DynamicVariable::ArrayType cells;
+    for(FDCore::DynamicVariable::IntType i = 0; i < 10; ++i)
+        cells.push_back(makeExpressionRecord(i, 0.5 * i, i % 2 ? "active" : "closed")
+                          .internalValue());
+
+    const FDCore::DynamicVariable records(std::move(cells));
+    FDCore::ExpressionEnvironment environment;
+    environment.fieldTypes["/quantity"] = FDCore::ValueType::Integer;
+
+    FDCore::Expression doubled("quantity * 2", environment);
+    FDCore::DynamicVariable results = doubled.evaluateAll(records);
+    ASSERT_EQ(results.getElementType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(results.size(), 10u);
+    ASSERT_EQ(results[9], 18);
+
+    std::vector<FDCore::DynamicVariable> statuses;
+    FDCore::Expression("status").evaluate(records, statuses);
+    ASSERT_EQ(statuses.size(), 10u);
+    ASSERT_EQ(statuses[1], "active"_var);
+
+    FDCore::DynamicVariable generic = FDCore::Expression("status").evaluateAll(records);
+    ASSERT_EQ(generic.getElementType(), FDCore::ValueType::None);
+    ASSERT_EQ(generic[2], "closed"_var);
+
+    FDCore::DynamicVariable active =
+      FDCore::Expression("status == 'active' && item.price > 1").filter(records);
+    ASSERT_EQ(active.size(), 4u);
+    ASSERT_EQ(active[0].internalNode(), records[3].internalNode());
+
+    const FDCore::DynamicVariable numbers(
+      std::vector<FDCore::DynamicVariable::IntType> { 1, 2, 3 });
+    FDCore::DynamicVariable squares = FDCore::Expression("$ * $").evaluateAll(numbers);
+    ASSERT_EQ(squares[2], 9);
+    ASSERT_THROW(FDCore::Expression("quantity").filter(records), std::runtime_error);
+    ASSERT_THROW(doubled.evaluateAll(1_var), std::runtime_error);
+}
+
+#endif // FDCORE_EXPRESSION_TEST_H
@@ -0,0 +1,116 @@
+#ifndef FDCORE_FUNCTIONVALUE_TEST_H
+#define FDCORE_FUNCTIONVALUE_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/FunctionValue.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+using FDCore::operator""_var;
+
+static FDCore::DynamicVariable sumArguments(FDCore::FunctionValue::Arguments arguments)
+{
+    FDCore::DynamicVariable result = 0_var;
+    for(const FDCore::DynamicVariable &argument: arguments)
+        result += argument;
+
+    return result;
+}
+
+TEST(FunctionValue_test, test_call)
+{
+    FDCore::DynamicVariable add(FDCore::FunctionValue(
+      [](FDCore::FunctionValue::Arguments arguments) { return arguments[0] + arguments[1]; }));
+    ASSERT_TRUE(add.isType(FDCore::ValueType::Function));
+    ASSERT_TRUE(static_cast<const FDCore::FunctionValue &>(*add.internalNode()).isInline());
+    ASSERT_EQ(add(1, 2), 3);
+    ASSERT_EQ(add("a"_var, "b"_var), "ab"_var);
+
+    FDCore::DynamicVariable sum((FDCore::FunctionValue(&sumArguments)));
+    ASSERT_EQ(sum(), 0);
+    ASSERT_EQ(sum(1, 2, 3), 6);
+
+    const std::array<FDCore::DynamicVariable, 2> arguments { 4_var, 5_var };
+    ASSERT_EQ(sum.call({ arguments.size(), arguments.data() }), 9);
+
+    FDCore::DynamicVariable::IntType factor = 3;
+    FDCore::DynamicVariable scale(
+      FDCore::FunctionValue([factor](FDCore::FunctionValue::Arguments arguments) {
+          return arguments[0] * FDCore::DynamicVariable(factor);
+      }));
+    ASSERT_EQ(scale(5), 15);
+
+    FDCore::DynamicVariable rules(FDCore::ValueType::Object);
+    rules.set("scale", scale);
+    rules.set("sum", sum);
+    ASSERT_EQ(rules["sum"](rules["scale"](2), 1), 7);
+}
+
+TEST(FunctionValue_test, test_errors)
+{
+    FDCore::DynamicVariable empty(FDCore::ValueType::Function);
+    ASSERT_TRUE(static_cast<const FDCore::FunctionValue &>(*empty.internalNode()).isEmpty());
+    ASSERT_THROW(empty(), std::runtime_error);
+    const FDCore::DynamicVariable one = 1_var;
+    ASSERT_THROW(one(), std::runtime_error);
+
+    FDCore::DynamicVariable fail(FDCore::FunctionValue([](FDCore::FunctionValue::Arguments) {
+        throw std::invalid_argument("fail");
+        return FDCore::DynamicVariable();
+    }));
+    ASSERT_THROW(fail(), std::invalid_argument);
+}
+
+TEST(FunctionValue_test, test_storage)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        FDCore::DynamicVariable small(
+          FDCore::FunctionValue([counter](FDCore::FunctionValue::Arguments) {
+              return FDCore::DynamicVariable(*counter);
+          }));
+        ASSERT_EQ(counter.use_count(), 2);
+        ASSERT_EQ(small.memoryUsage()[FDCore::ValueType::Function].payloadBytes, 0u);
+
+        FDCore::DynamicVariable copy = small.clone();
+        ASSERT_EQ(counter.use_count(), 3);
+        ASSERT_EQ(copy(), 0);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+
+    std::array<FDCore::DynamicVariable::IntType, 16> table {};
+    table[15] = 42;
+    auto lookup = [table, counter](FDCore::FunctionValue::Arguments arguments) {
+        return FDCore::DynamicVariable(table[static_cast<size_t>(arguments[0])]);
+    };
+
+    {
+        FDCore::DynamicVariable large((FDCore::FunctionValue(lookup)));
+        const auto &node = static_cast<const FDCore::FunctionValue &>(*large.internalNode());
+        ASSERT_FALSE(node.isInline());
+        ASSERT_EQ(large.memoryUsage()[FDCore::ValueType::Function].payloadBytes, sizeof(lookup));
+        ASSERT_EQ(large(15), 42);
+        ASSERT_EQ(counter.use_count(), 3);
+
+        FDCore::DynamicVariable copy = large.clone();
+        ASSERT_EQ(copy(15), 42);
+        ASSERT_EQ(counter.use_count(), 4);
+    }
+    ASSERT_EQ(counter.use_count(), 2);
+}
+
+TEST(FunctionValue_test, test_identity)
+{
+    FDCore::DynamicVariable function((FDCore::FunctionValue(&sumArguments)));
+    FDCore::DynamicVariable shared = function;
+    FDCore::DynamicVariable copy = function.clone();
+
+    ASSERT_EQ(function, shared);
+    ASSERT_EQ(function.hash(), shared.hash());
+    ASSERT_NE(function, copy);
+    ASSERT_EQ(copy(1, 2), 3);
+}
+
+#endif // FDCORE_FUNCTIONVALUE_TEST_H
@@ -0,0 +1,122 @@
+#ifndef FDCORE_JSONCODEC_TEST_H
+#define FDCORE_JSONCODEC_TEST_H
+
+#include <FDCore/DynamicVariable/JsonCodec.h>
+#include <gtest/gtest.h>
+
+struct JsonCodecPoint
+{
+    int x = 0;
+    double y = 0.0;
+};
+
+struct JsonCodecRecord
+{
+    std::string name;
+    bool enabled = false;
+    JsonCodecPoint origin;
+    std::vector<int64_t> ids;
+    std::vector<JsonCodecPoint> path;
+};
+
+FDCORE_STRUCT_SCHEMA(JsonCodecPoint,
+                     FDCORE_STRUCT_FIELD(JsonCodecPoint, x),
+                     FDCORE_STRUCT_FIELD(JsonCodecPoint, y));
+
+FDCORE_STRUCT_SCHEMA(JsonCodecRecord,
+                     FDCORE_STRUCT_FIELD(JsonCodecRecord, name),
+                     FDCORE_STRUCT_FIELD(JsonCodecRecord, enabled),
+                     FDCORE_STRUCT_FIELD(JsonCodecRecord, origin),
+                     FDCORE_STRUCT_FIELD(JsonCodecRecord, ids),
+                     FDCORE_STRUCT_FIELD(JsonCodecRecord, path));
+
+static JsonCodecRecord makeJsonCodecRecord()
+{
+    JsonCodecRecord record;
+    record.name = "a \"quoted\"\nname";
+    record.enabled = true;
+    record.origin = { 1, 2.5 };
+    record.ids = { 4, 5, 6 };
+    record.path = { { 1, 1.0 }, { -2, 0.25 } };
+    return record;
+}
+
+TEST(JsonCodec_test, test_struct_schema)
+{
+    JsonCodecRecord record = makeJsonCodecRecord();
+    FDCore::DynamicVariable variable(record);
+    ASSERT_TRUE(variable.isType(FDCore::ValueType::Object));
+    ASSERT_EQ(variable["name"], FDCore::DynamicVariable::StringType(record.name));
+    ASSERT_EQ(variable["origin"]["x"], 1);
+    ASSERT_EQ(variable["ids"].getElementType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(variable["path"][1]["x"], -2);
+
+    auto shaped = std::dynamic_pointer_cast<FDCore::ShapedObjectValue>(variable.internalValue());
+    ASSERT_NE(shaped, nullptr);
+    ASSERT_EQ(shaped->getShape(),
+              std::static_pointer_cast<const FDCore::ShapedObjectValue>(
+                FDCore::DynamicVariable(makeJsonCodecRecord()).internalValue())
+                ->getShape());
+
+    JsonCodecRecord copy;
+    ASSERT_TRUE(FDCore::fromVariable(variable, copy));
+    ASSERT_EQ(copy.name, record.name);
+    ASSERT_EQ(copy.origin.y, 2.5);
+    ASSERT_EQ(copy.ids, record.ids);
+    ASSERT_EQ(copy.path[1].y, 0.25);
+
+    FDCore::DynamicVariable generic(FDCore::ValueType::Object);
+    generic.set("y", FDCore::DynamicVariable(0.5));
+    generic.set("x", FDCore::DynamicVariable(3));
+    auto point = FDCore::is_DynamicVariable_constructible<JsonCodecPoint>::fromVariable(
+      generic.internalValue());
+    ASSERT_TRUE(point.has_value());
+    ASSERT_EQ(point->x, 3);
+
+    generic.unset("y");
+    ASSERT_FALSE(FDCore::fromVariable(generic, copy.origin));
+    ASSERT_FALSE(FDCore::fromVariable(FDCore::DynamicVariable(1), copy));
+}
+
+TEST(JsonCodec_test, test_json)
+{
+    JsonCodecRecord record = makeJsonCodecRecord();
+    std::string json = FDCore::toJson(record);
+    ASSERT_EQ(json, "{\"name\":\"a \\\"quoted\\\"\\nname\",\"enabled\":true,"
+                    "\"origin\":{\"x\":1,\"y\":2.5},\"ids\":[4,5,6],"
+                    "\"path\":[{\"x\":1,\"y\":1.0},{\"x\":-2,\"y\":0.25}]}");
+
+    JsonCodecRecord decoded = FDCore::fromJson<JsonCodecRecord>(json);
+    ASSERT_EQ(decoded.name, record.name);
+    ASSERT_TRUE(decoded.enabled);
+    ASSERT_EQ(decoded.origin.x, 1);
+    ASSERT_EQ(decoded.ids, record.ids);
+    ASSERT_EQ(decoded.path.size(), 2u);
+    ASSERT_EQ(decoded.path[1].x, -2);
+
+    JsonCodecPoint point =
+      FDCore::fromJson<JsonCodecPoint>(" { \"extra\": [1, {}], \"y\": 3, \"x\": 7 } ");
+    ASSERT_EQ(point.x, 7);
+    ASSERT_EQ(point.y, 3.0);
+    ASSERT_THROW(FDCore::fromJson<JsonCodecPoint>("{\"x\": 1}"), std::invalid_argument);
+    ASSERT_THROW(FDCore::fromJson<JsonCodecPoint>("{\"x\": 1.5, \"y\": 1}"),
+                 std::invalid_argument);
+
+    // integers out of the range of the field are refused, not truncated
+    ASSERT_EQ(FDCore::fromJson<uint8_t>("255"), 255);
+    ASSERT_THROW(FDCore::fromJson<uint8_t>("300"), std::invalid_argument);
+    ASSERT_THROW(FDCore::fromJson<uint32_t>("-1"), std::invalid_argument);
+    ASSERT_EQ(FDCore::fromJson<int16_t>("-32768"), -32768);
+    ASSERT_THROW(FDCore::fromJson<int16_t>("-32769"), std::invalid_argument);
+    ASSERT_THROW(FDCore::fromJson<int64_t>("99999999999999999999"), std::invalid_argument);
+    ASSERT_THROW(FDCore::fromJson<JsonCodecPoint>("{\"x\": 3000000000, \"y\": 1}"),
+                 std::invalid_argument);
+
+    ASSERT_EQ(FDCore::toJson(FDCore::DynamicVariable(record)), json);
+    FDCore::DynamicVariable variable = FDCore::DynamicVariableView(json).toVariable();
+    ASSERT_EQ(variable["path"][0]["y"].getValueType(), FDCore::ValueType::Float);
+    ASSERT_EQ(FDCore::toJson(FDCore::DynamicVariable()), "null");
+    ASSERT_EQ(FDCore::toJson(std::vector<double> { 1e300, 0.1 }), "[1e+300,0.1]");
+}
+
+#endif // FDCORE_JSONCODEC_TEST_H
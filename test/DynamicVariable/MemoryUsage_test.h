@@ -0,0 +1,65 @@
+#ifndef FDCORE_MEMORYUSAGE_TEST_H
+#define FDCORE_MEMORYUSAGE_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/MemoryUsage.h>
+#include <gtest/gtest.h>
+
+using FDCore::operator""_var;
+
+TEST(MemoryUsage_test, test_footprint)
+{
+    const FDCore::DynamicVariable::StringType text(256, 'x');
+    FDCore::DynamicVariable record(FDCore::ValueType::Object);
+    record.set("text", FDCore::DynamicVariable(text));
+    record.set("count", 1_var);
+    record.set("ids", FDCore::DynamicVariable(std::vector<FDCore::DynamicVariable::IntType> {
+                        1, 2, 3, 4 }));
+
+    FDCore::MemoryUsage usage = record.memoryUsage();
+    ASSERT_EQ(usage[FDCore::ValueType::Object].nodes, 1u);
+    ASSERT_EQ(usage[FDCore::ValueType::Integer].nodes, 1u);
+    ASSERT_EQ(usage[FDCore::ValueType::Array].nodes, 1u);
+    ASSERT_EQ(usage[FDCore::ValueType::String].nodes, 1u);
+    ASSERT_GE(usage[FDCore::ValueType::String].payloadBytes, text.size());
+    ASSERT_GE(usage[FDCore::ValueType::Array].payloadBytes,
+              4 * sizeof(FDCore::DynamicVariable::IntType));
+    ASSERT_EQ(usage[FDCore::ValueType::Integer].headerBytes, sizeof(FDCore::IntValue));
+    ASSERT_EQ(usage.sharedReferences, 0u);
+    ASSERT_EQ(usage.total().nodes, 4u);
+    ASSERT_EQ(usage.total().totalBytes(),
+              usage.total().headerBytes + usage.total().payloadBytes + usage.total().slackBytes);
+
+    FDCore::DynamicVariable document { record, record, record };
+    FDCore::MemoryUsage shared = document.memoryUsage();
+    ASSERT_EQ(shared[FDCore::ValueType::Array].nodes, 2u);
+    ASSERT_EQ(shared[FDCore::ValueType::String].nodes, 1u);
+    ASSERT_EQ(shared.sharedReferences, 2u);
+    ASSERT_EQ(shared.total().totalBytes() - shared[FDCore::ValueType::Array].totalBytes(),
+              usage.total().totalBytes() - usage[FDCore::ValueType::Array].totalBytes());
+
+    FDCore::DynamicVariable copy = document.clone();
+    FDCore::MemoryUsageCounter counter;
+    counter.add(document.internalNode());
+    counter.add(copy.internalNode());
+    ASSERT_EQ(counter.getUsage()[FDCore::ValueType::String].nodes, 4u);
+    ASSERT_EQ(FDCore::DynamicVariable().memoryUsage().total().nodes, 0u);
+}
+
+TEST(MemoryUsage_test, test_live_values)
+{
+    const auto before = FDCore::getLiveValueCounts();
+    const size_t stringIndex = static_cast<size_t>(FDCore::ValueType::String);
+    {
+        FDCore::DynamicVariable values { "a"_var, "b"_var };
+        const auto during = FDCore::getLiveValueCounts();
+        if(FDCore::isValueTrackingEnabled())
+            ASSERT_EQ(during[stringIndex], before[stringIndex] + 2);
+        else
+            ASSERT_EQ(during[stringIndex], 0u);
+    }
+
+    ASSERT_EQ(FDCore::getLiveValueCounts()[stringIndex], before[stringIndex]);
+}
+
+#endif // FDCORE_MEMORYUSAGE_TEST_H
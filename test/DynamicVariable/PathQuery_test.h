@@ -0,0 +1,115 @@
+#ifndef FDCORE_PATHQUERY_TEST_H
+#define FDCORE_PATHQUERY_TEST_H
+
+#include <FDCore/DynamicVariable/ObjectValue.h>
+#include <FDCore/DynamicVariable/PathQuery.h>
+#include <FDCore/DynamicVariable/ShapedObjectValue.h>
+#include <gtest/gtest.h>
+
+using FDCore::operator""_var;
+
+static FDCore::DynamicVariable makePathQueryDocument()
+{
+    FDCore::DynamicVariable item(FDCore::ValueType::Object);
+    item.set("name", "first"_var);
+    item.set("a/b", 1_var);
+    item.set("m~n", 2_var);
+
+    auto shaped = std::make_shared<FDCore::ShapedObjectValue>();
+    shaped->set("name", std::make_shared<FDCore::StringValue>("second"));
+
+    FDCore::DynamicVariable items { item, FDCore::DynamicVariable(shaped) };
+    FDCore::DynamicVariable document(FDCore::ValueType::Object);
+    document.set("items", items);
+    document.set("ids", FDCore::DynamicVariable(std::vector<FDCore::DynamicVariable::IntType> {
+                          4, 5, 6 }));
+    document.set("0", "zero"_var);
+    return document;
+}
+
+TEST(PathQuery_test, test_parsing)
+{
+    FDCore::PathQuery pointer = FDCore::PathQuery::fromPointer("/items/0/a~1b");
+    ASSERT_EQ(pointer.size(), 3u);
+    ASSERT_EQ(pointer.getSegments()[1].index, 0u);
+    ASSERT_TRUE(pointer.getSegments()[1].matchesMember);
+    ASSERT_EQ(pointer.getSegments()[2].member, "a/b");
+    ASSERT_EQ(pointer.toPointer(), "/items/0/a~1b");
+
+    FDCore::PathQuery path = FDCore::PathQuery::fromPath("$.items[0]['a/b']");
+    ASSERT_EQ(path.size(), 3u);
+    ASSERT_FALSE(path.getSegments()[1].matchesMember);
+    ASSERT_EQ(path.toPointer(), "/items/0/a~1b");
+    ASSERT_NE(path, pointer);
+    ASSERT_EQ(FDCore::PathQuery("$.items[\"0\"]"), FDCore::PathQuery("$['items']['0']"));
+
+    ASSERT_TRUE(FDCore::PathQuery("").isEmpty());
+    ASSERT_TRUE(FDCore::PathQuery("$").isEmpty());
+    ASSERT_EQ(FDCore::PathQuery("/").size(), 1u);
+    ASSERT_EQ(FDCore::PathQuery("/01").getSegments()[0].index, FDCore::PathQuery::npos);
+
+    ASSERT_THROW(FDCore::PathQuery("items"), std::invalid_argument);
+    ASSERT_THROW(FDCore::PathQuery("/a~2"), std::invalid_argument);
+    ASSERT_THROW(FDCore::PathQuery("$.items[0"), std::invalid_argument);
+    ASSERT_THROW(FDCore::PathQuery("$..name"), std::invalid_argument);
+    ASSERT_THROW(FDCore::PathQuery("$.items[*]"), std::invalid_argument);
+    ASSERT_THROW(FDCore::PathQuery("$['name]"), std::invalid_argument);
+}
+
+TEST(PathQuery_test, test_get)
+{
+    FDCore::DynamicVariable document = makePathQueryDocument();
+
+    ASSERT_EQ(FDCore::PathQuery("/items/0/name").get(document),
+              FDCore::DynamicVariable::StringType("first"));
+    ASSERT_EQ(FDCore::PathQuery("$.items[1].name").get(document),
+              FDCore::DynamicVariable::StringType("second"));
+    ASSERT_EQ(FDCore::PathQuery("/items/0/m~0n").get(document), 2);
+    ASSERT_EQ(FDCore::PathQuery("/ids/2").get(document), 6);
+    ASSERT_EQ(FDCore::PathQuery("/0").get(document), FDCore::DynamicVariable::StringType("zero"));
+    ASSERT_EQ(FDCore::PathQuery("").get(document).internalValue(), document.internalValue());
+
+    ASSERT_TRUE(FDCore::PathQuery("/items/2").get(document) == nullptr);
+    ASSERT_TRUE(FDCore::PathQuery("/ids/0/name").get(document) == nullptr);
+    ASSERT_TRUE(FDCore::PathQuery("$.items.name").get(document) == nullptr);
+    ASSERT_TRUE(FDCore::PathQuery("$[0]").get(document) == nullptr);
+    ASSERT_TRUE(FDCore::PathQuery("/missing").get(document) == nullptr);
+
+    ASSERT_TRUE(FDCore::PathQuery("/items/1").exists(document));
+    ASSERT_FALSE(FDCore::PathQuery("/items/1/id").exists(document));
+
+    FDCore::StringInterner arena;
+    auto object = std::make_shared<FDCore::ObjectValue>(arena);
+    object->set("key", std::make_shared<FDCore::IntValue>(3));
+    ASSERT_EQ(FDCore::PathQuery("/key").get(FDCore::DynamicVariable(object)), 3);
+}
+
+TEST(PathQuery_test, test_batch)
+{
+    FDCore::DynamicVariable document = makePathQueryDocument();
+
+    FDCore::PathQueryBatch batch;
+    ASSERT_EQ(batch.add("/items/0/name"), 0u);
+    ASSERT_EQ(batch.add("$.items[1].name"), 1u);
+    ASSERT_EQ(batch.add("/missing/path"), 2u);
+    ASSERT_EQ(batch.add("/items/0/name"), 3u);
+    ASSERT_EQ(batch.add("/ids/1"), 4u);
+    ASSERT_EQ(batch.add(""), 5u);
+    ASSERT_EQ(batch.size(), 6u);
+
+    std::vector<FDCore::DynamicVariable> results = batch.extract(document);
+    ASSERT_EQ(results.size(), 6u);
+    ASSERT_EQ(results[0], FDCore::DynamicVariable::StringType("first"));
+    ASSERT_EQ(results[1], FDCore::DynamicVariable::StringType("second"));
+    ASSERT_TRUE(results[2] == nullptr);
+    ASSERT_EQ(results[3], results[0]);
+    ASSERT_EQ(results[4], 5);
+    ASSERT_EQ(results[5].internalValue(), document.internalValue());
+
+    batch.extract(FDCore::DynamicVariable(FDCore::ValueType::Object), results);
+    ASSERT_EQ(results.size(), 6u);
+    ASSERT_TRUE(results[0] == nullptr);
+    ASSERT_TRUE(results[5] != nullptr);
+}
+
+#endif // FDCORE_PATHQUERY_TEST_H
@@ -0,0 +1,141 @@
+#ifndef FDCORE_SHAPEDOBJECTVALUE_TEST_H
+#define FDCORE_SHAPEDOBJECTVALUE_TEST_H
+
+#include <FDCore/DynamicVariable/IntValue.h>
+#include <FDCore/DynamicVariable/ShapedObjectValue.h>
+#include <FDCore/DynamicVariable/StringValue.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(ShapedObjectValue_test, test_shape_interning)
+{
+    FDCore::ObjectShape::Ptr shape = FDCore::ObjectShape::fromKeys({ "id", "name" });
+    ASSERT_EQ(shape->size(), 2u);
+    ASSERT_EQ(shape->indexOf("id"), 0u);
+    ASSERT_EQ(shape->indexOf("name"), 1u);
+    ASSERT_EQ(shape->indexOf("other"), FDCore::ObjectShape::npos);
+
+    ASSERT_EQ(FDCore::ObjectShape::root()->withKey("id")->withKey("name"), shape);
+    ASSERT_EQ(shape->withKey("id"), shape);
+    ASSERT_EQ(shape->withoutKey("name"), FDCore::ObjectShape::root()->withKey("id"));
+    ASSERT_NE(FDCore::ObjectShape::fromKeys({ "name", "id" }), shape);
+
+    std::vector<FDCore::ObjectShape::StringType> keys;
+    for(int i = 0; i < 20; ++i)
+        keys.push_back("key" + std::to_string(i));
+
+    FDCore::ObjectShape::Ptr large = FDCore::ObjectShape::fromKeys(keys);
+    for(size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(large->indexOf(keys[i]), i);
+
+    ASSERT_FALSE(large->hasKey("key20"));
+}
+
+TEST(ShapedObjectValue_test, test_member_functions)
+{
+    FDCore::ShapedObjectValue first;
+    FDCore::ShapedObjectValue second;
+    ASSERT_TRUE(first.isEmpty());
+
+    first.set("id", FDCore::AbstractValue::Ptr(new FDCore::IntValue(1)));
+    first.set("name", FDCore::AbstractValue::Ptr(new FDCore::StringValue("first")));
+    second.set("id", FDCore::AbstractValue::Ptr(new FDCore::IntValue(2)));
+    second.set("name", FDCore::AbstractValue::Ptr(new FDCore::StringValue("second")));
+
+    ASSERT_EQ(first.getShape(), second.getShape());
+    ASSERT_EQ(first.size(), 2u);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*first["id"]), 1);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*second["id"]), 2);
+    ASSERT_FALSE(first["missing"]);
+
+    first.set("id", FDCore::AbstractValue::Ptr(new FDCore::IntValue(3)));
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*first["id"]), 3);
+    ASSERT_EQ(first.getShape(), second.getShape());
+
+    first.unset("id");
+    ASSERT_EQ(first.size(), 1u);
+    ASSERT_FALSE(first["id"]);
+    ASSERT_EQ(static_cast<const FDCore::StringValue &>(*first["name"]), "first");
+    ASSERT_NE(first.getShape(), second.getShape());
+
+    FDCore::ShapedObjectValue record(second.getShape());
+    ASSERT_EQ(record.size(), 2u);
+    ASSERT_FALSE(record["name"]);
+}
+
+TEST(ShapedObjectValue_test, test_shape_bounds)
+{
+    // a shape lives as long as the objects using it, the transitions do not keep it
+    std::weak_ptr<const FDCore::ObjectShape> transient =
+      FDCore::ObjectShape::root()->withKey("transient key");
+    ASSERT_TRUE(transient.expired());
+
+    std::vector<FDCore::ObjectShape::StringType> keys;
+    for(size_t i = 0; i < FDCore::ObjectShape::MaxKeys; ++i)
+        keys.push_back("field" + std::to_string(i));
+
+    FDCore::ObjectShape::Ptr full = FDCore::ObjectShape::fromKeys(keys);
+    ASSERT_EQ(full->size(), FDCore::ObjectShape::MaxKeys);
+    ASSERT_EQ(full->withKey("extra"), nullptr);
+    ASSERT_EQ(full->withKey("field3"), full);
+
+    // shapes built for a schema are never refused
+    keys.push_back("extra");
+    FDCore::ObjectShape::Ptr larger = FDCore::ObjectShape::fromKeys(keys);
+    for(size_t i = 0; i < keys.size(); ++i)
+        ASSERT_EQ(larger->indexOf(keys[i]), i);
+
+    FDCore::ObjectShape::Ptr parent = FDCore::ObjectShape::root()->withKey("fan out");
+    std::vector<FDCore::ObjectShape::Ptr> children;
+    for(size_t i = 0; i < FDCore::ObjectShape::MaxTransitions; ++i)
+        children.push_back(parent->withKey("child" + std::to_string(i)));
+    ASSERT_EQ(parent->withKey("one too many"), nullptr);
+    ASSERT_EQ(parent->withKey("child0"), children[0]);
+
+    // the transitions of released shapes are reclaimed
+    children.pop_back();
+    ASSERT_NE(parent->withKey("one too many"), nullptr);
+}
+
+TEST(ShapedObjectValue_test, test_dictionary_mode)
+{
+    FDCore::ShapedObjectValue object;
+    for(int i = 0; i < 1000; ++i)
+        object.set("key" + std::to_string(i), std::make_shared<FDCore::IntValue>(i));
+
+    ASSERT_TRUE(object.isDictionary());
+    ASSERT_EQ(object.getShape(), nullptr);
+    ASSERT_EQ(object.size(), 1000u);
+    for(int i = 0; i < 1000; i += 37)
+        ASSERT_EQ(static_cast<const FDCore::IntValue &>(*object["key" + std::to_string(i)]), i);
+
+    FDCore::ShapedObjectValue copy(object);
+    copy.unset("key0");
+    copy.set("key1", std::make_shared<FDCore::IntValue>(-1));
+    ASSERT_EQ(copy.size(), 999u);
+    ASSERT_FALSE(copy["key0"]);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*object["key1"]), 1);
+
+    const FDCore::AbstractValue::Ptr cloned = object.clone();
+    const auto &clonedObject = static_cast<const FDCore::ShapedObjectValue &>(*cloned);
+    ASSERT_TRUE(clonedObject.isDictionary());
+    ASSERT_NE(clonedObject["key1"], object["key1"]);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*clonedObject["key1"]), 1);
+
+    // objects keyed like maps leave the shapes instead of piling up transitions on the root
+    std::vector<FDCore::ShapedObjectValue> maps(200);
+    size_t dictionaries = 0;
+    for(size_t i = 0; i < maps.size(); ++i)
+    {
+        maps[i].set("entry" + std::to_string(i), std::make_shared<FDCore::IntValue>(1));
+        if(maps[i].isDictionary())
+            ++dictionaries;
+    }
+    ASSERT_GE(dictionaries, maps.size() - FDCore::ObjectShape::MaxTransitions);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*maps.back()["entry199"]), 1);
+}
+
+#endif // FDCORE_SHAPEDOBJECTVALUE_TEST_H
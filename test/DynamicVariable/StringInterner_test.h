@@ -0,0 +1,150 @@
+#ifndef FDCORE_STRINGINTERNER_TEST_H
+#define FDCORE_STRINGINTERNER_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/ObjectValue.h>
+#include <FDCore/DynamicVariable/PathQuery.h>
+#include <FDCore/DynamicVariable/StringInterner.h>
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+TEST(StringInterner_test, test_interner)
+{
+    FDCore::StringInterner interner;
+    FDCore::InternedString first = interner.intern("key");
+    FDCore::InternedString second = interner.intern(std::string("k") + "ey");
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(&first.str(), &second.str());
+    ASSERT_EQ(first.hash(), std::hash<std::string_view>()("key"));
+    ASSERT_NE(first, interner.intern("other"));
+    ASSERT_EQ(interner.size(), 2u);
+
+    ASSERT_TRUE(interner.find("key").has_value());
+    ASSERT_FALSE(interner.find("missing").has_value());
+    ASSERT_TRUE(interner.intern("").isEmpty());
+
+    FDCore::InternedString global = FDCore::StringInterner::global().intern("key");
+    ASSERT_EQ(first, global);
+    ASSERT_NE(&first.str(), &global.str());
+
+    std::unordered_set<FDCore::InternedString> set { first, second, global };
+    ASSERT_EQ(set.size(), 1u);
+}
+
+TEST(StringInterner_test, test_string_value)
+{
+    FDCore::StringValue value("enum value");
+    ASSERT_FALSE(value.isInterned());
+    value.intern();
+    ASSERT_TRUE(value.isInterned());
+    ASSERT_EQ(value, "enum value");
+
+    FDCore::StringValue other(FDCore::StringInterner::global().intern("enum value"));
+    ASSERT_EQ(value, other);
+    ASSERT_EQ(value.hash(), other.hash());
+
+    other += "!";
+    ASSERT_FALSE(other.isInterned());
+    ASSERT_EQ(other, "enum value!");
+    ASSERT_EQ(value, "enum value");
+
+    FDCore::DynamicVariable var(FDCore::StringInterner::global().intern("enum value"));
+    ASSERT_EQ(var, FDCore::DynamicVariable::StringType("enum value"));
+}
+
+TEST(StringInterner_test, test_object_value)
+{
+    FDCore::StringInterner arena;
+    FDCore::ObjectValue object(arena);
+    object.set("name", std::make_shared<FDCore::IntValue>(1));
+    ASSERT_EQ(arena.size(), 1u);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*object["name"]), 1);
+    ASSERT_EQ(object["unknown"], nullptr);
+    ASSERT_EQ(arena.size(), 1u);
+
+    object.unset("name");
+    ASSERT_EQ(object["name"], nullptr);
+}
+
+TEST(StringInterner_test, test_detached)
+{
+    FDCore::InternedString detached("detached key, too long to be inline");
+    ASSERT_TRUE(detached.isDetached());
+    ASSERT_FALSE(detached.isInline());
+    ASSERT_EQ(detached.hash(),
+              std::hash<std::string_view>()("detached key, too long to be inline"));
+    FDCore::InternedString copy = detached;
+    ASSERT_EQ(&copy.str(), &detached.str());
+    detached = FDCore::InternedString();
+    ASSERT_EQ(copy, "detached key, too long to be inline");
+
+    FDCore::StringInterner interner;
+    ASSERT_EQ(copy, interner.intern("detached key, too long to be inline"));
+    ASSERT_FALSE(interner.intern("detached key").isDetached());
+    ASSERT_FALSE(FDCore::InternedString("").isDetached());
+
+    // objects and queries keep their names to themselves unless an interner is given
+    const FDCore::StringInterner::SizeType globalSize = FDCore::StringInterner::global().size();
+    FDCore::ObjectValue object;
+    object.set("object only key", std::make_shared<FDCore::IntValue>(1));
+    ASSERT_EQ(object.getInterner(), nullptr);
+    FDCore::DynamicVariable shaped(FDCore::ValueType::Object);
+    shaped.set("shaped only key", FDCore::DynamicVariable(2));
+    ASSERT_EQ(FDCore::PathQuery("/shaped only key").get(shaped), 2);
+    ASSERT_TRUE(FDCore::PathQuery("/query only key").get(shaped) == nullptr);
+    ASSERT_EQ(FDCore::StringInterner::global().size(), globalSize);
+
+    FDCore::InternedString member;
+    object.forEachMember(
+      [&member](const FDCore::InternedString &name, const FDCore::AbstractValue::Ptr &) {
+          member = name;
+      });
+    object.unset("object only key");
+    ASSERT_TRUE(object.isEmpty());
+    ASSERT_EQ(member, "object only key");
+}
+
+TEST(StringInterner_test, test_inline)
+{
+    ASSERT_EQ(sizeof(FDCore::InternedString), 2 * sizeof(void *));
+    const std::string longest(FDCore::InternedString::InlineCapacity, 'k');
+
+    FDCore::InternedString key("id");
+    ASSERT_TRUE(key.isInline());
+    ASSERT_TRUE(key.isDetached());
+    ASSERT_EQ(key.view(), "id");
+    ASSERT_EQ(key.hash(), std::hash<std::string_view>()("id"));
+    ASSERT_TRUE(FDCore::InternedString(longest).isInline());
+    ASSERT_FALSE(FDCore::InternedString(longest + "k").isInline());
+    ASSERT_TRUE(FDCore::InternedString().isInline());
+
+    // inline handles compare with each other and with interned handles on the same string
+    FDCore::StringInterner interner;
+    FDCore::InternedString interned = interner.intern("id");
+    ASSERT_FALSE(interned.isInline());
+    ASSERT_EQ(key, FDCore::InternedString(std::string("i") + "d"));
+    ASSERT_EQ(key, interned);
+    ASSERT_EQ(key.hash(), interned.hash());
+    ASSERT_NE(key, FDCore::InternedString("i"));
+    ASSERT_LT(FDCore::InternedString("a"), FDCore::InternedString("b"));
+
+    FDCore::InternedString moved = std::move(key);
+    ASSERT_EQ(moved, "id");
+    ASSERT_TRUE(key.isEmpty());
+
+    // a string value copies an inline string instead of holding the handle
+    FDCore::StringValue value(moved);
+    ASSERT_FALSE(value.isInterned());
+    ASSERT_EQ(value, "id");
+    ASSERT_EQ(static_cast<const FDCore::StringValue::StringType &>(value), "id");
+
+    FDCore::ObjectValue object;
+    object.set("id", std::make_shared<FDCore::IntValue>(1));
+    object.set(longest + "k", std::make_shared<FDCore::IntValue>(2));
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*object[interned.view()]), 1);
+    ASSERT_NE(object.findSlot(interned), nullptr);
+    ASSERT_NE(object.findSlot(longest + "k"), nullptr);
+}
+
+#endif // FDCORE_STRINGINTERNER_TEST_H
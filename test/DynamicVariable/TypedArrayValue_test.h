@@ -0,0 +1,93 @@
+#ifndef FDCORE_TYPEDARRAYVALUE_TEST_H
+#define FDCORE_TYPEDARRAYVALUE_TEST_H
+
+#include <FDCore/DynamicVariable/DynamicVariable.h>
+#include <FDCore/DynamicVariable/TypedArrayValue.h>
+#include <gtest/gtest.h>
+
+TEST(TypedArrayValue_test, test_member_functions)
+{
+    FDCore::IntArrayValue value { 1, 2, 3 };
+    ASSERT_EQ(value.size(), 3u);
+    ASSERT_EQ(value.getElementType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*value[1]), 2);
+
+    value.push(FDCore::AbstractValue::Ptr(new FDCore::IntValue(4)));
+    ASSERT_EQ(value.at(3), 4);
+    ASSERT_THROW(value.push(FDCore::AbstractValue::Ptr(new FDCore::FloatValue(4.5))),
+                 std::invalid_argument);
+
+    value.insert(FDCore::AbstractValue::Ptr(new FDCore::IntValue(0)), 0);
+    ASSERT_EQ(value.at(0), 0);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*value.removeAt(1)), 1);
+    ASSERT_EQ(static_cast<const FDCore::IntValue &>(*value.pop()), 4);
+
+    auto span = value.getSpan();
+    ASSERT_EQ(span.size, 3u);
+    ASSERT_EQ(span.data[2], 3);
+
+    FDCore::BoolArrayValue flags { 1, 0 };
+    ASSERT_TRUE(static_cast<bool>(static_cast<const FDCore::BoolValue &>(*flags[0])));
+    ASSERT_FALSE(static_cast<bool>(static_cast<const FDCore::BoolValue &>(*flags[1])));
+
+    FDCore::StringArrayValue strings { "a", "b" };
+    ASSERT_EQ(static_cast<const FDCore::StringValue &>(*strings[1]), "b");
+}
+
+TEST(TypedArrayValue_test, test_dynamic_variable)
+{
+    FDCore::DynamicVariable value(std::vector<FDCore::DynamicVariable::FloatType> { 0.5, 1.5 });
+    ASSERT_EQ(value.getElementType(), FDCore::ValueType::Float);
+    ASSERT_EQ(value.size(), 2u);
+    ASSERT_EQ(value[1], 1.5);
+
+    value.push(FDCore::DynamicVariable(2.5));
+    ASSERT_EQ(value.getSpan<FDCore::DynamicVariable::FloatType>().data[2], 2.5);
+    ASSERT_THROW(value.getSpan<FDCore::DynamicVariable::IntType>(), std::runtime_error);
+
+    value.makeGeneric();
+    ASSERT_EQ(value.getElementType(), FDCore::ValueType::None);
+    ASSERT_EQ(value[2], 2.5);
+    value.push(FDCore::DynamicVariable(FDCore::DynamicVariable::StringType("text")));
+    ASSERT_FALSE(value.makeDense());
+    value.pop();
+    ASSERT_TRUE(value.makeDense());
+    ASSERT_EQ(value.getElementType(), FDCore::ValueType::Float);
+
+    auto values = FDCore::is_DynamicVariable_constructible<
+      std::vector<FDCore::DynamicVariable::FloatType>>::fromVariable(value.internalValue());
+    ASSERT_TRUE(values.has_value());
+    ASSERT_EQ(values->size(), 3u);
+}
+
+TEST(TypedArrayValue_test, test_transparent_generic)
+{
+    FDCore::DynamicVariable ints(std::vector<FDCore::DynamicVariable::IntType> { 1, 2 });
+    FDCore::DynamicVariable shared = ints;
+    ints.push(FDCore::DynamicVariable(2.5));
+    ASSERT_EQ(ints.getElementType(), FDCore::ValueType::None);
+    ASSERT_EQ(ints.size(), 3u);
+    ASSERT_EQ(ints[2], 2.5);
+    ASSERT_EQ(shared.getElementType(), FDCore::ValueType::Integer);
+    ASSERT_EQ(shared.size(), 2u);
+
+    FDCore::DynamicVariable strings(std::vector<FDCore::DynamicVariable::StringType> { "a" });
+    strings.insert(FDCore::DynamicVariable(), 0);
+    ASSERT_EQ(strings.size(), 2u);
+    ASSERT_TRUE(strings[0] == nullptr);
+    ASSERT_EQ(strings[1], FDCore::DynamicVariable::StringType("a"));
+
+    const FDCore::DynamicVariable constFloats(
+      std::vector<FDCore::DynamicVariable::FloatType> { 0.5, 1.5 });
+    ASSERT_EQ(static_cast<FDCore::DynamicVariable::ArrayType>(constFloats).size(), 2u);
+    ASSERT_EQ(constFloats.getElementType(), FDCore::ValueType::Float);
+
+    FDCore::DynamicVariable floats = constFloats;
+    const auto &cells = static_cast<const FDCore::DynamicVariable::ArrayType &>(floats);
+    ASSERT_EQ(cells.size(), 2u);
+    ASSERT_EQ(FDCore::DynamicVariable(cells[1]), 1.5);
+    ASSERT_EQ(floats.getElementType(), FDCore::ValueType::None);
+    ASSERT_EQ(constFloats.getElementType(), FDCore::ValueType::Float);
+}
+
+#endif // FDCORE_TYPEDARRAYVALUE_TEST_H